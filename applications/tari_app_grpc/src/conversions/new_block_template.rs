@@ -47,26 +47,7 @@ impl TryFrom<NewBlockTemplate> for grpc::NewBlockTemplate {
             }),
         };
         Ok(Self {
-            body: Some(grpc::AggregateBody {
-                inputs: block
-                    .body
-                    .inputs()
-                    .iter()
-                    .map(|input| grpc::TransactionInput::try_from(input.clone()))
-                    .collect::<Result<Vec<grpc::TransactionInput>, _>>()?,
-                outputs: block
-                    .body
-                    .outputs()
-                    .iter()
-                    .map(|output| grpc::TransactionOutput::try_from(output.clone()))
-                    .collect::<Result<Vec<_>, _>>()?,
-                kernels: block
-                    .body
-                    .kernels()
-                    .iter()
-                    .map(|kernel| grpc::TransactionKernel::from(kernel.clone()))
-                    .collect(),
-            }),
+            body: Some(block.body.try_into()?),
             header: Some(header),
         })
     }
@@ -37,12 +37,19 @@ use tari_core::{
         service::BaseNodeServiceInitializer,
         state_machine_service::initializer::BaseNodeStateMachineInitializer,
         LocalNodeCommsInterface,
+        PruningWorkerInitializer,
         StateMachineHandle,
     },
     chain_storage::{async_db::AsyncBlockchainDb, BlockchainBackend, BlockchainDatabase},
     consensus::ConsensusManager,
     mempool,
-    mempool::{service::MempoolHandle, Mempool, MempoolServiceInitializer, MempoolSyncInitializer},
+    mempool::{
+        service::MempoolHandle,
+        Mempool,
+        MempoolServiceInitializer,
+        MempoolSnapshotInitializer,
+        MempoolSyncInitializer,
+    },
     proof_of_work::randomx_factory::RandomXFactory,
     transactions::CryptoFactories,
 };
@@ -141,6 +148,10 @@ where B: BlockchainBackend + 'static
                 peer_message_subscriptions.clone(),
             ))
             .add_initializer(mempool_sync)
+            .add_initializer(MempoolSnapshotInitializer::new(
+                base_node_config.mempool.service.clone(),
+                self.mempool.clone(),
+            ))
             .add_initializer(LivenessInitializer::new(
                 LivenessConfig {
                     auto_ping_interval: Some(base_node_config.metadata_auto_ping_interval),
@@ -150,6 +161,7 @@ where B: BlockchainBackend + 'static
                 peer_message_subscriptions,
             ))
             .add_initializer(ChainMetadataServiceInitializer)
+            .add_initializer(PruningWorkerInitializer::new(self.db.clone().into()))
             .add_initializer(BaseNodeStateMachineInitializer::new(
                 self.db.clone().into(),
                 base_node_config.state_machine.clone(),
@@ -141,6 +141,8 @@ impl Default for BaseNodeConfig {
             user_agent: format!("tari/basenode/{}", consts::APP_VERSION_NUMBER),
             ..Default::default()
         };
+        let mut mempool = MempoolConfig::default();
+        mempool.service.snapshot_file = Some(PathBuf::from("mempool_snapshot.bin"));
         Self {
             override_from: None,
             network: Network::default(),
@@ -159,7 +161,7 @@ impl Default for BaseNodeConfig {
             force_sync_peers: StringList::default(),
             messaging_request_timeout: Duration::from_secs(60),
             storage: Default::default(),
-            mempool: Default::default(),
+            mempool,
             status_line_interval: Duration::from_secs(5),
             buffer_size: 1_500,
             buffer_rate_limit: 1_000,
@@ -190,6 +192,11 @@ impl BaseNodeConfig {
         if !self.lmdb_path.is_absolute() {
             self.lmdb_path = self.data_dir.join(self.lmdb_path.as_path());
         }
+        if let Some(snapshot_file) = self.mempool.service.snapshot_file.as_mut() {
+            if !snapshot_file.is_absolute() {
+                *snapshot_file = self.data_dir.join(snapshot_file.as_path());
+            }
+        }
         self.p2p.set_base_path(base_path);
     }
 }
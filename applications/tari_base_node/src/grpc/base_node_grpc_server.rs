@@ -23,6 +23,7 @@
 use std::{
     cmp,
     convert::{TryFrom, TryInto},
+    mem,
 };
 
 use borsh::{BorshDeserialize, BorshSerialize};
@@ -43,13 +44,13 @@ use tari_core::{
         LocalNodeCommsInterface,
         StateMachineHandle,
     },
-    blocks::{Block, BlockHeader, NewBlockTemplate},
+    blocks::{Block, BlockHeader, ChainHeader, NewBlockTemplate},
     chain_storage::ChainStorageError,
     consensus::{emission::Emission, ConsensusManager, NetworkConsensus},
     iterators::NonOverlappingIntegerPairIter,
     mempool::{service::LocalMempoolService, TxStorageResponse},
     proof_of_work::PowAlgorithm,
-    transactions::transaction_components::Transaction,
+    transactions::{aggregated_body::AggregateBody, transaction_components::Transaction},
 };
 use tari_p2p::{auto_update::SoftwareUpdaterHandle, services::liveness::LivenessHandle};
 use tari_utilities::{hex::Hex, message_format::MessageFormat, ByteArray};
@@ -59,9 +60,10 @@ use tonic::{Request, Response, Status};
 use crate::{
     builder::BaseNodeContext,
     grpc::{
-        blocks::{block_fees, block_heights, block_size, GET_BLOCKS_MAX_HEIGHTS, GET_BLOCKS_PAGE_SIZE},
+        blocks::{block_fees, block_heights, block_size, height_pages, GET_BLOCKS_MAX_HEIGHTS, GET_BLOCKS_PAGE_SIZE},
         hash_rate::HashRateMovingAverage,
         helpers::{mean, median},
+        template_cache::TemplateBodyCache,
     },
 };
 
@@ -94,6 +96,7 @@ pub struct BaseNodeGrpcServer {
     comms: CommsNode,
     liveness: LivenessHandle,
     report_grpc_error: bool,
+    template_body_cache: TemplateBodyCache,
 }
 
 impl BaseNodeGrpcServer {
@@ -108,6 +111,7 @@ impl BaseNodeGrpcServer {
             comms: ctx.base_node_comms().clone(),
             liveness: ctx.liveness(),
             report_grpc_error: ctx.get_report_grpc_error(),
+            template_body_cache: TemplateBodyCache::new(),
         }
     }
 
@@ -474,7 +478,7 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
 
         let mut handler = self.node_service.clone();
 
-        let new_template = handler
+        let mut new_template = handler
             .get_new_block_template(algo, request.max_weight)
             .await
             .map_err(|e| {
@@ -488,18 +492,26 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
 
         let status_watch = self.state_machine_handle.get_status_info_watch();
         let pow = algo as i32;
+        let miner_data = tari_rpc::MinerData {
+            reward: new_template.reward.into(),
+            target_difficulty: new_template.target_difficulty.as_u64(),
+            total_fees: new_template.total_fees.into(),
+            algo: Some(tari_rpc::PowAlgo { pow_algo: pow }),
+        };
+        // The body is converted separately so that an unchanged body can be served from the cache
+        let body = mem::replace(&mut new_template.body, AggregateBody::empty());
+        let mut new_block_template: tari_rpc::NewBlockTemplate = new_template
+            .try_into()
+            .map_err(|e| obscure_error_if_true(report_error_flag, Status::internal(e)))?;
+        let body = self
+            .template_body_cache
+            .get_or_convert(body)
+            .map_err(|e| obscure_error_if_true(report_error_flag, Status::internal(e)))?;
+        // The response owns its body, so a cached body is copied rather than converted again
+        new_block_template.body = Some((*body).clone());
         let response = tari_rpc::NewBlockTemplateResponse {
-            miner_data: Some(tari_rpc::MinerData {
-                reward: new_template.reward.into(),
-                target_difficulty: new_template.target_difficulty.as_u64(),
-                total_fees: new_template.total_fees.into(),
-                algo: Some(tari_rpc::PowAlgo { pow_algo: pow }),
-            }),
-            new_block_template: Some(
-                new_template
-                    .try_into()
-                    .map_err(|e| obscure_error_if_true(report_error_flag, Status::internal(e)))?,
-            ),
+            miner_data: Some(miner_data),
+            new_block_template: Some(new_block_template),
 
             initial_sync_achieved: (*status_watch.borrow()).bootstrapped,
         };
@@ -846,15 +858,13 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
 
         heights.truncate(GET_BLOCKS_MAX_HEIGHTS);
         heights.sort_unstable();
-        // unreachable panic: `heights` is not empty
-        let start = *heights.first().expect("unreachable");
-        let end = *heights.last().expect("unreachable");
+        heights.dedup();
 
         let mut handler = self.node_service.clone();
         let (mut tx, rx) = mpsc::channel(GET_BLOCKS_PAGE_SIZE);
         task::spawn(async move {
-            let page_iter = NonOverlappingIntegerPairIter::new(start, end + 1, GET_BLOCKS_PAGE_SIZE);
-            for (start, end) in page_iter {
+            // Each page only spans consecutive requested heights, so every block fetched is sent to the client
+            for (start, end) in height_pages(&heights, GET_BLOCKS_PAGE_SIZE) {
                 let blocks = match handler.get_blocks(start..=end, false).await {
                     Err(err) => {
                         warn!(
@@ -863,11 +873,7 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
                         );
                         return;
                     },
-                    Ok(data) => {
-                        // TODO: Change this interface to a start-end ranged one (clients like the block explorer
-                        // convert start end ranges to integer lists anyway)
-                        data.into_iter().filter(|b| heights.contains(&b.header().height))
-                    },
+                    Ok(data) => data,
                 };
 
                 for block in blocks {
@@ -930,6 +936,7 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
         let report_error_flag = self.report_error_flag();
         debug!(target: LOG_TARGET, "Incoming GRPC request for SearchKernels");
         let request = request.into_inner();
+        let headers_only = request.headers_only;
 
         let kernels = request
             .signatures
@@ -942,6 +949,20 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
 
         let (mut tx, rx) = mpsc::channel(GET_BLOCKS_PAGE_SIZE);
         task::spawn(async move {
+            if headers_only {
+                let headers = match handler.get_headers_with_kernels(kernels).await {
+                    Err(err) => {
+                        warn!(
+                            target: LOG_TARGET,
+                            "Error communicating with local base node: {:?}", err,
+                        );
+                        return;
+                    },
+                    Ok(data) => data,
+                };
+                send_header_only_blocks(&mut handler, &mut tx, headers, "search_kernels", report_error_flag).await;
+                return;
+            }
             let blocks = match handler.get_blocks_with_kernels(kernels).await {
                 Err(err) => {
                     warn!(
@@ -980,6 +1001,7 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
         let report_error_flag = self.report_error_flag();
         debug!(target: LOG_TARGET, "Incoming GRPC request for SearchUtxos");
         let request = request.into_inner();
+        let headers_only = request.headers_only;
 
         let outputs = request
             .commitments
@@ -992,6 +1014,20 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
 
         let (mut tx, rx) = mpsc::channel(GET_BLOCKS_PAGE_SIZE);
         task::spawn(async move {
+            if headers_only {
+                let headers = match handler.fetch_headers_with_utxos(outputs).await {
+                    Err(err) => {
+                        warn!(
+                            target: LOG_TARGET,
+                            "Error communicating with local base node: {:?}", err,
+                        );
+                        return;
+                    },
+                    Ok(data) => data,
+                };
+                send_header_only_blocks(&mut handler, &mut tx, headers, "search_utxos", report_error_flag).await;
+                return;
+            }
             let blocks = match handler.fetch_blocks_with_utxos(outputs).await {
                 Err(err) => {
                     warn!(
@@ -1014,6 +1050,7 @@ impl tari_rpc::base_node_server::BaseNode for BaseNodeGrpcServer {
                         target: LOG_TARGET,
                         "[search_utxos] Request was cancelled while sending a response"
                     );
+                    return;
                 }
             }
         });
@@ -1727,6 +1764,45 @@ enum BlockGroupType {
     BlockFees,
     BlockSize,
 }
+
+/// Streams the given headers as historical blocks without bodies, for the `headers_only` block searches
+async fn send_header_only_blocks(
+    handler: &mut LocalNodeCommsInterface,
+    tx: &mut mpsc::Sender<Result<tari_rpc::HistoricalBlock, Status>>,
+    headers: Vec<ChainHeader>,
+    request_name: &str,
+    report_error_flag: bool,
+) {
+    let tip_height = match handler.get_metadata().await {
+        Ok(metadata) => metadata.height_of_longest_chain(),
+        Err(err) => {
+            let _ = tx
+                .send(Err(obscure_error_if_true(
+                    report_error_flag,
+                    Status::internal(err.to_string()),
+                )))
+                .await;
+            return;
+        },
+    };
+    for header in headers {
+        let block = tari_rpc::HistoricalBlock {
+            confirmations: tip_height.saturating_sub(header.height()) + 1,
+            block: Some(tari_rpc::Block {
+                header: Some(header.into_header().into()),
+                body: None,
+            }),
+        };
+        if tx.send(Ok(block)).await.is_err() {
+            warn!(
+                target: LOG_TARGET,
+                "[{}] Request was cancelled while sending a response", request_name
+            );
+            return;
+        }
+    }
+}
+
 async fn get_block_group(
     mut handler: LocalNodeCommsInterface,
     request: Request<tari_rpc::BlockGroupRequest>,
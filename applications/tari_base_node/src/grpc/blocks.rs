@@ -65,6 +65,28 @@ pub async fn block_heights(
     }
 }
 
+/// Splits sorted and deduplicated heights into inclusive ranges of consecutive heights, each at most `page_size` long,
+/// so that only the requested blocks are read from the database
+pub fn height_pages(heights: &[u64], page_size: usize) -> Vec<(u64, u64)> {
+    let mut pages = Vec::new();
+    let mut iter = heights.iter().copied();
+    let mut current = match iter.next() {
+        Some(height) => (height, height),
+        None => return pages,
+    };
+    for height in iter {
+        let len = current.1 - current.0 + 1;
+        if height == current.1 + 1 && len < page_size as u64 {
+            current.1 = height;
+        } else {
+            pages.push(current);
+            current = (height, height);
+        }
+    }
+    pages.push(current);
+    pages
+}
+
 pub fn block_size(block: &HistoricalBlock) -> u64 {
     let body = &block.block().body;
 
@@ -82,3 +104,20 @@ pub fn block_fees(block: &HistoricalBlock) -> u64 {
         .iter()
         .sum::<u64>()
 }
+
+#[cfg(test)]
+pub mod test {
+    use super::height_pages;
+
+    #[test]
+    fn it_pages_consecutive_heights() {
+        assert!(height_pages(&[], 10).is_empty());
+        assert_eq!(height_pages(&[5], 10), vec![(5, 5)]);
+        assert_eq!(height_pages(&[1, 2, 3, 4, 5], 2), vec![(1, 2), (3, 4), (5, 5)]);
+        assert_eq!(height_pages(&[0, 1, 7, 8, 9, 100], 10), vec![
+            (0, 1),
+            (7, 9),
+            (100, 100)
+        ]);
+    }
+}
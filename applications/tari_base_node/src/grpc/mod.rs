@@ -24,3 +24,4 @@ pub mod base_node_grpc_server;
 pub mod blocks;
 pub mod hash_rate;
 pub mod helpers;
+pub mod template_cache;
@@ -0,0 +1,187 @@
+// Copyright 2019. The Tari Project
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+// following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+// disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+// following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+// products derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+use std::{
+    convert::TryInto,
+    sync::{Arc, Mutex},
+};
+
+use tari_app_grpc::tari_rpc;
+use tari_common_types::types::{Commitment, Signature};
+use tari_core::transactions::aggregated_body::AggregateBody;
+
+/// Holds the gRPC body of the last block template that was handed out. Miners poll for new templates much more often
+/// than the mempool changes, so consecutive templates usually contain the same transactions. In that case the
+/// converted body is reused instead of encoding (and hashing) every input, output and kernel again.
+#[derive(Clone, Default)]
+pub struct TemplateBodyCache {
+    last: Arc<Mutex<Option<CachedBody>>>,
+}
+
+struct CachedBody {
+    key: BodyKey,
+    body: Arc<tari_rpc::AggregateBody>,
+}
+
+/// Identifies a template body by the commitments it spends and creates, and by its kernel excess signatures. None of
+/// these have to be hashed, so an unchanged body is recognised without redoing the work of a conversion.
+struct BodyKey {
+    inputs: Vec<Commitment>,
+    outputs: Vec<Commitment>,
+    excess_sigs: Vec<Signature>,
+}
+
+impl BodyKey {
+    /// Returns None if an input does not carry the commitment it spends, in which case the body is not cached
+    fn new(body: &AggregateBody) -> Option<Self> {
+        Some(Self {
+            inputs: body
+                .inputs()
+                .iter()
+                .map(|input| input.commitment().ok().cloned())
+                .collect::<Option<_>>()?,
+            outputs: body
+                .outputs()
+                .iter()
+                .map(|output| output.commitment().clone())
+                .collect(),
+            excess_sigs: body.kernels().iter().map(|kernel| kernel.excess_sig.clone()).collect(),
+        })
+    }
+
+    fn matches(&self, body: &AggregateBody) -> bool {
+        self.inputs.len() == body.inputs().len() &&
+            self.outputs.len() == body.outputs().len() &&
+            self.excess_sigs.len() == body.kernels().len() &&
+            self.excess_sigs
+                .iter()
+                .zip(body.kernels())
+                .all(|(sig, kernel)| *sig == kernel.excess_sig) &&
+            self.outputs
+                .iter()
+                .zip(body.outputs())
+                .all(|(commitment, output)| commitment == output.commitment()) &&
+            self.inputs
+                .iter()
+                .zip(body.inputs())
+                .all(|(commitment, input)| input.commitment().map_or(false, |c| c == commitment))
+    }
+}
+
+impl TemplateBodyCache {
+    pub fn new() -> Self {
+        Default::default()
+    }
+
+    /// Returns the gRPC form of `body`, converting it only if it differs from the body of the previous template
+    pub fn get_or_convert(&self, body: AggregateBody) -> Result<Arc<tari_rpc::AggregateBody>, String> {
+        let mut last = self
+            .last
+            .lock()
+            .map_err(|_| "Template body cache lock poisoned".to_string())?;
+        if let Some(cached) = last.as_ref().filter(|cached| cached.key.matches(&body)) {
+            return Ok(cached.body.clone());
+        }
+
+        let key = BodyKey::new(&body);
+        let converted = Arc::new(body.try_into()?);
+        *last = key.map(|key| CachedBody {
+            key,
+            body: converted.clone(),
+        });
+        Ok(converted)
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use tari_common_types::types::CommitmentFactory;
+    use tari_core::transactions::{
+        tari_amount::MicroTari,
+        test_helpers::{create_test_input, create_test_kernel},
+        transaction_components::{KernelFeatures, TransactionOutput},
+        CryptoFactories,
+    };
+
+    use super::*;
+
+    fn create_outputs(values: &[u64]) -> Vec<TransactionOutput> {
+        let factories = CryptoFactories::default();
+        values
+            .iter()
+            .map(|v| {
+                let (_, unblinded) = create_test_input(MicroTari(*v), 0, &factories.commitment);
+                unblinded.as_transaction_output(&factories).unwrap()
+            })
+            .collect()
+    }
+
+    #[test]
+    fn it_reuses_the_body_of_an_unchanged_template() {
+        let cache = TemplateBodyCache::new();
+        let (input, _) = create_test_input(MicroTari(10_000), 0, &CommitmentFactory::default());
+        let kernel = create_test_kernel(MicroTari(100), 0, KernelFeatures::empty());
+        let body = AggregateBody::new(vec![input], create_outputs(&[1_000, 2_000]), vec![kernel]);
+
+        let first = cache.get_or_convert(body.clone()).unwrap();
+        let second = cache.get_or_convert(body).unwrap();
+        assert!(Arc::ptr_eq(&first, &second));
+    }
+
+    #[test]
+    fn it_converts_a_body_with_the_same_kernels_but_different_outputs() {
+        let cache = TemplateBodyCache::new();
+        let (input, _) = create_test_input(MicroTari(10_000), 0, &CommitmentFactory::default());
+        let kernel = create_test_kernel(MicroTari(100), 0, KernelFeatures::empty());
+        let body = AggregateBody::new(vec![input.clone()], create_outputs(&[1_000, 2_000]), vec![
+            kernel.clone()
+        ]);
+        let changed = AggregateBody::new(vec![input], create_outputs(&[1_000, 2_000]), vec![kernel]);
+
+        let first = cache.get_or_convert(body).unwrap();
+        let second = cache.get_or_convert(changed.clone()).unwrap();
+        assert!(!Arc::ptr_eq(&first, &second));
+        let expected: tari_rpc::AggregateBody = changed.try_into().unwrap();
+        assert_eq!(*second, expected);
+    }
+
+    #[test]
+    fn it_matches_a_template_without_hashing_its_outputs() {
+        let cache = TemplateBodyCache::new();
+        let (input, _) = create_test_input(MicroTari(10_000), 0, &CommitmentFactory::default());
+        let kernel = create_test_kernel(MicroTari(100), 0, KernelFeatures::empty());
+        let outputs = create_outputs(&[1_000, 2_000]);
+        let body = AggregateBody::new(vec![input.clone()], outputs.clone(), vec![kernel.clone()]);
+
+        // Only the output hashes of this body differ, so a key that needed them would miss
+        let mut rehashed = outputs;
+        for output in &mut rehashed {
+            output.minimum_value_promise = MicroTari(1);
+        }
+        let body_with_other_hashes = AggregateBody::new(vec![input], rehashed, vec![kernel]);
+        assert_ne!(body.outputs()[0].hash(), body_with_other_hashes.outputs()[0].hash());
+
+        let first = cache.get_or_convert(body).unwrap();
+        let second = cache.get_or_convert(body_with_other_hashes).unwrap();
+        assert!(Arc::ptr_eq(&first, &second));
+    }
+}
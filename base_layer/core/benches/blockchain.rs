@@ -0,0 +1,281 @@
+//  Copyright 2022. The Tari Project
+//
+//  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+//  following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+//  disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+//  following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+//  products derived from this software without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+//  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+//  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+//  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#[cfg(not(feature = "benches"))]
+mod benches {
+    pub fn main() {
+        println!("Enable the `benches` feature to run benches");
+    }
+}
+
+#[cfg(feature = "benches")]
+mod benches {
+    use std::{collections::VecDeque, sync::Arc, thread};
+
+    use criterion::{criterion_group, BatchSize, BenchmarkId, Criterion};
+    use tari_core::{
+        blocks::{Block, BlockHeader, ChainBlock},
+        chain_storage::{BlockchainBackend, DbTransaction},
+        test_helpers::{
+            blockchain::{create_custom_blockchain, create_test_db, TestBlockchain},
+            create_chain_header,
+            BlockSpec,
+        },
+        transactions::{
+            tari_amount::T,
+            test_helpers::schema_to_transaction,
+            transaction_components::{transaction_output::batch_verify_range_proofs, Transaction, UnblindedOutput},
+            CryptoFactories,
+        },
+        txn_schema,
+        validation::{block_validators::BlockValidator, BlockSyncBodyValidation},
+    };
+    use tokio::runtime::Runtime;
+
+    /// The number of blocks with transactions in the fixture chain, after the blocks needed for coinbase maturity
+    const NUM_TX_BLOCKS: usize = 20;
+    /// The number of outputs each block creates from a matured coinbase. The outputs are spent in pairs in the next
+    /// block, so every block after the first has inputs, outputs and kernels from several transactions.
+    const FAN_OUT: usize = 32;
+    const NUM_HEADERS: u64 = 10_000;
+
+    /// A chain with realistic block bodies. The shape of the chain is fixed, so every run measures the same amount of
+    /// work, but keys and nonces are random.
+    struct ChainFixture {
+        blockchain: TestBlockchain,
+        /// The blocks after genesis, in order
+        blocks: Vec<Arc<ChainBlock>>,
+        /// A valid next block that has not been added to the chain, with MMR roots calculated against the tip
+        next_block: Block,
+    }
+
+    fn leak_name(height: usize) -> &'static str {
+        Box::leak(format!("B{}", height).into_boxed_str())
+    }
+
+    fn create_fixture() -> ChainFixture {
+        let mut blockchain = TestBlockchain::default();
+        let lock_height = blockchain.rules().consensus_constants(0).coinbase_lock_height() as usize;
+        let mut coinbases = VecDeque::new();
+        let mut spendable = Vec::<UnblindedOutput>::new();
+        let mut blocks = Vec::new();
+
+        let num_blocks = lock_height + 1 + NUM_TX_BLOCKS;
+        let mut next_transactions = Vec::new();
+        for height in 1..=num_blocks {
+            let (block, coinbase) = blockchain
+                .append_to_tip(
+                    BlockSpec::builder()
+                        .with_name(leak_name(height))
+                        .with_transactions(next_transactions)
+                        .finish(),
+                )
+                .unwrap();
+            blocks.push(block);
+            coinbases.push_back(coinbase);
+            next_transactions = create_transactions(height as u64 + 1, &mut coinbases, &mut spendable);
+        }
+
+        let (block, _) = blockchain.create_next_tip(
+            BlockSpec::builder()
+                .with_name(leak_name(num_blocks + 1))
+                .with_transactions(next_transactions)
+                .finish(),
+        );
+        let mut next_block = block.block().clone();
+        let (_, roots) = blockchain.db().calculate_mmr_roots(next_block.clone()).unwrap();
+        next_block.header.kernel_mr = roots.kernel_mr;
+        next_block.header.kernel_mmr_size = roots.kernel_mmr_size;
+        next_block.header.input_mr = roots.input_mr;
+        next_block.header.output_mr = roots.output_mr;
+        next_block.header.witness_mr = roots.witness_mr;
+        next_block.header.output_mmr_size = roots.output_mmr_size;
+        next_block.header.validator_node_mr = roots.validator_node_mr;
+
+        ChainFixture {
+            blockchain,
+            blocks,
+            next_block,
+        }
+    }
+
+    /// Creates the transactions for the block at `height`: one that fans a matured coinbase out into `FAN_OUT`
+    /// outputs and one for each pair of outputs created by the previous fan out.
+    fn create_transactions(
+        height: u64,
+        coinbases: &mut VecDeque<UnblindedOutput>,
+        spendable: &mut Vec<UnblindedOutput>,
+    ) -> Vec<Transaction> {
+        let mut schemas = spendable
+            .chunks(2)
+            .map(|pair| txn_schema!(from: pair.to_vec(), to: vec![T]))
+            .collect::<Vec<_>>();
+        spendable.clear();
+
+        let is_mature = coinbases
+            .front()
+            .map(|coinbase| coinbase.features.maturity <= height)
+            .unwrap_or(false);
+        if is_mature {
+            let coinbase = coinbases.pop_front().unwrap();
+            schemas.push(txn_schema!(from: vec![coinbase], to: vec![T; FAN_OUT]));
+        }
+
+        let (transactions, outputs) = schema_to_transaction(&schemas);
+        // Only the fan out outputs are spent in the next block, change outputs are left in the UTXO set
+        spendable.extend(outputs.into_iter().filter(|output| output.value == T));
+        transactions.into_iter().map(|tx| (*tx).clone()).collect()
+    }
+
+    /// Inserts every output and kernel of `blocks` the way horizon sync does, without the block bodies
+    #[allow(clippy::cast_possible_truncation)]
+    fn horizon_sync_transaction(blocks: &[Arc<ChainBlock>]) -> DbTransaction {
+        let mut txn = DbTransaction::new();
+        for block in blocks {
+            let header = block.header();
+            let body = &block.block().body;
+            let first_output_position = header.output_mmr_size - body.outputs().len() as u64;
+            for (i, output) in body.outputs().iter().enumerate() {
+                txn.insert_utxo(
+                    output.clone(),
+                    *block.hash(),
+                    header.height,
+                    (first_output_position + i as u64) as u32,
+                    header.timestamp.as_u64(),
+                );
+            }
+            let first_kernel_position = header.kernel_mmr_size - body.kernels().len() as u64;
+            for (i, kernel) in body.kernels().iter().enumerate() {
+                txn.insert_kernel(kernel.clone(), *block.hash(), (first_kernel_position + i as u64) as u32);
+            }
+        }
+        txn
+    }
+
+    pub fn chain_storage(c: &mut Criterion) {
+        let fixture = create_fixture();
+        let rules = fixture.blockchain.rules().clone();
+
+        let mut group = c.benchmark_group("chain_storage");
+        group.sample_size(10);
+
+        group.bench_function("add_block", |b| {
+            b.iter_batched(
+                || create_custom_blockchain(rules.clone()),
+                |db| {
+                    for block in &fixture.blocks {
+                        db.add_block(block.to_arc_block()).unwrap();
+                    }
+                },
+                BatchSize::PerIteration,
+            );
+        });
+
+        group.bench_function("calculate_mmr_roots", |b| {
+            let db = fixture.blockchain.db();
+            b.iter(|| db.calculate_mmr_roots(fixture.next_block.clone()).unwrap());
+        });
+
+        group.bench_function("horizon_sync_insert", |b| {
+            b.iter_batched(
+                || (create_test_db(), horizon_sync_transaction(&fixture.blocks)),
+                |(mut db, txn)| db.write(txn).unwrap(),
+                BatchSize::PerIteration,
+            );
+        });
+
+        let db = create_custom_blockchain(rules);
+        let mut prev = db.fetch_tip_header().unwrap();
+        let mut txn = DbTransaction::new();
+        for _ in 0..NUM_HEADERS {
+            let header = create_chain_header(BlockHeader::from_previous(prev.header()), prev.accumulated_data());
+            txn.insert_chain_header(header.clone());
+            prev = header;
+        }
+        db.write(txn).unwrap();
+        for num_headers in [100u64, 1_000, NUM_HEADERS] {
+            group.bench_with_input(
+                BenchmarkId::new("fetch_chain_headers", num_headers),
+                &num_headers,
+                |b, num_headers| b.iter(|| db.fetch_chain_headers(1..=*num_headers).unwrap()),
+            );
+        }
+
+        group.finish();
+    }
+
+    pub fn block_validation(c: &mut Criterion) {
+        let runtime = Runtime::new().unwrap();
+        let fixture = create_fixture();
+        let factories = CryptoFactories::default();
+
+        let mut group = c.benchmark_group("block_validation");
+        group.sample_size(10);
+
+        let validator = BlockValidator::new(
+            fixture.blockchain.db().clone().into(),
+            fixture.blockchain.rules().clone(),
+            factories.clone(),
+            false,
+            thread::available_parallelism().map(|n| n.get()).unwrap_or(1),
+        );
+        runtime
+            .block_on(validator.validate_body(fixture.next_block.clone()))
+            .expect("the fixture block should be valid");
+        group.bench_function("validate_body", |b| {
+            b.iter(|| {
+                runtime
+                    .block_on(validator.validate_body(fixture.next_block.clone()))
+                    .unwrap()
+            })
+        });
+
+        let outputs = fixture
+            .blocks
+            .iter()
+            .flat_map(|block| block.block().body.outputs().iter())
+            .collect::<Vec<_>>();
+        for num_outputs in [1usize, 16, 64, 256] {
+            let outputs = &outputs[..num_outputs.min(outputs.len())];
+            group.bench_with_input(
+                BenchmarkId::new("batch_verify_range_proofs", outputs.len()),
+                outputs,
+                |b, outputs| b.iter(|| batch_verify_range_proofs(&factories.range_proof, outputs).unwrap()),
+            );
+        }
+
+        group.finish();
+    }
+
+    criterion_group!(chain_storage_perf, chain_storage);
+    criterion_group!(block_validation_perf, block_validation);
+
+    pub fn main() {
+        chain_storage_perf();
+        block_validation_perf();
+        criterion::Criterion::default().configure_from_args().final_summary();
+    }
+}
+
+fn main() {
+    benches::main();
+}
@@ -49,6 +49,8 @@ pub enum NodeCommsRequest {
     FetchMatchingBlocks { range: RangeInclusive<u64>, compact: bool },
     FetchBlocksByKernelExcessSigs(Vec<Signature>),
     FetchBlocksByUtxos(Vec<Commitment>),
+    FetchHeadersByKernelExcessSigs(Vec<Signature>),
+    FetchHeadersByUtxos(Vec<Commitment>),
     GetHeaderByHash(HashOutput),
     GetBlockByHash(HashOutput),
     GetNewBlockTemplate(GetNewBlockTemplateRequest),
@@ -84,6 +86,8 @@ impl Display for NodeCommsRequest {
             },
             FetchBlocksByKernelExcessSigs(v) => write!(f, "FetchBlocksByKernelExcessSigs (n={})", v.len()),
             FetchBlocksByUtxos(v) => write!(f, "FetchBlocksByUtxos (n={})", v.len()),
+            FetchHeadersByKernelExcessSigs(v) => write!(f, "FetchHeadersByKernelExcessSigs (n={})", v.len()),
+            FetchHeadersByUtxos(v) => write!(f, "FetchHeadersByUtxos (n={})", v.len()),
             GetHeaderByHash(v) => write!(f, "GetHeaderByHash({})", v.to_hex()),
             GetBlockByHash(v) => write!(f, "GetBlockByHash({})", v.to_hex()),
             GetNewBlockTemplate(v) => write!(f, "GetNewBlockTemplate ({}) with weight {}", v.algo, v.max_weight),
@@ -170,76 +170,33 @@ where B: BlockchainBackend + 'static
                 Ok(NodeCommsResponse::HistoricalBlocks(blocks))
             },
             NodeCommsRequest::FetchBlocksByKernelExcessSigs(excess_sigs) => {
-                if excess_sigs.len() > MAX_REQUEST_BY_KERNEL_EXCESS_SIGS {
-                    return Err(CommsInterfaceError::InvalidRequest {
-                        request: "FetchBlocksByKernelExcessSigs",
-                        details: format!(
-                            "Exceeded maximum number of kernel excess sigs in request (max: {}, got:{})",
-                            MAX_REQUEST_BY_KERNEL_EXCESS_SIGS,
-                            excess_sigs.len()
-                        ),
-                    });
-                }
-                let mut blocks = Vec::with_capacity(excess_sigs.len());
-                for sig in excess_sigs {
-                    let sig_hex = sig.get_signature().to_hex();
-                    debug!(
-                        target: LOG_TARGET,
-                        "A peer has requested a block with kernel with sig {}", sig_hex
-                    );
-                    match self.blockchain_db.fetch_block_with_kernel(sig).await {
-                        Ok(Some(block)) => blocks.push(block),
-                        Ok(None) => warn!(
-                            target: LOG_TARGET,
-                            "Could not provide requested block containing kernel with sig {} to peer because not \
-                             stored",
-                            sig_hex
-                        ),
-                        Err(e) => warn!(
-                            target: LOG_TARGET,
-                            "Could not provide requested block containing kernel with sig {} to peer because: {}",
-                            sig_hex,
-                            e.to_string()
-                        ),
-                    }
-                }
+                check_request_len(
+                    "FetchBlocksByKernelExcessSigs",
+                    excess_sigs.len(),
+                    MAX_REQUEST_BY_KERNEL_EXCESS_SIGS,
+                )?;
+                let blocks = self.blockchain_db.fetch_blocks_with_kernels(excess_sigs).await?;
                 Ok(NodeCommsResponse::HistoricalBlocks(blocks))
             },
             NodeCommsRequest::FetchBlocksByUtxos(commitments) => {
-                if commitments.len() > MAX_REQUEST_BY_UTXO_HASHES {
-                    return Err(CommsInterfaceError::InvalidRequest {
-                        request: "FetchBlocksByUtxos",
-                        details: format!(
-                            "Exceeded maximum number of utxo hashes in request (max: {}, got:{})",
-                            MAX_REQUEST_BY_UTXO_HASHES,
-                            commitments.len()
-                        ),
-                    });
-                }
-                let mut blocks = Vec::with_capacity(commitments.len());
-                for commitment in commitments {
-                    let commitment_hex = commitment.to_hex();
-                    debug!(
-                        target: LOG_TARGET,
-                        "A peer has requested a block with commitment {}", commitment_hex,
-                    );
-                    match self.blockchain_db.fetch_block_with_utxo(commitment).await {
-                        Ok(Some(block)) => blocks.push(block),
-                        Ok(None) => warn!(
-                            target: LOG_TARGET,
-                            "Could not provide requested block with commitment {} to peer because not stored",
-                            commitment_hex,
-                        ),
-                        Err(e) => warn!(
-                            target: LOG_TARGET,
-                            "Could not provide requested block with commitment {} to peer because: {}",
-                            commitment_hex,
-                            e.to_string()
-                        ),
-                    }
-                }
+                check_request_len("FetchBlocksByUtxos", commitments.len(), MAX_REQUEST_BY_UTXO_HASHES)?;
+                let blocks = self.blockchain_db.fetch_blocks_with_utxos(commitments).await?;
                 Ok(NodeCommsResponse::HistoricalBlocks(blocks))
             },
+            NodeCommsRequest::FetchHeadersByKernelExcessSigs(excess_sigs) => {
+                check_request_len(
+                    "FetchHeadersByKernelExcessSigs",
+                    excess_sigs.len(),
+                    MAX_REQUEST_BY_KERNEL_EXCESS_SIGS,
+                )?;
+                let headers = self.blockchain_db.fetch_chain_headers_with_kernels(excess_sigs).await?;
+                Ok(NodeCommsResponse::BlockHeaders(headers))
+            },
+            NodeCommsRequest::FetchHeadersByUtxos(commitments) => {
+                check_request_len("FetchHeadersByUtxos", commitments.len(), MAX_REQUEST_BY_UTXO_HASHES)?;
+                let headers = self.blockchain_db.fetch_chain_headers_with_utxos(commitments).await?;
+                Ok(NodeCommsResponse::BlockHeaders(headers))
+            },
             NodeCommsRequest::GetHeaderByHash(hash) => {
                 let header = self.blockchain_db.fetch_chain_header_by_block_hash(hash).await?;
                 Ok(NodeCommsResponse::BlockHeader(header))
@@ -511,13 +468,12 @@ where B: BlockchainBackend + 'static
 
         // We know that the block is neither and orphan or a coinbase, so lets ask our mempool for the transactions
         let (known_transactions, missing_excess_sigs) = self.mempool.retrieve_by_excess_sigs(excess_sigs).await?;
-        let known_transactions = known_transactions.into_iter().map(|tx| (*tx).clone()).collect();
 
         metrics::compact_block_tx_misses(header.height).set(missing_excess_sigs.len() as i64);
 
         let mut builder = BlockBuilder::new(header.version)
             .with_coinbase_utxo(coinbase_output, coinbase_kernel)
-            .with_transactions(known_transactions);
+            .with_shared_transactions(known_transactions);
 
         if missing_excess_sigs.is_empty() {
             debug!(
@@ -542,10 +498,11 @@ where B: BlockchainBackend + 'static
                 .request_transactions_by_excess_sig(source_peer.clone(), missing_excess_sigs)
                 .await?;
 
-            // Add returned transactions to unconfirmed pool
+            // Add returned transactions to the unconfirmed pool and share them with the block
             if !transactions.is_empty() {
                 self.mempool.insert_all(transactions.clone()).await?;
             }
+            builder = builder.with_shared_transactions(transactions);
 
             if !not_found.is_empty() {
                 warn!(
@@ -562,13 +519,6 @@ where B: BlockchainBackend + 'static
                 let block = self.request_full_block_from_peer(source_peer, block_hash).await?;
                 return Ok(block);
             }
-
-            builder = builder.with_transactions(
-                transactions
-                    .into_iter()
-                    .map(|tx| Arc::try_unwrap(tx).unwrap_or_else(|tx| (*tx).clone()))
-                    .collect(),
-            );
         }
 
         // NB: Add the header last because `with_transactions` etc updates the current header, but we have the final one
@@ -883,3 +833,16 @@ impl<B> Clone for InboundNodeCommsHandlers<B> {
         }
     }
 }
+
+fn check_request_len(request: &'static str, len: usize, max: usize) -> Result<(), CommsInterfaceError> {
+    if len > max {
+        return Err(CommsInterfaceError::InvalidRequest {
+            request,
+            details: format!(
+                "Exceeded maximum number of items in request (max: {}, got:{})",
+                max, len
+            ),
+        });
+    }
+    Ok(())
+}
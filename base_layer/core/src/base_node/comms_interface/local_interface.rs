@@ -239,6 +239,36 @@ impl LocalNodeCommsInterface {
         }
     }
 
+    /// Fetches the headers of the blocks with the specified utxo commitments
+    pub async fn fetch_headers_with_utxos(
+        &mut self,
+        commitments: Vec<Commitment>,
+    ) -> Result<Vec<ChainHeader>, CommsInterfaceError> {
+        match self
+            .request_sender
+            .call(NodeCommsRequest::FetchHeadersByUtxos(commitments))
+            .await??
+        {
+            NodeCommsResponse::BlockHeaders(headers) => Ok(headers),
+            _ => Err(CommsInterfaceError::UnexpectedApiResponse),
+        }
+    }
+
+    /// Fetches the headers of the blocks with the specified kernel signatures
+    pub async fn get_headers_with_kernels(
+        &mut self,
+        kernels: Vec<Signature>,
+    ) -> Result<Vec<ChainHeader>, CommsInterfaceError> {
+        match self
+            .request_sender
+            .call(NodeCommsRequest::FetchHeadersByKernelExcessSigs(kernels))
+            .await??
+        {
+            NodeCommsResponse::BlockHeaders(headers) => Ok(headers),
+            _ => Err(CommsInterfaceError::UnexpectedApiResponse),
+        }
+    }
+
     /// Return header matching the given hash. If the header cannot be found `Ok(None)` is returned.
     pub async fn get_header_by_hash(&mut self, hash: HashOutput) -> Result<Option<ChainHeader>, CommsInterfaceError> {
         match self
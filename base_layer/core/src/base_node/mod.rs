@@ -42,6 +42,11 @@ pub use comms_interface::LocalNodeCommsInterface;
 #[cfg(feature = "base_node")]
 mod metrics;
 
+#[cfg(feature = "base_node")]
+mod pruning_worker;
+#[cfg(feature = "base_node")]
+pub use pruning_worker::PruningWorkerInitializer;
+
 #[cfg(feature = "base_node")]
 pub mod service;
 
@@ -0,0 +1,96 @@
+//  Copyright 2022, The Tari Project
+//
+//  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+//  following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+//  disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+//  following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+//  products derived from this software without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+//  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+//  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+//  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+use log::*;
+use tari_service_framework::{async_trait, ServiceInitializationError, ServiceInitializer, ServiceInitializerContext};
+use tokio::sync::broadcast;
+
+use crate::{
+    base_node::comms_interface::{BlockEvent, LocalNodeCommsInterface},
+    chain_storage::{async_db::AsyncBlockchainDb, BlockchainBackend},
+};
+
+const LOG_TARGET: &str = "c::bn::pruning_worker";
+
+/// Works off the pruning backlog of a pruned node in the background. Adding a block only prunes a single bounded
+/// chunk, so a node that has fallen behind (e.g. after a sync or a change of pruning horizon) relies on this worker
+/// to catch up. It runs once at startup, resuming from the persisted pruned height, and again after every block event.
+pub struct PruningWorkerInitializer<B> {
+    db: AsyncBlockchainDb<B>,
+}
+
+impl<B> PruningWorkerInitializer<B> {
+    pub fn new(db: AsyncBlockchainDb<B>) -> Self {
+        Self { db }
+    }
+}
+
+#[async_trait]
+impl<B> ServiceInitializer for PruningWorkerInitializer<B>
+where B: BlockchainBackend + 'static
+{
+    async fn initialize(&mut self, context: ServiceInitializerContext) -> Result<(), ServiceInitializationError> {
+        let db = self.db.clone();
+
+        context.spawn_when_ready(move |handles| async move {
+            let base_node = handles.expect_handle::<LocalNodeCommsInterface>();
+            let mut block_event_stream = base_node.get_block_event_stream();
+            let mut shutdown = handles.get_shutdown_signal();
+
+            prune(&db).await;
+            loop {
+                tokio::select! {
+                    event = block_event_stream.recv() => match event {
+                        Ok(event) => {
+                            if is_chain_modified(&event) {
+                                prune(&db).await;
+                            }
+                        },
+                        Err(broadcast::error::RecvError::Lagged(n)) => {
+                            debug!(target: LOG_TARGET, "Pruning worker lagged {} block event(s)", n);
+                            prune(&db).await;
+                        },
+                        Err(broadcast::error::RecvError::Closed) => break,
+                    },
+                    _ = shutdown.wait() => break,
+                }
+            }
+            debug!(target: LOG_TARGET, "Pruning worker shut down");
+        });
+
+        Ok(())
+    }
+}
+
+fn is_chain_modified(event: &BlockEvent) -> bool {
+    match event {
+        BlockEvent::ValidBlockAdded(_, result) => result.was_chain_modified(),
+        BlockEvent::BlockSyncComplete(_, _) => true,
+        _ => false,
+    }
+}
+
+async fn prune<B: BlockchainBackend + 'static>(db: &AsyncBlockchainDb<B>) {
+    if let Err(err) = db.prune_if_needed().await {
+        warn!(target: LOG_TARGET, "Failed to prune the blockchain database: {}", err);
+    }
+}
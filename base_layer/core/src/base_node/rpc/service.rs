@@ -26,7 +26,7 @@ use std::convert::{TryFrom, TryInto};
 use log::*;
 use tari_common_types::types::{FixedHash, Signature};
 use tari_comms::protocol::rpc::{Request, Response, RpcStatus, RpcStatusResultExt, Streaming};
-use tari_utilities::hex::Hex;
+use tari_utilities::{epoch_time::EpochTime, hex::Hex};
 use tokio::sync::mpsc;
 
 use crate::{
@@ -280,26 +280,69 @@ impl<B: BlockchainBackend + 'static> BaseNodeWalletService for BaseNodeWalletRpc
         };
 
         let message = request.into_message();
+        let signatures = message
+            .sigs
+            .into_iter()
+            .map(Signature::try_from)
+            .collect::<Result<Vec<_>, _>>()
+            .map_err(|_| RpcStatus::bad_request("Signature was invalid"))?;
 
-        let mut responses: Vec<TxQueryBatchResponse> = Vec::new();
+        let db = self.db();
+        let metadata = db.get_chain_metadata().await.rpc_status_internal_error(LOG_TARGET)?;
+        let tip_height = metadata.height_of_longest_chain();
 
-        let metadata = self
-            .db
-            .get_chain_metadata()
+        let mined = db
+            .fetch_mined_kernels_by_excess_sigs(signatures.clone())
             .await
             .rpc_status_internal_error(LOG_TARGET)?;
 
-        for sig in message.sigs {
-            let signature = Signature::try_from(sig).map_err(|_| RpcStatus::bad_request("Signature was invalid"))?;
-            let response: TxQueryResponse = self.fetch_kernel(signature.clone()).await?;
-            responses.push(TxQueryBatchResponse {
-                signature: Some(SignatureProto::from(signature)),
-                location: response.location,
-                block_hash: response.block_hash,
-                confirmations: response.confirmations,
-                block_height: response.height_of_longest_chain - response.confirmations,
-                mined_timestamp: response.mined_timestamp,
-            });
+        // Only the signatures that were not found in the chain need to be looked up in the mempool
+        let unmined = signatures
+            .iter()
+            .zip(&mined)
+            .filter(|(_, mined)| mined.is_none())
+            .map(|(sig, _)| sig.clone())
+            .collect::<Vec<_>>();
+        let mut mempool_states = if unmined.is_empty() {
+            Vec::new()
+        } else {
+            self.mempool()
+                .get_tx_state_by_excess_sigs(unmined)
+                .await
+                .rpc_status_internal_error(LOG_TARGET)?
+        }
+        .into_iter();
+
+        let mut responses = Vec::with_capacity(signatures.len());
+        for (signature, mined) in signatures.into_iter().zip(mined) {
+            let response = match mined {
+                Some((_, block_hash, header)) => {
+                    let confirmations = tip_height.saturating_sub(header.height);
+                    TxQueryBatchResponse {
+                        signature: Some(SignatureProto::from(signature)),
+                        location: TxLocation::Mined as i32,
+                        block_hash: Some(block_hash.to_vec()),
+                        confirmations,
+                        block_height: tip_height - confirmations,
+                        mined_timestamp: Some(header.timestamp.as_u64()),
+                    }
+                },
+                None => {
+                    let location = match mempool_states.next() {
+                        Some(TxStorageResponse::UnconfirmedPool) => TxLocation::InMempool,
+                        _ => TxLocation::NotStored,
+                    };
+                    TxQueryBatchResponse {
+                        signature: Some(SignatureProto::from(signature)),
+                        location: location as i32,
+                        block_hash: None,
+                        confirmations: 0,
+                        block_height: tip_height,
+                        mined_timestamp: None,
+                    }
+                },
+            };
+            responses.push(response);
         }
         Ok(Response::new(TxQueryBatchResponses {
             responses,
@@ -556,57 +599,12 @@ impl<B: BlockchainBackend + 'static> BaseNodeWalletService for BaseNodeWalletRpc
 
     async fn get_height_at_time(&self, request: Request<u64>) -> Result<Response<u64>, RpcStatus> {
         let requested_epoch_time: u64 = request.into_message();
-
-        let tip_header = self
+        let height = self
             .db()
-            .fetch_tip_header()
+            .fetch_height_at_time(EpochTime::from(requested_epoch_time))
             .await
             .rpc_status_internal_error(LOG_TARGET)?;
-
-        let mut left_height = 0u64;
-        let mut right_height = tip_header.height();
-
-        while left_height <= right_height {
-            let mut mid_height = (left_height + right_height) / 2;
-
-            if mid_height == 0 {
-                return Ok(Response::new(0u64));
-            }
-            // If the two bounds are adjacent then perform the test between the right and left sides
-            if left_height == mid_height {
-                mid_height = right_height;
-            }
-
-            let mid_header = self
-                .db()
-                .fetch_header(mid_height)
-                .await
-                .rpc_status_internal_error(LOG_TARGET)?
-                .ok_or_else(|| {
-                    RpcStatus::not_found(&format!("Header not found during search at height {}", mid_height))
-                })?;
-            let before_mid_header = self
-                .db()
-                .fetch_header(mid_height - 1)
-                .await
-                .rpc_status_internal_error(LOG_TARGET)?
-                .ok_or_else(|| {
-                    RpcStatus::not_found(&format!("Header not found during search at height {}", mid_height - 1))
-                })?;
-            if requested_epoch_time < mid_header.timestamp.as_u64() &&
-                requested_epoch_time >= before_mid_header.timestamp.as_u64()
-            {
-                return Ok(Response::new(before_mid_header.height));
-            } else if mid_height == right_height {
-                return Ok(Response::new(right_height));
-            } else if requested_epoch_time <= mid_header.timestamp.as_u64() {
-                right_height = mid_height;
-            } else {
-                left_height = mid_height;
-            }
-        }
-
-        Ok(Response::new(0u64))
+        Ok(Response::new(height))
     }
 
     async fn sync_utxos_by_block(
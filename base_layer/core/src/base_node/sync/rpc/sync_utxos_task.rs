@@ -208,7 +208,7 @@ where B: BlockchainBackend + 'static
 
             let (utxos, deleted_diff) = self
                 .db
-                .fetch_utxos_in_block(current_header.hash(), Some(bitmap.clone()))
+                .fetch_utxos_in_block(current_header_hash, Some(bitmap.clone()))
                 .await
                 .rpc_status_internal_error(LOG_TARGET)?;
             debug!(
@@ -26,6 +26,7 @@
 use std::{
     fmt,
     fmt::{Display, Formatter},
+    sync::Arc,
 };
 
 use borsh::{BorshDeserialize, BorshSerialize};
@@ -251,6 +252,43 @@ impl BlockBuilder {
         self
     }
 
+    /// This functions adds the provided shared transactions to the block, modifying the header MMR counts and offsets.
+    /// The components of a transaction are moved into the block if this is the last reference to it, otherwise (e.g.
+    /// the mempool still holds the transaction) they are cloned.
+    pub fn with_shared_transactions(mut self, txs: Vec<Arc<Transaction>>) -> Self {
+        let (num_inputs, num_outputs, num_kernels) = txs.iter().fold((0, 0, 0), |(i, o, k), tx| {
+            (
+                i + tx.body.inputs().len(),
+                o + tx.body.outputs().len(),
+                k + tx.body.kernels().len(),
+            )
+        });
+        self.inputs.reserve(num_inputs);
+        self.outputs.reserve(num_outputs);
+        self.kernels.reserve(num_kernels);
+        for tx in txs {
+            self = match Arc::try_unwrap(tx) {
+                Ok(tx) => self.add_transaction(tx),
+                Err(tx) => self.add_transaction_components(&tx),
+            };
+        }
+        self
+    }
+
+    fn add_transaction_components(mut self, tx: &Transaction) -> Self {
+        self.inputs.extend_from_slice(tx.body.inputs());
+        self.header.output_mmr_size += tx.body.outputs().len() as u64;
+        self.outputs.extend_from_slice(tx.body.outputs());
+        self.header.kernel_mmr_size += tx.body.kernels().len() as u64;
+        for kernel in tx.body.kernels() {
+            self.total_fee += kernel.fee;
+        }
+        self.kernels.extend_from_slice(tx.body.kernels());
+        self.header.total_kernel_offset = self.header.total_kernel_offset + tx.offset.clone();
+        self.header.total_script_offset = self.header.total_script_offset + tx.script_offset.clone();
+        self
+    }
+
     /// This will add the given coinbase UTXO to the block
     pub fn with_coinbase_utxo(mut self, coinbase_utxo: TransactionOutput, coinbase_kernel: TransactionKernel) -> Self {
         self.kernels.push(coinbase_kernel);
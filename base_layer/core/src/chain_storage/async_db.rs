@@ -170,6 +170,8 @@ impl<B: BlockchainBackend + 'static> AsyncBlockchainDb<B> {
     //---------------------------------- Kernel --------------------------------------------//
     make_async_fn!(fetch_kernel_by_excess_sig(excess_sig: Signature) -> Option<(TransactionKernel, HashOutput)>, "fetch_kernel_by_excess_sig");
 
+    make_async_fn!(fetch_mined_kernels_by_excess_sigs(excess_sigs: Vec<Signature>) -> Vec<Option<(TransactionKernel, HashOutput, BlockHeader)>>, "fetch_mined_kernels_by_excess_sigs");
+
     make_async_fn!(fetch_kernels_in_block(hash: HashOutput) -> Vec<TransactionKernel>, "fetch_kernels_in_block");
 
     //---------------------------------- MMR --------------------------------------------//
@@ -237,6 +239,14 @@ impl<B: BlockchainBackend + 'static> AsyncBlockchainDb<B> {
 
     make_async_fn!(fetch_block_with_utxo(commitment: Commitment) -> Option<HistoricalBlock>, "fetch_block_with_utxo");
 
+    make_async_fn!(fetch_chain_headers_with_kernels(excess_sigs: Vec<Signature>) -> Vec<ChainHeader>, "fetch_chain_headers_with_kernels");
+
+    make_async_fn!(fetch_blocks_with_kernels(excess_sigs: Vec<Signature>) -> Vec<HistoricalBlock>, "fetch_blocks_with_kernels");
+
+    make_async_fn!(fetch_chain_headers_with_utxos(commitments: Vec<Commitment>) -> Vec<ChainHeader>, "fetch_chain_headers_with_utxos");
+
+    make_async_fn!(fetch_blocks_with_utxos(commitments: Vec<Commitment>) -> Vec<HistoricalBlock>, "fetch_blocks_with_utxos");
+
     make_async_fn!(fetch_block_accumulated_data(hash: HashOutput) -> BlockAccumulatedData, "fetch_block_accumulated_data");
 
     make_async_fn!(fetch_block_accumulated_data_by_height(height: u64) -> BlockAccumulatedData, "fetch_block_accumulated_data_by_height");
@@ -245,12 +255,18 @@ impl<B: BlockchainBackend + 'static> AsyncBlockchainDb<B> {
 
     make_async_fn!(prune_to_height(height: u64) -> (), "prune_to_height");
 
+    make_async_fn!(prune_if_needed() -> (), "prune_if_needed");
+
     make_async_fn!(rewind_to_height(height: u64) -> Vec<Arc<ChainBlock>>, "rewind_to_height");
 
     make_async_fn!(rewind_to_hash(hash: BlockHash) -> Vec<Arc<ChainBlock>>, "rewind_to_hash");
 
     make_async_fn!(fetch_block_timestamps(start_hash: HashOutput) -> RollingVec<EpochTime>, "fetch_block_timestamps");
 
+    make_async_fn!(fetch_header_timestamps(start_height: u64, end_height: u64) -> Vec<EpochTime>, "fetch_header_timestamps");
+
+    make_async_fn!(fetch_height_at_time(epoch_time: EpochTime) -> u64, "fetch_height_at_time");
+
     make_async_fn!(fetch_target_difficulty_for_next_block(pow_algo: PowAlgorithm, current_block_hash: HashOutput) -> TargetDifficultyWindow, "fetch_target_difficulty");
 
     make_async_fn!(fetch_target_difficulties_for_next_block(current_block_hash: HashOutput) -> TargetDifficulties, "fetch_target_difficulties_for_next_block");
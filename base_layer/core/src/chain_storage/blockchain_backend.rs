@@ -6,6 +6,7 @@ use tari_common_types::{
     chain_metadata::ChainMetadata,
     types::{Commitment, HashOutput, PublicKey, Signature},
 };
+use tari_utilities::epoch_time::EpochTime;
 
 use super::TemplateRegistrationEntry;
 use crate::{
@@ -20,6 +21,7 @@ use crate::{
     },
     chain_storage::{
         pruned_output::PrunedOutput,
+        BlockContents,
         ChainStorageError,
         DbBasicStats,
         DbKey,
@@ -72,6 +74,13 @@ pub trait BlockchainBackend: Send + Sync {
 
     fn fetch_header_containing_utxo_mmr(&self, mmr_position: u64) -> Result<ChainHeader, ChainStorageError>;
 
+    /// Fetches the timestamps of the headers from `start_height` up to and including `end_height` without reading the
+    /// headers themselves. Fewer timestamps are returned if the chain ends before `end_height`.
+    fn fetch_header_timestamps(&self, start_height: u64, end_height: u64) -> Result<Vec<EpochTime>, ChainStorageError>;
+
+    /// Returns the height of the last header with a timestamp at or before `epoch_time`, or 0 if there is none
+    fn fetch_height_at_time(&self, epoch_time: EpochTime) -> Result<u64, ChainStorageError>;
+
     /// Used to determine if the database is empty, i.e. a brand new database.
     /// This is called to decide if the genesis block should be created.
     fn is_empty(&self) -> Result<bool, ChainStorageError>;
@@ -87,6 +96,20 @@ pub trait BlockchainBackend: Send + Sync {
         height: u64,
     ) -> Result<Option<BlockAccumulatedData>, ChainStorageError>;
 
+    /// Calls `visitor` with the contents of each main chain block from `start_height` up to and including `end_height`,
+    /// in height order, reading all of them from a single consistent view of the database. The walk stops at the first
+    /// missing block or when `visitor` returns false. If `with_spent_outputs` is set, inputs are populated with the
+    /// data of the outputs they spend.
+    fn for_each_block<F>(
+        &self,
+        start_height: u64,
+        end_height: u64,
+        with_spent_outputs: bool,
+        visitor: F,
+    ) -> Result<(), ChainStorageError>
+    where
+        F: FnMut(BlockContents) -> Result<bool, ChainStorageError>;
+
     /// Fetch all the kernels in a block
     fn fetch_kernels_in_block(&self, header_hash: &HashOutput) -> Result<Vec<TransactionKernel>, ChainStorageError>;
 
@@ -103,6 +126,13 @@ pub trait BlockchainBackend: Send + Sync {
         excess_sig: &Signature,
     ) -> Result<Option<(TransactionKernel, HashOutput)>, ChainStorageError>;
 
+    /// Fetch the kernels with these excess signatures from a single consistent view of the database. The results are
+    /// returned in the same order as `excess_sigs`.
+    fn fetch_kernels_by_excess_sigs(
+        &self,
+        excess_sigs: &[Signature],
+    ) -> Result<Vec<Option<(TransactionKernel, HashOutput)>>, ChainStorageError>;
+
     /// Fetch all UTXOs and spends in the block
     fn fetch_utxos_in_block(
         &self,
@@ -120,6 +150,13 @@ pub trait BlockchainBackend: Send + Sync {
         commitment: &Commitment,
     ) -> Result<Option<HashOutput>, ChainStorageError>;
 
+    /// Fetches the unspent outputs with these commitments from a single consistent view of the database. The results
+    /// are returned in the same order as `commitments`.
+    fn fetch_unspent_outputs_by_commitments(
+        &self,
+        commitments: &[Commitment],
+    ) -> Result<Vec<Option<UtxoMinedInfo>>, ChainStorageError>;
+
     /// Fetch all outputs in a block
     fn fetch_outputs_in_block(&self, header_hash: &HashOutput) -> Result<Vec<PrunedOutput>, ChainStorageError>;
 
@@ -23,11 +23,12 @@
 use std::{
     cmp,
     cmp::Ordering,
-    collections::VecDeque,
+    collections::{HashMap, HashSet, VecDeque},
     convert::TryFrom,
     mem,
     ops::{Bound, RangeBounds},
     sync::{atomic, atomic::AtomicBool, Arc, RwLock, RwLockReadGuard, RwLockWriteGuard},
+    thread,
     time::Instant,
 };
 
@@ -68,6 +69,7 @@ use crate::{
         pruned_output::PrunedOutput,
         utxo_mined_info::UtxoMinedInfo,
         BlockAddResult,
+        BlockContents,
         BlockchainBackend,
         DbBasicStats,
         DbTotalSizeStats,
@@ -81,7 +83,7 @@ use crate::{
     common::rolling_vec::RollingVec,
     consensus::{chain_strength_comparer::ChainStrengthComparer, ConsensusConstants, ConsensusManager},
     proof_of_work::{monero_rx::MoneroPowData, PowAlgorithm, TargetDifficultyWindow},
-    transactions::transaction_components::{TransactionInput, TransactionKernel},
+    transactions::transaction_components::TransactionKernel,
     validation::{
         helpers::calc_median_timestamp,
         DifficultyCalculator,
@@ -97,6 +99,9 @@ use crate::{
 };
 
 const LOG_TARGET: &str = "c::cs::database";
+/// The maximum number of blocks that are pruned while holding the write lock. Larger pruning backlogs are worked off
+/// one chunk at a time, releasing the lock in between.
+const PRUNING_CHUNK_SIZE: u64 = 100;
 
 /// Configuration for the BlockchainDatabase.
 #[derive(Clone, Copy, Debug, Serialize, Deserialize)]
@@ -426,6 +431,39 @@ where B: BlockchainBackend
         db.fetch_kernel_by_excess_sig(&excess_sig)
     }
 
+    /// Fetches the kernels with these excess signatures, along with the hash and header of the block each was mined in,
+    /// from a single consistent view of the database. The results are returned in the same order as `excess_sigs`.
+    pub fn fetch_mined_kernels_by_excess_sigs(
+        &self,
+        excess_sigs: Vec<Signature>,
+    ) -> Result<Vec<Option<(TransactionKernel, HashOutput, BlockHeader)>>, ChainStorageError> {
+        let db = self.db_read_access()?;
+        let kernels = db.fetch_kernels_by_excess_sigs(&excess_sigs)?;
+        // Kernels that were mined in the same block share a header
+        let mut headers = HashMap::<HashOutput, BlockHeader>::new();
+        let mut results = Vec::with_capacity(kernels.len());
+        for kernel in kernels {
+            let result = match kernel {
+                Some((kernel, block_hash)) => {
+                    let header = match headers.get(&block_hash) {
+                        Some(header) => Some(header.clone()),
+                        None => {
+                            let header = fetch_header_by_block_hash(&*db, block_hash)?;
+                            if let Some(header) = &header {
+                                headers.insert(block_hash, header.clone());
+                            }
+                            header
+                        },
+                    };
+                    header.map(|header| (kernel, block_hash, header))
+                },
+                None => None,
+            };
+            results.push(result);
+        }
+        Ok(results)
+    }
+
     pub fn fetch_kernels_in_block(&self, hash: HashOutput) -> Result<Vec<TransactionKernel>, ChainStorageError> {
         let db = self.db_read_access()?;
         db.fetch_kernels_in_block(&hash)
@@ -535,17 +573,29 @@ where B: BlockchainBackend
         let timestamp_window = constants.get_median_timestamp_count();
         let start_window = start_header.height.saturating_sub(timestamp_window as u64);
 
-        let timestamps = self
-            .fetch_headers(start_window..=start_header.height)?
-            .iter()
-            .map(|h| h.timestamp)
-            .collect::<Vec<_>>();
+        let timestamps = self.fetch_header_timestamps(start_window, start_header.height)?;
 
         let mut rolling = RollingVec::new(timestamp_window);
         rolling.extend(timestamps);
         Ok(rolling)
     }
 
+    /// Returns the timestamps of the headers from `start_height` up to and including `end_height`
+    pub fn fetch_header_timestamps(
+        &self,
+        start_height: u64,
+        end_height: u64,
+    ) -> Result<Vec<EpochTime>, ChainStorageError> {
+        let db = self.db_read_access()?;
+        db.fetch_header_timestamps(start_height, end_height)
+    }
+
+    /// Returns the height of the last header with a timestamp at or before `epoch_time`, or 0 if there is none
+    pub fn fetch_height_at_time(&self, epoch_time: EpochTime) -> Result<u64, ChainStorageError> {
+        let db = self.db_read_access()?;
+        db.fetch_height_at_time(epoch_time)
+    }
+
     /// Fetch the accumulated data stored for this header
     pub fn fetch_header_accumulated_data(
         &self,
@@ -793,10 +843,7 @@ where B: BlockchainBackend
             });
         }
 
-        let timestamps = fetch_headers(&*db, min_height, prev_block_height)?
-            .iter()
-            .map(|h| h.timestamp)
-            .collect::<Vec<_>>();
+        let timestamps = db.fetch_header_timestamps(min_height, prev_block_height)?;
         if timestamps.is_empty() {
             return Err(ChainStorageError::DataInconsistencyDetected {
                 function: "prepare_new_block",
@@ -938,7 +985,8 @@ where B: BlockchainBackend
                 "Best chain is now at height: {}",
                 db.fetch_chain_metadata()?.height_of_longest_chain()
             );
-            // If blocks were added and the node is in pruned mode, perform pruning
+            // If blocks were added and the node is in pruned mode, prune at most one chunk. Any remaining backlog is
+            // left to `prune_if_needed` so that adding a block is never held up by a long pruning run.
             prune_database_if_needed(&mut *db, self.config.pruning_horizon, self.config.pruning_interval)?;
         }
 
@@ -990,10 +1038,38 @@ where B: BlockchainBackend
         store_pruning_horizon(&mut *db, pruning_horizon)
     }
 
-    /// Prunes the blockchain up to and including the given height
+    /// Prunes the blockchain up to and including the given height. The write lock is released after every chunk of
+    /// `PRUNING_CHUNK_SIZE` blocks so that blocks can be added while a large range is pruned.
     pub fn prune_to_height(&self, height: u64) -> Result<(), ChainStorageError> {
-        let mut db = self.db_write_access()?;
-        prune_to_height(&mut *db, height)
+        loop {
+            let pruned_height = {
+                let mut db = self.db_write_access()?;
+                prune_to_height(&mut *db, height, PRUNING_CHUNK_SIZE)?
+            };
+            if pruned_height >= height {
+                return Ok(());
+            }
+            thread::yield_now();
+        }
+    }
+
+    /// Prunes a pruned node up to its pruning horizon if the pruned height has fallen behind by more than the pruning
+    /// interval. Pruning resumes from the persisted pruned height and is done in chunks, releasing the write lock in
+    /// between. This is a no-op for archival nodes.
+    pub fn prune_if_needed(&self) -> Result<(), ChainStorageError> {
+        let mut pruning_interval = self.config.pruning_interval;
+        loop {
+            let has_more = {
+                let mut db = self.db_write_access()?;
+                prune_database_if_needed(&mut *db, self.config.pruning_horizon, pruning_interval)?
+            };
+            if !has_more {
+                return Ok(());
+            }
+            // Once pruning has started, keep going until the horizon is reached
+            pruning_interval = 0;
+            thread::yield_now();
+        }
     }
 
     /// Fetch a block from the blockchain database.
@@ -1074,6 +1150,52 @@ where B: BlockchainBackend
         fetch_block_by_utxo_commitment(&*db, &commitment)
     }
 
+    /// Returns the headers of the main chain blocks that contain kernels with any of these excess signatures, in height
+    /// order and without duplicates. Signatures that are not found are ignored.
+    pub fn fetch_chain_headers_with_kernels(
+        &self,
+        excess_sigs: Vec<Signature>,
+    ) -> Result<Vec<ChainHeader>, ChainStorageError> {
+        let db = self.db_read_access()?;
+        fetch_chain_headers_with_kernels(&*db, &excess_sigs)
+    }
+
+    /// Returns the main chain blocks that contain kernels with any of these excess signatures, in height order and
+    /// without duplicates. Signatures that are not found are ignored.
+    pub fn fetch_blocks_with_kernels(
+        &self,
+        excess_sigs: Vec<Signature>,
+    ) -> Result<Vec<HistoricalBlock>, ChainStorageError> {
+        let db = self.db_read_access()?;
+        fetch_chain_headers_with_kernels(&*db, &excess_sigs)?
+            .iter()
+            .map(|header| fetch_block(&*db, header.height(), false))
+            .collect()
+    }
+
+    /// Returns the headers of the main chain blocks that contain unspent outputs with any of these commitments, in
+    /// height order and without duplicates. Commitments that are not found are ignored.
+    pub fn fetch_chain_headers_with_utxos(
+        &self,
+        commitments: Vec<Commitment>,
+    ) -> Result<Vec<ChainHeader>, ChainStorageError> {
+        let db = self.db_read_access()?;
+        fetch_chain_headers_with_utxos(&*db, &commitments)
+    }
+
+    /// Returns the main chain blocks that contain unspent outputs with any of these commitments, in height order and
+    /// without duplicates. Commitments that are not found are ignored.
+    pub fn fetch_blocks_with_utxos(
+        &self,
+        commitments: Vec<Commitment>,
+    ) -> Result<Vec<HistoricalBlock>, ChainStorageError> {
+        let db = self.db_read_access()?;
+        fetch_chain_headers_with_utxos(&*db, &commitments)?
+            .iter()
+            .map(|header| fetch_block(&*db, header.height(), false))
+            .collect()
+    }
+
     /// Returns true if this block exists in the chain, or is orphaned.
     pub fn block_exists(&self, hash: BlockHash) -> Result<bool, ChainStorageError> {
         let db = self.db_read_access()?;
@@ -1573,48 +1695,58 @@ pub fn fetch_target_difficulty_for_next_block<T: BlockchainBackend>(
 }
 
 fn fetch_block<T: BlockchainBackend>(db: &T, height: u64, compact: bool) -> Result<HistoricalBlock, ChainStorageError> {
+    check_for_valid_height(db, height)?;
+    fetch_blocks(db, height, height, compact)?
+        .pop()
+        .ok_or_else(|| ChainStorageError::ValueNotFound {
+            entity: "Block",
+            field: "height",
+            value: height.to_string(),
+        })
+}
+
+/// Fetches the main chain blocks from `start` up to and including `end_inclusive`, reading them in a single pass over
+/// the database
+fn fetch_blocks<T: BlockchainBackend>(
+    db: &T,
+    start: u64,
+    end_inclusive: u64,
+    compact: bool,
+) -> Result<Vec<HistoricalBlock>, ChainStorageError> {
+    let metadata = db.fetch_chain_metadata()?;
+    let tip_height = metadata.height_of_longest_chain();
+    let pruned_height = metadata.pruned_height();
     let mark = Instant::now();
-    let (tip_height, is_pruned) = check_for_valid_height(&*db, height)?;
-    let chain_header = db.fetch_chain_header_by_height(height)?;
-    let (header, accumulated_data) = chain_header.into_parts();
-    let kernels = db.fetch_kernels_in_block(&accumulated_data.hash)?;
-    let outputs = db.fetch_outputs_in_block(&accumulated_data.hash)?;
-    // Fetch inputs from the backend and populate their spent_output data if available
-    let inputs = db
-        .fetch_inputs_in_block(&accumulated_data.hash)?
-        .into_iter()
-        .map(|mut compact_input| {
-            if compact {
-                return Ok(compact_input);
-            }
-            let utxo_mined_info = match db.fetch_output(&compact_input.output_hash()) {
-                Ok(Some(o)) => o,
-                Ok(None) => {
-                    return Err(ChainStorageError::InvalidBlock(
-                        "An Input in a block doesn't contain a matching spending output".to_string(),
-                    ))
-                },
-                Err(e) => return Err(e),
-            };
+    let mut blocks = Vec::new();
+    db.for_each_block(start, end_inclusive, !compact, |contents| {
+        let is_pruned = contents.header.height() < pruned_height;
+        blocks.push(historical_block_from_contents(db, contents, tip_height, is_pruned)?);
+        Ok(true)
+    })?;
+    trace!(
+        target: LOG_TARGET,
+        "Fetched {} block(s) from height:{} in {:.0?}",
+        blocks.len(),
+        start,
+        mark.elapsed()
+    );
+    Ok(blocks)
+}
 
-            match utxo_mined_info.output {
-                PrunedOutput::Pruned { .. } => Ok(compact_input),
-                PrunedOutput::NotPruned { output } => {
-                    compact_input.add_output_data(
-                        output.version,
-                        output.features,
-                        output.commitment,
-                        output.script,
-                        output.sender_offset_public_key,
-                        output.covenant,
-                        output.encrypted_value,
-                        output.minimum_value_promise,
-                    );
-                    Ok(compact_input)
-                },
-            }
-        })
-        .collect::<Result<Vec<TransactionInput>, _>>()?;
+fn historical_block_from_contents<T: BlockchainBackend>(
+    db: &T,
+    contents: BlockContents,
+    tip_height: u64,
+    is_pruned: bool,
+) -> Result<HistoricalBlock, ChainStorageError> {
+    let BlockContents {
+        header,
+        kernels,
+        outputs,
+        inputs,
+    } = contents;
+    let (header, accumulated_data) = header.into_parts();
+    let height = header.height;
 
     let mut unpruned = vec![];
     let mut pruned = vec![];
@@ -1656,12 +1788,6 @@ fn fetch_block<T: BlockchainBackend>(db: &T, height: u64, compact: bool) -> Resu
         .add_outputs(unpruned)
         .add_kernels(kernels)
         .build();
-    trace!(
-        target: LOG_TARGET,
-        "Fetched block at height:{} in {:.0?}",
-        height,
-        mark.elapsed()
-    );
     Ok(HistoricalBlock::new(
         block,
         tip_height - height + 1,
@@ -1671,15 +1797,6 @@ fn fetch_block<T: BlockchainBackend>(db: &T, height: u64, compact: bool) -> Resu
     ))
 }
 
-fn fetch_blocks<T: BlockchainBackend>(
-    db: &T,
-    start: u64,
-    end_inclusive: u64,
-    compact: bool,
-) -> Result<Vec<HistoricalBlock>, ChainStorageError> {
-    (start..=end_inclusive).map(|i| fetch_block(db, i, compact)).collect()
-}
-
 fn fetch_block_by_kernel_signature<T: BlockchainBackend>(
     db: &T,
     excess_sig: Signature,
@@ -1711,6 +1828,65 @@ fn fetch_block_by_utxo_commitment<T: BlockchainBackend>(
     }
 }
 
+fn fetch_chain_headers_with_kernels<T: BlockchainBackend>(
+    db: &T,
+    excess_sigs: &[Signature],
+) -> Result<Vec<ChainHeader>, ChainStorageError> {
+    let hashes = db
+        .fetch_kernels_by_excess_sigs(excess_sigs)?
+        .into_iter()
+        .flatten()
+        .map(|(_, hash)| hash);
+    fetch_chain_headers_by_block_hashes(db, hashes)
+}
+
+fn fetch_chain_headers_with_utxos<T: BlockchainBackend>(
+    db: &T,
+    commitments: &[Commitment],
+) -> Result<Vec<ChainHeader>, ChainStorageError> {
+    let hashes = db
+        .fetch_unspent_outputs_by_commitments(commitments)?
+        .into_iter()
+        .flatten()
+        .map(|info| info.header_hash);
+    fetch_chain_headers_by_block_hashes(db, hashes)
+}
+
+/// Fetches the distinct headers with the given block hashes, sorted by height
+fn fetch_chain_headers_by_block_hashes<T, I>(db: &T, hashes: I) -> Result<Vec<ChainHeader>, ChainStorageError>
+where
+    T: BlockchainBackend,
+    I: IntoIterator<Item = HashOutput>,
+{
+    let hashes = hashes.into_iter().collect::<HashSet<_>>();
+    let mut headers = Vec::with_capacity(hashes.len());
+    for hash in hashes {
+        let header = match fetch_header_by_block_hash(db, hash)? {
+            Some(header) => header,
+            None => continue,
+        };
+        let accumulated_data =
+            db.fetch_header_accumulated_data(&hash)?
+                .ok_or_else(|| ChainStorageError::ValueNotFound {
+                    entity: "BlockHeaderAccumulatedData",
+                    field: "hash",
+                    value: hash.to_hex(),
+                })?;
+        let header = ChainHeader::try_construct(header, accumulated_data).ok_or_else(|| {
+            ChainStorageError::DataInconsistencyDetected {
+                function: "fetch_chain_headers_by_block_hashes",
+                details: format!(
+                    "Mismatch between header and accumulated data for header {}",
+                    hash.to_hex()
+                ),
+            }
+        })?;
+        headers.push(header);
+    }
+    headers.sort_by_key(|header| header.height());
+    Ok(headers)
+}
+
 fn fetch_block_by_hash<T: BlockchainBackend>(
     db: &T,
     hash: BlockHash,
@@ -1735,7 +1911,8 @@ fn check_for_valid_height<T: BlockchainBackend>(db: &T, height: u64) -> Result<(
     Ok((tip_height, height < pruned_height))
 }
 
-/// Removes blocks from the db from current tip to specified height.
+/// Removes blocks from the db from current tip to specified height in a single write transaction. A rewind past the
+/// pruning horizon then deletes the remaining block bodies in further transactions of `PRUNING_CHUNK_SIZE` blocks.
 /// Returns the blocks removed, ordered from tip to height.
 #[allow(clippy::too_many_lines)]
 fn rewind_to_height<T: BlockchainBackend>(db: &mut T, height: u64) -> Result<Vec<Arc<ChainBlock>>, ChainStorageError> {
@@ -1765,21 +1942,22 @@ fn rewind_to_height<T: BlockchainBackend>(db: &mut T, height: u64) -> Result<Vec
             last_header_height - steps_back
         );
     }
+    // All changes are applied in a single write transaction
+    let mut txn = DbTransaction::new();
     // We might have more headers than blocks, so we first see if we need to delete the extra headers.
     for h in 0..steps_back {
-        let mut txn = DbTransaction::new();
         info!(
             target: LOG_TARGET,
             "Rewinding headers at height {}",
             last_header_height - h
         );
         txn.delete_header(last_header_height - h);
-        db.write(txn)?;
     }
     // Delete blocks
     let mut steps_back = last_block_height.saturating_sub(height);
     // No blocks to remove, no need to update the best block
     if steps_back == 0 {
+        db.write(txn)?;
         return Ok(vec![]);
     }
 
@@ -1802,7 +1980,6 @@ fn rewind_to_height<T: BlockchainBackend>(db: &mut T, height: u64) -> Result<Vec
         steps_back = effective_pruning_horizon;
     }
     for h in 0..steps_back {
-        let mut txn = DbTransaction::new();
         info!(target: LOG_TARGET, "Deleting block {}", last_block_height - h,);
         let block = fetch_block(db, last_block_height - h, false)?;
         let block = Arc::new(block.try_into_chain_block()?);
@@ -1817,21 +1994,6 @@ fn rewind_to_height<T: BlockchainBackend>(db: &mut T, height: u64) -> Result<Vec
             txn.insert_chained_orphan(block.clone());
         }
         removed_blocks.push(block);
-        // Set best block to one before, to keep DB consistent. Or if we reached pruned horizon, set best block to 0.
-        let chain_header = db.fetch_chain_header_by_height(if prune_past_horizon && h + 1 == steps_back {
-            0
-        } else {
-            last_block_height - h - 1
-        })?;
-        let metadata = db.fetch_chain_metadata()?;
-        let expected_block_hash = *metadata.best_block();
-        txn.set_best_block(
-            chain_header.height(),
-            chain_header.accumulated_data().hash,
-            chain_header.accumulated_data().total_accumulated_difficulty,
-            expected_block_hash,
-            chain_header.timestamp(),
-        );
         if h == 0 {
             // insert the new orphan chain tip
             debug!(
@@ -1841,23 +2003,39 @@ fn rewind_to_height<T: BlockchainBackend>(db: &mut T, height: u64) -> Result<Vec
             );
             txn.insert_orphan_chain_tip(block_hash);
         }
-        // Update metadata
-        debug!(
-            target: LOG_TARGET,
-            "Updating best block to height (#{}), total accumulated difficulty: {}",
-            chain_header.height(),
-            chain_header.accumulated_data().total_accumulated_difficulty
-        );
-        db.write(txn)?;
     }
 
+    // Set best block to the new tip. Or if we reached pruned horizon, set best block to 0.
+    let chain_header = db.fetch_chain_header_by_height(if prune_past_horizon {
+        0
+    } else {
+        last_block_height - steps_back
+    })?;
+    txn.set_best_block(
+        chain_header.height(),
+        chain_header.accumulated_data().hash,
+        chain_header.accumulated_data().total_accumulated_difficulty,
+        *metadata.best_block(),
+        chain_header.timestamp(),
+    );
+    // Update metadata
+    debug!(
+        target: LOG_TARGET,
+        "Updating best block to height (#{}), total accumulated difficulty: {}",
+        chain_header.height(),
+        chain_header.accumulated_data().total_accumulated_difficulty
+    );
+
+    db.write(txn)?;
+
     if prune_past_horizon {
         // We are rewinding past pruning horizon, so we need to remove all blocks and the UTXO's from them. We do not
         // have to delete the headers as they are still valid.
         // We don't have these complete blocks, so we don't push them to the channel for further processing such as the
         // mempool add reorg'ed tx.
+        // This can be the whole chain, so the bodies are deleted in bounded write transactions, as when pruning.
+        let mut txn = DbTransaction::new();
         for h in 0..(last_block_height - steps_back) {
-            let mut txn = DbTransaction::new();
             debug!(
                 target: LOG_TARGET,
                 "Deleting blocks and utxos {}",
@@ -1865,8 +2043,11 @@ fn rewind_to_height<T: BlockchainBackend>(db: &mut T, height: u64) -> Result<Vec
             );
             let header = fetch_header(db, last_block_height - h - steps_back)?;
             txn.delete_block(header.hash());
-            db.write(txn)?;
+            if (h + 1) % PRUNING_CHUNK_SIZE == 0 {
+                db.write(mem::take(&mut txn))?;
+            }
         }
+        db.write(txn)?;
     }
 
     Ok(removed_blocks)
@@ -2320,14 +2501,16 @@ fn cleanup_orphans<T: BlockchainBackend>(db: &mut T, orphan_storage_capacity: us
     db.delete_oldest_orphans(horizon_height, orphan_storage_capacity)
 }
 
+/// Prunes at most one chunk if the pruned height is more than `pruning_interval` blocks behind the pruning horizon.
+/// Returns true if the pruned height is still behind the pruning horizon.
 fn prune_database_if_needed<T: BlockchainBackend>(
     db: &mut T,
     pruning_horizon: u64,
     pruning_interval: u64,
-) -> Result<(), ChainStorageError> {
+) -> Result<bool, ChainStorageError> {
     let metadata = db.fetch_chain_metadata()?;
     if !metadata.is_pruned_node() {
-        return Ok(());
+        return Ok(false);
     }
 
     let db_height = metadata.height_of_longest_chain();
@@ -2341,13 +2524,20 @@ fn prune_database_if_needed<T: BlockchainBackend>(
         pruning_interval,
     );
     if metadata.pruned_height() < abs_pruning_horizon.saturating_sub(pruning_interval) {
-        prune_to_height(db, abs_pruning_horizon)?;
+        let pruned_height = prune_to_height(db, abs_pruning_horizon, PRUNING_CHUNK_SIZE)?;
+        return Ok(pruned_height < abs_pruning_horizon);
     }
 
-    Ok(())
+    Ok(false)
 }
 
-fn prune_to_height<T: BlockchainBackend>(db: &mut T, target_horizon_height: u64) -> Result<(), ChainStorageError> {
+/// Prunes towards `target_horizon_height`, pruning no more than `max_blocks` blocks. The pruned height is committed
+/// with each write, so an interrupted run resumes where it left off. Returns the new pruned height.
+fn prune_to_height<T: BlockchainBackend>(
+    db: &mut T,
+    target_horizon_height: u64,
+    max_blocks: u64,
+) -> Result<u64, ChainStorageError> {
     let metadata = db.fetch_chain_metadata()?;
     let last_pruned = metadata.pruned_height();
     if target_horizon_height < last_pruned {
@@ -2366,7 +2556,7 @@ fn prune_to_height<T: BlockchainBackend>(db: &mut T, target_horizon_height: u64)
             target: LOG_TARGET,
             "Blockchain already pruned to height {}", target_horizon_height
         );
-        return Ok(());
+        return Ok(last_pruned);
     }
 
     if target_horizon_height > metadata.height_of_longest_chain() {
@@ -2381,9 +2571,10 @@ fn prune_to_height<T: BlockchainBackend>(db: &mut T, target_horizon_height: u64)
         });
     }
 
+    let prune_to = cmp::min(target_horizon_height, last_pruned.saturating_add(max_blocks));
     info!(
         target: LOG_TARGET,
-        "Pruning blockchain database at height {} (was={})", target_horizon_height, last_pruned,
+        "Pruning blockchain database at height {} (was={}, target={})", prune_to, last_pruned, target_horizon_height,
     );
     let mut last_block = db.fetch_block_accumulated_data_by_height(last_pruned).or_not_found(
         "BlockAccumulatedData",
@@ -2391,7 +2582,7 @@ fn prune_to_height<T: BlockchainBackend>(db: &mut T, target_horizon_height: u64)
         last_pruned.to_string(),
     )?;
     let mut txn = DbTransaction::new();
-    for block_to_prune in (last_pruned + 1)..=target_horizon_height {
+    for block_to_prune in (last_pruned + 1)..=prune_to {
         let header = db.fetch_chain_header_by_height(block_to_prune)?;
         let curr_block = db.fetch_block_accumulated_data_by_height(block_to_prune).or_not_found(
             "BlockAccumulatedData",
@@ -2411,10 +2602,10 @@ fn prune_to_height<T: BlockchainBackend>(db: &mut T, target_horizon_height: u64)
         }
     }
 
-    txn.set_pruned_height(target_horizon_height);
+    txn.set_pruned_height(prune_to);
 
     db.write(txn)?;
-    Ok(())
+    Ok(prune_to)
 }
 
 fn log_error<T>(req: DbKey, err: ChainStorageError) -> Result<T, ChainStorageError> {
@@ -3004,6 +3195,34 @@ mod test {
         check_whole_chain(&mut *access);
     }
 
+    mod fetch_mined_kernels_by_excess_sigs {
+        use super::*;
+
+        #[test]
+        fn it_returns_kernels_in_request_order() {
+            let db = create_new_blockchain();
+            let (_, chain) = create_main_chain(&db, &[("A->GB", 1, 120), ("B->A", 1, 120), ("C->B", 1, 120)]);
+            let block_a = chain.get("A").unwrap();
+            let block_c = chain.get("C").unwrap();
+            let sig_a = block_a.block().body.kernels()[0].excess_sig.clone();
+            let sig_c = block_c.block().body.kernels()[0].excess_sig.clone();
+
+            let results = db
+                .fetch_mined_kernels_by_excess_sigs(vec![sig_c.clone(), Signature::default(), sig_a.clone()])
+                .unwrap();
+            assert_eq!(results.len(), 3);
+            let (kernel, hash, header) = results[0].as_ref().unwrap();
+            assert_eq!(kernel.excess_sig, sig_c);
+            assert_eq!(hash, block_c.hash());
+            assert_eq!(header.height, 3);
+            assert!(results[1].is_none());
+            let (kernel, hash, header) = results[2].as_ref().unwrap();
+            assert_eq!(kernel.excess_sig, sig_a);
+            assert_eq!(hash, block_a.hash());
+            assert_eq!(header.height, 1);
+        }
+    }
+
     #[test]
     fn test_handle_possible_reorg_target_difficulty_is_correct_case_1() {
         let (result, _blocks) = test_case_handle_possible_reorg(&[
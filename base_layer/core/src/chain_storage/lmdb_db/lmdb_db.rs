@@ -34,6 +34,7 @@ use tari_common_types::{
 };
 use tari_storage::lmdb_store::{db, LMDBBuilder, LMDBConfig, LMDBStore};
 use tari_utilities::{
+    epoch_time::EpochTime,
     hex::{to_hex, Hex},
     ByteArray,
 };
@@ -75,6 +76,7 @@ use crate::{
                 lmdb_replace,
             },
             validator_node_store::ValidatorNodeStore,
+            BlockUndoData,
             TransactionInputRowData,
             TransactionInputRowDataRef,
             TransactionKernelRowData,
@@ -82,6 +84,7 @@ use crate::{
         },
         stats::DbTotalSizeStats,
         utxo_mined_info::UtxoMinedInfo,
+        BlockContents,
         BlockchainBackend,
         DbBasicStats,
         DbSize,
@@ -115,8 +118,10 @@ pub const LOG_TARGET: &str = "c::cs::lmdb_db::lmdb_db";
 const LMDB_DB_METADATA: &str = "metadata";
 const LMDB_DB_HEADERS: &str = "headers";
 const LMDB_DB_HEADER_ACCUMULATED_DATA: &str = "header_accumulated_data";
+const LMDB_DB_HEADER_TIMESTAMPS: &str = "header_timestamps";
 const LMDB_DB_BLOCK_ACCUMULATED_DATA: &str = "mmr_peak_data";
 const LMDB_DB_BLOCK_HASHES: &str = "block_hashes";
+const LMDB_DB_BLOCK_UNDO: &str = "block_undo";
 const LMDB_DB_UTXOS: &str = "utxos";
 const LMDB_DB_INPUTS: &str = "inputs";
 const LMDB_DB_TXOS_HASH_TO_INDEX: &str = "txos_hash_to_index";
@@ -130,6 +135,8 @@ const LMDB_DB_UTXO_COMMITMENT_INDEX: &str = "utxo_commitment_index";
 const LMDB_DB_UNIQUE_ID_INDEX: &str = "unique_id_index";
 const LMDB_DB_CONTRACT_ID_INDEX: &str = "contract_index";
 const LMDB_DB_ORPHANS: &str = "orphans";
+const LMDB_DB_ORPHAN_HEADERS: &str = "orphan_headers";
+const LMDB_DB_ORPHAN_HEIGHT_INDEX: &str = "orphan_height_index";
 const LMDB_DB_MONERO_SEED_HEIGHT: &str = "monero_seed_height";
 const LMDB_DB_ORPHAN_HEADER_ACCUMULATED_DATA: &str = "orphan_accumulated_data";
 const LMDB_DB_ORPHAN_CHAIN_TIPS: &str = "orphan_chain_tips";
@@ -148,6 +155,8 @@ type KernelKey = CompositeKey<68>;
 type OutputKey = CompositeKey<68>;
 /// Height(8), Hash(32)
 type ValidatorNodeRegistrationKey = CompositeKey<40>;
+/// Height(8, big endian), Hash(32)
+type OrphanHeightKey = CompositeKey<40>;
 
 pub fn create_lmdb_database<P: AsRef<Path>>(
     path: P,
@@ -169,8 +178,10 @@ pub fn create_lmdb_database<P: AsRef<Path>>(
         .add_database(LMDB_DB_METADATA, flags | db::INTEGERKEY)
         .add_database(LMDB_DB_HEADERS, flags | db::INTEGERKEY)
         .add_database(LMDB_DB_HEADER_ACCUMULATED_DATA, flags | db::INTEGERKEY)
+        .add_database(LMDB_DB_HEADER_TIMESTAMPS, flags | db::INTEGERKEY)
         .add_database(LMDB_DB_BLOCK_ACCUMULATED_DATA, flags | db::INTEGERKEY)
         .add_database(LMDB_DB_BLOCK_HASHES, flags)
+        .add_database(LMDB_DB_BLOCK_UNDO, flags)
         .add_database(LMDB_DB_UTXOS, flags)
         .add_database(LMDB_DB_INPUTS, flags)
         .add_database(LMDB_DB_TXOS_HASH_TO_INDEX, flags)
@@ -184,6 +195,8 @@ pub fn create_lmdb_database<P: AsRef<Path>>(
         .add_database(LMDB_DB_CONTRACT_ID_INDEX, flags)
         .add_database(LMDB_DB_DELETED_TXO_MMR_POSITION_TO_HEIGHT_INDEX, flags | db::INTEGERKEY)
         .add_database(LMDB_DB_ORPHANS, flags)
+        .add_database(LMDB_DB_ORPHAN_HEADERS, flags)
+        .add_database(LMDB_DB_ORPHAN_HEIGHT_INDEX, flags)
         .add_database(LMDB_DB_ORPHAN_HEADER_ACCUMULATED_DATA, flags)
         .add_database(LMDB_DB_MONERO_SEED_HEIGHT, flags)
         .add_database(LMDB_DB_ORPHAN_CHAIN_TIPS, flags)
@@ -208,10 +221,14 @@ pub struct LMDBDatabase {
     headers_db: DatabaseRef,
     /// Maps height -> BlockHeaderAccumulatedData
     header_accumulated_data_db: DatabaseRef,
+    /// Maps height -> header timestamp
+    header_timestamps_db: DatabaseRef,
     /// Maps height -> BlockAccumulatedData
     block_accumulated_data_db: DatabaseRef,
     /// Maps block_hash -> height
     block_hashes_db: DatabaseRef,
+    /// Maps block_hash -> BlockUndoData
+    block_undo_db: DatabaseRef,
     /// Maps OutputKey -> TransactionOutputRowData
     utxos_db: DatabaseRef,
     /// Maps InputKey -> TransactionInputRowData
@@ -239,6 +256,10 @@ pub struct LMDBDatabase {
     deleted_txo_mmr_position_to_height_index: DatabaseRef,
     /// Maps block_hash -> Block
     orphans_db: DatabaseRef,
+    /// Maps block_hash -> BlockHeader for every block in orphans_db
+    orphan_headers_db: DatabaseRef,
+    /// Maps OrphanHeightKey -> (height, block_hash), ordered by height
+    orphan_height_index: DatabaseRef,
     /// Maps randomx_seed -> height
     monero_seed_height_db: DatabaseRef,
     /// Maps block_hash -> BlockHeaderAccumulatedData
@@ -273,8 +294,10 @@ impl LMDBDatabase {
             metadata_db: get_database(store, LMDB_DB_METADATA)?,
             headers_db: get_database(store, LMDB_DB_HEADERS)?,
             header_accumulated_data_db: get_database(store, LMDB_DB_HEADER_ACCUMULATED_DATA)?,
+            header_timestamps_db: get_database(store, LMDB_DB_HEADER_TIMESTAMPS)?,
             block_accumulated_data_db: get_database(store, LMDB_DB_BLOCK_ACCUMULATED_DATA)?,
             block_hashes_db: get_database(store, LMDB_DB_BLOCK_HASHES)?,
+            block_undo_db: get_database(store, LMDB_DB_BLOCK_UNDO)?,
             utxos_db: get_database(store, LMDB_DB_UTXOS)?,
             inputs_db: get_database(store, LMDB_DB_INPUTS)?,
             txos_hash_to_index_db: get_database(store, LMDB_DB_TXOS_HASH_TO_INDEX)?,
@@ -291,6 +314,8 @@ impl LMDBDatabase {
                 LMDB_DB_DELETED_TXO_MMR_POSITION_TO_HEIGHT_INDEX,
             )?,
             orphans_db: get_database(store, LMDB_DB_ORPHANS)?,
+            orphan_headers_db: get_database(store, LMDB_DB_ORPHAN_HEADERS)?,
+            orphan_height_index: get_database(store, LMDB_DB_ORPHAN_HEIGHT_INDEX)?,
             orphan_header_accumulated_data_db: get_database(store, LMDB_DB_ORPHAN_HEADER_ACCUMULATED_DATA)?,
             monero_seed_height_db: get_database(store, LMDB_DB_MONERO_SEED_HEIGHT)?,
             orphan_chain_tips_db: get_database(store, LMDB_DB_ORPHAN_CHAIN_TIPS)?,
@@ -323,6 +348,19 @@ impl LMDBDatabase {
         WriteTransaction::new(&*self.env).map_err(Into::into)
     }
 
+    /// Deletes the undo record of a block, so that a block stored before undo records were written can be tested.
+    /// Returns true if the block had a record.
+    #[cfg(test)]
+    pub(crate) fn delete_block_undo_data(&self, block_hash: &HashOutput) -> Result<bool, ChainStorageError> {
+        let txn = self.write_transaction()?;
+        let existed = lmdb_exists(&txn, &self.block_undo_db, block_hash.as_slice())?;
+        if existed {
+            lmdb_delete(&txn, &self.block_undo_db, block_hash.as_slice(), "block_undo_db")?;
+        }
+        txn.commit()?;
+        Ok(existed)
+    }
+
     #[allow(clippy::too_many_lines)]
     fn apply_db_transaction(&mut self, txn: &DbTransaction) -> Result<(), ChainStorageError> {
         #[allow(clippy::enum_glob_use)]
@@ -336,14 +374,14 @@ impl LMDBDatabase {
                     self.insert_header(&write_txn, header.header(), header.accumulated_data())?;
                 },
                 InsertBlockBody { block } => {
-                    self.insert_block_body(&write_txn, block.header(), block.block().body.clone())?;
+                    self.insert_block_body(&write_txn, block.hash(), block.header(), block.block().body.clone())?;
                 },
                 InsertKernel {
                     header_hash,
                     kernel,
                     mmr_position,
                 } => {
-                    self.insert_kernel(&write_txn, header_hash, &**kernel, *mmr_position)?;
+                    self.insert_kernel(&write_txn, header_hash, &**kernel, &kernel.hash(), *mmr_position)?;
                 },
                 InsertOutput {
                     header_hash,
@@ -357,6 +395,8 @@ impl LMDBDatabase {
                         header_hash,
                         *header_height,
                         &*output,
+                        &output.hash(),
+                        &output.witness_hash(),
                         *mmr_position,
                         *timestamp,
                     )?;
@@ -511,13 +551,15 @@ impl LMDBDatabase {
         Ok(())
     }
 
-    fn all_dbs(&self) -> [(&'static str, &DatabaseRef); 27] {
+    fn all_dbs(&self) -> [(&'static str, &DatabaseRef); 31] {
         [
             ("metadata_db", &self.metadata_db),
             ("headers_db", &self.headers_db),
             ("header_accumulated_data_db", &self.header_accumulated_data_db),
+            ("header_timestamps_db", &self.header_timestamps_db),
             ("block_accumulated_data_db", &self.block_accumulated_data_db),
             ("block_hashes_db", &self.block_hashes_db),
+            ("block_undo_db", &self.block_undo_db),
             ("utxos_db", &self.utxos_db),
             ("inputs_db", &self.inputs_db),
             ("txos_hash_to_index_db", &self.txos_hash_to_index_db),
@@ -534,6 +576,8 @@ impl LMDBDatabase {
                 &self.deleted_txo_mmr_position_to_height_index,
             ),
             ("orphans_db", &self.orphans_db),
+            ("orphan_headers_db", &self.orphan_headers_db),
+            ("orphan_height_index", &self.orphan_height_index),
             (
                 "orphan_header_accumulated_data_db",
                 &self.orphan_header_accumulated_data_db,
@@ -574,19 +618,18 @@ impl LMDBDatabase {
         header_hash: &HashOutput,
         header_height: u64,
         output: &TransactionOutput,
+        output_hash: &HashOutput,
+        witness_hash: &HashOutput,
         mmr_position: u32,
         timestamp: u64,
     ) -> Result<(), ChainStorageError> {
-        let output_hash = output.hash();
-        let witness_hash = output.witness_hash();
-
         let output_key = OutputKey::try_from_parts(&[header_hash.as_slice(), mmr_position.to_le_bytes().as_slice()])?;
 
         lmdb_insert(
             txn,
             &*self.utxo_commitment_index,
             output.commitment.as_bytes(),
-            &output_hash,
+            output_hash,
             "utxo_commitment_index",
         )?;
 
@@ -605,8 +648,8 @@ impl LMDBDatabase {
                 output: Some(output.clone()),
                 header_hash: *header_hash,
                 mmr_position,
-                hash: output_hash,
-                witness_hash,
+                hash: *output_hash,
+                witness_hash: *witness_hash,
                 mined_height: header_height,
                 mined_timestamp: timestamp,
             },
@@ -662,9 +705,9 @@ impl LMDBDatabase {
         txn: &WriteTransaction<'_>,
         header_hash: &HashOutput,
         kernel: &TransactionKernel,
+        hash: &HashOutput,
         mmr_position: u32,
     ) -> Result<(), ChainStorageError> {
-        let hash = kernel.hash();
         let key = KernelKey::try_from_parts(&[
             header_hash.as_slice(),
             mmr_position.to_le_bytes().as_slice(),
@@ -675,18 +718,16 @@ impl LMDBDatabase {
             txn,
             &*self.kernel_excess_index,
             kernel.excess.as_bytes(),
-            &(*header_hash, mmr_position, hash),
+            &(*header_hash, mmr_position, *hash),
             "kernel_excess_index",
         )?;
 
-        let mut excess_sig_key = Vec::<u8>::with_capacity(32 * 2);
-        excess_sig_key.extend(kernel.excess_sig.get_public_nonce().as_bytes());
-        excess_sig_key.extend(kernel.excess_sig.get_signature().as_bytes());
+        let excess_sig_key = excess_sig_key(&kernel.excess_sig);
         lmdb_insert(
             txn,
             &*self.kernel_excess_sig_index,
             excess_sig_key.as_slice(),
-            &(*header_hash, mmr_position, hash),
+            &(*header_hash, mmr_position, *hash),
             "kernel_excess_sig_index",
         )?;
 
@@ -698,7 +739,7 @@ impl LMDBDatabase {
                 kernel: kernel.clone(),
                 header_hash: *header_hash,
                 mmr_position,
-                hash,
+                hash: *hash,
             },
             "kernels_db",
         )
@@ -765,6 +806,20 @@ impl LMDBDatabase {
         let k = block.hash();
         lmdb_insert_dup(txn, &self.orphan_parent_map_index, block.header.prev_hash.deref(), &k)?;
         lmdb_insert(txn, &self.orphans_db, k.as_slice(), &block, "orphans_db")?;
+        lmdb_insert(
+            txn,
+            &self.orphan_headers_db,
+            k.as_slice(),
+            &block.header,
+            "orphan_headers_db",
+        )?;
+        lmdb_insert(
+            txn,
+            &self.orphan_height_index,
+            &orphan_height_key(block.header.height, &k)?,
+            &(block.header.height, k),
+            "orphan_height_index",
+        )?;
 
         Ok(())
     }
@@ -860,6 +915,13 @@ impl LMDBDatabase {
             "block_hashes_db",
         )?;
         lmdb_insert(txn, &self.headers_db, &header.height, header, "headers_db")?;
+        lmdb_insert(
+            txn,
+            &self.header_timestamps_db,
+            &header.height,
+            &header.timestamp.as_u64(),
+            "header_timestamps_db",
+        )?;
         lmdb_insert(
             txn,
             &self.kernel_mmr_size_index,
@@ -919,6 +981,7 @@ impl LMDBDatabase {
 
         lmdb_delete(txn, &self.block_hashes_db, hash.as_slice(), "block_hashes_db")?;
         lmdb_delete(txn, &self.headers_db, &height, "headers_db")?;
+        lmdb_delete(txn, &self.header_timestamps_db, &height, "header_timestamps_db")?;
         lmdb_delete(
             txn,
             &self.header_accumulated_data_db,
@@ -981,6 +1044,10 @@ impl LMDBDatabase {
         txn: &WriteTransaction<'_>,
         block_hash: &[u8],
     ) -> Result<(), ChainStorageError> {
+        let undo_data = lmdb_get::<_, BlockUndoData>(txn, &self.block_undo_db, block_hash)?;
+        if undo_data.is_some() {
+            lmdb_delete(txn, &self.block_undo_db, block_hash, "block_undo_db")?;
+        }
         let output_rows = lmdb_delete_keys_starting_with::<TransactionOutputRowData>(txn, &self.utxos_db, block_hash)?;
         debug!(target: LOG_TARGET, "Deleted {} outputs...", output_rows.len());
         let inputs = lmdb_delete_keys_starting_with::<TransactionInputRowData>(txn, &self.inputs_db, block_hash)?;
@@ -1025,7 +1092,8 @@ impl LMDBDatabase {
                 &row.mmr_position,
                 "deleted_txo_mmr_position_to_height_index",
             )?;
-            if output_rows.iter().any(|r| r.hash == output_hash) {
+            // The spent outputs are restored from the undo record below, if the block has one
+            if undo_data.is_some() || output_rows.iter().any(|r| r.hash == output_hash) {
                 continue;
             }
 
@@ -1069,6 +1137,18 @@ impl LMDBDatabase {
                 "utxo_commitment_index",
             )?;
         }
+        if let Some(undo_data) = undo_data {
+            for (commitment, output_hash) in undo_data.spent_outputs {
+                trace!(target: LOG_TARGET, "Output moved back to UTXO set: {}", output_hash.to_hex());
+                lmdb_insert(
+                    txn,
+                    &*self.utxo_commitment_index,
+                    commitment.as_bytes(),
+                    &output_hash,
+                    "utxo_commitment_index",
+                )?;
+            }
+        }
         Ok(())
     }
 
@@ -1087,9 +1167,7 @@ impl LMDBDatabase {
                 kernel.kernel.excess.as_bytes(),
                 "kernel_excess_index",
             )?;
-            let mut excess_sig_key = Vec::<u8>::new();
-            excess_sig_key.extend(kernel.kernel.excess_sig.get_public_nonce().as_bytes());
-            excess_sig_key.extend(kernel.kernel.excess_sig.get_signature().as_bytes());
+            let excess_sig_key = excess_sig_key(&kernel.kernel.excess_sig);
             trace!(
                 target: LOG_TARGET,
                 "Deleting excess signature `{}`",
@@ -1106,8 +1184,8 @@ impl LMDBDatabase {
     }
 
     fn delete_orphan(&self, txn: &WriteTransaction<'_>, hash: &HashOutput) -> Result<(), ChainStorageError> {
-        let orphan = match lmdb_get::<_, Block>(txn, &self.orphans_db, hash.as_slice())? {
-            Some(orphan) => orphan,
+        let header = match lmdb_get::<_, BlockHeader>(txn, &self.orphan_headers_db, hash.as_slice())? {
+            Some(header) => header,
             None => {
                 // delete_orphan is idempotent
                 debug!(
@@ -1119,8 +1197,14 @@ impl LMDBDatabase {
             },
         };
 
-        let parent_hash = orphan.header.prev_hash;
+        let parent_hash = header.prev_hash;
         lmdb_delete_key_value(txn, &self.orphan_parent_map_index, parent_hash.as_slice(), &hash)?;
+        lmdb_delete(
+            txn,
+            &self.orphan_height_index,
+            &orphan_height_key(header.height, hash)?,
+            "orphan_height_index",
+        )?;
 
         // Orphan is a tip hash
         if lmdb_exists(txn, &self.orphan_chain_tips_db, hash.as_slice())? {
@@ -1146,15 +1230,7 @@ impl LMDBDatabase {
                 "orphan_header_accumulated_data_db",
             )?;
         }
-
-        if lmdb_exists(txn, &self.orphan_header_accumulated_data_db, hash.as_slice())? {
-            lmdb_delete(
-                txn,
-                &self.orphan_header_accumulated_data_db,
-                hash.as_slice(),
-                "orphan_header_accumulated_data_db",
-            )?;
-        }
+        lmdb_delete(txn, &self.orphan_headers_db, hash.as_slice(), "orphan_headers_db")?;
         lmdb_delete(txn, &self.orphans_db, hash.as_slice(), "orphans_db")?;
         Ok(())
     }
@@ -1164,10 +1240,10 @@ impl LMDBDatabase {
     fn insert_block_body(
         &self,
         txn: &WriteTransaction<'_>,
+        block_hash: &HashOutput,
         header: &BlockHeader,
         body: AggregateBody,
     ) -> Result<(), ChainStorageError> {
-        let block_hash = header.hash();
         debug!(
             target: LOG_TARGET,
             "Inserting block body for header `{}`: {}",
@@ -1176,14 +1252,12 @@ impl LMDBDatabase {
         );
 
         // Check that the database has not been changed by another thread
-        // 1. The header we are inserting for matches the header at that height
-        let current_header_at_height = lmdb_get::<_, BlockHeader>(txn, &self.headers_db, &header.height).or_not_found(
-            "BlockHeader",
-            "height",
-            header.height.to_string(),
-        )?;
-        let hash = current_header_at_height.hash();
-        if hash != block_hash {
+        // 1. The header we are inserting for matches the header at that height. The stored accumulated data carries the
+        //    hash of that header, so it does not have to be hashed again.
+        let hash = lmdb_get::<_, BlockHeaderAccumulatedData>(txn, &self.header_accumulated_data_db, &header.height)
+            .or_not_found("BlockHeaderAccumulatedData", "height", header.height.to_string())?
+            .hash;
+        if hash != *block_hash {
             return Err(ChainStorageError::InvalidOperation(format!(
                 "Could not insert this block body because there is a different header stored at height {}. New header \
                  ({}), current header: ({})",
@@ -1218,7 +1292,8 @@ impl LMDBDatabase {
 
         for kernel in kernels {
             total_kernel_sum = &total_kernel_sum + &kernel.excess;
-            let pos = kernel_mmr.push(kernel.hash().to_vec())?;
+            let kernel_hash = kernel.hash();
+            let pos = kernel_mmr.push(kernel_hash.to_vec())?;
             trace!(
                 target: LOG_TARGET,
                 "Inserting kernel `{}`",
@@ -1227,7 +1302,7 @@ impl LMDBDatabase {
             let pos = u32::try_from(pos).map_err(|_| {
                 ChainStorageError::InvalidOperation(format!("Kernel MMR node count ({}) is greater than u32::MAX", pos))
             })?;
-            self.insert_kernel(txn, &block_hash, &kernel, pos)?;
+            self.insert_kernel(txn, block_hash, &kernel, &kernel_hash, pos)?;
         }
         let mut output_mmr = MutablePrunedOutputMmr::new(pruned_output_set, Bitmap::create())?;
         let mut witness_mmr = PrunedWitnessMmr::new(pruned_proof_set);
@@ -1240,11 +1315,13 @@ impl LMDBDatabase {
             .into_iter()
             .enumerate()
             .map(|(i, output)| {
-                output_mmr.push(output.hash().to_vec())?;
-                witness_mmr.push(output.witness_hash().to_vec())?;
+                let output_hash = output.hash();
+                let witness_hash = output.witness_hash();
+                output_mmr.push(output_hash.to_vec())?;
+                witness_mmr.push(witness_hash.to_vec())?;
                 // lets check burn
                 if output.is_burned() {
-                    let index = match output_mmr.find_leaf_index(output.hash().as_slice())? {
+                    let index = match output_mmr.find_leaf_index(output_hash.as_slice())? {
                         Some(index) => {
                             debug!(target: LOG_TARGET, "Output {} burned in current block", output);
                             burned_outputs.push(output.commitment.clone());
@@ -1264,16 +1341,20 @@ impl LMDBDatabase {
                         )));
                     }
                 };
-                Ok((output, leaf_count + i + 1))
+                Ok((output, output_hash, witness_hash, leaf_count + i + 1))
             })
             .collect::<Result<Vec<_>, ChainStorageError>>()?;
 
         let mut spent_zero_conf_commitments = Vec::new();
+        let mut undo_data = BlockUndoData::default();
         // unique_id_index expects inputs to be inserted before outputs
         for input in &inputs {
             let output_hash = input.output_hash();
             let index = match self.fetch_mmr_leaf_index(&**txn, MmrTree::Utxo, &output_hash)? {
-                Some(index) => index,
+                Some(index) => {
+                    undo_data.spent_outputs.push((input.commitment()?.clone(), output_hash));
+                    index
+                },
                 None => match output_mmr.find_leaf_index(output_hash.as_slice())? {
                     Some(index) => {
                         debug!(
@@ -1304,10 +1385,10 @@ impl LMDBDatabase {
                 )));
             }
             trace!(target: LOG_TARGET, "Inserting input `{}`", input.commitment()?.to_hex());
-            self.insert_input(txn, current_header_at_height.height, &block_hash, input, index)?;
+            self.insert_input(txn, header.height, block_hash, input, index)?;
         }
 
-        for (output, mmr_count) in outputs {
+        for (output, output_hash, witness_hash, mmr_count) in outputs {
             trace!(target: LOG_TARGET, "Inserting output `{}`", output.commitment.to_hex());
             let mmr_count = u32::try_from(mmr_count).map(|c| c - 1).map_err(|_| {
                 ChainStorageError::InvalidOperation(format!(
@@ -1316,7 +1397,6 @@ impl LMDBDatabase {
                 ))
             })?;
 
-            let output_hash = output.hash();
             if let Some(vn_reg) = output
                 .features
                 .sidechain_feature
@@ -1335,16 +1415,18 @@ impl LMDBDatabase {
                     registration_data: template_reg.clone(),
                     output_hash,
                     block_height: header.height,
-                    block_hash,
+                    block_hash: *block_hash,
                 };
 
                 self.insert_template_registration(txn, &record)?;
             }
             self.insert_output(
                 txn,
-                &block_hash,
+                block_hash,
                 header.height,
                 &output,
+                &output_hash,
+                &witness_hash,
                 mmr_count,
                 header.timestamp().as_u64(),
             )?;
@@ -1366,6 +1448,13 @@ impl LMDBDatabase {
                 "utxo_commitment_index",
             )?;
         }
+        lmdb_insert(
+            txn,
+            &self.block_undo_db,
+            block_hash.as_slice(),
+            &undo_data,
+            "block_undo_db",
+        )?;
         // Merge current deletions with the tip bitmap
         let deleted_at_current_height = output_mmr.deleted().clone();
         // Merge the new indexes with the blockchain deleted bitmap
@@ -1522,6 +1611,10 @@ impl LMDBDatabase {
     ) -> Result<(), ChainStorageError> {
         let inputs = lmdb_delete_keys_starting_with::<TransactionInput>(txn, &self.inputs_db, block_hash.as_slice())?;
         debug!(target: LOG_TARGET, "Deleted {} input(s)", inputs.len());
+        // Like the inputs, the undo record is only needed to rewind blocks above the pruning horizon
+        if lmdb_exists(txn, &self.block_undo_db, block_hash.as_slice())? {
+            lmdb_delete(txn, &self.block_undo_db, block_hash.as_slice(), "block_undo_db")?;
+        }
         Ok(())
     }
 
@@ -1584,6 +1677,26 @@ impl LMDBDatabase {
         lmdb_get(txn, &self.block_hashes_db, header_hash.as_slice()).map_err(Into::into)
     }
 
+    fn fetch_kernel_by_excess_sig_key(
+        &self,
+        txn: &ConstTransaction<'_>,
+        excess_sig_key: &[u8],
+    ) -> Result<Option<(TransactionKernel, HashOutput)>, ChainStorageError> {
+        if let Some((header_hash, mmr_position, hash)) =
+            lmdb_get::<_, (HashOutput, u32, HashOutput)>(txn, &self.kernel_excess_sig_index, excess_sig_key)?
+        {
+            let key = KernelKey::try_from_parts(&[
+                header_hash.as_slice(),
+                mmr_position.to_le_bytes().as_slice(),
+                hash.as_slice(),
+            ])?;
+            Ok(lmdb_get(txn, &self.kernels_db, &key)?
+                .map(|kernel: TransactionKernelRowData| (kernel.kernel, header_hash)))
+        } else {
+            Ok(None)
+        }
+    }
+
     fn fetch_header_accumulated_data_by_height(
         &self,
         txn: &ReadTransaction,
@@ -1592,6 +1705,14 @@ impl LMDBDatabase {
         lmdb_get(txn, &self.header_accumulated_data_db, &height)
     }
 
+    fn fetch_header_timestamp(
+        &self,
+        txn: &ConstTransaction<'_>,
+        height: u64,
+    ) -> Result<Option<EpochTime>, ChainStorageError> {
+        Ok(lmdb_get::<_, u64>(txn, &self.header_timestamps_db, &height)?.map(EpochTime::from))
+    }
+
     fn fetch_last_header_in_txn(&self, txn: &ConstTransaction<'_>) -> Result<Option<BlockHeader>, ChainStorageError> {
         lmdb_last(txn, &self.headers_db)
     }
@@ -1645,6 +1766,73 @@ impl LMDBDatabase {
         )
     }
 
+    fn fetch_kernels_in_block_in_txn(
+        &self,
+        txn: &ConstTransaction<'_>,
+        header_hash: &HashOutput,
+    ) -> Result<Vec<TransactionKernel>, ChainStorageError> {
+        Ok(lmdb_fetch_matching_after(txn, &self.kernels_db, header_hash.deref())?
+            .into_iter()
+            .map(|f: TransactionKernelRowData| f.kernel)
+            .collect())
+    }
+
+    fn fetch_outputs_in_block_in_txn(
+        &self,
+        txn: &ConstTransaction<'_>,
+        header_hash: &HashOutput,
+    ) -> Result<Vec<PrunedOutput>, ChainStorageError> {
+        Ok(lmdb_fetch_matching_after(txn, &self.utxos_db, header_hash.as_slice())?
+            .into_iter()
+            .map(|f: TransactionOutputRowData| match f.output {
+                Some(o) => PrunedOutput::NotPruned { output: o },
+                None => PrunedOutput::Pruned {
+                    output_hash: f.hash,
+                    witness_hash: f.witness_hash,
+                },
+            })
+            .collect())
+    }
+
+    fn fetch_inputs_in_block_in_txn(
+        &self,
+        txn: &ConstTransaction<'_>,
+        header_hash: &HashOutput,
+    ) -> Result<Vec<TransactionInput>, ChainStorageError> {
+        Ok(lmdb_fetch_matching_after(txn, &self.inputs_db, header_hash.as_slice())?
+            .into_iter()
+            .map(|f: TransactionInputRowData| f.input)
+            .collect())
+    }
+
+    /// Populates the spent output data of `input` if the output it spends has not been pruned
+    fn add_spent_output_data_in_txn(
+        &self,
+        txn: &ConstTransaction<'_>,
+        input: &mut TransactionInput,
+    ) -> Result<(), ChainStorageError> {
+        let utxo_mined_info = self
+            .fetch_output_in_txn(txn, input.output_hash().as_slice())?
+            .ok_or_else(|| {
+                ChainStorageError::InvalidBlock(
+                    "An Input in a block doesn't contain a matching spending output".to_string(),
+                )
+            })?;
+        if let PrunedOutput::NotPruned { output } = utxo_mined_info.output {
+            input.add_output_data(
+                output.version,
+                output.features,
+                output.commitment,
+                output.script,
+                output.sender_offset_public_key,
+                output.covenant,
+                output.encrypted_value,
+                output.minimum_value_promise,
+            );
+        }
+        Ok(())
+    }
+
     fn fetch_output_in_txn(
         &self,
         txn: &ConstTransaction<'_>,
@@ -1885,16 +2073,15 @@ impl BlockchainBackend for LMDBDatabase {
             lmdb_get(&txn, &self.orphan_header_accumulated_data_db, hash.as_slice())?;
 
         if let Some(accum) = orphan_accum {
-            let orphan =
-                self.fetch_orphan(&txn, hash)?
-                    .ok_or_else(|| ChainStorageError::DataInconsistencyDetected {
-                        function: "fetch_chain_header_in_all_chains",
-                        details: format!(
-                            "Orphan accumulated data exists but the corresponding orphan header {} does not",
-                            hash.to_hex()
-                        ),
-                    })?;
-            let chain_header = ChainHeader::try_construct(orphan.header, accum).ok_or_else(|| {
+            let orphan_header = lmdb_get::<_, BlockHeader>(&txn, &self.orphan_headers_db, hash.as_slice())?
+                .ok_or_else(|| ChainStorageError::DataInconsistencyDetected {
+                    function: "fetch_chain_header_in_all_chains",
+                    details: format!(
+                        "Orphan accumulated data exists but the corresponding orphan header {} does not",
+                        hash.to_hex()
+                    ),
+                })?;
+            let chain_header = ChainHeader::try_construct(orphan_header, accum).ok_or_else(|| {
                 ChainStorageError::DataInconsistencyDetected {
                     function: "fetch_chain_header_in_all_chains",
                     details: format!("accumulated data mismatch for orphan header {}", hash.to_hex()),
@@ -1985,6 +2172,39 @@ impl BlockchainBackend for LMDBDatabase {
         Ok(chain_header)
     }
 
+    fn fetch_header_timestamps(&self, start_height: u64, end_height: u64) -> Result<Vec<EpochTime>, ChainStorageError> {
+        let txn = self.read_transaction()?;
+        let mut timestamps = Vec::new();
+        for height in start_height..=end_height {
+            match self.fetch_header_timestamp(&txn, height)? {
+                Some(timestamp) => timestamps.push(timestamp),
+                None => break,
+            }
+        }
+        Ok(timestamps)
+    }
+
+    fn fetch_height_at_time(&self, epoch_time: EpochTime) -> Result<u64, ChainStorageError> {
+        let txn = self.read_transaction()?;
+        // Headers are stored contiguously from the genesis block, so the number of entries gives the tip height
+        let num_headers = lmdb_len(&txn, &self.header_timestamps_db)? as u64;
+        // Find the first header after the genesis block that is newer than `epoch_time`
+        let mut left = 1u64;
+        let mut right = num_headers;
+        while left < right {
+            let mid = left + (right - left) / 2;
+            let timestamp =
+                self.fetch_header_timestamp(&txn, mid)
+                    .or_not_found("BlockHeader", "height", mid.to_string())?;
+            if timestamp > epoch_time {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        Ok(left - 1)
+    }
+
     fn is_empty(&self) -> Result<bool, ChainStorageError> {
         let txn = self.read_transaction()?;
         Ok(lmdb_len(&txn, &self.headers_db)? == 0)
@@ -2010,12 +2230,61 @@ impl BlockchainBackend for LMDBDatabase {
         self.fetch_block_accumulated_data(&txn, height)
     }
 
+    fn for_each_block<F>(
+        &self,
+        start_height: u64,
+        end_height: u64,
+        with_spent_outputs: bool,
+        mut visitor: F,
+    ) -> Result<(), ChainStorageError>
+    where
+        F: FnMut(BlockContents) -> Result<bool, ChainStorageError>,
+    {
+        let txn = self.read_transaction()?;
+        for height in start_height..=end_height {
+            let header = match lmdb_get::<_, BlockHeader>(&txn, &self.headers_db, &height)? {
+                Some(header) => header,
+                None => break,
+            };
+            // Headers may be synced ahead of the blocks, the walk ends at the first header without a body
+            let accum_data = match self.fetch_block_accumulated_data(&txn, height)? {
+                Some(_) => self
+                    .fetch_header_accumulated_data_by_height(&txn, height)
+                    .or_not_found("BlockHeaderAccumulatedData", "height", height.to_string())?,
+                None => break,
+            };
+            let header = ChainHeader::try_construct(header, accum_data).ok_or_else(|| {
+                ChainStorageError::DataInconsistencyDetected {
+                    function: "for_each_block",
+                    details: format!("Mismatch in accumulated data at height #{}", height),
+                }
+            })?;
+
+            let kernels = self.fetch_kernels_in_block_in_txn(&txn, header.hash())?;
+            let outputs = self.fetch_outputs_in_block_in_txn(&txn, header.hash())?;
+            let mut inputs = self.fetch_inputs_in_block_in_txn(&txn, header.hash())?;
+            if with_spent_outputs {
+                for input in &mut inputs {
+                    self.add_spent_output_data_in_txn(&txn, input)?;
+                }
+            }
+
+            let contents = BlockContents {
+                header,
+                kernels,
+                outputs,
+                inputs,
+            };
+            if !visitor(contents)? {
+                break;
+            }
+        }
+        Ok(())
+    }
+
     fn fetch_kernels_in_block(&self, header_hash: &HashOutput) -> Result<Vec<TransactionKernel>, ChainStorageError> {
         let txn = self.read_transaction()?;
-        Ok(lmdb_fetch_matching_after(&txn, &self.kernels_db, header_hash.deref())?
-            .into_iter()
-            .map(|f: TransactionKernelRowData| f.kernel)
-            .collect())
+        self.fetch_kernels_in_block_in_txn(&txn, header_hash)
     }
 
     fn fetch_kernel_by_excess(
@@ -2039,22 +2308,26 @@ impl BlockchainBackend for LMDBDatabase {
         excess_sig: &Signature,
     ) -> Result<Option<(TransactionKernel, HashOutput)>, ChainStorageError> {
         let txn = self.read_transaction()?;
-        let mut key = Vec::<u8>::new();
-        key.extend(excess_sig.get_public_nonce().as_bytes());
-        key.extend(excess_sig.get_signature().as_bytes());
-        if let Some((header_hash, mmr_position, hash)) =
-            lmdb_get::<_, (HashOutput, u32, HashOutput)>(&txn, &self.kernel_excess_sig_index, key.as_slice())?
-        {
-            let key = KernelKey::try_from_parts(&[
-                header_hash.as_slice(),
-                mmr_position.to_le_bytes().as_slice(),
-                hash.as_slice(),
-            ])?;
-            Ok(lmdb_get(&txn, &self.kernels_db, &key)?
-                .map(|kernel: TransactionKernelRowData| (kernel.kernel, header_hash)))
-        } else {
-            Ok(None)
+        self.fetch_kernel_by_excess_sig_key(&txn, &excess_sig_key(excess_sig))
+    }
+
+    fn fetch_kernels_by_excess_sigs(
+        &self,
+        excess_sigs: &[Signature],
+    ) -> Result<Vec<Option<(TransactionKernel, HashOutput)>>, ChainStorageError> {
+        let txn = self.read_transaction()?;
+        // Look the keys up in key order so that consecutive reads touch neighbouring index pages
+        let mut keys = excess_sigs
+            .iter()
+            .enumerate()
+            .map(|(i, sig)| (excess_sig_key(sig), i))
+            .collect::<Vec<_>>();
+        keys.sort_unstable();
+        let mut results = vec![None; excess_sigs.len()];
+        for (key, i) in keys {
+            results[i] = self.fetch_kernel_by_excess_sig_key(&txn, &key)?;
         }
+        Ok(results)
     }
 
     fn fetch_utxos_in_block(
@@ -2121,28 +2394,33 @@ impl BlockchainBackend for LMDBDatabase {
         lmdb_get::<_, HashOutput>(&*txn, &*self.utxo_commitment_index, commitment.as_bytes())
     }
 
+    fn fetch_unspent_outputs_by_commitments(
+        &self,
+        commitments: &[Commitment],
+    ) -> Result<Vec<Option<UtxoMinedInfo>>, ChainStorageError> {
+        let txn = self.read_transaction()?;
+        // Look the commitments up in key order so that consecutive reads touch neighbouring index pages
+        let mut order = (0..commitments.len()).collect::<Vec<_>>();
+        order.sort_unstable_by_key(|i| commitments[*i].as_bytes());
+        let mut results = vec![None; commitments.len()];
+        for i in order {
+            if let Some(output_hash) =
+                lmdb_get::<_, HashOutput>(&*txn, &*self.utxo_commitment_index, commitments[i].as_bytes())?
+            {
+                results[i] = self.fetch_output_in_txn(&*txn, output_hash.as_slice())?;
+            }
+        }
+        Ok(results)
+    }
+
     fn fetch_outputs_in_block(&self, header_hash: &HashOutput) -> Result<Vec<PrunedOutput>, ChainStorageError> {
         let txn = self.read_transaction()?;
-        Ok(lmdb_fetch_matching_after(&txn, &self.utxos_db, header_hash.as_slice())?
-            .into_iter()
-            .map(|f: TransactionOutputRowData| match f.output {
-                Some(o) => PrunedOutput::NotPruned { output: o },
-                None => PrunedOutput::Pruned {
-                    output_hash: f.hash,
-                    witness_hash: f.witness_hash,
-                },
-            })
-            .collect())
+        self.fetch_outputs_in_block_in_txn(&txn, header_hash)
     }
 
     fn fetch_inputs_in_block(&self, header_hash: &HashOutput) -> Result<Vec<TransactionInput>, ChainStorageError> {
         let txn = self.read_transaction()?;
-        Ok(
-            lmdb_fetch_matching_after(&txn, &self.inputs_db, header_hash.as_slice())?
-                .into_iter()
-                .map(|f: TransactionInputRowData| f.input)
-                .collect(),
-        )
+        self.fetch_inputs_in_block_in_txn(&txn, header_hash)
     }
 
     fn fetch_mmr_size(&self, tree: MmrTree) -> Result<u64, ChainStorageError> {
@@ -2248,11 +2526,13 @@ impl BlockchainBackend for LMDBDatabase {
             return Ok(None);
         }
 
-        let orphan: Block =
-            lmdb_get(&txn, &self.orphans_db, hash.as_slice())?.ok_or_else(|| ChainStorageError::ValueNotFound {
-                entity: "Orphan",
-                field: "hash",
-                value: hash.to_hex(),
+        let orphan_header: BlockHeader =
+            lmdb_get(&txn, &self.orphan_headers_db, hash.as_slice())?.ok_or_else(|| {
+                ChainStorageError::ValueNotFound {
+                    entity: "Orphan",
+                    field: "hash",
+                    value: hash.to_hex(),
+                }
             })?;
 
         let accumulated_data =
@@ -2264,8 +2544,8 @@ impl BlockchainBackend for LMDBDatabase {
                 }
             })?;
 
-        let height = orphan.header.height;
-        let chain_header = ChainHeader::try_construct(orphan.header, accumulated_data).ok_or_else(|| {
+        let height = orphan_header.height;
+        let chain_header = ChainHeader::try_construct(orphan_header, accumulated_data).ok_or_else(|| {
             ChainStorageError::DataInconsistencyDetected {
                 function: "fetch_orphan_chain_tip_by_hash",
                 details: format!("Accumulated data mismatch at height #{}", height),
@@ -2279,11 +2559,13 @@ impl BlockchainBackend for LMDBDatabase {
         let tips: Vec<HashOutput> = lmdb_filter_map_values(&txn, &self.orphan_chain_tips_db, Some)?;
         let mut result = Vec::new();
         for hash in tips {
-            let orphan: Block =
-                lmdb_get(&txn, &self.orphans_db, hash.as_slice())?.ok_or_else(|| ChainStorageError::ValueNotFound {
-                    entity: "Orphan",
-                    field: "hash",
-                    value: hash.to_hex(),
+            let orphan_header: BlockHeader =
+                lmdb_get(&txn, &self.orphan_headers_db, hash.as_slice())?.ok_or_else(|| {
+                    ChainStorageError::ValueNotFound {
+                        entity: "Orphan",
+                        field: "hash",
+                        value: hash.to_hex(),
+                    }
                 })?;
 
             let accumulated_data = lmdb_get(&txn, &self.orphan_header_accumulated_data_db, hash.as_slice())?
@@ -2292,8 +2574,8 @@ impl BlockchainBackend for LMDBDatabase {
                     field: "hash",
                     value: hash.to_hex(),
                 })?;
-            let height = orphan.header.height;
-            let chain_header = ChainHeader::try_construct(orphan.header, accumulated_data).ok_or_else(|| {
+            let height = orphan_header.height;
+            let chain_header = ChainHeader::try_construct(orphan_header, accumulated_data).ok_or_else(|| {
                 ChainStorageError::DataInconsistencyDetected {
                     function: "fetch_orphan_chain_tip_by_hash",
                     details: format!("Accumulated data mismatch at height #{}", height),
@@ -2387,17 +2669,12 @@ impl BlockchainBackend for LMDBDatabase {
             num_over_limit,
         );
 
-        let mut orphans;
-
-        {
+        // The height index is ordered by height, so no orphan block has to be loaded to find the oldest ones
+        let orphans: Vec<(u64, HashOutput)> = {
             let read_txn = self.read_transaction()?;
+            lmdb_filter_map_values(&read_txn, &self.orphan_height_index, Some)?
+        };
 
-            orphans = lmdb_filter_map_values(&read_txn, &self.orphans_db, |block: Block| {
-                Some((block.header.height, block.hash()))
-            })?;
-        }
-
-        orphans.sort_by(|a, b| a.0.cmp(&b.0));
         let mut txn = DbTransaction::new();
         for (removed_count, (height, block_hash)) in orphans.into_iter().enumerate() {
             if height > horizon_height && removed_count >= num_over_limit {
@@ -2659,6 +2936,19 @@ fn fetch_pruning_horizon(txn: &ConstTransaction<'_>, db: &Database) -> Result<u6
     }
 }
 
+/// The key of a kernel in the excess signature index: the public nonce followed by the signature
+fn excess_sig_key(excess_sig: &Signature) -> Vec<u8> {
+    let mut key = Vec::with_capacity(32 * 2);
+    key.extend(excess_sig.get_public_nonce().as_bytes());
+    key.extend(excess_sig.get_signature().as_bytes());
+    key
+}
+
+/// The key of an orphan in the orphan height index. The height is big endian so that keys sort by height.
+fn orphan_height_key(height: u64, hash: &HashOutput) -> Result<OrphanHeightKey, ChainStorageError> {
+    OrphanHeightKey::try_from_parts(&[height.to_be_bytes().as_slice(), hash.as_slice()])
+}
+
 fn get_database(store: &LMDBStore, name: &str) -> Result<DatabaseRef, ChainStorageError> {
     let handle = store
         .get_handle(name)
@@ -2798,7 +3088,7 @@ impl<'a, 'b> DeletedBitmapModel<'a, WriteTransaction<'b>> {
 }
 
 fn run_migrations(db: &LMDBDatabase) -> Result<(), ChainStorageError> {
-    const MIGRATION_VERSION: u64 = 1;
+    const MIGRATION_VERSION: u64 = 3;
     let txn = db.read_transaction()?;
 
     let k = MetadataKey::MigrationVersion;
@@ -2814,9 +3104,15 @@ fn run_migrations(db: &LMDBDatabase) -> Result<(), ChainStorageError> {
     drop(txn);
 
     if n < MIGRATION_VERSION {
+        let txn = db.write_transaction()?;
         // Add migrations here
+        if n < 2 {
+            migrate_header_timestamps(&txn, db)?;
+        }
+        if n < 3 {
+            migrate_orphan_indexes(&txn, db)?;
+        }
         info!(target: LOG_TARGET, "Migrated database to version {}", MIGRATION_VERSION);
-        let txn = db.write_transaction()?;
         lmdb_replace(
             &txn,
             &db.metadata_db,
@@ -2828,3 +3124,36 @@ fn run_migrations(db: &LMDBDatabase) -> Result<(), ChainStorageError> {
 
     Ok(())
 }
+
+/// Populates the orphan header and height indexes for orphans that were stored before they existed
+fn migrate_orphan_indexes(txn: &WriteTransaction<'_>, db: &LMDBDatabase) -> Result<(), ChainStorageError> {
+    let headers = lmdb_filter_map_values(txn, &db.orphans_db, |block: Block| Some(block.header))?;
+    info!(target: LOG_TARGET, "Indexing {} orphan block(s).", headers.len());
+    for header in headers {
+        let hash = header.hash();
+        lmdb_replace(
+            txn,
+            &db.orphan_height_index,
+            &orphan_height_key(header.height, &hash)?,
+            &(header.height, hash),
+        )?;
+        lmdb_replace(txn, &db.orphan_headers_db, hash.as_slice(), &header)?;
+    }
+    Ok(())
+}
+
+/// Populates the header timestamp index for headers that were stored before it existed
+fn migrate_header_timestamps(txn: &WriteTransaction<'_>, db: &LMDBDatabase) -> Result<(), ChainStorageError> {
+    let timestamps = lmdb_filter_map_values(txn, &db.headers_db, |header: BlockHeader| {
+        Some((header.height, header.timestamp.as_u64()))
+    })?;
+    info!(
+        target: LOG_TARGET,
+        "Indexing timestamps of {} header(s). This may take a while.",
+        timestamps.len()
+    );
+    for (height, timestamp) in timestamps {
+        lmdb_replace(txn, &db.header_timestamps_db, &height, &timestamp)?;
+    }
+    Ok(())
+}
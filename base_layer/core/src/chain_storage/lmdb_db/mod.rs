@@ -22,7 +22,7 @@
 
 pub use lmdb_db::{create_lmdb_database, create_recovery_lmdb_database, LMDBDatabase};
 use serde::{Deserialize, Serialize};
-use tari_common_types::types::HashOutput;
+use tari_common_types::types::{Commitment, HashOutput};
 use tari_crypto::hash_domain;
 
 use crate::transactions::transaction_components::{TransactionInput, TransactionKernel, TransactionOutput};
@@ -67,6 +67,14 @@ pub(crate) struct TransactionInputRowData {
     pub hash: HashOutput,
 }
 
+/// Recorded when a block body is inserted, so that rewinding the block does not have to load the outputs it spent
+/// back from the database
+#[derive(Serialize, Deserialize, Debug, Default)]
+pub(crate) struct BlockUndoData {
+    /// The commitment and hash of every output created in an earlier block and spent by this block
+    pub spent_outputs: Vec<(Commitment, HashOutput)>,
+}
+
 #[derive(Serialize, Deserialize, Debug)]
 pub(crate) struct TransactionKernelRowData {
     pub kernel: TransactionKernel,
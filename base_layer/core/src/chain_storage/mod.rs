@@ -34,6 +34,9 @@ pub mod async_db;
 mod block_add_result;
 pub use block_add_result::BlockAddResult;
 
+mod block_contents;
+pub use block_contents::BlockContents;
+
 mod blockchain_database;
 pub use blockchain_database::{
     calculate_mmr_roots,
@@ -522,6 +522,54 @@ mod fetch_header_containing_kernel_mmr {
     }
 }
 
+mod rewind_to_height {
+    use super::*;
+
+    #[test]
+    fn it_restores_spent_outputs_of_blocks_without_undo_data() {
+        let db = setup();
+        let (blocks, outputs) = add_many_chained_blocks(1, &db);
+        let utxo_count = db.utxo_count().unwrap();
+        let (txns, _) = schema_to_transaction(&[txn_schema!(from: vec![outputs[0].clone()], to: vec![50 * T])]);
+        let (block, _) = create_next_block(&db, &blocks[0], txns);
+        db.add_block(block.clone()).unwrap().assert_added();
+        assert_ne!(db.utxo_count().unwrap(), utxo_count);
+
+        // Blocks stored before undo records were written have none, so their spent outputs are looked up instead
+        assert!(db
+            .db_read_access()
+            .unwrap()
+            .db()
+            .delete_block_undo_data(&block.hash())
+            .unwrap());
+        db.rewind_to_height(1).unwrap();
+        assert_eq!(db.get_height().unwrap(), 1);
+        assert_eq!(db.utxo_count().unwrap(), utxo_count);
+    }
+}
+
+mod fetch_header_timestamps {
+    use super::*;
+
+    #[test]
+    fn it_follows_header_inserts_and_rewinds() {
+        let db = setup();
+        let _block_and_outputs = add_many_chained_blocks(4, &db);
+        let expected = db
+            .fetch_headers(0..=4)
+            .unwrap()
+            .into_iter()
+            .map(|h| h.timestamp)
+            .collect::<Vec<_>>();
+        assert_eq!(db.fetch_header_timestamps(0, 10).unwrap(), expected);
+        assert_eq!(db.fetch_header_timestamps(2, 3).unwrap(), expected[2..=3]);
+
+        db.rewind_to_height(2).unwrap();
+        assert_eq!(db.fetch_header_timestamps(0, 10).unwrap(), expected[..=2]);
+        assert_eq!(db.fetch_height_at_time(expected[4]).unwrap(), 2);
+    }
+}
+
 mod clear_all_pending_headers {
     use super::*;
 
@@ -20,8 +20,10 @@
 // WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
 // USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+use std::{path::PathBuf, time::Duration};
+
 use serde::{Deserialize, Serialize};
-use tari_common::SubConfigPath;
+use tari_common::{configuration::serializers, SubConfigPath};
 
 use crate::mempool::{reorg_pool::ReorgPoolConfig, unconfirmed_pool::UnconfirmedPoolConfig};
 
@@ -52,6 +54,14 @@ pub struct MempoolServiceConfig {
     pub initial_sync_max_transactions: usize,
     /// The maximum number of blocks added via sync or re-org to triggering a sync
     pub block_sync_trigger: usize,
+    /// The file that the mempool is persisted to, so that it can be restored after a restart. A relative path is
+    /// relative to the base node data directory. The mempool is not persisted if this is not set.
+    pub snapshot_file: Option<PathBuf>,
+    /// The interval at which the mempool snapshot is written. It is also written on shutdown.
+    #[serde(with = "serializers::seconds")]
+    pub snapshot_interval: Duration,
+    /// A snapshot that was written more than this many blocks below the current tip is discarded instead of restored
+    pub snapshot_max_age_blocks: u64,
 }
 
 impl Default for MempoolServiceConfig {
@@ -60,6 +70,9 @@ impl Default for MempoolServiceConfig {
             initial_sync_num_peers: 2,
             initial_sync_max_transactions: 10_000,
             block_sync_trigger: 5,
+            snapshot_file: None,
+            snapshot_interval: Duration::from_secs(5 * 60),
+            snapshot_max_age_blocks: 720,
         }
     }
 }
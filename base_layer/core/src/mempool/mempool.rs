@@ -78,6 +78,30 @@ impl Mempool {
         .await
     }
 
+    /// Inserts a batch of transactions into the mempool and returns the storage result of each transaction that was
+    /// not already in the mempool. Validation is the expensive part of an insert, so the batch is validated in
+    /// parallel while only holding the read lock and the write lock is only taken to store the results. A block
+    /// that is processed between the two steps removes any transaction it invalidates, as it would for transactions
+    /// that were already stored.
+    pub async fn insert_batch(
+        &self,
+        transactions: Vec<Arc<Transaction>>,
+    ) -> Result<Vec<(Arc<Transaction>, TxStorageResponse)>, MempoolError> {
+        let validated = self
+            .with_read_access(move |storage| storage.validate_unknown(transactions))
+            .await?;
+        self.with_write_access(move |storage| {
+            Ok(validated
+                .into_iter()
+                .map(|(tx, result)| {
+                    let response = storage.insert_validated(tx.clone(), result);
+                    (tx, response)
+                })
+                .collect())
+        })
+        .await
+    }
+
     /// Update the Mempool based on the received published block.
     pub async fn process_published_block(&self, published_block: Arc<Block>) -> Result<(), MempoolError> {
         self.with_write_access(move |storage| storage.process_published_block(&published_block))
@@ -132,6 +156,21 @@ impl Mempool {
             .await
     }
 
+    /// Check the state of the transactions with the specified excess signatures under a single read lock. The results
+    /// are returned in the same order as `excess_sigs`.
+    pub async fn has_txs_with_excess_sigs(
+        &self,
+        excess_sigs: Vec<Signature>,
+    ) -> Result<Vec<TxStorageResponse>, MempoolError> {
+        self.with_read_access(move |storage| {
+            Ok(excess_sigs
+                .iter()
+                .map(|excess_sig| storage.has_tx_with_excess_sig(excess_sig))
+                .collect())
+        })
+        .await
+    }
+
     /// Check if the specified transaction is stored in the Mempool.
     pub async fn has_transaction(&self, tx: Arc<Transaction>) -> Result<TxStorageResponse, MempoolError> {
         self.with_read_access(move |storage| storage.has_transaction(&tx)).await
@@ -23,6 +23,7 @@
 use std::{sync::Arc, time::Instant};
 
 use log::*;
+use rayon::prelude::*;
 use tari_common_types::types::{PrivateKey, Signature};
 use tari_utilities::hex::Hex;
 
@@ -73,21 +74,52 @@ impl MempoolStorage {
     /// Insert an unconfirmed transaction into the Mempool. The transaction *MUST* have passed through the validation
     /// pipeline already and will thus always be internally consistent by this stage
     pub fn insert(&mut self, tx: Arc<Transaction>) -> TxStorageResponse {
+        let timer = Instant::now();
+        let validation_result = self.validator.validate(&tx);
+        trace!(target: LOG_TARGET, "Transaction validated in {:.2?}", timer.elapsed());
+        self.insert_validated(tx, validation_result)
+    }
+
+    /// Validates the transactions that are not already stored in the mempool, in parallel. The returned transactions
+    /// and validation results are passed to `insert_validated` to store them.
+    pub fn validate_unknown(
+        &self,
+        txs: Vec<Arc<Transaction>>,
+    ) -> Result<Vec<(Arc<Transaction>, Result<(), ValidationError>)>, MempoolError> {
+        let mut unknown = Vec::with_capacity(txs.len());
+        for tx in txs {
+            if !self.has_transaction(&tx)?.is_stored() {
+                unknown.push(tx);
+            }
+        }
+        let validator = &self.validator;
+        Ok(unknown
+            .into_par_iter()
+            .map(|tx| {
+                let result = validator.validate(&tx);
+                (tx, result)
+            })
+            .collect())
+    }
+
+    /// Stores a transaction in the Mempool according to the result of validating it with the mempool validator
+    pub fn insert_validated(
+        &mut self,
+        tx: Arc<Transaction>,
+        validation_result: Result<(), ValidationError>,
+    ) -> TxStorageResponse {
         let tx_id = tx
             .body
             .kernels()
             .first()
             .map(|k| k.excess_sig.get_signature().to_hex())
             .unwrap_or_else(|| "None?!".into());
-        let timer = Instant::now();
         debug!(target: LOG_TARGET, "Inserting tx into mempool: {}", tx_id);
-        match self.validator.validate(&tx) {
+        match validation_result {
             Ok(()) => {
                 debug!(
                     target: LOG_TARGET,
-                    "Transaction {} is VALID ({:.2?}), inserting in unconfirmed pool in",
-                    tx_id,
-                    timer.elapsed()
+                    "Transaction {} is VALID, inserting in unconfirmed pool", tx_id
                 );
                 let timer = Instant::now();
                 let weight = self.get_transaction_weighting(0);
@@ -64,6 +64,11 @@ pub mod service;
 #[cfg(feature = "base_node")]
 pub use service::{MempoolServiceError, MempoolServiceInitializer, OutboundMempoolServiceInterface};
 
+#[cfg(feature = "base_node")]
+mod snapshot;
+#[cfg(feature = "base_node")]
+pub use snapshot::{MempoolSnapshot, MempoolSnapshotError, MempoolSnapshotInitializer};
+
 #[cfg(feature = "base_node")]
 mod sync_protocol;
 use core::fmt::{Display, Error, Formatter};
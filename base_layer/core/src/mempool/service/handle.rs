@@ -69,6 +69,16 @@ impl MempoolHandle {
         }
     }
 
+    pub async fn get_tx_state_by_excess_sigs(
+        &mut self,
+        sigs: Vec<Signature>,
+    ) -> Result<Vec<TxStorageResponse>, MempoolServiceError> {
+        match self.inner.call(MempoolRequest::GetTxStateByExcessSigs(sigs)).await?? {
+            MempoolResponse::TxStorages(resp) => Ok(resp),
+            _ => panic!("Incorrect response"),
+        }
+    }
+
     pub async fn submit_transaction(
         &mut self,
         transaction: Transaction,
@@ -57,13 +57,23 @@ impl MempoolInboundHandlers {
     /// Handle inbound Mempool service requests from remote nodes and local services.
     pub async fn handle_request(&mut self, request: MempoolRequest) -> Result<MempoolResponse, MempoolServiceError> {
         debug!(target: LOG_TARGET, "Handling remote request: {}", request);
-        use MempoolRequest::{GetFeePerGramStats, GetState, GetStats, GetTxStateByExcessSig, SubmitTransaction};
+        use MempoolRequest::{
+            GetFeePerGramStats,
+            GetState,
+            GetStats,
+            GetTxStateByExcessSig,
+            GetTxStateByExcessSigs,
+            SubmitTransaction,
+        };
         match request {
             GetStats => Ok(MempoolResponse::Stats(self.mempool.stats().await?)),
             GetState => Ok(MempoolResponse::State(self.mempool.state().await?)),
             GetTxStateByExcessSig(excess_sig) => Ok(MempoolResponse::TxStorage(
                 self.mempool.has_tx_with_excess_sig(excess_sig).await?,
             )),
+            GetTxStateByExcessSigs(excess_sigs) => Ok(MempoolResponse::TxStorages(
+                self.mempool.has_txs_with_excess_sigs(excess_sigs).await?,
+            )),
             SubmitTransaction(tx) => {
                 debug!(
                     target: LOG_TARGET,
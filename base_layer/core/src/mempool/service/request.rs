@@ -35,6 +35,7 @@ pub enum MempoolRequest {
     GetStats,
     GetState,
     GetTxStateByExcessSig(Signature),
+    GetTxStateByExcessSigs(Vec<Signature>),
     SubmitTransaction(Transaction),
     GetFeePerGramStats { count: usize, tip_height: u64 },
 }
@@ -47,6 +48,9 @@ impl Display for MempoolRequest {
             MempoolRequest::GetTxStateByExcessSig(sig) => {
                 write!(f, "GetTxStateByExcessSig ({})", sig.get_signature().to_hex())
             },
+            MempoolRequest::GetTxStateByExcessSigs(sigs) => {
+                write!(f, "GetTxStateByExcessSigs ({} signature(s))", sigs.len())
+            },
             MempoolRequest::SubmitTransaction(tx) => write!(
                 f,
                 "SubmitTransaction ({})",
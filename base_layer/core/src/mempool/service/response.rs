@@ -32,16 +32,18 @@ pub enum MempoolResponse {
     Stats(StatsResponse),
     State(StateResponse),
     TxStorage(TxStorageResponse),
+    TxStorages(Vec<TxStorageResponse>),
     FeePerGramStats { response: Vec<FeePerGramStat> },
 }
 
 impl fmt::Display for MempoolResponse {
     fn fmt(&self, f: &mut Formatter<'_>) -> fmt::Result {
-        use MempoolResponse::{FeePerGramStats, State, Stats, TxStorage};
+        use MempoolResponse::{FeePerGramStats, State, Stats, TxStorage, TxStorages};
         match &self {
             Stats(_) => write!(f, "Stats"),
             State(_) => write!(f, "State"),
             TxStorage(_) => write!(f, "TxStorage"),
+            TxStorages(responses) => write!(f, "TxStorages({} item(s))", responses.len()),
             FeePerGramStats { response } => write!(f, "FeePerGramStats({} item(s))", response.len()),
         }
     }
@@ -0,0 +1,202 @@
+//  Copyright 2022, The Tari Project
+//
+//  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+//  following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+//  disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+//  following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+//  products derived from this software without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+//  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+//  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+//  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+use std::{path::PathBuf, time::Duration};
+
+use log::*;
+use tari_service_framework::{async_trait, ServiceInitializationError, ServiceInitializer, ServiceInitializerContext};
+use tari_shutdown::ShutdownSignal;
+use tokio::{task, time, time::MissedTickBehavior};
+
+use crate::{
+    base_node::{comms_interface::LocalNodeCommsInterface, StateMachineHandle},
+    mempool::{
+        snapshot::{MempoolSnapshot, MempoolSnapshotError},
+        Mempool,
+        MempoolError,
+        MempoolServiceConfig,
+    },
+};
+
+const LOG_TARGET: &str = "c::mempool::snapshot";
+
+/// Restores the mempool from the snapshot file once the node has synced and then persists the mempool periodically
+/// and on shutdown. Nothing is done if `snapshot_file` is not configured.
+pub struct MempoolSnapshotInitializer {
+    config: MempoolServiceConfig,
+    mempool: Mempool,
+}
+
+impl MempoolSnapshotInitializer {
+    pub fn new(config: MempoolServiceConfig, mempool: Mempool) -> Self {
+        Self { config, mempool }
+    }
+}
+
+#[async_trait]
+impl ServiceInitializer for MempoolSnapshotInitializer {
+    async fn initialize(&mut self, context: ServiceInitializerContext) -> Result<(), ServiceInitializationError> {
+        let path = match self.config.snapshot_file.clone() {
+            Some(path) => path,
+            None => {
+                debug!(target: LOG_TARGET, "Mempool snapshots are disabled");
+                return Ok(());
+            },
+        };
+        let config = self.config.clone();
+        let mempool = self.mempool.clone();
+
+        context.spawn_when_ready(move |handles| async move {
+            let state_machine = handles.expect_handle::<StateMachineHandle>();
+            let base_node = handles.expect_handle::<LocalNodeCommsInterface>();
+            let mut shutdown = handles.get_shutdown_signal();
+
+            // Transactions can only be revalidated once the chain they spend from has been synced
+            let mut status_watch = state_machine.get_status_info_watch();
+            while !status_watch.borrow().state_info.is_synced() {
+                tokio::select! {
+                    changed = status_watch.changed() => {
+                        if changed.is_err() {
+                            return;
+                        }
+                    },
+                    _ = shutdown.wait() => return,
+                }
+            }
+
+            let mut task = MempoolSnapshotTask {
+                path,
+                config,
+                mempool,
+                base_node,
+                tip_height: 0,
+            };
+            task.run(shutdown).await;
+        });
+
+        Ok(())
+    }
+}
+
+struct MempoolSnapshotTask {
+    path: PathBuf,
+    config: MempoolServiceConfig,
+    mempool: Mempool,
+    base_node: LocalNodeCommsInterface,
+    tip_height: u64,
+}
+
+impl MempoolSnapshotTask {
+    async fn run(&mut self, mut shutdown: ShutdownSignal) {
+        self.update_tip_height().await;
+        if let Err(err) = self.restore().await {
+            warn!(target: LOG_TARGET, "Failed to restore mempool snapshot: {}", err);
+        }
+
+        let mut interval = time::interval_at(
+            time::Instant::now() + self.config.snapshot_interval,
+            self.config.snapshot_interval.max(Duration::from_secs(1)),
+        );
+        interval.set_missed_tick_behavior(MissedTickBehavior::Delay);
+        loop {
+            tokio::select! {
+                _ = interval.tick() => {
+                    self.update_tip_height().await;
+                    self.save().await;
+                },
+                _ = shutdown.wait() => {
+                    // The base node may already be shutting down, so the snapshot is stamped with the last known tip
+                    self.save().await;
+                    break;
+                },
+            }
+        }
+    }
+
+    async fn update_tip_height(&mut self) {
+        match self.base_node.get_metadata().await {
+            Ok(metadata) => self.tip_height = metadata.height_of_longest_chain(),
+            Err(err) => warn!(target: LOG_TARGET, "Failed to fetch the chain tip: {}", err),
+        }
+    }
+
+    async fn restore(&self) -> Result<(), MempoolSnapshotError> {
+        let path = self.path.clone();
+        let snapshot = match task::spawn_blocking(move || MempoolSnapshot::read_from_file(path))
+            .await
+            .map_err(MempoolError::from)??
+        {
+            Some(snapshot) => snapshot,
+            None => {
+                debug!(target: LOG_TARGET, "No mempool snapshot found at {}", self.path.display());
+                return Ok(());
+            },
+        };
+
+        let age = self.tip_height.saturating_sub(snapshot.validation_height);
+        if age > self.config.snapshot_max_age_blocks {
+            info!(
+                target: LOG_TARGET,
+                "Discarding mempool snapshot validated at height {} as it is {} blocks behind the tip",
+                snapshot.validation_height,
+                age
+            );
+            return Ok(());
+        }
+
+        let validation_height = snapshot.validation_height;
+        let num_transactions = snapshot.transactions.len();
+        let num_stored = snapshot.restore(&self.mempool).await?;
+        info!(
+            target: LOG_TARGET,
+            "Restored {} of {} transaction(s) from the mempool snapshot validated at height {}",
+            num_stored,
+            num_transactions,
+            validation_height
+        );
+        Ok(())
+    }
+
+    async fn save(&self) {
+        let transactions = match self.mempool.snapshot().await {
+            Ok(transactions) => transactions,
+            Err(err) => {
+                warn!(target: LOG_TARGET, "Failed to take a snapshot of the mempool: {}", err);
+                return;
+            },
+        };
+        let num_transactions = transactions.len();
+        let snapshot = MempoolSnapshot {
+            validation_height: self.tip_height,
+            transactions,
+        };
+        let path = self.path.clone();
+        match task::spawn_blocking(move || snapshot.write_to_file(path)).await {
+            Ok(Ok(())) => debug!(
+                target: LOG_TARGET,
+                "Wrote {} transaction(s) to the mempool snapshot at height {}", num_transactions, self.tip_height
+            ),
+            Ok(Err(err)) => warn!(target: LOG_TARGET, "Failed to write the mempool snapshot: {}", err),
+            Err(err) => warn!(target: LOG_TARGET, "Failed to write the mempool snapshot: {}", err),
+        }
+    }
+}
@@ -0,0 +1,356 @@
+//  Copyright 2022, The Tari Project
+//
+//  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+//  following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+//  disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+//  following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+//  products derived from this software without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+//  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+//  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+//  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! # Mempool snapshot
+//!
+//! The unconfirmed transactions in the mempool are written to a file on shutdown and periodically while the node is
+//! running, so that a restarted node can restore its mempool instead of waiting for the mempool sync protocol and
+//! rebroadcasts to refill it. Restored transactions are revalidated against the current tip before they are stored.
+//!
+//! The file is laid out as follows, with all integers in little endian:
+//!
+//! ```text
+//! magic              b"TMPS"
+//! version            u8
+//! validation height  u64, the chain height at which the transactions were last known to be valid
+//! count              u32
+//! count times:
+//!   length           u32
+//!   transaction      protobuf encoded transaction of `length` bytes
+//! ```
+
+use std::{
+    convert::TryFrom,
+    fs,
+    fs::File,
+    io,
+    io::{BufReader, BufWriter, Read, Write},
+    mem,
+    path::Path,
+    sync::Arc,
+};
+
+pub use error::MempoolSnapshotError;
+pub use initializer::MempoolSnapshotInitializer;
+use log::*;
+use prost::Message;
+
+use crate::{
+    mempool::{Mempool, TxStorageResponse},
+    proto::types as proto,
+    transactions::transaction_components::Transaction,
+};
+
+mod error;
+mod initializer;
+
+const LOG_TARGET: &str = "c::mempool::snapshot";
+
+const SNAPSHOT_MAGIC: &[u8; 4] = b"TMPS";
+const SNAPSHOT_VERSION: u8 = 1;
+/// Transactions larger than this are not written to, or read from, a snapshot
+const MAX_TRANSACTION_SIZE: usize = 3 * 1024 * 1024; // 3 MiB
+/// The number of restored transactions that are validated and inserted into the mempool together
+const RESTORE_BATCH_SIZE: usize = 256;
+
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct MempoolSnapshot {
+    /// The chain height at which the transactions were last known to be valid
+    pub validation_height: u64,
+    pub transactions: Vec<Arc<Transaction>>,
+}
+
+impl MempoolSnapshot {
+    /// Writes the snapshot to `path`. The snapshot is first written to a temporary file that then replaces the
+    /// previous snapshot, so that an interrupted write never leaves a truncated snapshot behind.
+    pub fn write_to_file<P: AsRef<Path>>(&self, path: P) -> Result<(), MempoolSnapshotError> {
+        let path = path.as_ref();
+        if let Some(parent) = path.parent() {
+            fs::create_dir_all(parent)?;
+        }
+        let tmp_path = path.with_extension("tmp");
+        let mut writer = BufWriter::new(File::create(&tmp_path)?);
+        self.write(&mut writer)?;
+        writer.into_inner().map_err(|e| e.into_error())?.sync_all()?;
+        fs::rename(&tmp_path, path)?;
+        Ok(())
+    }
+
+    /// Reads the snapshot at `path`, returning None if there is no snapshot
+    pub fn read_from_file<P: AsRef<Path>>(path: P) -> Result<Option<Self>, MempoolSnapshotError> {
+        let file = match File::open(path) {
+            Ok(file) => file,
+            Err(err) if err.kind() == io::ErrorKind::NotFound => return Ok(None),
+            Err(err) => return Err(err.into()),
+        };
+        Self::read(&mut BufReader::new(file)).map(Some)
+    }
+
+    fn write<W: Write>(&self, writer: &mut W) -> Result<(), MempoolSnapshotError> {
+        let encoded = self
+            .transactions
+            .iter()
+            .filter_map(|tx| match proto::Transaction::try_from(tx.clone()) {
+                Ok(tx) => Some(tx.encode_to_vec()),
+                Err(err) => {
+                    warn!(target: LOG_TARGET, "Could not convert transaction: {}", err);
+                    None
+                },
+            })
+            .filter(|bytes| bytes.len() <= MAX_TRANSACTION_SIZE)
+            .collect::<Vec<_>>();
+
+        writer.write_all(SNAPSHOT_MAGIC)?;
+        writer.write_all(&[SNAPSHOT_VERSION])?;
+        writer.write_all(&self.validation_height.to_le_bytes())?;
+        #[allow(clippy::cast_possible_truncation)]
+        writer.write_all(&(encoded.len() as u32).to_le_bytes())?;
+        for bytes in encoded {
+            #[allow(clippy::cast_possible_truncation)]
+            writer.write_all(&(bytes.len() as u32).to_le_bytes())?;
+            writer.write_all(&bytes)?;
+        }
+        Ok(())
+    }
+
+    fn read<R: Read>(reader: &mut R) -> Result<Self, MempoolSnapshotError> {
+        let mut magic = [0u8; 4];
+        reader.read_exact(&mut magic)?;
+        if &magic != SNAPSHOT_MAGIC {
+            return Err(MempoolSnapshotError::InvalidSnapshot(
+                "not a mempool snapshot".to_string(),
+            ));
+        }
+        let mut version = [0u8; 1];
+        reader.read_exact(&mut version)?;
+        if version[0] != SNAPSHOT_VERSION {
+            return Err(MempoolSnapshotError::InvalidSnapshot(format!(
+                "unsupported version {}",
+                version[0]
+            )));
+        }
+        let validation_height = u64::from_le_bytes(read_array(reader)?);
+        let count = u32::from_le_bytes(read_array(reader)?) as usize;
+
+        let mut transactions = Vec::with_capacity(count.min(RESTORE_BATCH_SIZE));
+        let mut buf = Vec::new();
+        for _ in 0..count {
+            let len = u32::from_le_bytes(read_array(reader)?) as usize;
+            if len > MAX_TRANSACTION_SIZE {
+                return Err(MempoolSnapshotError::InvalidSnapshot(format!(
+                    "transaction of {} bytes exceeds the maximum size",
+                    len
+                )));
+            }
+            buf.resize(len, 0);
+            reader.read_exact(&mut buf)?;
+            let tx = proto::Transaction::decode(buf.as_slice())
+                .map_err(|err| MempoolSnapshotError::InvalidSnapshot(err.to_string()))?;
+            match Transaction::try_from(tx) {
+                Ok(tx) => transactions.push(Arc::new(tx)),
+                Err(err) => warn!(target: LOG_TARGET, "Skipping malformed transaction in snapshot: {}", err),
+            }
+        }
+
+        Ok(Self {
+            validation_height,
+            transactions,
+        })
+    }
+
+    /// Revalidates the snapshot transactions against the current tip and inserts the valid ones into the mempool.
+    /// Returns the number of transactions that were stored.
+    ///
+    /// Snapshots list transactions in the order they entered the mempool, which usually puts parents before the
+    /// transactions that spend them, but a chunk is validated in parallel and a parent may have re-entered the mempool
+    /// after its child (e.g. after a reorg). Orphans are therefore resubmitted after each
+    /// chunk, until a round stores none of them.
+    pub async fn restore(self, mempool: &Mempool) -> Result<usize, MempoolSnapshotError> {
+        let mut num_stored = 0;
+        let mut orphans = Vec::new();
+        let mut transactions = self.transactions;
+        while !transactions.is_empty() {
+            let rest = transactions.split_off(RESTORE_BATCH_SIZE.min(transactions.len()));
+            let (mut stored, new_orphans) = Self::insert_batch(mempool, transactions).await?;
+            num_stored += stored;
+            orphans.extend(new_orphans);
+            // An orphan may spend the outputs of a transaction that was stored since it was last tried
+            while stored > 0 && !orphans.is_empty() {
+                let (retried, remaining) = Self::insert_batch(mempool, mem::take(&mut orphans)).await?;
+                stored = retried;
+                num_stored += retried;
+                orphans = remaining;
+            }
+            transactions = rest;
+        }
+        if !orphans.is_empty() {
+            debug!(
+                target: LOG_TARGET,
+                "{} orphaned transaction(s) in the snapshot were not restored",
+                orphans.len()
+            );
+        }
+        Ok(num_stored)
+    }
+
+    /// Inserts `transactions` into the mempool, returning the number that were stored and the orphans
+    async fn insert_batch(
+        mempool: &Mempool,
+        transactions: Vec<Arc<Transaction>>,
+    ) -> Result<(usize, Vec<Arc<Transaction>>), MempoolSnapshotError> {
+        let results = mempool.insert_batch(transactions).await?;
+        let num_stored = results.iter().filter(|(_, result)| result.is_stored()).count();
+        let orphans = results
+            .into_iter()
+            .filter(|(_, result)| *result == TxStorageResponse::NotStoredOrphan)
+            .map(|(tx, _)| tx)
+            .collect();
+        Ok((num_stored, orphans))
+    }
+}
+
+fn read_array<R: Read, const N: usize>(reader: &mut R) -> Result<[u8; N], io::Error> {
+    let mut buf = [0u8; N];
+    reader.read_exact(&mut buf)?;
+    Ok(buf)
+}
+
+#[cfg(test)]
+mod test {
+    use std::collections::HashSet;
+
+    use tari_common::configuration::Network;
+    use tari_common_types::types::HashOutput;
+    use tempfile::tempdir;
+
+    use super::*;
+    use crate::{
+        consensus::ConsensusManager,
+        transactions::{
+            tari_amount::uT,
+            test_helpers::{create_tx, spend_utxos},
+        },
+        txn_schema,
+        validation::{mocks::MockValidator, MempoolTransactionValidation, ValidationError},
+    };
+
+    /// Treats the given outputs as the UTXO set, so that spending any other output is reported as an unknown input
+    struct UtxoSetValidator(HashSet<HashOutput>);
+
+    impl MempoolTransactionValidation for UtxoSetValidator {
+        fn validate(&self, transaction: &Transaction) -> Result<(), ValidationError> {
+            let unknown = transaction
+                .body
+                .inputs()
+                .iter()
+                .map(|input| input.output_hash())
+                .filter(|hash| !self.0.contains(hash))
+                .collect::<Vec<_>>();
+            if unknown.is_empty() {
+                Ok(())
+            } else {
+                Err(ValidationError::UnknownInputs(unknown))
+            }
+        }
+    }
+
+    fn create_transactions(n: usize) -> Vec<Arc<Transaction>> {
+        (0..n)
+            .map(|_| {
+                let (transaction, _, _) = create_tx(5000 * uT, 3 * uT, 1, 2, 1, 3, Default::default());
+                Arc::new(transaction)
+            })
+            .collect()
+    }
+
+    #[test]
+    fn it_reads_back_a_written_snapshot() {
+        let tmp = tempdir().unwrap();
+        let path = tmp.path().join("mempool_snapshot.bin");
+        assert!(MempoolSnapshot::read_from_file(&path).unwrap().is_none());
+
+        let snapshot = MempoolSnapshot {
+            validation_height: 123,
+            transactions: create_transactions(3),
+        };
+        snapshot.write_to_file(&path).unwrap();
+        let read = MempoolSnapshot::read_from_file(&path).unwrap().unwrap();
+        assert_eq!(read, snapshot);
+
+        fs::write(&path, b"TMPS\x02").unwrap();
+        assert!(matches!(
+            MempoolSnapshot::read_from_file(&path),
+            Err(MempoolSnapshotError::InvalidSnapshot(_))
+        ));
+    }
+
+    #[tokio::test]
+    async fn it_restores_transactions_into_the_mempool() {
+        let mempool = Mempool::new(
+            Default::default(),
+            ConsensusManager::builder(Network::LocalNet).build(),
+            Box::new(MockValidator::new(true)),
+        );
+        let transactions = create_transactions(2);
+        mempool.insert(transactions[0].clone()).await.unwrap();
+
+        let snapshot = MempoolSnapshot {
+            validation_height: 1,
+            transactions,
+        };
+        assert_eq!(snapshot.clone().restore(&mempool).await.unwrap(), 1);
+        assert_eq!(mempool.snapshot().await.unwrap().len(), 2);
+    }
+
+    #[tokio::test]
+    async fn it_restores_children_listed_before_their_parents() {
+        let (parent, _, parent_outputs) = create_tx(5000 * uT, 3 * uT, 1, 2, 1, 3, Default::default());
+        let (child, _) = spend_utxos(txn_schema!(from: vec![parent_outputs[0].clone()]));
+        let (parent, child) = (Arc::new(parent), Arc::new(child));
+        let utxo_set = parent
+            .body
+            .inputs()
+            .iter()
+            .map(|input| input.output_hash())
+            .collect::<HashSet<_>>();
+        let create_mempool = || {
+            Mempool::new(
+                Default::default(),
+                ConsensusManager::builder(Network::LocalNet).build(),
+                Box::new(UtxoSetValidator(utxo_set.clone())),
+            )
+        };
+
+        let mempool = create_mempool();
+        assert!(mempool.insert(parent.clone()).await.unwrap().is_stored());
+        assert!(mempool.insert(child.clone()).await.unwrap().is_stored());
+        assert_eq!(mempool.snapshot().await.unwrap(), vec![parent.clone(), child.clone()]);
+
+        let snapshot = MempoolSnapshot {
+            validation_height: 1,
+            transactions: vec![child, parent],
+        };
+        let mempool = create_mempool();
+        assert_eq!(snapshot.restore(&mempool).await.unwrap(), 2);
+        assert_eq!(mempool.snapshot().await.unwrap().len(), 2);
+    }
+}
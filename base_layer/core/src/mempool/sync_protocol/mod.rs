@@ -64,8 +64,10 @@
 //! ```
 
 use std::{
+    collections::{HashMap, HashSet},
     convert::TryFrom,
     iter,
+    mem,
     sync::{
         atomic::{AtomicUsize, Ordering},
         Arc,
@@ -112,6 +114,8 @@ mod initializer;
 
 const MAX_FRAME_SIZE: usize = 3 * 1024 * 1024; // 3 MiB
 const LOG_TARGET: &str = "c::mempool::sync_protocol";
+/// The number of received transactions that are validated in parallel and inserted into the mempool together
+const TRANSACTION_BATCH_SIZE: usize = 64;
 
 pub static MEMPOOL_SYNC_PROTOCOL: Bytes = Bytes::from_static(b"t/mempool-sync/1");
 
@@ -452,20 +456,23 @@ where TSubstream: AsyncRead + AsyncWrite + Unpin
 
         let transactions = self.mempool.snapshot().await?;
 
-        let mut duplicate_inventory_items = Vec::new();
+        // Index the inventory by excess signature so that the difference between the two sets is found in a single
+        // pass over our mempool
+        let inventory_indexes = inventory
+            .items
+            .iter()
+            .enumerate()
+            .map(|(i, bytes)| (bytes.as_slice(), i))
+            .collect::<HashMap<_, _>>();
+        let mut duplicate_inventory_items = HashSet::new();
         let (transactions, _) = transactions.into_iter().partition::<Vec<_>, _>(|transaction| {
             let excess_sig = transaction
                 .first_kernel_excess_sig()
                 .expect("transaction stored in mempool did not have any kernels");
 
-            let has_item = inventory
-                .items
-                .iter()
-                .position(|bytes| bytes.as_slice() == excess_sig.get_signature().as_bytes());
-
-            match has_item {
+            match inventory_indexes.get(excess_sig.get_signature().as_bytes()) {
                 Some(pos) => {
-                    duplicate_inventory_items.push(pos);
+                    duplicate_inventory_items.insert(*pos);
                     false
                 },
                 None => true,
@@ -516,6 +523,7 @@ where TSubstream: AsyncRead + AsyncWrite + Unpin
 
     async fn read_and_insert_transactions_until_complete(&mut self) -> Result<(), MempoolProtocolError> {
         let mut num_recv = 0;
+        let mut batch = Vec::with_capacity(TRANSACTION_BATCH_SIZE);
         while let Some(result) = self.framed.next().await {
             let bytes = result?;
             let item = proto::TransactionItem::decode(&mut bytes.freeze()).map_err(|err| {
@@ -527,7 +535,10 @@ where TSubstream: AsyncRead + AsyncWrite + Unpin
 
             match item.transaction {
                 Some(txn) => {
-                    self.validate_and_insert_transaction(txn).await?;
+                    batch.push(self.convert_transaction(txn)?);
+                    if batch.len() >= TRANSACTION_BATCH_SIZE {
+                        self.validate_and_insert_transactions(mem::take(&mut batch)).await?;
+                    }
                     num_recv += 1;
                 },
                 None => {
@@ -541,6 +552,9 @@ where TSubstream: AsyncRead + AsyncWrite + Unpin
                 },
             }
         }
+        if !batch.is_empty() {
+            self.validate_and_insert_transactions(batch).await?;
+        }
 
         #[allow(clippy::cast_possible_truncation)]
         #[allow(clippy::cast_possible_wrap)]
@@ -553,10 +567,10 @@ where TSubstream: AsyncRead + AsyncWrite + Unpin
         Ok(())
     }
 
-    async fn validate_and_insert_transaction(
-        &mut self,
+    fn convert_transaction(
+        &self,
         txn: shared_proto::types::Transaction,
-    ) -> Result<(), MempoolProtocolError> {
+    ) -> Result<Arc<Transaction>, MempoolProtocolError> {
         let txn = Transaction::try_from(txn).map_err(|err| MempoolProtocolError::MessageConversionFailed {
             peer: self.peer_node_id.clone(),
             message: err,
@@ -564,35 +578,41 @@ where TSubstream: AsyncRead + AsyncWrite + Unpin
         let excess_sig = txn
             .first_kernel_excess_sig()
             .ok_or_else(|| MempoolProtocolError::ExcessSignatureMissing(self.peer_node_id.clone()))?;
-        let excess_sig_hex = excess_sig.get_signature().to_hex();
 
         debug!(
             target: LOG_TARGET,
             "Received transaction `{}` from peer `{}`",
-            excess_sig_hex,
+            excess_sig.get_signature().to_hex(),
             self.peer_node_id.short_str()
         );
-        let txn = Arc::new(txn);
-        let store_state = self.mempool.has_transaction(txn.clone()).await?;
-        if store_state.is_stored() {
-            return Ok(());
-        }
+        Ok(Arc::new(txn))
+    }
 
-        let stored_result = self.mempool.insert(txn).await?;
-        if stored_result.is_stored() {
-            metrics::inbound_transactions(Some(&self.peer_node_id)).inc();
-            debug!(
-                target: LOG_TARGET,
-                "Inserted transaction `{}` from peer `{}`",
-                excess_sig_hex,
-                self.peer_node_id.short_str()
-            );
-        } else {
-            metrics::rejected_inbound_transactions(Some(&self.peer_node_id)).inc();
-            debug!(
-                target: LOG_TARGET,
-                "Did not store new transaction `{}` in mempool: {}", excess_sig_hex, stored_result
-            )
+    async fn validate_and_insert_transactions(
+        &mut self,
+        txns: Vec<Arc<Transaction>>,
+    ) -> Result<(), MempoolProtocolError> {
+        let results = self.mempool.insert_batch(txns).await?;
+        for (txn, stored_result) in results {
+            let excess_sig_hex = txn
+                .first_kernel_excess_sig()
+                .map(|sig| sig.get_signature().to_hex())
+                .unwrap_or_default();
+            if stored_result.is_stored() {
+                metrics::inbound_transactions(Some(&self.peer_node_id)).inc();
+                debug!(
+                    target: LOG_TARGET,
+                    "Inserted transaction `{}` from peer `{}`",
+                    excess_sig_hex,
+                    self.peer_node_id.short_str()
+                );
+            } else {
+                metrics::rejected_inbound_transactions(Some(&self.peer_node_id)).inc();
+                debug!(
+                    target: LOG_TARGET,
+                    "Did not store new transaction `{}` in mempool: {}", excess_sig_hex, stored_result
+                )
+            }
         }
 
         Ok(())
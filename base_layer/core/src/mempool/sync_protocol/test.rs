@@ -48,7 +48,13 @@ use crate::{
     consensus::ConsensusManager,
     mempool::{
         proto,
-        sync_protocol::{MempoolPeerProtocol, MempoolSyncProtocol, MAX_FRAME_SIZE, MEMPOOL_SYNC_PROTOCOL},
+        sync_protocol::{
+            MempoolPeerProtocol,
+            MempoolSyncProtocol,
+            MAX_FRAME_SIZE,
+            MEMPOOL_SYNC_PROTOCOL,
+            TRANSACTION_BATCH_SIZE,
+        },
         Mempool,
     },
     transactions::{tari_amount::uT, test_helpers::create_tx, transaction_components::Transaction},
@@ -171,6 +177,39 @@ async fn synchronise() {
     assert!(transactions2.iter().all(|txn| transactions.contains(txn)));
 }
 
+#[tokio::test]
+async fn synchronise_more_than_one_batch() {
+    let (_, connectivity_manager_state, mempool1, transactions1) = setup(TRANSACTION_BATCH_SIZE + 3).await;
+
+    let node1 = build_node_identity(PeerFeatures::COMMUNICATION_NODE);
+    let node2 = build_node_identity(PeerFeatures::COMMUNICATION_NODE);
+    let (_node1_conn, node1_mock, node2_conn, _) =
+        create_peer_connection_mock_pair(node1.to_peer(), node2.to_peer()).await;
+
+    // This node connected to a peer, so it should open the substream
+    connectivity_manager_state.publish_event(ConnectivityEvent::PeerConnected(node2_conn));
+
+    let substream = node1_mock.next_incoming_substream().await.unwrap();
+    let framed = framing::canonical(substream, MAX_FRAME_SIZE);
+
+    let (mempool2, transactions2) = new_mempool_with_transactions(2).await;
+    mempool2.insert(Arc::new(transactions1[0].clone())).await.unwrap();
+    MempoolPeerProtocol::new(Default::default(), framed, node2.node_id().clone(), mempool2.clone())
+        .start_responder()
+        .await
+        .unwrap();
+
+    let transactions = get_snapshot(&mempool2).await;
+    assert_eq!(transactions.len(), TRANSACTION_BATCH_SIZE + 5);
+    assert!(transactions1.iter().all(|txn| transactions.contains(txn)));
+    assert!(transactions2.iter().all(|txn| transactions.contains(txn)));
+
+    let transactions = get_snapshot(&mempool1).await;
+    assert_eq!(transactions.len(), TRANSACTION_BATCH_SIZE + 5);
+    assert!(transactions1.iter().all(|txn| transactions.contains(txn)));
+    assert!(transactions2.iter().all(|txn| transactions.contains(txn)));
+}
+
 #[tokio::test]
 async fn duplicate_set() {
     let (_, connectivity_manager_state, mempool1, transactions1) = setup(2).await;
@@ -124,7 +124,14 @@ impl MempoolServiceMock {
     }
 
     async fn handle_request(&self, req: MempoolRequest) -> Result<MempoolResponse, MempoolServiceError> {
-        use MempoolRequest::{GetFeePerGramStats, GetState, GetStats, GetTxStateByExcessSig, SubmitTransaction};
+        use MempoolRequest::{
+            GetFeePerGramStats,
+            GetState,
+            GetStats,
+            GetTxStateByExcessSig,
+            GetTxStateByExcessSigs,
+            SubmitTransaction,
+        };
 
         self.state.inc_call_count();
         match req {
@@ -133,6 +140,10 @@ impl MempoolServiceMock {
             GetTxStateByExcessSig(_) => Ok(MempoolResponse::TxStorage(
                 self.state.get_tx_state_by_excess_sig.lock().await.clone(),
             )),
+            GetTxStateByExcessSigs(sigs) => {
+                let state = self.state.get_tx_state_by_excess_sig.lock().await.clone();
+                Ok(MempoolResponse::TxStorages(vec![state; sigs.len()]))
+            },
             SubmitTransaction(_) => Ok(MempoolResponse::TxStorage(
                 self.state.submit_transaction.lock().await.clone(),
             )),
@@ -239,8 +239,8 @@ impl UnconfirmedPool {
         let mut remaining = Vec::new();
 
         for sig in excess_sigs {
-            match self.txs_by_signature.get(sig).cloned() {
-                Some(ids) => found.extend(ids),
+            match self.txs_by_signature.get(sig) {
+                Some(ids) => found.extend(ids.iter()),
                 None => remaining.push(sig.clone()),
             }
         }
@@ -249,7 +249,7 @@ impl UnconfirmedPool {
             .into_iter()
             .map(|id| {
                 self.tx_by_key
-                    .get(&id)
+                    .get(id)
                     .map(|tx| tx.transaction.clone())
                     .expect("mempool indexes out of sync: transaction exists in txs_by_signature but not in tx_by_key")
             })
@@ -515,9 +515,11 @@ impl UnconfirmedPool {
         self.txs_by_signature.len()
     }
 
-    /// Returns all transaction stored in the UnconfirmedPool.
+    /// Returns all transaction stored in the UnconfirmedPool, in the order they were inserted.
     pub fn snapshot(&self) -> Vec<Arc<Transaction>> {
-        self.tx_by_key.iter().map(|(_, ptx)| ptx.transaction.clone()).collect()
+        let mut keys = self.tx_by_key.keys().copied().collect::<Vec<_>>();
+        keys.sort_unstable();
+        keys.iter().map(|key| self.tx_by_key[key].transaction.clone()).collect()
     }
 
     /// Returns the total weight of all transactions stored in the pool.
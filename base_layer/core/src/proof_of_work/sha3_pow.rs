@@ -37,21 +37,23 @@ pub fn sha3x_difficulty(header: &BlockHeader) -> Difficulty {
     sha3x_difficulty_with_hash(header).0
 }
 
-pub fn sha3_hash(header: &BlockHeader) -> Vec<u8> {
+pub fn sha3_hash(header: &BlockHeader) -> [u8; 32] {
+    // The PoW is hashed field by field, which is equivalent to hashing `pow.to_bytes()` without allocating it
     Sha3_256::new()
         .chain(header.nonce.to_le_bytes())
         .chain(header.mining_hash())
-        .chain(header.pow.to_bytes())
+        .chain([header.pow.pow_algo as u8])
+        .chain(&header.pow.pow_data)
         .finalize()
-        .to_vec()
+        .into()
 }
 
-fn sha3x_difficulty_with_hash(header: &BlockHeader) -> (Difficulty, Vec<u8>) {
+fn sha3x_difficulty_with_hash(header: &BlockHeader) -> (Difficulty, [u8; 32]) {
     let hash = sha3_hash(header);
     let hash = Sha3_256::digest(&hash);
     let hash = Sha3_256::digest(&hash);
     let difficulty = big_endian_difficulty(&hash);
-    (difficulty, hash.to_vec())
+    (difficulty, hash.into())
 }
 
 #[cfg(test)]
@@ -36,6 +36,7 @@ use tari_common_types::{
 };
 use tari_storage::lmdb_store::LMDBConfig;
 use tari_test_utils::paths::create_temporary_data_path;
+use tari_utilities::epoch_time::EpochTime;
 
 use super::{create_block, mine_to_difficulty};
 use crate::{
@@ -52,6 +53,7 @@ use crate::{
     chain_storage::{
         create_lmdb_database,
         BlockAddResult,
+        BlockContents,
         BlockchainBackend,
         BlockchainDatabase,
         BlockchainDatabaseConfig,
@@ -251,6 +253,17 @@ impl BlockchainBackend for TempDatabase {
         self.db.as_ref().unwrap().fetch_header_containing_utxo_mmr(mmr_position)
     }
 
+    fn fetch_header_timestamps(&self, start_height: u64, end_height: u64) -> Result<Vec<EpochTime>, ChainStorageError> {
+        self.db
+            .as_ref()
+            .unwrap()
+            .fetch_header_timestamps(start_height, end_height)
+    }
+
+    fn fetch_height_at_time(&self, epoch_time: EpochTime) -> Result<u64, ChainStorageError> {
+        self.db.as_ref().unwrap().fetch_height_at_time(epoch_time)
+    }
+
     fn is_empty(&self) -> Result<bool, ChainStorageError> {
         self.db.as_ref().unwrap().is_empty()
     }
@@ -269,6 +282,22 @@ impl BlockchainBackend for TempDatabase {
         self.db.as_ref().unwrap().fetch_block_accumulated_data_by_height(height)
     }
 
+    fn for_each_block<F>(
+        &self,
+        start_height: u64,
+        end_height: u64,
+        with_spent_outputs: bool,
+        visitor: F,
+    ) -> Result<(), ChainStorageError>
+    where
+        F: FnMut(BlockContents) -> Result<bool, ChainStorageError>,
+    {
+        self.db
+            .as_ref()
+            .unwrap()
+            .for_each_block(start_height, end_height, with_spent_outputs, visitor)
+    }
+
     fn fetch_kernels_in_block(&self, header_hash: &HashOutput) -> Result<Vec<TransactionKernel>, ChainStorageError> {
         self.db.as_ref().unwrap().fetch_kernels_in_block(header_hash)
     }
@@ -287,6 +316,13 @@ impl BlockchainBackend for TempDatabase {
         self.db.as_ref().unwrap().fetch_kernel_by_excess_sig(excess_sig)
     }
 
+    fn fetch_kernels_by_excess_sigs(
+        &self,
+        excess_sigs: &[Signature],
+    ) -> Result<Vec<Option<(TransactionKernel, HashOutput)>>, ChainStorageError> {
+        self.db.as_ref().unwrap().fetch_kernels_by_excess_sigs(excess_sigs)
+    }
+
     fn fetch_utxos_in_block(
         &self,
         header_hash: &HashOutput,
@@ -309,6 +345,16 @@ impl BlockchainBackend for TempDatabase {
             .fetch_unspent_output_hash_by_commitment(commitment)
     }
 
+    fn fetch_unspent_outputs_by_commitments(
+        &self,
+        commitments: &[Commitment],
+    ) -> Result<Vec<Option<UtxoMinedInfo>>, ChainStorageError> {
+        self.db
+            .as_ref()
+            .unwrap()
+            .fetch_unspent_outputs_by_commitments(commitments)
+    }
+
     fn fetch_outputs_in_block(&self, header_hash: &HashOutput) -> Result<Vec<PrunedOutput>, ChainStorageError> {
         self.db.as_ref().unwrap().fetch_outputs_in_block(header_hash)
     }
@@ -232,7 +232,8 @@ impl AggregateBody {
         if self.sorted {
             return;
         }
-        self.inputs.sort();
+        // Inputs are ordered by the hash of the output they spend, so hash each input once rather than per comparison
+        self.inputs.sort_by_cached_key(TransactionInput::output_hash);
         self.outputs.sort();
         self.kernels.sort();
         self.sorted = true;
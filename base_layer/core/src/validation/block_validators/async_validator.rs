@@ -98,13 +98,7 @@ impl<B: BlockchainBackend + 'static> BlockValidator<B> {
         let min_height = block_header
             .height
             .saturating_sub(constants.get_median_timestamp_count() as u64);
-        let timestamps = self
-            .db
-            .fetch_headers(min_height..=height)
-            .await?
-            .iter()
-            .map(|h| h.timestamp)
-            .collect::<Vec<_>>();
+        let timestamps = self.db.fetch_header_timestamps(min_height, height).await?;
 
         check_header_timestamp_greater_than_median(block_header, &timestamps)?;
 
@@ -28,7 +28,7 @@ use super::LOG_TARGET;
 use crate::{
     blocks::{BlockHeader, ChainBlock},
     chain_storage,
-    chain_storage::{fetch_headers, BlockchainBackend},
+    chain_storage::BlockchainBackend,
     consensus::{ConsensusConstants, ConsensusManager},
     validation::{
         helpers::{self, check_header_timestamp_greater_than_median},
@@ -66,10 +66,7 @@ impl BodyOnlyValidator {
         let min_height = block_header
             .height
             .saturating_sub(constants.get_median_timestamp_count() as u64);
-        let timestamps = fetch_headers(db, min_height, height)?
-            .iter()
-            .map(|h| h.timestamp)
-            .collect::<Vec<_>>();
+        let timestamps = db.fetch_header_timestamps(min_height, height)?;
 
         check_header_timestamp_greater_than_median(block_header, &timestamps)?;
 
@@ -325,7 +325,13 @@ pub fn is_all_unique_and_sorted<'a, I: IntoIterator<Item = &'a T>, T: PartialOrd
 
 // This function checks for duplicate inputs and outputs. There should be no duplicate inputs or outputs in a block
 pub fn check_sorting_and_duplicates(body: &AggregateBody) -> Result<(), ValidationError> {
-    if !is_all_unique_and_sorted(body.inputs()) {
+    // Inputs are ordered by output hash, which is computed on every comparison. Hash each input once instead.
+    let input_hashes = body
+        .inputs()
+        .iter()
+        .map(TransactionInput::output_hash)
+        .collect::<Vec<_>>();
+    if !is_all_unique_and_sorted(&input_hashes) {
         return Err(ValidationError::UnsortedOrDuplicateInput);
     }
 
@@ -60,6 +60,12 @@ fn test_lmdb_insert_contains_delete_and_fetch_orphan() {
     txn.delete_orphan(hash);
     assert!(db.write(txn).is_ok());
     assert!(!db.contains(&DbKey::OrphanBlock(hash)).unwrap());
+
+    // The orphan indexes are removed along with the orphan, so it can be stored again
+    let mut txn = DbTransaction::new();
+    txn.insert_orphan(orphan.into());
+    assert!(db.write(txn).is_ok());
+    assert!(db.contains(&DbKey::OrphanBlock(hash)).unwrap());
 }
 
 #[test]
@@ -22,7 +22,7 @@
 
 use rand::{rngs::OsRng, RngCore};
 use tari_common::configuration::Network;
-use tari_common_types::types::BlockHash;
+use tari_common_types::types::{BlockHash, Commitment, Signature};
 use tari_core::{
     blocks::{genesis_block, Block, BlockHeader},
     chain_storage::{
@@ -213,6 +213,7 @@ fn test_rewind_to_height() {
         BlockAddResult::Ok(_b1) =
             generate_new_block(&mut db, &mut blocks, &mut outputs, schema, &consensus_manager).unwrap()
     );
+    let utxo_count_at_height_1 = db.utxo_count().unwrap();
     // Block 2
     let schema = vec![txn_schema!(from: vec![outputs[1][0].clone()], to: vec![3 * T, 1 * T])];
     unpack_enum!(
@@ -237,6 +238,8 @@ fn test_rewind_to_height() {
     assert_eq!(db.get_height().unwrap(), 3);
     db.rewind_to_height(1).unwrap();
     assert_eq!(db.get_height().unwrap(), 1);
+    // The outputs spent in the rewound blocks are unspent again
+    assert_eq!(db.utxo_count().unwrap(), utxo_count_at_height_1);
 }
 
 #[test]
@@ -1334,13 +1337,34 @@ fn test_store_and_retrieve_blocks_from_contents() {
     );
 
     assert_eq!(
-        db.fetch_block_with_utxo(utxo_commit)
+        db.fetch_block_with_utxo(utxo_commit.clone())
             .unwrap()
             .unwrap()
             .try_into_chain_block()
             .unwrap(),
         blocks[2]
     );
+
+    // Batched lookups return each block once, in height order, and skip unknown items
+    let headers = db
+        .fetch_chain_headers_with_kernels(vec![
+            blocks[2].block().body.kernels()[0].excess_sig.clone(),
+            Signature::default(),
+            kernel_sig.clone(),
+            kernel_sig,
+        ])
+        .unwrap();
+    assert_eq!(headers.iter().map(|h| h.hash()).collect::<Vec<_>>(), vec![
+        blocks[1].hash(),
+        blocks[2].hash()
+    ]);
+    let found = db
+        .fetch_blocks_with_utxos(vec![utxo_commit, Commitment::default()])
+        .unwrap()
+        .into_iter()
+        .map(|b| b.try_into_chain_block().unwrap())
+        .collect::<Vec<_>>();
+    assert_eq!(found, vec![blocks[2].clone()]);
 }
 
 #[test]
@@ -1978,6 +2002,100 @@ fn pruned_mode_cleanup_and_fetch_block() {
     assert_eq!(metadata.pruning_horizon(), 3);
 }
 
+#[test]
+fn pruned_mode_prunes_large_backlog_in_chunks() {
+    let network = Network::LocalNet;
+    let block0 = genesis_block::get_esmeralda_genesis_block();
+    let consensus_manager = ConsensusManagerBuilder::new(network).with_block(block0.clone()).build();
+    let validators = Validators::new(
+        MockValidator::new(true),
+        MockValidator::new(true),
+        MockValidator::new(true),
+    );
+    let db = create_test_db();
+    // The pruning interval is larger than the chain, so adding blocks never prunes
+    let config = BlockchainDatabaseConfig {
+        orphan_storage_capacity: 3,
+        pruning_horizon: 1,
+        pruning_interval: 500,
+        ..Default::default()
+    };
+    let store = BlockchainDatabase::new(
+        db,
+        consensus_manager.clone(),
+        validators,
+        config,
+        DifficultyCalculator::new(consensus_manager.clone(), Default::default()),
+    )
+    .unwrap();
+    let mut prev_block = block0;
+    for _ in 0..250 {
+        prev_block = append_block(&store, &prev_block, vec![], &consensus_manager, 1.into()).unwrap();
+    }
+    assert_eq!(store.get_chain_metadata().unwrap().pruned_height(), 0);
+
+    store.prune_if_needed().unwrap();
+    assert_eq!(store.get_chain_metadata().unwrap().pruned_height(), 0);
+
+    store.prune_to_height(230).unwrap();
+    let metadata = store.get_chain_metadata().unwrap();
+    assert_eq!(metadata.pruned_height(), 230);
+    assert_eq!(metadata.height_of_longest_chain(), 250);
+}
+
+#[test]
+fn prune_if_needed_works_off_a_backlog_larger_than_a_chunk() {
+    let network = Network::LocalNet;
+    let block0 = genesis_block::get_esmeralda_genesis_block();
+    let consensus_manager = ConsensusManagerBuilder::new(network).with_block(block0.clone()).build();
+    let validators = Validators::new(
+        MockValidator::new(true),
+        MockValidator::new(true),
+        MockValidator::new(true),
+    );
+    let temp_path = create_temporary_data_path();
+    // Build the chain as an archival node, so that nothing is pruned while blocks are added
+    {
+        let mut db = TempDatabase::from_path(&temp_path);
+        db.disable_delete_on_drop();
+        let store = BlockchainDatabase::new(
+            db,
+            consensus_manager.clone(),
+            validators.clone(),
+            BlockchainDatabaseConfig::default(),
+            DifficultyCalculator::new(consensus_manager.clone(), Default::default()),
+        )
+        .unwrap();
+        let mut prev_block = block0;
+        for _ in 0..250 {
+            prev_block = append_block(&store, &prev_block, vec![], &consensus_manager, 1.into()).unwrap();
+        }
+    }
+
+    // Reopening it as a pruned node leaves a backlog of 240 blocks, which is more than one pruning chunk
+    let config = BlockchainDatabaseConfig {
+        pruning_horizon: 10,
+        pruning_interval: 50,
+        ..Default::default()
+    };
+    let store = BlockchainDatabase::new(
+        TempDatabase::from_path(&temp_path),
+        consensus_manager.clone(),
+        validators,
+        config,
+        DifficultyCalculator::new(consensus_manager, Default::default()),
+    )
+    .unwrap();
+    let metadata = store.get_chain_metadata().unwrap();
+    assert_eq!(metadata.pruned_height(), 0);
+    assert_eq!(metadata.height_of_longest_chain(), 250);
+
+    store.prune_if_needed().unwrap();
+    let metadata = store.get_chain_metadata().unwrap();
+    assert_eq!(metadata.pruned_height(), 240);
+    assert_eq!(metadata.height_of_longest_chain(), 250);
+}
+
 mod malleability {
     use tari_common_types::types::{ComAndPubSignature, RangeProof};
     use tari_core::{
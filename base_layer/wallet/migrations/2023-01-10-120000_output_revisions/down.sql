@@ -0,0 +1,4 @@
+DROP TRIGGER outputs_revision_on_update;
+DROP TRIGGER outputs_revision_on_insert;
+DROP INDEX idx_outputs_revision;
+ALTER TABLE outputs DROP COLUMN revision;
@@ -0,0 +1,15 @@
+-- Every change to an exported output column bumps the row's revision so that clients can fetch only the outputs that
+-- changed since the last revision they have seen.
+ALTER TABLE outputs ADD revision BIGINT NOT NULL DEFAULT 0;
+UPDATE outputs SET revision = id;
+CREATE INDEX idx_outputs_revision ON outputs (revision);
+
+CREATE TRIGGER outputs_revision_on_insert AFTER INSERT ON outputs
+BEGIN
+    UPDATE outputs SET revision = (SELECT MAX(revision) FROM outputs) + 1 WHERE id = NEW.id;
+END;
+
+CREATE TRIGGER outputs_revision_on_update AFTER UPDATE OF commitment, value, status, mined_height, mined_timestamp ON outputs
+BEGIN
+    UPDATE outputs SET revision = (SELECT MAX(revision) FROM outputs) + 1 WHERE id = NEW.id;
+END;
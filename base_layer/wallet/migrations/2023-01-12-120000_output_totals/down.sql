@@ -0,0 +1,8 @@
+DROP INDEX idx_outputs_script_lock_height;
+DROP INDEX idx_outputs_maturity;
+DROP INDEX idx_outputs_status_value;
+DROP INDEX idx_outputs_spendable;
+DROP TRIGGER output_totals_on_delete;
+DROP TRIGGER output_totals_on_update;
+DROP TRIGGER output_totals_on_insert;
+DROP TABLE output_totals;
@@ -0,0 +1,36 @@
+-- Running totals of output values per status and source, kept up to date by triggers in the same transaction as the
+-- change to the outputs table so that balance queries do not have to aggregate the whole table.
+CREATE TABLE output_totals (
+    status  INTEGER NOT NULL,
+    source  INTEGER NOT NULL,
+    value   BIGINT  NOT NULL DEFAULT 0,
+    PRIMARY KEY (status, source)
+);
+
+INSERT INTO output_totals (status, source, value)
+    SELECT status, source, coalesce(sum(value), 0) FROM outputs GROUP BY status, source;
+
+CREATE TRIGGER output_totals_on_insert AFTER INSERT ON outputs
+BEGIN
+    INSERT OR IGNORE INTO output_totals (status, source, value) VALUES (NEW.status, NEW.source, 0);
+    UPDATE output_totals SET value = value + NEW.value WHERE status = NEW.status AND source = NEW.source;
+END;
+
+CREATE TRIGGER output_totals_on_update AFTER UPDATE OF status, source, value ON outputs
+BEGIN
+    UPDATE output_totals SET value = value - OLD.value WHERE status = OLD.status AND source = OLD.source;
+    INSERT OR IGNORE INTO output_totals (status, source, value) VALUES (NEW.status, NEW.source, 0);
+    UPDATE output_totals SET value = value + NEW.value WHERE status = NEW.status AND source = NEW.source;
+END;
+
+CREATE TRIGGER output_totals_on_delete AFTER DELETE ON outputs
+BEGIN
+    UPDATE output_totals SET value = value - OLD.value WHERE status = OLD.status AND source = OLD.source;
+END;
+
+-- Coin selection filters on status and orders by spending priority and value
+CREATE INDEX idx_outputs_spendable ON outputs (status, spending_priority DESC, value);
+CREATE INDEX idx_outputs_status_value ON outputs (status, value);
+-- Time locked balance
+CREATE INDEX idx_outputs_maturity ON outputs (maturity);
+CREATE INDEX idx_outputs_script_lock_height ON outputs (script_lock_height);
@@ -0,0 +1,3 @@
+DROP INDEX idx_outbound_transactions_timestamp;
+DROP INDEX idx_inbound_transactions_timestamp;
+DROP INDEX idx_completed_transactions_timestamp;
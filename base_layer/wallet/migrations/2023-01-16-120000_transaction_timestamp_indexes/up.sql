@@ -0,0 +1,4 @@
+-- Transaction summaries are paged newest first with a (timestamp, tx_id) keyset cursor
+CREATE INDEX idx_completed_transactions_timestamp ON completed_transactions (timestamp, tx_id);
+CREATE INDEX idx_inbound_transactions_timestamp ON inbound_transactions (timestamp, tx_id);
+CREATE INDEX idx_outbound_transactions_timestamp ON outbound_transactions (timestamp, tx_id);
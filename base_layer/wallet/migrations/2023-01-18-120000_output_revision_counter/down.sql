@@ -0,0 +1,16 @@
+DROP TRIGGER outputs_revision_on_delete;
+DROP TRIGGER outputs_revision_on_update;
+DROP TRIGGER outputs_revision_on_insert;
+
+CREATE TRIGGER outputs_revision_on_insert AFTER INSERT ON outputs
+BEGIN
+    UPDATE outputs SET revision = (SELECT MAX(revision) FROM outputs) + 1 WHERE id = NEW.id;
+END;
+
+CREATE TRIGGER outputs_revision_on_update AFTER UPDATE OF commitment, value, status, mined_height, mined_timestamp ON outputs
+BEGIN
+    UPDATE outputs SET revision = (SELECT MAX(revision) FROM outputs) + 1 WHERE id = NEW.id;
+END;
+
+DROP TABLE deleted_outputs;
+DROP TABLE output_revision;
@@ -0,0 +1,40 @@
+-- Output revisions are taken from a single row counter that only ever increases, so deleting the most recently changed
+-- output cannot cause its revision to be handed out again.
+CREATE TABLE output_revision (
+    id       INTEGER PRIMARY KEY CHECK (id = 0),
+    revision BIGINT  NOT NULL
+);
+INSERT INTO output_revision (id, revision) SELECT 0, coalesce(max(revision), 0) FROM outputs;
+
+-- Deleted outputs leave a tombstone carrying their last exported columns so that clients syncing by revision learn
+-- about the removal.
+CREATE TABLE deleted_outputs (
+    revision        BIGINT   PRIMARY KEY NOT NULL,
+    commitment      BLOB,
+    value           BIGINT   NOT NULL,
+    status          INTEGER  NOT NULL,
+    mined_height    BIGINT,
+    mined_timestamp DATETIME
+);
+
+DROP TRIGGER outputs_revision_on_insert;
+DROP TRIGGER outputs_revision_on_update;
+
+CREATE TRIGGER outputs_revision_on_insert AFTER INSERT ON outputs
+BEGIN
+    UPDATE output_revision SET revision = revision + 1;
+    UPDATE outputs SET revision = (SELECT revision FROM output_revision) WHERE id = NEW.id;
+END;
+
+CREATE TRIGGER outputs_revision_on_update AFTER UPDATE OF commitment, value, status, mined_height, mined_timestamp ON outputs
+BEGIN
+    UPDATE output_revision SET revision = revision + 1;
+    UPDATE outputs SET revision = (SELECT revision FROM output_revision) WHERE id = NEW.id;
+END;
+
+CREATE TRIGGER outputs_revision_on_delete AFTER DELETE ON outputs
+BEGIN
+    UPDATE output_revision SET revision = revision + 1;
+    INSERT INTO deleted_outputs (revision, commitment, value, status, mined_height, mined_timestamp)
+        SELECT revision, OLD.commitment, OLD.value, OLD.status, OLD.mined_height, OLD.mined_timestamp FROM output_revision;
+END;
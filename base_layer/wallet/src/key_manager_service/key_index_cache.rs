@@ -0,0 +1,127 @@
+//  Copyright 2022, The Tari Project
+//
+//  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+//  following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+//  disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+//  following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+//  products derived from this software without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+//  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+//  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+//  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+//  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+use std::collections::HashMap;
+
+use rayon::prelude::*;
+use tari_common_types::types::PrivateKey;
+use tari_key_manager::key_manager::KeyManager;
+use tari_utilities::{ByteArray, ByteArrayError};
+
+use crate::types::KeyDigest;
+
+/// Number of keys that are derived in parallel each time the cache is extended
+const KEY_INDEX_CACHE_CHUNK_SIZE: u64 = 4096;
+
+/// Maps the keys of a single key manager branch to their index. The cache is rebuilt lazily: keys are only derived,
+/// in parallel chunks, when a lookup misses, so each index is derived at most once for the lifetime of the service.
+///
+/// Only a 64 bit fingerprint of each key is kept, so a hit is confirmed by deriving the key at the cached index.
+#[derive(Default)]
+pub(crate) struct KeyIndexCache {
+    indices: HashMap<u64, u64>,
+    derived_up_to: u64,
+}
+
+impl KeyIndexCache {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// The number of indices, starting at 0, that have been derived into the cache
+    pub fn derived_up_to(&self) -> u64 {
+        self.derived_up_to
+    }
+
+    /// Returns the lowest index below `search_depth` that `km` derives `key` at, extending the cache as required
+    pub fn find(
+        &mut self,
+        km: &KeyManager<PrivateKey, KeyDigest>,
+        key: &PrivateKey,
+        search_depth: u64,
+    ) -> Result<Option<u64>, ByteArrayError> {
+        let fingerprint = Self::fingerprint(key);
+        if let Some(index) = self.indices.get(&fingerprint).copied() {
+            if km.derive_key(index)?.k == *key {
+                // Only the first index a fingerprint is seen at is kept, so no lower index derives `key`
+                return Ok(Some(index).filter(|i| *i < search_depth));
+            }
+            // Two keys share a fingerprint, which is too unlikely to be worth indexing
+            return Self::search(km, key, 0, search_depth);
+        }
+
+        while self.derived_up_to < search_depth {
+            let start = self.derived_up_to;
+            let end = (start + KEY_INDEX_CACHE_CHUNK_SIZE).min(search_depth);
+            let keys = Self::derive_keys(km, start, end)?;
+            self.derived_up_to = end;
+
+            let mut found = None;
+            for (index, k) in (start..end).zip(keys) {
+                self.indices.entry(Self::fingerprint(&k)).or_insert(index);
+                if found.is_none() && k == *key {
+                    found = Some(index);
+                }
+            }
+            if found.is_some() {
+                return Ok(found);
+            }
+        }
+
+        Ok(None)
+    }
+
+    fn search(
+        km: &KeyManager<PrivateKey, KeyDigest>,
+        key: &PrivateKey,
+        start: u64,
+        end: u64,
+    ) -> Result<Option<u64>, ByteArrayError> {
+        let mut chunk_start = start;
+        while chunk_start < end {
+            let chunk_end = (chunk_start + KEY_INDEX_CACHE_CHUNK_SIZE).min(end);
+            let keys = Self::derive_keys(km, chunk_start, chunk_end)?;
+            if let Some(offset) = keys.iter().position(|k| k == key) {
+                return Ok(Some(chunk_start + offset as u64));
+            }
+            chunk_start = chunk_end;
+        }
+        Ok(None)
+    }
+
+    fn derive_keys(
+        km: &KeyManager<PrivateKey, KeyDigest>,
+        start: u64,
+        end: u64,
+    ) -> Result<Vec<PrivateKey>, ByteArrayError> {
+        (start..end)
+            .into_par_iter()
+            .map(|i| km.derive_key(i).map(|derived| derived.k))
+            .collect()
+    }
+
+    fn fingerprint(key: &PrivateKey) -> u64 {
+        let mut buf = [0u8; 8];
+        buf.copy_from_slice(&key.as_bytes()[..8]);
+        u64::from_le_bytes(buf)
+    }
+}
@@ -29,6 +29,8 @@ pub use handle::KeyManagerHandle;
 mod initializer;
 pub use initializer::KeyManagerInitializer;
 
+mod key_index_cache;
+
 mod service;
 pub use service::KeyManagerInner;
 
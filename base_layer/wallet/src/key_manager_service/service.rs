@@ -34,12 +34,14 @@ use std::collections::HashMap;
 use crate::key_manager_service::{
     error::KeyManagerServiceError,
     interface::NextKeyResult,
+    key_index_cache::KeyIndexCache,
     storage::database::{KeyManagerBackend, KeyManagerDatabase, KeyManagerState},
     AddResult,
 };
 
 pub struct KeyManagerInner<TBackend> {
     key_managers: HashMap<String, Mutex<KeyManager<PrivateKey, KeyDigest>>>,
+    key_index_caches: HashMap<String, Mutex<KeyIndexCache>>,
     db: KeyManagerDatabase<TBackend>,
     master_seed: CipherSeed,
 }
@@ -50,6 +52,7 @@ where TBackend: KeyManagerBackend + 'static
     pub fn new(master_seed: CipherSeed, db: KeyManagerDatabase<TBackend>) -> Self {
         KeyManagerInner {
             key_managers: HashMap::new(),
+            key_index_caches: HashMap::new(),
             db,
             master_seed,
         }
@@ -72,6 +75,10 @@ where TBackend: KeyManagerBackend + 'static
             },
             Some(km) => km,
         };
+        // The derived keys only depend on the master seed and the branch, so an existing cache stays valid
+        self.key_index_caches
+            .entry(branch.clone())
+            .or_insert_with(|| Mutex::new(KeyIndexCache::new()));
         self.key_managers.insert(
             branch,
             Mutex::new(KeyManager::<PrivateKey, KeyDigest>::from(
@@ -109,25 +116,33 @@ where TBackend: KeyManagerBackend + 'static
         Ok(key.k)
     }
 
-    /// Search the specified branch key manager key chain to find the index of the specified key.
+    /// Search the specified branch key manager key chain to find the index of the specified key. Keys derived during
+    /// the search are cached per branch, so subsequent searches only derive keys past the furthest index searched so
+    /// far.
     pub async fn find_key_index(&self, branch: String, key: &PrivateKey) -> Result<u64, KeyManagerServiceError> {
+        // Only hold the key manager lock long enough to take a copy, so that new keys can be issued during the search
         let km = self
             .key_managers
             .get(&branch)
             .ok_or(KeyManagerServiceError::UnknownKeyBranch)?
             .lock()
+            .await
+            .clone();
+        let mut cache = self
+            .key_index_caches
+            .get(&branch)
+            .ok_or(KeyManagerServiceError::UnknownKeyBranch)?
+            .lock()
             .await;
 
-        let current_index = km.key_index();
-
-        for i in 0u64..current_index + KEY_MANAGER_MAX_SEARCH_DEPTH {
-            if km.derive_key(i)?.k == *key {
+        let search_depth = km.key_index() + KEY_MANAGER_MAX_SEARCH_DEPTH;
+        match cache.find(&km, key, search_depth)? {
+            Some(i) => {
                 trace!(target: LOG_TARGET, "Key found in {} Key Chain at index {}", branch, i);
-                return Ok(i);
-            }
+                Ok(i)
+            },
+            None => Err(KeyManagerServiceError::KeyNotFoundInKeyChain),
         }
-
-        Err(KeyManagerServiceError::KeyNotFoundInKeyChain)
     }
 
     /// If the supplied index is higher than the current UTXO key chain indices then they will be updated.
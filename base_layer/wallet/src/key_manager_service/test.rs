@@ -20,9 +20,13 @@
 //  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
 //  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-use tari_key_manager::cipher_seed::CipherSeed;
+use tari_common_types::types::PrivateKey;
+use tari_key_manager::{cipher_seed::CipherSeed, key_manager::KeyManager};
 
-use crate::key_manager_service::KeyManagerMock;
+use crate::{
+    key_manager_service::{key_index_cache::KeyIndexCache, KeyManagerMock},
+    types::KeyDigest,
+};
 
 #[tokio::test]
 async fn get_next_key_test_mock() {
@@ -71,3 +75,27 @@ async fn get_key_at_test_mock() {
     assert_ne!(key_2.key, key_1.key);
     assert_eq!(key_1.key, key_1_2);
 }
+
+#[test]
+fn key_index_cache_test() {
+    let km = KeyManager::<PrivateKey, KeyDigest>::from(CipherSeed::new(), "test_branch".to_string(), 0);
+    let other_km = KeyManager::<PrivateKey, KeyDigest>::from(CipherSeed::new(), "test_branch".to_string(), 0);
+    let mut cache = KeyIndexCache::new();
+
+    let key_5000 = km.derive_key(5000).unwrap().k;
+    assert_eq!(cache.find(&km, &key_5000, 10_000).unwrap(), Some(5000));
+    let derived_up_to = cache.derived_up_to();
+    assert!(derived_up_to > 5000 && derived_up_to <= 10_000);
+
+    // Keys below the furthest derived index are answered from the cache
+    let key_7 = km.derive_key(7).unwrap().k;
+    assert_eq!(cache.find(&km, &key_7, 10_000).unwrap(), Some(7));
+    assert_eq!(cache.derived_up_to(), derived_up_to);
+
+    // The search depth is respected even when the index is cached
+    assert_eq!(cache.find(&km, &key_5000, 5000).unwrap(), None);
+
+    let unknown_key = other_km.derive_key(1).unwrap().k;
+    assert_eq!(cache.find(&km, &unknown_key, 10_000).unwrap(), None);
+    assert_eq!(cache.derived_up_to(), 10_000);
+}
@@ -24,6 +24,7 @@ use std::time::Instant;
 
 use log::*;
 use rand::rngs::OsRng;
+use rayon::prelude::*;
 use tari_common_types::{
     transaction::TxId,
     types::{BulletRangeProof, PrivateKey, PublicKey},
@@ -47,7 +48,7 @@ use crate::{
         resources::OutputManagerKeyManagerBranch,
         storage::{
             database::{OutputManagerBackend, OutputManagerDatabase},
-            models::DbUnblindedOutput,
+            models::{DbUnblindedOutput, KnownOneSidedPaymentScript},
             OutputSource,
         },
     },
@@ -92,49 +93,16 @@ where
 
         let known_scripts = self.db.get_all_known_one_sided_payment_scripts()?;
 
-        let mut rewound_outputs: Vec<(UnblindedOutput, BulletRangeProof)> = Vec::new();
-        for output in outputs {
-            let known_script_index = known_scripts.iter().position(|s| s.script == output.script);
-            if output.script != script!(Nop) && known_script_index.is_none() {
-                continue;
-            }
-            let committed_value = EncryptedValue::decrypt_value(
-                &self.rewind_data.encryption_key,
-                &output.commitment,
-                &output.encrypted_value,
-            );
-            if let Ok(committed_value) = committed_value {
-                let blinding_factor =
-                    output.recover_mask(&self.factories.range_proof, &self.rewind_data.rewind_blinding_key)?;
-                if output.verify_mask(&self.factories.range_proof, &blinding_factor, committed_value.into())? {
-                    let (input_data, script_key) = if let Some(index) = known_script_index {
-                        (
-                            known_scripts[index].input.clone(),
-                            known_scripts[index].private_key.clone(),
-                        )
-                    } else {
-                        let key = PrivateKey::random(&mut OsRng);
-                        (inputs!(PublicKey::from_secret_key(&key)), key)
-                    };
-                    let uo = UnblindedOutput::new(
-                        output.version,
-                        committed_value,
-                        blinding_factor,
-                        output.features,
-                        output.script,
-                        input_data,
-                        script_key,
-                        output.sender_offset_public_key,
-                        output.metadata_signature,
-                        0,
-                        output.covenant,
-                        output.encrypted_value,
-                        output.minimum_value_promise,
-                    );
-                    rewound_outputs.push((uo, output.proof));
-                }
-            }
-        }
+        // Rewinding is independent per output, so the outputs are rewound in parallel
+        let rewind_data = &self.rewind_data;
+        let factories = &self.factories;
+        let mut rewound_outputs = outputs
+            .into_par_iter()
+            .map(|output| Self::rewind_output(output, &known_scripts, rewind_data, factories))
+            .collect::<Result<Vec<_>, _>>()?
+            .into_iter()
+            .flatten()
+            .collect::<Vec<_>>();
 
         let rewind_time = start.elapsed();
         trace!(
@@ -191,6 +159,56 @@ where
         Ok(rewound_outputs_with_tx_id)
     }
 
+    /// Attempt to rewind a single output, returning None if it does not belong to this wallet
+    fn rewind_output(
+        output: TransactionOutput,
+        known_scripts: &[KnownOneSidedPaymentScript],
+        rewind_data: &RewindData,
+        factories: &CryptoFactories,
+    ) -> Result<Option<(UnblindedOutput, BulletRangeProof)>, OutputManagerError> {
+        let known_script_index = known_scripts.iter().position(|s| s.script == output.script);
+        if output.script != script!(Nop) && known_script_index.is_none() {
+            return Ok(None);
+        }
+        let committed_value = match EncryptedValue::decrypt_value(
+            &rewind_data.encryption_key,
+            &output.commitment,
+            &output.encrypted_value,
+        ) {
+            Ok(committed_value) => committed_value,
+            Err(_) => return Ok(None),
+        };
+        let blinding_factor = output.recover_mask(&factories.range_proof, &rewind_data.rewind_blinding_key)?;
+        if !output.verify_mask(&factories.range_proof, &blinding_factor, committed_value.into())? {
+            return Ok(None);
+        }
+        let (input_data, script_key) = if let Some(index) = known_script_index {
+            (
+                known_scripts[index].input.clone(),
+                known_scripts[index].private_key.clone(),
+            )
+        } else {
+            let key = PrivateKey::random(&mut OsRng);
+            (inputs!(PublicKey::from_secret_key(&key)), key)
+        };
+        let uo = UnblindedOutput::new(
+            output.version,
+            committed_value,
+            blinding_factor,
+            output.features,
+            output.script,
+            input_data,
+            script_key,
+            output.sender_offset_public_key,
+            output.metadata_signature,
+            0,
+            output.covenant,
+            output.encrypted_value,
+            output.minimum_value_promise,
+        );
+        Ok(Some((uo, output.proof)))
+    }
+
     /// Find the key manager index that corresponds to the spending key in the rewound output, if found then modify
     /// output to contain correct associated script private key and update the key manager to the highest index it has
     /// seen so far.
@@ -20,13 +20,14 @@
 // WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
 // USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-use std::{convert::TryInto, fmt, sync::Arc};
+use std::{collections::HashMap, convert::TryInto, fmt, sync::Arc};
 
 use diesel::result::{DatabaseErrorKind, Error as DieselError};
 use futures::{pin_mut, StreamExt};
 use itertools::Itertools;
 use log::*;
 use rand::{rngs::OsRng, RngCore};
+use rayon::prelude::*;
 use strum::IntoEnumIterator;
 use tari_common_types::{
     transaction::TxId,
@@ -95,7 +96,7 @@ use crate::{
             OutputSource,
             OutputStatus,
         },
-        tasks::TxoValidationTask,
+        tasks::{TxoValidationCheckpoint, TxoValidationTask},
     },
     types::WalletHasher,
     WalletOutputEncryptionKeysDomainHasher,
@@ -115,7 +116,11 @@ pub struct OutputManagerService<TBackend, TWalletConnectivity, TKeyManagerInterf
     base_node_service: BaseNodeServiceHandle,
     last_seen_tip_height: Option<u64>,
     node_identity: Arc<NodeIdentity>,
-    validation_in_progress: Arc<Mutex<()>>,
+    /// Held while a TXO validation runs and guards the tip the last successful validation ran against
+    validation_in_progress: Arc<Mutex<Option<TxoValidationCheckpoint>>>,
+    /// Known one-sided payment scripts keyed by the public key of their private key. Loaded from the database on the
+    /// first scan and kept up to date by `add_known_script`.
+    known_one_sided_scripts: Option<HashMap<PublicKey, KnownOneSidedPaymentScript>>,
 }
 
 impl<TBackend, TWalletConnectivity, TKeyManagerInterface>
@@ -171,7 +176,8 @@ where
             base_node_service,
             last_seen_tip_height: None,
             node_identity,
-            validation_in_progress: Arc::new(Mutex::new(())),
+            validation_in_progress: Arc::new(Mutex::new(None)),
+            known_one_sided_scripts: None,
         })
     }
 
@@ -550,7 +556,7 @@ where
         let validation_in_progress = self.validation_in_progress.clone();
         tokio::spawn(async move {
             // Note: We do not want the validation task to be queued
-            let mut _lock = match validation_in_progress.try_lock() {
+            let mut last_validated_tip = match validation_in_progress.try_lock() {
                 Ok(val) => val,
                 _ => {
                     if let Err(e) = event_publisher.send(Arc::new(OutputManagerEvent::TxoValidationAlreadyBusy(id))) {
@@ -567,7 +573,7 @@ where
                 },
             };
 
-            let exec_fut = txo_validation.execute();
+            let exec_fut = txo_validation.execute(&mut last_validated_tip);
             tokio::pin!(exec_fut);
             loop {
                 tokio::select! {
@@ -2499,8 +2505,9 @@ where
     /// to look for when scanning for one-sided payments
     fn add_known_script(&mut self, known_script: KnownOneSidedPaymentScript) -> Result<(), OutputManagerError> {
         debug!(target: LOG_TARGET, "Adding new script to output manager service");
+        let public_key = PublicKey::from_secret_key(&known_script.private_key);
         // It is not a problem if the script has already been persisted
-        match self.resources.db.add_known_script(known_script) {
+        match self.resources.db.add_known_script(known_script.clone()) {
             Ok(_) => (),
             Err(OutputManagerStorageError::DieselError(DieselError::DatabaseError(
                 DatabaseErrorKind::UniqueViolation,
@@ -2513,47 +2520,54 @@ where
             },
             Err(e) => return Err(e.into()),
         }
+        if let Some(scripts) = self.known_one_sided_scripts.as_mut() {
+            scripts.entry(public_key).or_insert(known_script);
+        }
         Ok(())
     }
 
+    /// Returns the known one-sided payment scripts keyed by public key, loading them from the database if this is the
+    /// first time they are needed
+    fn known_one_sided_scripts(
+        &mut self,
+    ) -> Result<&HashMap<PublicKey, KnownOneSidedPaymentScript>, OutputManagerError> {
+        let scripts = match self.known_one_sided_scripts.take() {
+            Some(scripts) => scripts,
+            None => self
+                .resources
+                .db
+                .get_all_known_one_sided_payment_scripts()?
+                .into_iter()
+                .map(|s| (PublicKey::from_secret_key(&s.private_key), s))
+                .collect(),
+        };
+        Ok(self.known_one_sided_scripts.insert(scripts))
+    }
+
     // Scanning outputs addressed to this wallet
     fn scan_outputs_for_one_sided_payments(
         &mut self,
         outputs: Vec<TransactionOutput>,
     ) -> Result<Vec<RecoveredOutput>, OutputManagerError> {
+        let wallet_sk = self.node_identity.secret_key().clone();
+        let wallet_pk = self.node_identity.public_key().clone();
         // TODO: use MultiKey
         // NOTE: known keys is a list consisting of an actual and deprecated wallet keys
-        let known_keys = self.resources.db.get_all_known_one_sided_payment_scripts()?;
-
-        let wallet_sk = self.node_identity.secret_key().clone();
-        let wallet_pk = self.node_identity.public_key();
-
-        let mut scanned_outputs = vec![];
+        let known_keys = self.known_one_sided_scripts()?;
 
-        for output in outputs {
-            match output.script.as_slice() {
+        // The stealth checks need a DH exchange and a hash per output, so the outputs are checked in parallel. The
+        // order of the outputs is preserved.
+        let scanned_outputs = outputs
+            .into_par_iter()
+            .filter_map(|output| match output.script.as_slice() {
                 // ----------------------------------------------------------------------------
                 // simple one-sided address
                 [Opcode::PushPubKey(scanned_pk)] => {
-                    match known_keys
-                        .iter()
-                        .find(|x| &PublicKey::from_secret_key(&x.private_key) == scanned_pk.as_ref())
-                    {
-                        // none of the keys match, skipping
-                        None => continue,
-
-                        // match found
-                        Some(matched_key) => {
-                            let shared_secret =
-                                CommsDHKE::new(&matched_key.private_key, &output.sender_offset_public_key);
-                            scanned_outputs.push((
-                                output.clone(),
-                                OutputSource::OneSided,
-                                matched_key.private_key.clone(),
-                                shared_secret,
-                            ));
-                        },
-                    }
+                    // none of the keys match, skipping
+                    let matched_key = known_keys.get(scanned_pk.as_ref())?;
+                    let shared_secret = CommsDHKE::new(&matched_key.private_key, &output.sender_offset_public_key);
+                    let script_private_key = matched_key.private_key.clone();
+                    Some((output, OutputSource::OneSided, script_private_key, shared_secret))
                 },
 
                 // ----------------------------------------------------------------------------
@@ -2571,22 +2585,22 @@ where
                     .unwrap();
 
                     // matching spending (public) keys
-                    if &(PublicKey::from_secret_key(&stealth_address_offset) + wallet_pk) != scanned_pk.as_ref() {
-                        continue;
+                    if &(PublicKey::from_secret_key(&stealth_address_offset) + &wallet_pk) != scanned_pk.as_ref() {
+                        return None;
                     }
 
                     let shared_secret = CommsDHKE::new(&wallet_sk, &output.sender_offset_public_key);
-                    scanned_outputs.push((
-                        output.clone(),
+                    Some((
+                        output,
                         OutputSource::StealthOneSided,
                         wallet_sk.clone() + stealth_address_offset,
                         shared_secret,
-                    ));
+                    ))
                 },
 
-                _ => {},
-            }
-        }
+                _ => None,
+            })
+            .collect::<Vec<_>>();
 
         self.import_onesided_outputs(scanned_outputs)
     }
@@ -13,7 +13,7 @@ use crate::output_manager_service::{
     service::Balance,
     storage::{
         database::{DbKey, DbValue, OutputBackendQuery, WriteOperation},
-        models::DbUnblindedOutput,
+        models::{DbUnblindedOutput, OutputSummary, OutputValidationUpdate},
     },
 };
 
@@ -61,6 +61,9 @@ pub trait OutputManagerBackend: Send + Sync + Clone {
     ) -> Result<(), OutputManagerStorageError>;
 
     fn mark_output_as_unspent(&self, hash: FixedHash) -> Result<(), OutputManagerStorageError>;
+    /// Applies the updates found by one round of output validation. The updates share group commits instead of each
+    /// waiting for its own, and an update fails on its own if its output is not found.
+    fn apply_validation_updates(&self, updates: Vec<OutputValidationUpdate>) -> Result<(), OutputManagerStorageError>;
     /// This method encumbers the specified outputs into a `PendingTransactionOutputs` record. This is a short term
     /// encumberance in case the app is closed or crashes before transaction neogtiation is complete. These will be
     /// cleared on startup of the service.
@@ -89,6 +92,8 @@ pub trait OutputManagerBackend: Send + Sync + Clone {
     fn get_last_mined_output(&self) -> Result<Option<DbUnblindedOutput>, OutputManagerStorageError>;
     /// Get the output that was most recently spent, ordered descending by mined height
     fn get_last_spent_output(&self) -> Result<Option<DbUnblindedOutput>, OutputManagerStorageError>;
+    /// Get the distinct heights and hashes of the blocks that outputs were mined or spent in, ordered by height
+    fn fetch_block_checkpoints(&self) -> Result<Vec<(u64, FixedHash)>, OutputManagerStorageError>;
     /// Set if a coinbase output is abandoned or not
     fn set_coinbase_abandoned(&self, tx_id: TxId, abandoned: bool) -> Result<(), OutputManagerStorageError>;
     /// Reinstate a cancelled inbound output
@@ -105,4 +110,13 @@ pub trait OutputManagerBackend: Send + Sync + Clone {
     ) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError>;
     fn fetch_outputs_by_tx_id(&self, tx_id: TxId) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError>;
     fn fetch_outputs_by(&self, q: OutputBackendQuery) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError>;
+    /// Retrieve the unencrypted summaries of up to `limit` outputs that changed or were deleted after `revision`,
+    /// ordered by revision
+    fn fetch_output_summaries_changed_since(
+        &self,
+        revision: u64,
+        limit: usize,
+    ) -> Result<Vec<OutputSummary>, OutputManagerStorageError>;
+    /// Discard the tombstones of outputs deleted at or before `revision`, returning the number discarded
+    fn prune_deleted_output_summaries(&self, revision: u64) -> Result<usize, OutputManagerStorageError>;
 }
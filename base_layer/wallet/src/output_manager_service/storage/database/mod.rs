@@ -30,7 +30,7 @@ pub use backend::OutputManagerBackend;
 use log::*;
 use tari_common_types::{
     transaction::TxId,
-    types::{BlindingFactor, Commitment, HashOutput},
+    types::{BlindingFactor, Commitment, FixedHash, HashOutput},
 };
 use tari_core::transactions::{
     tari_amount::MicroTari,
@@ -43,7 +43,7 @@ use crate::output_manager_service::{
     input_selection::UtxoSelectionCriteria,
     service::Balance,
     storage::{
-        models::{DbUnblindedOutput, KnownOneSidedPaymentScript},
+        models::{DbUnblindedOutput, KnownOneSidedPaymentScript, OutputSummary, OutputValidationUpdate},
         OutputStatus,
     },
 };
@@ -366,6 +366,10 @@ where T: OutputManagerBackend + 'static
         self.db.get_last_spent_output()
     }
 
+    pub fn fetch_block_checkpoints(&self) -> Result<Vec<(u64, FixedHash)>, OutputManagerStorageError> {
+        self.db.fetch_block_checkpoints()
+    }
+
     pub fn add_known_script(&self, known_script: KnownOneSidedPaymentScript) -> Result<(), OutputManagerStorageError> {
         self.db
             .write(WriteOperation::Insert(DbKeyValuePair::KnownOneSidedPaymentScripts(
@@ -445,6 +449,16 @@ where T: OutputManagerBackend + 'static
         Ok(())
     }
 
+    pub fn apply_validation_updates(
+        &self,
+        updates: Vec<OutputValidationUpdate>,
+    ) -> Result<(), OutputManagerStorageError> {
+        if updates.is_empty() {
+            return Ok(());
+        }
+        self.db.apply_validation_updates(updates)
+    }
+
     pub fn set_coinbase_abandoned(&self, tx_id: TxId, abandoned: bool) -> Result<(), OutputManagerStorageError> {
         let db = self.db.clone();
         db.set_coinbase_abandoned(tx_id, abandoned)?;
@@ -459,6 +473,18 @@ where T: OutputManagerBackend + 'static
     pub fn fetch_outputs_by(&self, q: OutputBackendQuery) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError> {
         self.db.fetch_outputs_by(q)
     }
+
+    pub fn fetch_output_summaries_changed_since(
+        &self,
+        revision: u64,
+        limit: usize,
+    ) -> Result<Vec<OutputSummary>, OutputManagerStorageError> {
+        self.db.fetch_output_summaries_changed_since(revision, limit)
+    }
+
+    pub fn prune_deleted_output_summaries(&self, revision: u64) -> Result<usize, OutputManagerStorageError> {
+        self.db.prune_deleted_output_summaries(revision)
+    }
 }
 
 fn unexpected_result<T>(req: DbKey, res: DbValue) -> Result<T, OutputManagerStorageError> {
@@ -26,6 +26,7 @@ use chrono::NaiveDateTime;
 use derivative::Derivative;
 use tari_common_types::types::{BlockHash, BulletRangeProof, Commitment, HashOutput, PrivateKey};
 use tari_core::transactions::{
+    tari_amount::MicroTari,
     transaction_components::UnblindedOutput,
     transaction_protocol::RewindData,
     CryptoFactories,
@@ -129,6 +130,49 @@ impl Ord for DbUnblindedOutput {
 
 impl Eq for DbUnblindedOutput {}
 
+/// The unencrypted columns of a stored output, used for bulk exports that do not need to decrypt the full output.
+/// `revision` increases every time one of these columns changes or the output is deleted. A `deleted` summary carries
+/// the last exported columns of an output that has been removed from the wallet.
+#[derive(Debug, Clone, PartialEq)]
+pub struct OutputSummary {
+    pub commitment: Option<Vec<u8>>,
+    pub value: MicroTari,
+    pub status: OutputStatus,
+    pub mined_height: Option<u64>,
+    pub mined_timestamp: Option<NaiveDateTime>,
+    pub revision: u64,
+    pub deleted: bool,
+}
+
+/// A change to the chain state of an output found while validating it against a base node
+#[derive(Debug, Clone, PartialEq)]
+pub enum OutputValidationUpdate {
+    Mined {
+        hash: HashOutput,
+        mined_height: u64,
+        mined_in_block: BlockHash,
+        mmr_position: u64,
+        confirmed: bool,
+        mined_timestamp: u64,
+    },
+    UnminedAndInvalid {
+        hash: HashOutput,
+    },
+    /// The output was not found, it is checked again once it is due for revalidation
+    Validated {
+        hash: HashOutput,
+    },
+    Spent {
+        hash: HashOutput,
+        deleted_height: u64,
+        deleted_in_block: BlockHash,
+        confirmed: bool,
+    },
+    Unspent {
+        hash: HashOutput,
+    },
+}
+
 #[derive(Debug, Clone)]
 pub enum SpendingPriority {
     Normal,
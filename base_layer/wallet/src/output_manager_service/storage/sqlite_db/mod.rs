@@ -36,7 +36,7 @@ use diesel::{
 };
 use log::*;
 pub use new_output_sql::NewOutputSql;
-pub use output_sql::OutputSql;
+pub use output_sql::{OutputSql, OutputSummarySql};
 use tari_common_types::{
     transaction::TxId,
     types::{Commitment, FixedHash, PrivateKey},
@@ -54,13 +54,13 @@ use crate::{
         service::Balance,
         storage::{
             database::{DbKey, DbKeyValuePair, DbValue, OutputBackendQuery, OutputManagerBackend, WriteOperation},
-            models::{DbUnblindedOutput, KnownOneSidedPaymentScript},
+            models::{DbUnblindedOutput, KnownOneSidedPaymentScript, OutputSummary, OutputValidationUpdate},
             OutputStatus,
         },
         UtxoSelectionCriteria,
     },
     schema::{known_one_sided_payment_scripts, outputs},
-    storage::sqlite_utilities::wallet_db_connection::WalletDbConnection,
+    storage::sqlite_utilities::{wallet_db_connection::WalletDbConnection, write_batcher::PendingWrite},
     util::{
         diesel_ext::ExpectedRowsExtension,
         encryption::{decrypt_bytes_integral_nonce, encrypt_bytes_integral_nonce, Encryptable},
@@ -185,56 +185,36 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
             },
             DbKey::OutputsByTxIdAndStatus(tx_id, status) => {
                 let outputs = OutputSql::find_by_tx_id_and_status(*tx_id, *status, &conn)?;
+                let outputs = OutputSql::to_db_unblinded_outputs(outputs, &cipher)?;
 
-                Some(DbValue::AnyOutputs(
-                    outputs
-                        .iter()
-                        .map(|o| o.clone().to_db_unblinded_output(&cipher))
-                        .collect::<Result<Vec<_>, _>>()?,
-                ))
+                Some(DbValue::AnyOutputs(outputs))
             },
             DbKey::UnspentOutputs => {
                 let outputs = OutputSql::index_status(
                     vec![OutputStatus::Unspent, OutputStatus::UnspentMinedUnconfirmed],
                     &conn,
                 )?;
+                let outputs = OutputSql::to_db_unblinded_outputs(outputs, &cipher)?;
 
-                Some(DbValue::UnspentOutputs(
-                    outputs
-                        .iter()
-                        .map(|o| o.clone().to_db_unblinded_output(&cipher))
-                        .collect::<Result<Vec<_>, _>>()?,
-                ))
+                Some(DbValue::UnspentOutputs(outputs))
             },
             DbKey::SpentOutputs => {
                 let outputs = OutputSql::index_status(vec![OutputStatus::Spent], &conn)?;
+                let outputs = OutputSql::to_db_unblinded_outputs(outputs, &cipher)?;
 
-                Some(DbValue::SpentOutputs(
-                    outputs
-                        .iter()
-                        .map(|o| o.clone().to_db_unblinded_output(&cipher))
-                        .collect::<Result<Vec<_>, _>>()?,
-                ))
+                Some(DbValue::SpentOutputs(outputs))
             },
             DbKey::TimeLockedUnspentOutputs(tip) => {
                 let outputs = OutputSql::index_time_locked(*tip, &conn)?;
+                let outputs = OutputSql::to_db_unblinded_outputs(outputs, &cipher)?;
 
-                Some(DbValue::UnspentOutputs(
-                    outputs
-                        .iter()
-                        .map(|o| o.clone().to_db_unblinded_output(&cipher))
-                        .collect::<Result<Vec<_>, _>>()?,
-                ))
+                Some(DbValue::UnspentOutputs(outputs))
             },
             DbKey::InvalidOutputs => {
                 let outputs = OutputSql::index_status(vec![OutputStatus::Invalid], &conn)?;
+                let outputs = OutputSql::to_db_unblinded_outputs(outputs, &cipher)?;
 
-                Some(DbValue::InvalidOutputs(
-                    outputs
-                        .iter()
-                        .map(|o| o.clone().to_db_unblinded_output(&cipher))
-                        .collect::<Result<Vec<_>, _>>()?,
-                ))
+                Some(DbValue::InvalidOutputs(outputs))
             },
             DbKey::KnownOneSidedPaymentScripts => {
                 let known_one_sided_payment_scripts = KnownOneSidedPaymentScriptSql::index(&conn)?;
@@ -269,10 +249,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         let outputs = OutputSql::index_by_output_type(output_type, &conn)?;
         let cipher = acquire_read_lock!(self.cipher);
 
-        outputs
-            .iter()
-            .map(|o| o.clone().to_db_unblinded_output(&cipher))
-            .collect::<Result<Vec<_>, _>>()
+        OutputSql::to_db_unblinded_outputs(outputs, &cipher)
     }
 
     fn fetch_sorted_unspent_outputs(&self) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError> {
@@ -280,10 +257,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         let outputs = OutputSql::index_unspent(&conn)?;
         let cipher = acquire_read_lock!(self.cipher);
 
-        outputs
-            .into_iter()
-            .map(|o| o.to_db_unblinded_output(&cipher))
-            .collect::<Result<Vec<_>, _>>()
+        OutputSql::to_db_unblinded_outputs(outputs, &cipher)
     }
 
     fn fetch_mined_unspent_outputs(&self) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError> {
@@ -303,10 +277,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
             );
         }
 
-        outputs
-            .into_iter()
-            .map(|o| o.to_db_unblinded_output(&cipher))
-            .collect::<Result<Vec<_>, _>>()
+        OutputSql::to_db_unblinded_outputs(outputs, &cipher)
     }
 
     fn fetch_invalid_outputs(&self, timestamp: i64) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError> {
@@ -326,10 +297,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
             );
         }
 
-        outputs
-            .into_iter()
-            .map(|o| o.to_db_unblinded_output(&cipher))
-            .collect::<Result<Vec<_>, _>>()
+        OutputSql::to_db_unblinded_outputs(outputs, &cipher)
     }
 
     fn fetch_unspent_mined_unconfirmed_outputs(&self) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError> {
@@ -349,10 +317,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
             );
         }
 
-        outputs
-            .into_iter()
-            .map(|o| o.to_db_unblinded_output(&cipher))
-            .collect::<Result<Vec<_>, _>>()
+        OutputSql::to_db_unblinded_outputs(outputs, &cipher)
     }
 
     fn write(&self, op: WriteOperation) -> Result<Option<DbValue>, OutputManagerStorageError> {
@@ -434,10 +399,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
                 start.elapsed().as_millis()
             );
         }
-        outputs
-            .iter()
-            .map(|o| o.clone().to_db_unblinded_output(&cipher))
-            .collect::<Result<Vec<_>, _>>()
+        OutputSql::to_db_unblinded_outputs(outputs, &cipher)
     }
 
     fn set_received_output_mined_height_and_status(
@@ -452,35 +414,17 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         let start = Instant::now();
         let conn = self.database_connection.get_pooled_connection()?;
         let acquire_lock = start.elapsed();
-        let status = if confirmed {
-            OutputStatus::Unspent as i32
-        } else {
-            OutputStatus::UnspentMinedUnconfirmed as i32
-        };
-        debug!(
-            target: LOG_TARGET,
-            "`set_received_output_mined_height` status: {}", status
-        );
-        let hash = hash.to_vec();
-        let mined_in_block = mined_in_block.to_vec();
-        let timestamp = NaiveDateTime::from_timestamp_opt(mined_timestamp as i64, 0).ok_or(
-            OutputManagerStorageError::ConversionError {
-                reason: format!("Could not create timestamp mined_timestamp: {}", mined_timestamp),
+        OutputSql::apply_validation_update(
+            &OutputValidationUpdate::Mined {
+                hash,
+                mined_height,
+                mined_in_block,
+                mmr_position,
+                confirmed,
+                mined_timestamp,
             },
+            &conn,
         )?;
-        diesel::update(outputs::table.filter(outputs::hash.eq(hash)))
-            .set((
-                outputs::mined_height.eq(mined_height as i64),
-                outputs::mined_in_block.eq(mined_in_block),
-                outputs::mined_mmr_position.eq(mmr_position as i64),
-                outputs::status.eq(status),
-                outputs::mined_timestamp.eq(timestamp),
-                outputs::marked_deleted_at_height.eq::<Option<i64>>(None),
-                outputs::marked_deleted_in_block.eq::<Option<Vec<u8>>>(None),
-                outputs::last_validation_timestamp.eq::<Option<NaiveDateTime>>(None),
-            ))
-            .execute(&conn)
-            .num_rows_affected_or_not_found(1)?;
         if start.elapsed().as_millis() > 0 {
             trace!(
                 target: LOG_TARGET,
@@ -498,19 +442,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         let start = Instant::now();
         let conn = self.database_connection.get_pooled_connection()?;
         let acquire_lock = start.elapsed();
-        let hash = hash.to_vec();
-        diesel::update(outputs::table.filter(outputs::hash.eq(hash)))
-            .set((
-                outputs::mined_height.eq::<Option<i64>>(None),
-                outputs::mined_in_block.eq::<Option<Vec<u8>>>(None),
-                outputs::mined_mmr_position.eq::<Option<i64>>(None),
-                outputs::status.eq(OutputStatus::Invalid as i32),
-                outputs::mined_timestamp.eq::<Option<NaiveDateTime>>(None),
-                outputs::marked_deleted_at_height.eq::<Option<i64>>(None),
-                outputs::marked_deleted_in_block.eq::<Option<Vec<u8>>>(None),
-            ))
-            .execute(&conn)
-            .num_rows_affected_or_not_found(1)?;
+        OutputSql::apply_validation_update(&OutputValidationUpdate::UnminedAndInvalid { hash }, &conn)?;
         if start.elapsed().as_millis() > 0 {
             trace!(
                 target: LOG_TARGET,
@@ -558,12 +490,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         let start = Instant::now();
         let conn = self.database_connection.get_pooled_connection()?;
         let acquire_lock = start.elapsed();
-        let hash = hash.to_vec();
-        diesel::update(outputs::table.filter(outputs::hash.eq(hash)))
-            .set((outputs::last_validation_timestamp
-                .eq::<Option<NaiveDateTime>>(NaiveDateTime::from_timestamp_opt(Utc::now().timestamp(), 0)),))
-            .execute(&conn)
-            .num_rows_affected_or_not_found(1)?;
+        OutputSql::apply_validation_update(&OutputValidationUpdate::Validated { hash }, &conn)?;
         if start.elapsed().as_millis() > 0 {
             trace!(
                 target: LOG_TARGET,
@@ -587,21 +514,15 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         let start = Instant::now();
         let conn = self.database_connection.get_pooled_connection()?;
         let acquire_lock = start.elapsed();
-        let hash = hash.to_vec();
-        let mark_deleted_in_block = mark_deleted_in_block.to_vec();
-        let status = if confirmed {
-            OutputStatus::Spent as i32
-        } else {
-            OutputStatus::SpentMinedUnconfirmed as i32
-        };
-        diesel::update(outputs::table.filter(outputs::hash.eq(hash)))
-            .set((
-                outputs::marked_deleted_at_height.eq(mark_deleted_at_height as i64),
-                outputs::marked_deleted_in_block.eq(mark_deleted_in_block),
-                outputs::status.eq(status),
-            ))
-            .execute(&conn)
-            .num_rows_affected_or_not_found(1)?;
+        OutputSql::apply_validation_update(
+            &OutputValidationUpdate::Spent {
+                hash,
+                deleted_height: mark_deleted_at_height,
+                deleted_in_block: mark_deleted_in_block,
+                confirmed,
+            },
+            &conn,
+        )?;
         if start.elapsed().as_millis() > 0 {
             trace!(
                 target: LOG_TARGET,
@@ -619,16 +540,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         let start = Instant::now();
         let conn = self.database_connection.get_pooled_connection()?;
         let acquire_lock = start.elapsed();
-        let hash = hash.to_vec();
-        debug!(target: LOG_TARGET, "mark_output_as_unspent({})", hash.to_hex());
-        diesel::update(outputs::table.filter(outputs::hash.eq(hash)))
-            .set((
-                outputs::marked_deleted_at_height.eq::<Option<i64>>(None),
-                outputs::marked_deleted_in_block.eq::<Option<Vec<u8>>>(None),
-                outputs::status.eq(OutputStatus::Unspent as i32),
-            ))
-            .execute(&conn)
-            .num_rows_affected_or_not_found(1)?;
+        OutputSql::apply_validation_update(&OutputValidationUpdate::Unspent { hash }, &conn)?;
         if start.elapsed().as_millis() > 0 {
             trace!(
                 target: LOG_TARGET,
@@ -642,6 +554,30 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         Ok(())
     }
 
+    fn apply_validation_updates(&self, updates: Vec<OutputValidationUpdate>) -> Result<(), OutputManagerStorageError> {
+        let start = Instant::now();
+        let num_updates = updates.len();
+        // Queue the whole round before waiting so that it is committed in as few transactions as possible
+        let pending = updates
+            .into_iter()
+            .map(|update| {
+                self.database_connection
+                    .submit_batched_write(move |conn| OutputSql::apply_validation_update(&update, conn))
+            })
+            .collect::<Vec<_>>();
+        let results = pending.into_iter().map(PendingWrite::wait).collect::<Vec<_>>();
+        if start.elapsed().as_millis() > 0 {
+            trace!(
+                target: LOG_TARGET,
+                "sqlite profile - apply_validation_updates: {} batched writes {} ms",
+                num_updates,
+                start.elapsed().as_millis()
+            );
+        }
+
+        results.into_iter().collect()
+    }
+
     fn short_term_encumber_outputs(
         &self,
         tx_id: TxId,
@@ -824,6 +760,27 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         }
     }
 
+    fn fetch_block_checkpoints(&self) -> Result<Vec<(u64, FixedHash)>, OutputManagerStorageError> {
+        let start = Instant::now();
+        let conn = self.database_connection.get_pooled_connection()?;
+        let acquire_lock = start.elapsed();
+        let checkpoints = OutputSql::block_checkpoints(&conn)?;
+        if start.elapsed().as_millis() > 0 {
+            trace!(
+                target: LOG_TARGET,
+                "sqlite profile - fetch_block_checkpoints: lock {} + db_op {} = {} ms",
+                acquire_lock.as_millis(),
+                (start.elapsed() - acquire_lock).as_millis(),
+                start.elapsed().as_millis()
+            );
+        }
+        // Malformed block hashes are ignored, as they are when outputs are read
+        Ok(checkpoints
+            .into_iter()
+            .filter_map(|(height, block)| Some((height as u64, FixedHash::try_from(block).ok()?)))
+            .collect())
+    }
+
     fn get_balance(
         &self,
         current_tip_for_time_lock_calculation: Option<u64>,
@@ -1093,10 +1050,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
             (start.elapsed() - acquire_lock).as_millis(),
             start.elapsed().as_millis()
         );
-        outputs
-            .iter()
-            .map(|o| o.clone().to_db_unblinded_output(&cipher))
-            .collect::<Result<Vec<_>, _>>()
+        OutputSql::to_db_unblinded_outputs(outputs, &cipher)
     }
 
     fn fetch_outputs_by_tx_id(&self, tx_id: TxId) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError> {
@@ -1104,10 +1058,7 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
         let outputs = OutputSql::find_by_tx_id(tx_id, &conn)?;
         let cipher = acquire_read_lock!(self.cipher);
 
-        outputs
-            .iter()
-            .map(|o| o.clone().to_db_unblinded_output(&cipher))
-            .collect::<Result<Vec<_>, _>>()
+        OutputSql::to_db_unblinded_outputs(outputs, &cipher)
     }
 
     fn fetch_outputs_by(&self, q: OutputBackendQuery) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError> {
@@ -1128,6 +1079,48 @@ impl OutputManagerBackend for OutputManagerSqliteDatabase {
             })
             .collect())
     }
+
+    fn fetch_output_summaries_changed_since(
+        &self,
+        revision: u64,
+        limit: usize,
+    ) -> Result<Vec<OutputSummary>, OutputManagerStorageError> {
+        let start = Instant::now();
+        let conn = self.database_connection.get_pooled_connection()?;
+        let acquire_lock = start.elapsed();
+        let limit = i64::try_from(limit).unwrap_or(i64::MAX);
+        let summaries = OutputSummarySql::fetch_changed_since(revision, limit, &conn)?
+            .into_iter()
+            .map(OutputSummary::try_from)
+            .collect::<Result<Vec<_>, _>>()?;
+        if start.elapsed().as_millis() > 0 {
+            trace!(
+                target: LOG_TARGET,
+                "sqlite profile - fetch_output_summaries_changed_since: lock {} + db_op {} = {} ms",
+                acquire_lock.as_millis(),
+                (start.elapsed() - acquire_lock).as_millis(),
+                start.elapsed().as_millis()
+            );
+        }
+        Ok(summaries)
+    }
+
+    fn prune_deleted_output_summaries(&self, revision: u64) -> Result<usize, OutputManagerStorageError> {
+        let start = Instant::now();
+        let conn = self.database_connection.get_pooled_connection()?;
+        let acquire_lock = start.elapsed();
+        let num_pruned = OutputSummarySql::prune_deleted(revision, &conn)?;
+        if start.elapsed().as_millis() > 0 {
+            trace!(
+                target: LOG_TARGET,
+                "sqlite profile - prune_deleted_output_summaries: lock {} + db_op {} = {} ms",
+                acquire_lock.as_millis(),
+                (start.elapsed() - acquire_lock).as_millis(),
+                start.elapsed().as_millis()
+            );
+        }
+        Ok(num_pruned)
+    }
 }
 
 fn update_outputs_with_tx_id_and_status_to_new_status(
@@ -1395,7 +1388,12 @@ mod test {
     use crate::{
         output_manager_service::storage::{
             models::DbUnblindedOutput,
-            sqlite_db::{new_output_sql::NewOutputSql, output_sql::OutputSql, OutputStatus, UpdateOutput},
+            sqlite_db::{
+                new_output_sql::NewOutputSql,
+                output_sql::{OutputSql, OutputSummarySql},
+                OutputStatus,
+                UpdateOutput,
+            },
             OutputSource,
         },
         util::encryption::Encryptable,
@@ -1532,6 +1530,175 @@ mod test {
         assert_eq!(result[0].spending_key, outputs[1].spending_key);
     }
 
+    #[test]
+    fn test_balance_running_totals() {
+        let db_name = format!("{}.sqlite3", random::string(8).as_str());
+        let temp_dir = tempdir().unwrap();
+        let db_folder = temp_dir.path().to_str().unwrap().to_string();
+        let db_path = format!("{}{}", db_folder, db_name);
+
+        embed_migrations!("./migrations");
+        let conn = SqliteConnection::establish(&db_path).unwrap_or_else(|_| panic!("Error connecting to {}", db_path));
+
+        embedded_migrations::run_with_output(&conn, &mut std::io::stdout()).expect("Migration failed");
+
+        let factories = CryptoFactories::default();
+        let mut key = [0u8; size_of::<Key>()];
+        OsRng.fill_bytes(&mut key);
+        let key_ga = Key::from_slice(&key);
+        let cipher = XChaCha20Poly1305::new(key_ga);
+
+        let mut outputs = Vec::new();
+        for (value, status) in [
+            (100, OutputStatus::Unspent),
+            (200, OutputStatus::Unspent),
+            (400, OutputStatus::EncumberedToBeReceived),
+            (800, OutputStatus::EncumberedToBeSpent),
+            (1600, OutputStatus::Spent),
+        ] {
+            let (_, uo) = make_input(MicroTari::from(value));
+            let uo = DbUnblindedOutput::from_unblinded_output(uo, &factories, None, OutputSource::Unknown).unwrap();
+            let o = NewOutputSql::new(uo, status, None, None, &cipher).unwrap();
+            o.commit(&conn).unwrap();
+            outputs.push(o);
+        }
+
+        let balance = OutputSql::get_balance(None, &conn).unwrap();
+        assert_eq!(balance.available_balance, MicroTari::from(300));
+        assert_eq!(balance.pending_incoming_balance, MicroTari::from(400));
+        assert_eq!(balance.pending_outgoing_balance, MicroTari::from(800));
+        assert_eq!(balance.time_locked_balance, None);
+
+        // Moving an output between statuses moves its value between the totals
+        OutputSql::find(&outputs[0].spending_key, &conn)
+            .unwrap()
+            .update(
+                UpdateOutput {
+                    status: Some(OutputStatus::EncumberedToBeSpent),
+                    ..Default::default()
+                },
+                &conn,
+            )
+            .unwrap();
+        OutputSql::find(&outputs[2].spending_key, &conn)
+            .unwrap()
+            .update(
+                UpdateOutput {
+                    status: Some(OutputStatus::Unspent),
+                    ..Default::default()
+                },
+                &conn,
+            )
+            .unwrap();
+        OutputSql::find(&outputs[3].spending_key, &conn)
+            .unwrap()
+            .delete(&conn)
+            .unwrap();
+
+        let balance = OutputSql::get_balance(Some(0), &conn).unwrap();
+        assert_eq!(balance.available_balance, MicroTari::from(600));
+        assert_eq!(balance.pending_incoming_balance, MicroTari::from(0));
+        assert_eq!(balance.pending_outgoing_balance, MicroTari::from(100));
+        assert_eq!(balance.time_locked_balance, Some(MicroTari::from(0)));
+    }
+
+    #[test]
+    fn test_output_summaries_changed_since() {
+        let db_name = format!("{}.sqlite3", random::string(8).as_str());
+        let temp_dir = tempdir().unwrap();
+        let db_folder = temp_dir.path().to_str().unwrap().to_string();
+        let db_path = format!("{}{}", db_folder, db_name);
+
+        embed_migrations!("./migrations");
+        let conn = SqliteConnection::establish(&db_path).unwrap_or_else(|_| panic!("Error connecting to {}", db_path));
+
+        embedded_migrations::run_with_output(&conn, &mut std::io::stdout()).expect("Migration failed");
+
+        let factories = CryptoFactories::default();
+        let mut key = [0u8; size_of::<Key>()];
+        OsRng.fill_bytes(&mut key);
+        let key_ga = Key::from_slice(&key);
+        let cipher = XChaCha20Poly1305::new(key_ga);
+
+        let mut outputs = Vec::new();
+        for _i in 0..3 {
+            let (_, uo) = make_input(MicroTari::from(100 + OsRng.next_u64() % 1000));
+            let uo = DbUnblindedOutput::from_unblinded_output(uo, &factories, None, OutputSource::Unknown).unwrap();
+            let o = NewOutputSql::new(uo, OutputStatus::Unspent, None, None, &cipher).unwrap();
+            o.commit(&conn).unwrap();
+            outputs.push(o);
+        }
+
+        let summaries = OutputSummarySql::fetch_changed_since(0, 10, &conn).unwrap();
+        assert_eq!(summaries.len(), 3);
+        assert!(summaries.windows(2).all(|w| w[0].revision < w[1].revision));
+        for (summary, output) in summaries.iter().zip(outputs.iter()) {
+            assert_eq!(summary.commitment, output.commitment);
+            assert_eq!(summary.value, output.value);
+        }
+        let last_revision = summaries[2].revision as u64;
+        assert!(OutputSummarySql::fetch_changed_since(last_revision, 10, &conn)
+            .unwrap()
+            .is_empty());
+        assert_eq!(OutputSummarySql::fetch_changed_since(0, 2, &conn).unwrap().len(), 2);
+
+        // Only the updated output is returned after a status change
+        OutputSql::find(&outputs[0].spending_key, &conn)
+            .unwrap()
+            .update(
+                UpdateOutput {
+                    status: Some(OutputStatus::Spent),
+                    ..Default::default()
+                },
+                &conn,
+            )
+            .unwrap();
+        let changed = OutputSummarySql::fetch_changed_since(last_revision, 10, &conn).unwrap();
+        assert_eq!(changed.len(), 1);
+        assert_eq!(changed[0].commitment, outputs[0].commitment);
+        assert_eq!(changed[0].status, OutputStatus::Spent as i32);
+        assert!(changed[0].revision as u64 > last_revision);
+        assert!(!changed[0].deleted);
+
+        // Deleting the most recently changed output leaves a tombstone and its revision is never handed out again
+        let last_revision = changed[0].revision as u64;
+        OutputSql::find(&outputs[0].spending_key, &conn)
+            .unwrap()
+            .delete(&conn)
+            .unwrap();
+        let (_, uo) = make_input(MicroTari::from(100 + OsRng.next_u64() % 1000));
+        let uo = DbUnblindedOutput::from_unblinded_output(uo, &factories, None, OutputSource::Unknown).unwrap();
+        let new_output = NewOutputSql::new(uo, OutputStatus::Unspent, None, None, &cipher).unwrap();
+        new_output.commit(&conn).unwrap();
+
+        let changed = OutputSummarySql::fetch_changed_since(last_revision, 10, &conn).unwrap();
+        assert_eq!(changed.len(), 2);
+        assert!(changed[0].deleted);
+        assert_eq!(changed[0].commitment, outputs[0].commitment);
+        assert_eq!(changed[0].status, OutputStatus::Spent as i32);
+        assert!(changed[0].revision as u64 > last_revision);
+        assert!(!changed[1].deleted);
+        assert_eq!(changed[1].commitment, new_output.commitment);
+        assert!(changed[1].revision > changed[0].revision);
+        assert_eq!(
+            OutputSummarySql::fetch_changed_since(last_revision, 1, &conn)
+                .unwrap()
+                .len(),
+            1
+        );
+
+        // Once a client has seen the deletion its tombstone can be discarded, live outputs are kept
+        assert_eq!(OutputSummarySql::prune_deleted(last_revision, &conn).unwrap(), 0);
+        assert_eq!(
+            OutputSummarySql::prune_deleted(changed[0].revision as u64, &conn).unwrap(),
+            1
+        );
+        let changed = OutputSummarySql::fetch_changed_since(last_revision, 10, &conn).unwrap();
+        assert_eq!(changed.len(), 1);
+        assert_eq!(changed[0].commitment, new_output.commitment);
+        assert_eq!(OutputSummarySql::fetch_changed_since(0, 10, &conn).unwrap().len(), 3);
+    }
+
     #[test]
     fn test_output_encryption() {
         let db_name = format!("{}.sqlite3", random::string(8).as_str());
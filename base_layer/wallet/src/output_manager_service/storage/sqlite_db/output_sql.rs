@@ -24,10 +24,11 @@ use std::convert::{TryFrom, TryInto};
 
 use borsh::BorshDeserialize;
 use chacha20poly1305::XChaCha20Poly1305;
-use chrono::NaiveDateTime;
+use chrono::{NaiveDateTime, Utc};
 use derivative::Derivative;
 use diesel::{prelude::*, sql_query, SqliteConnection};
 use log::*;
+use rayon::prelude::*;
 use tari_common_types::{
     transaction::TxId,
     types::{ComAndPubSignature, Commitment, PrivateKey, PublicKey},
@@ -37,7 +38,10 @@ use tari_core::transactions::{
     transaction_components::{EncryptedValue, OutputFeatures, OutputType, UnblindedOutput},
     CryptoFactories,
 };
-use tari_crypto::{commitment::HomomorphicCommitmentFactory, tari_utilities::ByteArray};
+use tari_crypto::{
+    commitment::HomomorphicCommitmentFactory,
+    tari_utilities::{hex::Hex, ByteArray},
+};
 use tari_script::{ExecutionStack, TariScript};
 use tari_utilities::Hidden;
 use zeroize::Zeroize;
@@ -49,7 +53,7 @@ use crate::{
         service::Balance,
         storage::{
             database::{OutputBackendQuery, SortDirection},
-            models::DbUnblindedOutput,
+            models::{DbUnblindedOutput, OutputSummary, OutputValidationUpdate},
             sqlite_db::{UpdateOutput, UpdateOutputSql},
             OutputSource,
             OutputStatus,
@@ -57,10 +61,10 @@ use crate::{
         UtxoSelectionFilter,
         UtxoSelectionOrdering,
     },
-    schema::outputs,
+    schema::{deleted_outputs, output_totals, outputs},
     util::{
         diesel_ext::ExpectedRowsExtension,
-        encryption::{decrypt_bytes_integral_nonce, encrypt_bytes_integral_nonce, Encryptable},
+        encryption::{decrypt_bytes_integral_nonce_in_place, encrypt_bytes_integral_nonce, Encryptable},
     },
 };
 
@@ -107,6 +111,7 @@ pub struct OutputSql {
     pub minimum_value_promise: i64,
     pub source: i32,
     pub last_validation_timestamp: Option<NaiveDateTime>,
+    pub revision: i64,
 }
 
 impl OutputSql {
@@ -365,6 +370,37 @@ impl OutputSql {
             .optional()?)
     }
 
+    /// Returns the distinct heights and hashes of the blocks that outputs were mined or spent in, ordered by height
+    pub fn block_checkpoints(conn: &SqliteConnection) -> Result<Vec<(i64, Vec<u8>)>, OutputManagerStorageError> {
+        let mut checkpoints = outputs::table
+            .select((outputs::mined_height, outputs::mined_in_block))
+            .filter(
+                outputs::mined_height
+                    .is_not_null()
+                    .and(outputs::mined_in_block.is_not_null()),
+            )
+            .distinct()
+            .load::<(Option<i64>, Option<Vec<u8>>)>(conn)?;
+        checkpoints.extend(
+            outputs::table
+                .select((outputs::marked_deleted_at_height, outputs::marked_deleted_in_block))
+                .filter(
+                    outputs::marked_deleted_at_height
+                        .is_not_null()
+                        .and(outputs::marked_deleted_in_block.is_not_null()),
+                )
+                .distinct()
+                .load::<(Option<i64>, Option<Vec<u8>>)>(conn)?,
+        );
+        let mut checkpoints = checkpoints
+            .into_iter()
+            .filter_map(|(height, block)| Some((height?, block?)))
+            .collect::<Vec<_>>();
+        checkpoints.sort_unstable();
+        checkpoints.dedup();
+        Ok(checkpoints)
+    }
+
     /// Find a particular Output, if it exists
     pub fn find(spending_key: &[u8], conn: &SqliteConnection) -> Result<OutputSql, OutputManagerStorageError> {
         Ok(outputs::table
@@ -382,108 +418,65 @@ impl OutputSql {
             .load(conn)?)
     }
 
-    /// Return the available, time locked, pending incoming and pending outgoing balance
-    #[allow(clippy::cast_possible_wrap)]
+    /// Return the available, time locked, pending incoming and pending outgoing balance. Apart from the time locked
+    /// balance, which depends on the tip, these are read from the running totals that the `output_totals` triggers
+    /// maintain instead of aggregating the outputs table.
+    #[allow(clippy::cast_possible_wrap, clippy::cast_sign_loss)]
     pub fn get_balance(
         current_tip_for_time_lock_calculation: Option<u64>,
         conn: &SqliteConnection,
     ) -> Result<Balance, OutputManagerStorageError> {
-        #[derive(QueryableByName, Clone)]
-        struct BalanceQueryResult {
-            #[sql_type = "diesel::sql_types::BigInt"]
-            amount: i64,
-            #[sql_type = "diesel::sql_types::Text"]
-            category: String,
+        let totals = output_totals::table
+            .select((output_totals::status, output_totals::source, output_totals::value))
+            .load::<(i32, i32, i64)>(conn)?;
+
+        let mut available_balance = MicroTari::from(0);
+        let mut pending_incoming_balance = MicroTari::from(0);
+        let mut pending_outgoing_balance = MicroTari::from(0);
+        for (status, source, value) in totals {
+            let value = MicroTari::from(value as u64);
+            match OutputStatus::try_from(status)? {
+                OutputStatus::Unspent => available_balance += value,
+                OutputStatus::EncumberedToBeReceived => {
+                    if source != OutputSource::Coinbase as i32 {
+                        pending_incoming_balance += value;
+                    }
+                },
+                OutputStatus::ShortTermEncumberedToBeReceived | OutputStatus::UnspentMinedUnconfirmed => {
+                    pending_incoming_balance += value
+                },
+                OutputStatus::EncumberedToBeSpent |
+                OutputStatus::ShortTermEncumberedToBeSpent |
+                OutputStatus::SpentMinedUnconfirmed => pending_outgoing_balance += value,
+                _ => {},
+            }
         }
-        let balance_query_result = if let Some(current_tip) = current_tip_for_time_lock_calculation {
-            let balance_query = sql_query(
-                "SELECT coalesce(sum(value), 0) as amount, 'available_balance' as category \
-                 FROM outputs WHERE status = ? \
-                 UNION ALL \
-                 SELECT coalesce(sum(value), 0) as amount, 'time_locked_balance' as category \
-                 FROM outputs WHERE status = ? AND maturity > ? OR script_lock_height > ? \
-                 UNION ALL \
-                 SELECT coalesce(sum(value), 0) as amount, 'pending_incoming_balance' as category \
-                 FROM outputs WHERE source != ? AND status = ? OR status = ? OR status = ? \
-                 UNION ALL \
-                 SELECT coalesce(sum(value), 0) as amount, 'pending_outgoing_balance' as category \
-                 FROM outputs WHERE status = ? OR status = ? OR status = ?",
-            )
-                // available_balance
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::Unspent as i32)
-                // time_locked_balance
+
+        let time_locked_balance = match current_tip_for_time_lock_calculation {
+            Some(current_tip) => {
+                #[derive(QueryableByName, Clone)]
+                struct TimeLockedQueryResult {
+                    #[sql_type = "diesel::sql_types::BigInt"]
+                    amount: i64,
+                }
+                let result = sql_query(
+                    "SELECT coalesce(sum(value), 0) as amount FROM outputs WHERE status = ? AND maturity > ? OR \
+                     script_lock_height > ?",
+                )
                 .bind::<diesel::sql_types::Integer, _>(OutputStatus::Unspent as i32)
                 .bind::<diesel::sql_types::BigInt, _>(current_tip as i64)
                 .bind::<diesel::sql_types::BigInt, _>(current_tip as i64)
-                // pending_incoming_balance
-                .bind::<diesel::sql_types::Integer, _>(OutputSource::Coinbase as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::EncumberedToBeReceived as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::ShortTermEncumberedToBeReceived as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::UnspentMinedUnconfirmed as i32)
-                // pending_outgoing_balance
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::EncumberedToBeSpent as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::ShortTermEncumberedToBeSpent as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::SpentMinedUnconfirmed as i32);
-            balance_query.load::<BalanceQueryResult>(conn)?
-        } else {
-            let balance_query = sql_query(
-                "SELECT coalesce(sum(value), 0) as amount, 'available_balance' as category \
-                 FROM outputs WHERE status = ? \
-                 UNION ALL \
-                 SELECT coalesce(sum(value), 0) as amount, 'pending_incoming_balance' as category \
-                 FROM outputs WHERE source != ? AND status = ? OR status = ? OR status = ? \
-                 UNION ALL \
-                 SELECT coalesce(sum(value), 0) as amount, 'pending_outgoing_balance' as category \
-                 FROM outputs WHERE status = ? OR status = ? OR status = ?",
-            )
-                // available_balance
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::Unspent as i32)
-                // pending_incoming_balance
-                .bind::<diesel::sql_types::Integer, _>(OutputSource::Coinbase as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::EncumberedToBeReceived as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::ShortTermEncumberedToBeReceived as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::UnspentMinedUnconfirmed as i32)
-                // pending_outgoing_balance
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::EncumberedToBeSpent as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::ShortTermEncumberedToBeSpent as i32)
-                .bind::<diesel::sql_types::Integer, _>(OutputStatus::SpentMinedUnconfirmed as i32);
-            balance_query.load::<BalanceQueryResult>(conn)?
+                .get_result::<TimeLockedQueryResult>(conn)?;
+                Some(MicroTari::from(result.amount as u64))
+            },
+            None => None,
         };
-        let mut available_balance = None;
-        let mut time_locked_balance = Some(None);
-        let mut pending_incoming_balance = None;
-        let mut pending_outgoing_balance = None;
-        for balance in balance_query_result {
-            match balance.category.as_str() {
-                "available_balance" => available_balance = Some(MicroTari::from(balance.amount as u64)),
-                "time_locked_balance" => time_locked_balance = Some(Some(MicroTari::from(balance.amount as u64))),
-                "pending_incoming_balance" => pending_incoming_balance = Some(MicroTari::from(balance.amount as u64)),
-                "pending_outgoing_balance" => pending_outgoing_balance = Some(MicroTari::from(balance.amount as u64)),
-                _ => {
-                    return Err(OutputManagerStorageError::UnexpectedResult(
-                        "Unexpected category in balance query".to_string(),
-                    ))
-                },
-            }
-        }
 
         Ok(Balance {
-            available_balance: available_balance.ok_or_else(|| {
-                OutputManagerStorageError::UnexpectedResult("Available balance could not be calculated".to_string())
-            })?,
-            time_locked_balance: time_locked_balance.ok_or_else(|| {
-                OutputManagerStorageError::UnexpectedResult("Time locked balance could not be calculated".to_string())
-            })?,
-            pending_incoming_balance: pending_incoming_balance.ok_or_else(|| {
-                OutputManagerStorageError::UnexpectedResult(
-                    "Pending incoming balance could not be calculated".to_string(),
-                )
-            })?,
-            pending_outgoing_balance: pending_outgoing_balance.ok_or_else(|| {
-                OutputManagerStorageError::UnexpectedResult(
-                    "Pending outgoing balance could not be calculated".to_string(),
-                )
-            })?,
+            available_balance,
+            time_locked_balance,
+            pending_incoming_balance,
+            pending_outgoing_balance,
         })
     }
 
@@ -607,6 +600,105 @@ impl OutputSql {
             .first::<OutputSql>(conn)?)
     }
 
+    /// Applies a change found by output validation to the output with the update's hash
+    #[allow(clippy::cast_possible_wrap)]
+    pub fn apply_validation_update(
+        update: &OutputValidationUpdate,
+        conn: &SqliteConnection,
+    ) -> Result<(), OutputManagerStorageError> {
+        match update {
+            OutputValidationUpdate::Mined {
+                hash,
+                mined_height,
+                mined_in_block,
+                mmr_position,
+                confirmed,
+                mined_timestamp,
+            } => {
+                let status = if *confirmed {
+                    OutputStatus::Unspent as i32
+                } else {
+                    OutputStatus::UnspentMinedUnconfirmed as i32
+                };
+                debug!(
+                    target: LOG_TARGET,
+                    "`set_received_output_mined_height` status: {}", status
+                );
+                let timestamp = NaiveDateTime::from_timestamp_opt(*mined_timestamp as i64, 0).ok_or(
+                    OutputManagerStorageError::ConversionError {
+                        reason: format!("Could not create timestamp mined_timestamp: {}", mined_timestamp),
+                    },
+                )?;
+                diesel::update(outputs::table.filter(outputs::hash.eq(hash.to_vec())))
+                    .set((
+                        outputs::mined_height.eq(*mined_height as i64),
+                        outputs::mined_in_block.eq(mined_in_block.to_vec()),
+                        outputs::mined_mmr_position.eq(*mmr_position as i64),
+                        outputs::status.eq(status),
+                        outputs::mined_timestamp.eq(timestamp),
+                        outputs::marked_deleted_at_height.eq::<Option<i64>>(None),
+                        outputs::marked_deleted_in_block.eq::<Option<Vec<u8>>>(None),
+                        outputs::last_validation_timestamp.eq::<Option<NaiveDateTime>>(None),
+                    ))
+                    .execute(conn)
+                    .num_rows_affected_or_not_found(1)?;
+            },
+            OutputValidationUpdate::UnminedAndInvalid { hash } => {
+                diesel::update(outputs::table.filter(outputs::hash.eq(hash.to_vec())))
+                    .set((
+                        outputs::mined_height.eq::<Option<i64>>(None),
+                        outputs::mined_in_block.eq::<Option<Vec<u8>>>(None),
+                        outputs::mined_mmr_position.eq::<Option<i64>>(None),
+                        outputs::status.eq(OutputStatus::Invalid as i32),
+                        outputs::mined_timestamp.eq::<Option<NaiveDateTime>>(None),
+                        outputs::marked_deleted_at_height.eq::<Option<i64>>(None),
+                        outputs::marked_deleted_in_block.eq::<Option<Vec<u8>>>(None),
+                    ))
+                    .execute(conn)
+                    .num_rows_affected_or_not_found(1)?;
+            },
+            OutputValidationUpdate::Validated { hash } => {
+                diesel::update(outputs::table.filter(outputs::hash.eq(hash.to_vec())))
+                    .set((outputs::last_validation_timestamp
+                        .eq::<Option<NaiveDateTime>>(NaiveDateTime::from_timestamp_opt(Utc::now().timestamp(), 0)),))
+                    .execute(conn)
+                    .num_rows_affected_or_not_found(1)?;
+            },
+            OutputValidationUpdate::Spent {
+                hash,
+                deleted_height,
+                deleted_in_block,
+                confirmed,
+            } => {
+                let status = if *confirmed {
+                    OutputStatus::Spent as i32
+                } else {
+                    OutputStatus::SpentMinedUnconfirmed as i32
+                };
+                diesel::update(outputs::table.filter(outputs::hash.eq(hash.to_vec())))
+                    .set((
+                        outputs::marked_deleted_at_height.eq(*deleted_height as i64),
+                        outputs::marked_deleted_in_block.eq(deleted_in_block.to_vec()),
+                        outputs::status.eq(status),
+                    ))
+                    .execute(conn)
+                    .num_rows_affected_or_not_found(1)?;
+            },
+            OutputValidationUpdate::Unspent { hash } => {
+                debug!(target: LOG_TARGET, "mark_output_as_unspent({})", hash.to_hex());
+                diesel::update(outputs::table.filter(outputs::hash.eq(hash.to_vec())))
+                    .set((
+                        outputs::marked_deleted_at_height.eq::<Option<i64>>(None),
+                        outputs::marked_deleted_in_block.eq::<Option<Vec<u8>>>(None),
+                        outputs::status.eq(OutputStatus::Unspent as i32),
+                    ))
+                    .execute(conn)
+                    .num_rows_affected_or_not_found(1)?;
+            },
+        }
+        Ok(())
+    }
+
     pub fn delete(&self, conn: &SqliteConnection) -> Result<(), OutputManagerStorageError> {
         let num_deleted =
             diesel::delete(outputs::table.filter(outputs::spending_key.eq(&self.spending_key))).execute(conn)?;
@@ -631,6 +723,17 @@ impl OutputSql {
         OutputSql::find(&self.spending_key, conn)
     }
 
+    /// Decrypts and converts a whole result set, spreading the rows over the available cores
+    pub fn to_db_unblinded_outputs(
+        outputs: Vec<OutputSql>,
+        cipher: &XChaCha20Poly1305,
+    ) -> Result<Vec<DbUnblindedOutput>, OutputManagerStorageError> {
+        outputs
+            .into_par_iter()
+            .map(|o| o.to_db_unblinded_output(cipher))
+            .collect()
+    }
+
     #[allow(clippy::too_many_lines)]
     pub fn to_db_unblinded_output(
         mut self,
@@ -824,11 +927,116 @@ impl Encryptable<XChaCha20Poly1305> for OutputSql {
     }
 
     fn decrypt(&mut self, cipher: &XChaCha20Poly1305) -> Result<(), String> {
-        self.spending_key = decrypt_bytes_integral_nonce(cipher, self.domain("spending_key"), &self.spending_key)?;
-
-        self.script_private_key =
-            decrypt_bytes_integral_nonce(cipher, self.domain("script_private_key"), &self.script_private_key)?;
+        decrypt_bytes_integral_nonce_in_place(cipher, &self.domain("spending_key"), &mut self.spending_key)?;
+        decrypt_bytes_integral_nonce_in_place(
+            cipher,
+            &self.domain("script_private_key"),
+            &mut self.script_private_key,
+        )?;
 
         Ok(())
     }
 }
+
+/// The unencrypted columns needed for a bulk output export, selected without loading or decrypting the rest of the
+/// row. `deleted` marks a tombstone left behind by an output that has since been removed from the wallet.
+#[derive(Clone, Debug)]
+pub struct OutputSummarySql {
+    pub commitment: Option<Vec<u8>>,
+    pub value: i64,
+    pub status: i32,
+    pub mined_height: Option<i64>,
+    pub mined_timestamp: Option<NaiveDateTime>,
+    pub revision: i64,
+    pub deleted: bool,
+}
+
+type OutputSummaryRow = (Option<Vec<u8>>, i64, i32, Option<i64>, Option<NaiveDateTime>, i64);
+
+impl OutputSummarySql {
+    /// Return up to `limit` outputs and tombstones of deleted outputs whose revision is greater than `revision`,
+    /// ordered by revision
+    #[allow(clippy::cast_possible_wrap)]
+    pub fn fetch_changed_since(
+        revision: u64,
+        limit: i64,
+        conn: &SqliteConnection,
+    ) -> Result<Vec<OutputSummarySql>, OutputManagerStorageError> {
+        let changed: Vec<OutputSummaryRow> = outputs::table
+            .select((
+                outputs::commitment,
+                outputs::value,
+                outputs::status,
+                outputs::mined_height,
+                outputs::mined_timestamp,
+                outputs::revision,
+            ))
+            .filter(outputs::revision.gt(revision as i64))
+            .order(outputs::revision.asc())
+            .limit(limit)
+            .load(conn)?;
+        let deleted: Vec<OutputSummaryRow> = deleted_outputs::table
+            .select((
+                deleted_outputs::commitment,
+                deleted_outputs::value,
+                deleted_outputs::status,
+                deleted_outputs::mined_height,
+                deleted_outputs::mined_timestamp,
+                deleted_outputs::revision,
+            ))
+            .filter(deleted_outputs::revision.gt(revision as i64))
+            .order(deleted_outputs::revision.asc())
+            .limit(limit)
+            .load(conn)?;
+
+        // Both tables draw their revisions from the same counter, so merging the two pages gives the first `limit`
+        // changes overall
+        let mut summaries = changed
+            .into_iter()
+            .map(|row| Self::from_row(row, false))
+            .chain(deleted.into_iter().map(|row| Self::from_row(row, true)))
+            .collect::<Vec<_>>();
+        summaries.sort_unstable_by_key(|s| s.revision);
+        summaries.truncate(usize::try_from(limit).unwrap_or(usize::MAX));
+        Ok(summaries)
+    }
+
+    /// Delete the tombstones of outputs deleted at or before `revision`, returning the number deleted
+    #[allow(clippy::cast_possible_wrap)]
+    pub fn prune_deleted(revision: u64, conn: &SqliteConnection) -> Result<usize, OutputManagerStorageError> {
+        Ok(
+            diesel::delete(deleted_outputs::table.filter(deleted_outputs::revision.le(revision as i64)))
+                .execute(conn)?,
+        )
+    }
+
+    fn from_row(row: OutputSummaryRow, deleted: bool) -> Self {
+        let (commitment, value, status, mined_height, mined_timestamp, revision) = row;
+        Self {
+            commitment,
+            value,
+            status,
+            mined_height,
+            mined_timestamp,
+            revision,
+            deleted,
+        }
+    }
+}
+
+impl TryFrom<OutputSummarySql> for OutputSummary {
+    type Error = OutputManagerStorageError;
+
+    #[allow(clippy::cast_sign_loss)]
+    fn try_from(o: OutputSummarySql) -> Result<Self, Self::Error> {
+        Ok(Self {
+            commitment: o.commitment,
+            value: MicroTari::from(o.value as u64),
+            status: OutputStatus::try_from(o.status)?,
+            mined_height: o.mined_height.map(|h| h as u64),
+            mined_timestamp: o.mined_timestamp,
+            revision: o.revision as u64,
+            deleted: o.deleted,
+        })
+    }
+}
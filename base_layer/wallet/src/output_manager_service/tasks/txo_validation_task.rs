@@ -45,13 +45,21 @@ use crate::{
         handle::{OutputManagerEvent, OutputManagerEventSender},
         storage::{
             database::{OutputManagerBackend, OutputManagerDatabase},
-            models::DbUnblindedOutput,
+            models::{DbUnblindedOutput, OutputValidationUpdate},
+            OutputStatus,
         },
     },
 };
 
 const LOG_TARGET: &str = "wallet::output_service::txo_validation_task";
 
+/// The chain tip that the last successful validation checked the wallet's outputs against
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct TxoValidationCheckpoint {
+    pub height: u64,
+    pub hash: BlockHash,
+}
+
 pub struct TxoValidationTask<TBackend, TWalletConnectivity> {
     operation_id: u64,
     db: OutputManagerDatabase<TBackend>,
@@ -59,6 +67,8 @@ pub struct TxoValidationTask<TBackend, TWalletConnectivity> {
     connectivity: TWalletConnectivity,
     event_publisher: OutputManagerEventSender,
     config: OutputManagerServiceConfig,
+    /// Block hashes already fetched from the base node during this validation, by height
+    header_cache: HashMap<u64, Option<BlockHash>>,
 }
 
 impl<TBackend, TWalletConnectivity> TxoValidationTask<TBackend, TWalletConnectivity>
@@ -80,10 +90,18 @@ where
             connectivity,
             event_publisher,
             config,
+            header_cache: HashMap::new(),
         }
     }
 
-    pub async fn execute(mut self) -> Result<u64, OutputManagerProtocolError> {
+    /// Validates the wallet's outputs against the chain. `checkpoint` is the tip the previous successful validation
+    /// ran against: blocks at or below it do not have to be searched for reorgs again, and outputs that were mined
+    /// and unspent at that tip do not have to be queried again while the tip has not moved. It is updated to the
+    /// current tip when this validation succeeds.
+    pub async fn execute(
+        mut self,
+        checkpoint: &mut Option<TxoValidationCheckpoint>,
+    ) -> Result<u64, OutputManagerProtocolError> {
         let mut base_node_client = self
             .connectivity
             .obtain_base_node_wallet_rpc_client()
@@ -102,14 +120,56 @@ where
             "Starting TXO validation protocol with peer {} (Id: {})", base_node_peer, self.operation_id,
         );
 
-        let last_mined_header = self.check_for_reorgs(&mut base_node_client).await?;
+        let tip = self
+            .get_chain_tip(&mut base_node_client)
+            .await
+            .for_protocol(self.operation_id)?;
+        // The checkpoint is only restored once this validation has succeeded
+        let verified_checkpoint = match checkpoint.take() {
+            Some(cp) => {
+                if self
+                    .is_block_in_chain(cp.height, cp.hash, &mut base_node_client)
+                    .await
+                    .for_protocol(self.operation_id)?
+                {
+                    Some(cp)
+                } else {
+                    debug!(
+                        target: LOG_TARGET,
+                        "Last validated tip {} at height {} is no longer in the chain (Operation ID: {})",
+                        cp.hash.to_hex(),
+                        cp.height,
+                        self.operation_id
+                    );
+                    None
+                }
+            },
+            None => None,
+        };
 
-        self.update_unconfirmed_outputs(&mut base_node_client).await?;
+        let last_mined_header = self
+            .check_for_reorgs(&mut base_node_client, verified_checkpoint)
+            .await?;
 
-        self.update_spent_outputs(&mut base_node_client, last_mined_header)
+        let num_newly_mined = self
+            .update_unconfirmed_outputs(&mut base_node_client, tip.map(|tip| tip.height))
             .await?;
 
+        // Spending an output needs a new block, so while the tip has not moved only newly found outputs can have
+        // been spent
+        if num_newly_mined > 0 || tip.is_none() || verified_checkpoint != tip {
+            self.update_spent_outputs(&mut base_node_client, last_mined_header)
+                .await?;
+        } else {
+            debug!(
+                target: LOG_TARGET,
+                "Chain tip has not moved since the last validation, not checking for spent outputs (Operation ID: {})",
+                self.operation_id
+            );
+        }
+
         self.update_invalid_outputs(&mut base_node_client).await?;
+        *checkpoint = tip;
 
         self.publish_event(OutputManagerEvent::TxoValidationSuccess(self.operation_id));
         debug!(
@@ -151,6 +211,7 @@ where
                 unmined.len(),
                 self.operation_id
             );
+            let mut updates = Vec::with_capacity(batch.len());
             for (output, mined_height, mined_in_block, mmr_position, mined_timestamp) in &mined {
                 info!(
                     target: LOG_TARGET,
@@ -162,21 +223,23 @@ where
                     tip_height,
                     self.operation_id
                 );
-                self.update_output_as_mined(
+                updates.push(self.mined_update(
                     output,
                     mined_in_block,
                     *mined_height,
                     *mmr_position,
                     tip_height,
                     *mined_timestamp,
-                )
-                .await?;
-            }
-            for output in unmined {
-                self.db
-                    .update_last_validation_timestamp(output.hash)
-                    .for_protocol(self.operation_id)?;
+                ));
             }
+            updates.extend(
+                unmined
+                    .iter()
+                    .map(|output| OutputValidationUpdate::Validated { hash: output.hash }),
+            );
+            self.db
+                .apply_validation_updates(updates)
+                .for_protocol(self.operation_id)?;
         }
         Ok(())
     }
@@ -213,6 +276,7 @@ where
                 .await
                 .for_protocol(self.operation_id)?;
 
+            let mut updates = Vec::with_capacity(batch.len());
             for output in batch {
                 let mined_mmr_position = if let Some(pos) = output.mined_mmr_position {
                     pos
@@ -224,9 +288,7 @@ where
                         output.commitment.to_hex(),
                         self.operation_id
                     );
-                    self.db
-                        .set_output_to_unmined_and_invalid(output.hash)
-                        .for_protocol(self.operation_id)?;
+                    updates.push(OutputValidationUpdate::UnminedAndInvalid { hash: output.hash });
                     continue;
                 };
 
@@ -258,9 +320,7 @@ where
                             output.commitment.to_hex(),
                             self.operation_id
                         );
-                        self.db
-                            .set_output_to_unmined_and_invalid(output.hash)
-                            .for_protocol(self.operation_id)?;
+                        updates.push(OutputValidationUpdate::UnminedAndInvalid { hash: output.hash });
                         continue;
                     };
 
@@ -276,9 +336,12 @@ where
                     let confirmed = (deleted_bitmap_response.height_of_longest_chain - deleted_height) >=
                         self.config.num_confirmations_required;
 
-                    self.db
-                        .mark_output_as_spent(output.hash, deleted_height, deleted_block, confirmed)
-                        .for_protocol(self.operation_id)?;
+                    updates.push(OutputValidationUpdate::Spent {
+                        hash: output.hash,
+                        deleted_height,
+                        deleted_in_block: deleted_block,
+                        confirmed,
+                    });
                     info!(
                         target: LOG_TARGET,
                         "Updating output comm:{}: hash {} as spent at tip height {} (Operation ID: {})",
@@ -294,9 +357,7 @@ where
                     .contains(&mined_mmr_position) &&
                     output.marked_deleted_at_height.is_some()
                 {
-                    self.db
-                        .mark_output_as_unspent(output.hash)
-                        .for_protocol(self.operation_id)?;
+                    updates.push(OutputValidationUpdate::Unspent { hash: output.hash });
                     info!(
                         target: LOG_TARGET,
                         "Updating output comm:{}: hash {} as unspent at tip height {} (Operation ID: {})",
@@ -307,15 +368,74 @@ where
                     );
                 }
             }
+            self.db
+                .apply_validation_updates(updates)
+                .for_protocol(self.operation_id)?;
         }
         Ok(())
     }
 
+    /// Updates outputs that have not been found or confirmed in the chain yet and returns the number of outputs that
+    /// were found in a block
     async fn update_unconfirmed_outputs(
         &self,
         wallet_client: &mut BaseNodeWalletRpcClient,
-    ) -> Result<(), OutputManagerProtocolError> {
-        let unconfirmed_outputs = self.db.fetch_unconfirmed_outputs().for_protocol(self.operation_id)?;
+        tip_height: Option<u64>,
+    ) -> Result<usize, OutputManagerProtocolError> {
+        let (mined_unconfirmed, unconfirmed_outputs): (Vec<_>, Vec<_>) = self
+            .db
+            .fetch_unconfirmed_outputs()
+            .for_protocol(self.operation_id)?
+            .into_iter()
+            .partition(|o| {
+                tip_height.is_some() &&
+                    o.status == OutputStatus::UnspentMinedUnconfirmed &&
+                    o.mined_height.is_some() &&
+                    o.mined_in_block.is_some() &&
+                    o.mined_mmr_position.is_some() &&
+                    o.mined_timestamp.is_some()
+            });
+
+        // The reorg check has already confirmed that the blocks these outputs were mined in are still in the chain,
+        // so only their confirmations change and those follow from the tip height
+        let tip_height = tip_height.unwrap_or_default();
+        let mut updates = Vec::with_capacity(mined_unconfirmed.len());
+        for output in &mined_unconfirmed {
+            let (mined_height, mined_in_block, mmr_position, mined_timestamp) = match (
+                output.mined_height,
+                output.mined_in_block,
+                output.mined_mmr_position,
+                output.mined_timestamp,
+            ) {
+                (Some(height), Some(block), Some(position), Some(timestamp)) => (height, block, position, timestamp),
+                _ => continue,
+            };
+            if tip_height.saturating_sub(mined_height) < self.config.num_confirmations_required {
+                continue;
+            }
+            info!(
+                target: LOG_TARGET,
+                "Updating output comm:{}: hash {} as confirmed at height {} with current tip at {} (Operation ID: {})",
+                output.commitment.to_hex(),
+                output.hash.to_hex(),
+                mined_height,
+                tip_height,
+                self.operation_id
+            );
+            updates.push(OutputValidationUpdate::Mined {
+                hash: output.hash,
+                mined_height,
+                mined_in_block,
+                mmr_position,
+                confirmed: true,
+                mined_timestamp: mined_timestamp.timestamp() as u64,
+            });
+        }
+        self.db
+            .apply_validation_updates(updates)
+            .for_protocol(self.operation_id)?;
+
+        let mut num_mined = 0;
 
         for batch in unconfirmed_outputs.chunks(self.config.tx_validator_batch_size) {
             debug!(
@@ -336,6 +456,7 @@ where
                 unmined.len(),
                 self.operation_id
             );
+            let mut updates = Vec::with_capacity(mined.len());
             for (output, mined_height, mined_in_block, mmr_position, mined_timestamp) in &mined {
                 info!(
                     target: LOG_TARGET,
@@ -346,19 +467,22 @@ where
                     tip_height,
                     self.operation_id
                 );
-                self.update_output_as_mined(
+                updates.push(self.mined_update(
                     output,
                     mined_in_block,
                     *mined_height,
                     *mmr_position,
                     tip_height,
                     *mined_timestamp,
-                )
-                .await?;
+                ));
             }
+            self.db
+                .apply_validation_updates(updates)
+                .for_protocol(self.operation_id)?;
+            num_mined += mined.len();
         }
 
-        Ok(())
+        Ok(num_mined)
     }
 
     // Returns the last header found still in the chain
@@ -366,6 +490,7 @@ where
     async fn check_for_reorgs(
         &mut self,
         client: &mut BaseNodeWalletRpcClient,
+        verified_checkpoint: Option<TxoValidationCheckpoint>,
     ) -> Result<Option<BlockHash>, OutputManagerProtocolError> {
         let mut last_mined_header_hash = None;
         debug!(
@@ -373,6 +498,42 @@ where
             "Checking last mined TXO to see if the base node has re-orged (Operation ID: {})", self.operation_id
         );
 
+        // Outputs are only recorded against blocks of one chain, so the blocks that are still in the chain are a
+        // prefix of the blocks they were mined or spent in, ordered by height. Binary search for the first block that
+        // was reorged out, skipping the blocks at or below the verified checkpoint.
+        let checkpoints = self.db.fetch_block_checkpoints().for_protocol(self.operation_id)?;
+        let unverified = &checkpoints[verified_checkpoint
+            .map(|cp| checkpoints.partition_point(|(height, _)| *height <= cp.height))
+            .unwrap_or(0)..];
+        let (mut low, mut high) = (0, unverified.len());
+        while low < high {
+            let mid = low + (high - low) / 2;
+            let (height, hash) = unverified[mid];
+            if self
+                .is_block_in_chain(height, hash, client)
+                .await
+                .for_protocol(self.operation_id)?
+            {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if let Some((reorg_height, reorg_hash)) = unverified.get(low) {
+            warn!(
+                target: LOG_TARGET,
+                "Block {} at height {} has been reorged out, will try to find the outputs mined or spent from this \
+                 height again, but these funds have potentially been re-orged out of the chain (Operation ID: {})",
+                reorg_hash.to_hex(),
+                reorg_height,
+                self.operation_id
+            );
+            self.invalidate_outputs_from_height(*reorg_height)?;
+        }
+
+        // The outputs at the new tip of the wallet's view of the chain are checked one at a time, which also catches
+        // data that does not follow the order above
+
         while let Some(last_spent_output) = self.db.get_last_spent_output().for_protocol(self.operation_id)? {
             let mined_height = if let Some(height) = last_spent_output.marked_deleted_at_height {
                 height
@@ -476,11 +637,66 @@ where
         Ok(last_mined_header_hash)
     }
 
+    /// Marks outputs spent at or above `height` as unspent and outputs mined at or above it as unmined so that they
+    /// are validated again
+    fn invalidate_outputs_from_height(&self, height: u64) -> Result<(), OutputManagerProtocolError> {
+        while let Some(output) = self.db.get_last_spent_output().for_protocol(self.operation_id)? {
+            if output.marked_deleted_at_height.map_or(true, |h| h < height) {
+                break;
+            }
+            self.db
+                .mark_output_as_unspent(output.hash)
+                .for_protocol(self.operation_id)?;
+        }
+        while let Some(output) = self.db.get_last_mined_output().for_protocol(self.operation_id)? {
+            if output.mined_height.map_or(true, |h| h < height) {
+                break;
+            }
+            self.db
+                .set_output_to_unmined_and_invalid(output.hash)
+                .for_protocol(self.operation_id)?;
+        }
+        Ok(())
+    }
+
+    /// Returns the tip of the base node's chain, or None if the base node did not report a usable tip in which case
+    /// the validation does not take any shortcuts
+    async fn get_chain_tip(
+        &self,
+        client: &mut BaseNodeWalletRpcClient,
+    ) -> Result<Option<TxoValidationCheckpoint>, OutputManagerError> {
+        let tip = client.get_tip_info().await?.metadata.and_then(|metadata| {
+            Some(TxoValidationCheckpoint {
+                height: metadata.height_of_longest_chain?,
+                hash: metadata.best_block?.try_into().ok()?,
+            })
+        });
+        if tip.is_none() {
+            warn!(
+                target: LOG_TARGET,
+                "Base node did not report a valid chain tip, validating all outputs (Operation ID: {})", self.operation_id
+            );
+        }
+        Ok(tip)
+    }
+
+    async fn is_block_in_chain(
+        &mut self,
+        height: u64,
+        hash: BlockHash,
+        client: &mut BaseNodeWalletRpcClient,
+    ) -> Result<bool, OutputManagerError> {
+        Ok(self.get_base_node_block_at_height(height, client).await? == Some(hash))
+    }
+
     async fn get_base_node_block_at_height(
         &mut self,
         height: u64,
         client: &mut BaseNodeWalletRpcClient,
     ) -> Result<Option<BlockHash>, OutputManagerError> {
+        if let Some(hash) = self.header_cache.get(&height) {
+            return Ok(*hash);
+        }
         let result = match client.get_header_by_height(height).await {
             Ok(r) => r,
             Err(rpc_error) => {
@@ -491,6 +707,7 @@ where
                 match &rpc_error {
                     RequestFailed(status) => {
                         if status.as_status_code().is_not_found() {
+                            self.header_cache.insert(height, None);
                             return Ok(None);
                         } else {
                             return Err(rpc_error.into());
@@ -506,7 +723,9 @@ where
         let block_header: BlockHeader = result
             .try_into()
             .map_err(|s| OutputManagerError::InvalidMessageError(format!("Could not convert block header: {}", s)))?;
-        Ok(Some(block_header.hash()))
+        let hash = block_header.hash();
+        self.header_cache.insert(height, Some(hash));
+        Ok(Some(hash))
     }
 
     async fn query_base_node_for_outputs(
@@ -573,7 +792,7 @@ where
     }
 
     #[allow(clippy::ptr_arg)]
-    async fn update_output_as_mined(
+    fn mined_update(
         &self,
         tx: &DbUnblindedOutput,
         mined_in_block: &BlockHash,
@@ -581,21 +800,15 @@ where
         mmr_position: u64,
         tip_height: u64,
         mined_timestamp: u64,
-    ) -> Result<(), OutputManagerProtocolError> {
-        let confirmed = (tip_height - mined_height) >= self.config.num_confirmations_required;
-
-        self.db
-            .set_received_output_mined_height_and_status(
-                tx.hash,
-                mined_height,
-                *mined_in_block,
-                mmr_position,
-                confirmed,
-                mined_timestamp,
-            )
-            .for_protocol(self.operation_id)?;
-
-        Ok(())
+    ) -> OutputValidationUpdate {
+        OutputValidationUpdate::Mined {
+            hash: tx.hash,
+            mined_height,
+            mined_in_block: *mined_in_block,
+            mmr_position,
+            confirmed: (tip_height - mined_height) >= self.config.num_confirmations_required,
+            mined_timestamp,
+        }
     }
 
     fn publish_event(&self, event: OutputManagerEvent) {
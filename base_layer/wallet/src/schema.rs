@@ -42,6 +42,17 @@ diesel::table! {
     }
 }
 
+diesel::table! {
+    deleted_outputs (revision) {
+        revision -> BigInt,
+        commitment -> Nullable<Binary>,
+        value -> BigInt,
+        status -> Integer,
+        mined_height -> Nullable<BigInt>,
+        mined_timestamp -> Nullable<Timestamp>,
+    }
+}
+
 diesel::table! {
     inbound_transactions (tx_id) {
         tx_id -> BigInt,
@@ -92,6 +103,21 @@ diesel::table! {
     }
 }
 
+diesel::table! {
+    output_revision (id) {
+        id -> Integer,
+        revision -> BigInt,
+    }
+}
+
+diesel::table! {
+    output_totals (status, source) {
+        status -> Integer,
+        source -> Integer,
+        value -> BigInt,
+    }
+}
+
 diesel::table! {
     outputs (id) {
         id -> Integer,
@@ -129,6 +155,7 @@ diesel::table! {
         minimum_value_promise -> BigInt,
         source -> Integer,
         last_validation_timestamp -> Nullable<Timestamp>,
+        revision -> BigInt,
     }
 }
 
@@ -153,10 +180,13 @@ diesel::allow_tables_to_appear_in_same_query!(
     client_key_values,
     completed_transactions,
     contacts,
+    deleted_outputs,
     inbound_transactions,
     key_manager_states,
     known_one_sided_payment_scripts,
     outbound_transactions,
+    output_revision,
+    output_totals,
     outputs,
     scanned_blocks,
     wallet_settings,
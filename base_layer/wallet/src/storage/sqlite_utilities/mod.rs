@@ -38,6 +38,7 @@ use crate::{
 };
 
 pub(crate) mod wallet_db_connection;
+pub mod write_batcher;
 
 const LOG_TARGET: &str = "wallet::storage:sqlite_utilities";
 
@@ -66,7 +67,7 @@ pub fn run_migration_and_create_sqlite_connection<P: AsRef<Path>>(
     embedded_migrations::run(&connection)
         .map_err(|err| WalletStorageError::DatabaseMigrationError(format!("Database migration failed {}", err)))?;
 
-    Ok(WalletDbConnection::new(pool, Some(file_lock)))
+    WalletDbConnection::new(pool, Some(file_lock))
 }
 
 pub fn acquire_exclusive_file_lock(db_path: &Path) -> Result<File, WalletStorageError> {
@@ -24,24 +24,31 @@ use std::{fs::File, sync::Arc};
 
 use diesel::{
     r2d2::{ConnectionManager, PooledConnection},
+    result::Error as DieselError,
     SqliteConnection,
 };
 use tari_common_sqlite::sqlite_connection_pool::SqliteConnectionPool;
 
-use crate::error::WalletStorageError;
+use crate::{
+    error::WalletStorageError,
+    storage::sqlite_utilities::write_batcher::{PendingWrite, WriteBatcher},
+};
 
 #[derive(Clone)]
 pub struct WalletDbConnection {
     pool: SqliteConnectionPool,
+    write_batcher: WriteBatcher,
     _file_lock: Arc<Option<File>>,
 }
 
 impl WalletDbConnection {
-    pub fn new(pool: SqliteConnectionPool, file_lock: Option<File>) -> Self {
-        Self {
+    pub fn new(pool: SqliteConnectionPool, file_lock: Option<File>) -> Result<Self, WalletStorageError> {
+        let write_batcher = WriteBatcher::new(pool.clone())?;
+        Ok(Self {
             pool,
+            write_batcher,
             _file_lock: Arc::new(file_lock),
-        }
+        })
     }
 
     pub fn get_pooled_connection(
@@ -51,4 +58,15 @@ impl WalletDbConnection {
             .get_pooled_connection()
             .map_err(WalletStorageError::DieselR2d2Error)
     }
+
+    /// Queues `op` for the next group commit without waiting for it, so that several writes can share one commit. The
+    /// caller must not hold a pooled connection while waiting on the result, as the writer needs one to run the batch.
+    pub fn submit_batched_write<F, R, E>(&self, op: F) -> PendingWrite<R, E>
+    where
+        F: FnOnce(&SqliteConnection) -> Result<R, E> + Send + 'static,
+        R: Send + 'static,
+        E: From<DieselError> + From<WalletStorageError> + Send + 'static,
+    {
+        self.write_batcher.submit(op)
+    }
 }
@@ -0,0 +1,235 @@
+// Copyright 2022. The Tari Project
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+// following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+// disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+// following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+// products derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//! Group commit for the wallet database.
+//!
+//! Output and transaction validation used to commit each output or transaction update in its own SQLite transaction,
+//! so a validation round cost one fsync per update. A round now queues all of its updates with the `WriteBatcher`
+//! before waiting on any of them. A single writer thread runs everything that was queued by the time it becomes free
+//! in one transaction. Each write runs in its own savepoint so that a failing write is rolled back on its own, and its
+//! caller only receives the result once the whole batch has been committed.
+//!
+//! Writes that arrive one at a time from independent events, such as contact liveness updates and key manager index
+//! increments, still use a pooled connection directly. Nothing would be queued behind them, so the batcher would only
+//! add a hop through the writer thread.
+
+use std::{
+    sync::{mpsc, Arc, Mutex},
+    thread,
+    time::Instant,
+};
+
+use diesel::{result::Error as DieselError, Connection, SqliteConnection};
+use log::*;
+use tari_common_sqlite::sqlite_connection_pool::SqliteConnectionPool;
+
+use crate::error::WalletStorageError;
+
+const LOG_TARGET: &str = "wallet::storage::write_batcher";
+
+/// The maximum number of writes that are committed in one transaction
+pub const MAX_WRITE_BATCH_SIZE: usize = 256;
+
+/// Reports whether the batch a write was part of has been committed
+type Completion = Box<dyn FnOnce(bool) + Send>;
+/// Runs a write on the batch connection, or fails it when no connection could be acquired
+type Job = Box<dyn FnOnce(Result<&SqliteConnection, &WalletStorageError>) -> Completion + Send>;
+
+#[derive(Clone)]
+pub struct WriteBatcher {
+    sender: Arc<Mutex<mpsc::Sender<Job>>>,
+}
+
+impl WriteBatcher {
+    /// Starts the writer thread. The thread exits once every clone of the returned batcher has been dropped.
+    pub fn new(pool: SqliteConnectionPool) -> Result<Self, WalletStorageError> {
+        let (sender, receiver) = mpsc::channel();
+        thread::Builder::new()
+            .name("wallet-db-writer".to_string())
+            .spawn(move || run_writer(&pool, &receiver))?;
+        Ok(Self {
+            sender: Arc::new(Mutex::new(sender)),
+        })
+    }
+
+    /// Queues `op` for the next batch and returns a handle to wait for its result
+    pub fn submit<F, R, E>(&self, op: F) -> PendingWrite<R, E>
+    where
+        F: FnOnce(&SqliteConnection) -> Result<R, E> + Send + 'static,
+        R: Send + 'static,
+        E: From<DieselError> + From<WalletStorageError> + Send + 'static,
+    {
+        let (result_sender, receiver) = mpsc::sync_channel(1);
+        let job: Job = Box::new(move |conn: Result<&SqliteConnection, &WalletStorageError>| {
+            let result = match conn {
+                Ok(conn) => conn.transaction(|| op(conn)),
+                Err(e) => Err(WalletStorageError::UnexpectedResult(format!(
+                    "Could not acquire a connection for the write batch: {}",
+                    e
+                ))
+                .into()),
+            };
+            let complete: Completion = Box::new(move |committed| {
+                let result = match result {
+                    Ok(_) if !committed => Err(DieselError::RollbackTransaction.into()),
+                    result => result,
+                };
+                // The caller may have stopped waiting, in which case there is nobody to tell
+                let _ = result_sender.send(result);
+            });
+            complete
+        });
+
+        let sent = self.sender.lock().unwrap_or_else(|e| e.into_inner()).send(job);
+        if let Err(mpsc::SendError(job)) = sent {
+            // The writer thread is gone, fail the write straight away
+            let e = WalletStorageError::UnexpectedResult("The wallet database writer has stopped".to_string());
+            job(Err(&e))(false);
+        }
+        PendingWrite { receiver }
+    }
+
+    /// Queues `op` for the next batch and blocks until the batch has been committed
+    pub fn execute<F, R, E>(&self, op: F) -> Result<R, E>
+    where
+        F: FnOnce(&SqliteConnection) -> Result<R, E> + Send + 'static,
+        R: Send + 'static,
+        E: From<DieselError> + From<WalletStorageError> + Send + 'static,
+    {
+        self.submit(op).wait()
+    }
+}
+
+/// The completion handle of a queued write
+pub struct PendingWrite<R, E> {
+    receiver: mpsc::Receiver<Result<R, E>>,
+}
+
+impl<R, E> PendingWrite<R, E>
+where E: From<WalletStorageError>
+{
+    /// Blocks until the batch containing this write has been committed and returns the result of the write
+    pub fn wait(self) -> Result<R, E> {
+        self.receiver.recv().unwrap_or_else(|_| {
+            Err(WalletStorageError::UnexpectedResult("The wallet database writer dropped a write".to_string()).into())
+        })
+    }
+}
+
+fn run_writer(pool: &SqliteConnectionPool, receiver: &mpsc::Receiver<Job>) {
+    // Block for the first write of a batch, then take everything that queued up while the previous batch committed
+    while let Ok(first) = receiver.recv() {
+        let mut jobs = vec![first];
+        while jobs.len() < MAX_WRITE_BATCH_SIZE {
+            match receiver.try_recv() {
+                Ok(job) => jobs.push(job),
+                Err(_) => break,
+            }
+        }
+
+        let start = Instant::now();
+        let num_jobs = jobs.len();
+        let mut completions = Vec::with_capacity(num_jobs);
+        let committed = match pool.get_pooled_connection() {
+            Ok(conn) => {
+                let result = conn.transaction::<_, DieselError, _>(|| {
+                    completions.extend(jobs.drain(..).map(|job| job(Ok(&*conn))));
+                    Ok(())
+                });
+                if let Err(e) = &result {
+                    error!(target: LOG_TARGET, "Could not commit a batch of {} writes: {}", num_jobs, e);
+                }
+                result.is_ok()
+            },
+            Err(e) => {
+                let e = WalletStorageError::DieselR2d2Error(e);
+                error!(target: LOG_TARGET, "Could not run a batch of {} writes: {}", num_jobs, e);
+                completions.extend(jobs.drain(..).map(|job| job(Err(&e))));
+                false
+            },
+        };
+        // If the transaction could not be started the writes never ran
+        if !jobs.is_empty() {
+            let e = WalletStorageError::UnexpectedResult("The write batch could not be started".to_string());
+            completions.extend(jobs.drain(..).map(|job| job(Err(&e))));
+        }
+        for complete in completions {
+            complete(committed);
+        }
+        trace!(
+            target: LOG_TARGET,
+            "sqlite profile - write batch of {}: {} ms",
+            num_jobs,
+            start.elapsed().as_millis()
+        );
+    }
+    debug!(target: LOG_TARGET, "Wallet database writer stopped");
+}
+
+#[cfg(test)]
+mod test {
+    use diesel::{sql_query, RunQueryDsl};
+    use tempfile::tempdir;
+
+    use super::*;
+
+    #[derive(QueryableByName)]
+    struct Count {
+        #[sql_type = "diesel::sql_types::BigInt"]
+        count: i64,
+    }
+
+    #[test]
+    fn it_commits_concurrent_writes_and_isolates_failures() {
+        let db_tempdir = tempdir().unwrap();
+        let db_path = format!("{}/{}", db_tempdir.path().to_str().unwrap(), "write_batcher.sqlite3");
+        let mut pool = SqliteConnectionPool::new(db_path, 2, true, true, std::time::Duration::from_secs(60));
+        pool.create_pool().unwrap();
+        sql_query("CREATE TABLE items (id INTEGER PRIMARY KEY NOT NULL)")
+            .execute(&pool.get_pooled_connection().unwrap())
+            .unwrap();
+
+        let batcher = WriteBatcher::new(pool.clone()).unwrap();
+        let pending = (0..100)
+            .map(|i| {
+                batcher.submit(move |conn| {
+                    sql_query(format!("INSERT INTO items (id) VALUES ({})", i % 90))
+                        .execute(conn)
+                        .map_err(WalletStorageError::from)
+                })
+            })
+            .collect::<Vec<_>>();
+        let results = pending.into_iter().map(PendingWrite::wait).collect::<Vec<_>>();
+        // The ids from 90 onwards are duplicates, their savepoints are rolled back without affecting the batch
+        assert!(results[..90].iter().all(|r| matches!(r, Ok(1))));
+        assert!(results[90..].iter().all(Result::is_err));
+
+        let count = batcher
+            .execute(|conn| {
+                sql_query("SELECT COUNT(*) AS count FROM items")
+                    .get_result::<Count>(conn)
+                    .map_err(WalletStorageError::from)
+            })
+            .unwrap();
+        assert_eq!(count.count, 90);
+    }
+}
@@ -50,12 +50,17 @@ use crate::{
     output_manager_service::UtxoSelectionCriteria,
     transaction_service::{
         error::TransactionServiceError,
-        storage::models::{
-            CompletedTransaction,
-            InboundTransaction,
-            OutboundTransaction,
-            TxCancellationReason,
-            WalletTransaction,
+        storage::{
+            models::{
+                CompletedTransaction,
+                InboundTransaction,
+                OutboundTransaction,
+                TransactionSummaryFilter,
+                TransactionSummaryPosition,
+                TxCancellationReason,
+                WalletTransaction,
+            },
+            sqlite_db::TransactionSummary,
         },
     },
     OperationId,
@@ -72,6 +77,11 @@ pub enum TransactionServiceRequest {
     GetCancelledPendingOutboundTransactions,
     GetCancelledCompletedTransactions,
     GetCompletedTransaction(TxId),
+    GetTransactionSummaries {
+        filter: TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+    },
     GetAnyTransaction(TxId),
     SendTransaction {
         destination: TariAddress,
@@ -123,6 +133,7 @@ pub enum TransactionServiceRequest {
         current_height: Option<u64>,
         mined_timestamp: Option<NaiveDateTime>,
     },
+    ImportUtxosWithStatus(Vec<UtxoImport>),
     SubmitTransactionToSelf(TxId, Transaction, MicroTari, MicroTari, String),
     SetLowPowerMode,
     SetNormalPowerMode,
@@ -154,6 +165,9 @@ impl fmt::Display for TransactionServiceRequest {
             Self::GetCancelledPendingOutboundTransactions => write!(f, "GetCancelledPendingOutboundTransactions"),
             Self::GetCancelledCompletedTransactions => write!(f, "GetCancelledCompletedTransactions"),
             Self::GetCompletedTransaction(t) => write!(f, "GetCompletedTransaction({})", t),
+            Self::GetTransactionSummaries { after, limit, .. } => {
+                write!(f, "GetTransactionSummaries(after: {:?}, limit: {})", after, limit)
+            },
             Self::SendTransaction {
                 destination,
                 amount,
@@ -211,6 +225,7 @@ impl fmt::Display for TransactionServiceRequest {
                 current_height,
                 mined_timestamp
             ),
+            Self::ImportUtxosWithStatus(imports) => write!(f, "ImportUtxos ({} outputs)", imports.len()),
             Self::SubmitTransactionToSelf(tx_id, _, _, _, _) => write!(f, "SubmitTransaction ({})", tx_id),
             Self::SetLowPowerMode => write!(f, "SetLowPowerMode "),
             Self::SetNormalPowerMode => write!(f, "SetNormalPowerMode"),
@@ -240,8 +255,10 @@ pub enum TransactionServiceResponse {
     PendingOutboundTransactions(HashMap<TxId, OutboundTransaction>),
     CompletedTransactions(HashMap<TxId, CompletedTransaction>),
     CompletedTransaction(Box<CompletedTransaction>),
+    TransactionSummaries(Vec<TransactionSummary>),
     BaseNodePublicKeySet,
     UtxoImported(TxId),
+    UtxosImported(Vec<Option<TxId>>),
     TransactionSubmitted,
     LowPowerModeSet,
     NormalPowerModeSet,
@@ -273,6 +290,19 @@ impl Display for TransactionSendStatus {
     }
 }
 
+/// An output found by scanning the blockchain that is recorded as an imported transaction
+#[derive(Clone, Debug)]
+pub struct UtxoImport {
+    pub amount: MicroTari,
+    pub source_address: TariAddress,
+    pub message: String,
+    pub maturity: Option<u64>,
+    pub import_status: ImportStatus,
+    pub tx_id: Option<TxId>,
+    pub current_height: Option<u64>,
+    pub mined_timestamp: Option<NaiveDateTime>,
+}
+
 /// Events that can be published on the Text Message Service Event Stream
 #[derive(Clone, Debug, Hash, PartialEq, Eq)]
 pub enum TransactionEvent {
@@ -664,6 +694,24 @@ impl TransactionServiceHandle {
         }
     }
 
+    /// Fetch a page of at most `limit` transactions matching the filter, newest first and starting after the `after`
+    /// position. The transaction bodies are not loaded.
+    pub async fn get_transaction_summaries(
+        &mut self,
+        filter: TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+    ) -> Result<Vec<TransactionSummary>, TransactionServiceError> {
+        match self
+            .handle
+            .call(TransactionServiceRequest::GetTransactionSummaries { filter, after, limit })
+            .await??
+        {
+            TransactionServiceResponse::TransactionSummaries(c) => Ok(c),
+            _ => Err(TransactionServiceError::UnexpectedApiResponse),
+        }
+    }
+
     pub async fn get_any_transaction(
         &mut self,
         tx_id: TxId,
@@ -708,6 +756,22 @@ impl TransactionServiceHandle {
         }
     }
 
+    /// Imports a batch of outputs and starts a single transaction validation for the whole batch. The result has an
+    /// entry per import, which is `None` if the output had already been imported.
+    pub async fn import_utxos_with_status(
+        &mut self,
+        imports: Vec<UtxoImport>,
+    ) -> Result<Vec<Option<TxId>>, TransactionServiceError> {
+        match self
+            .handle
+            .call(TransactionServiceRequest::ImportUtxosWithStatus(imports))
+            .await??
+        {
+            TransactionServiceResponse::UtxosImported(tx_ids) => Ok(tx_ids),
+            _ => Err(TransactionServiceError::UnexpectedApiResponse),
+        }
+    }
+
     pub async fn submit_transaction(
         &mut self,
         tx_id: TxId,
@@ -51,7 +51,7 @@ use crate::{
         handle::{TransactionEvent, TransactionEventSender},
         storage::{
             database::{TransactionBackend, TransactionDatabase},
-            models::TxCancellationReason,
+            models::{TransactionValidationUpdate, TxCancellationReason},
             sqlite_db::UnconfirmedTransactionInfo,
         },
     },
@@ -126,6 +126,7 @@ where
                 unmined.len(),
                 self.operation_id
             );
+            let mut updates = Vec::with_capacity(mined.len());
             for (mined_tx, mined_height, mined_in_block, num_confirmations, mined_timestamp) in &mined {
                 debug!(
                     target: LOG_TARGET,
@@ -134,18 +135,25 @@ where
                     *num_confirmations >= self.config.num_confirmations_required,
                     self.operation_id
                 );
-                self.update_transaction_as_mined(
+                updates.push(self.mined_update(
                     mined_tx.tx_id,
                     &mined_tx.status,
                     mined_in_block,
                     *mined_height,
                     *num_confirmations,
                     *mined_timestamp,
-                )
-                .await?;
+                ));
+            }
+            self.db
+                .apply_validation_updates(updates)
+                .for_protocol(self.operation_id)?;
+            for (mined_tx, _, _, num_confirmations, _) in &mined {
+                self.transaction_mined(mined_tx.tx_id, &mined_tx.status, *num_confirmations)
+                    .await;
                 state_changed = true;
             }
             if let Some((tip_height, tip_block, tip_mined_timestamp)) = tip_info {
+                let mut unmined_tx_ids = Vec::with_capacity(unmined.len());
                 for unmined_tx in &unmined {
                     // Treat coinbases separately
                     if unmined_tx.is_coinbase() {
@@ -180,11 +188,23 @@ where
                             target: LOG_TARGET,
                             "Updated transaction {} as unmined (Operation ID: {})", unmined_tx.tx_id, self.operation_id
                         );
-                        self.update_transaction_as_unmined(unmined_tx.tx_id, &unmined_tx.status)
-                            .await?;
-                        self.publish_event(TransactionEvent::NewBlockMined(unmined_tx.tx_id));
+                        self.set_coinbase_not_abandoned(unmined_tx.tx_id, &unmined_tx.status)
+                            .await;
+                        unmined_tx_ids.push(unmined_tx.tx_id);
                     }
                 }
+                self.db
+                    .apply_validation_updates(
+                        unmined_tx_ids
+                            .iter()
+                            .map(|tx_id| TransactionValidationUpdate::Unmined { tx_id: *tx_id })
+                            .collect(),
+                    )
+                    .for_protocol(self.operation_id)?;
+                for tx_id in unmined_tx_ids {
+                    self.publish_event(TransactionEvent::TransactionBroadcast(tx_id));
+                    self.publish_event(TransactionEvent::NewBlockMined(tx_id));
+                }
             }
         }
         if state_changed {
@@ -392,27 +412,28 @@ where
     }
 
     #[allow(clippy::ptr_arg)]
-    async fn update_transaction_as_mined(
-        &mut self,
+    fn mined_update(
+        &self,
         tx_id: TxId,
         status: &TransactionStatus,
         mined_in_block: &BlockHash,
         mined_height: u64,
         num_confirmations: u64,
         mined_timestamp: u64,
-    ) -> Result<(), TransactionServiceProtocolError<OperationId>> {
-        self.db
-            .set_transaction_mined_height(
-                tx_id,
-                mined_height,
-                *mined_in_block,
-                mined_timestamp,
-                num_confirmations,
-                num_confirmations >= self.config.num_confirmations_required,
-                status.is_faux(),
-            )
-            .for_protocol(self.operation_id)?;
+    ) -> TransactionValidationUpdate {
+        TransactionValidationUpdate::Mined {
+            tx_id,
+            mined_height,
+            mined_in_block: *mined_in_block,
+            mined_timestamp,
+            num_confirmations,
+            is_confirmed: num_confirmations >= self.config.num_confirmations_required,
+            is_faux: status.is_faux(),
+        }
+    }
 
+    /// Publishes the event for a transaction whose mined height has been stored
+    async fn transaction_mined(&mut self, tx_id: TxId, status: &TransactionStatus, num_confirmations: u64) {
         if num_confirmations >= self.config.num_confirmations_required {
             if status.is_faux() {
                 self.publish_event(TransactionEvent::FauxTransactionConfirmed { tx_id, is_valid: true })
@@ -433,6 +454,10 @@ where
             })
         }
 
+        self.set_coinbase_not_abandoned(tx_id, status).await;
+    }
+
+    async fn set_coinbase_not_abandoned(&mut self, tx_id: TxId, status: &TransactionStatus) {
         if *status == TransactionStatus::Coinbase {
             if let Err(e) = self.output_manager_handle.set_coinbase_abandoned(tx_id, false).await {
                 warn!(
@@ -444,8 +469,6 @@ where
                 );
             };
         }
-
-        Ok(())
     }
 
     #[allow(clippy::ptr_arg)]
@@ -502,17 +525,7 @@ where
         tx_id: TxId,
         status: &TransactionStatus,
     ) -> Result<(), TransactionServiceProtocolError<OperationId>> {
-        if *status == TransactionStatus::Coinbase {
-            if let Err(e) = self.output_manager_handle.set_coinbase_abandoned(tx_id, false).await {
-                warn!(
-                    target: LOG_TARGET,
-                    "Could not mark coinbase output for TxId: {} as not abandoned: {} (Operation ID: {})",
-                    tx_id,
-                    e,
-                    self.operation_id
-                );
-            };
-        }
+        self.set_coinbase_not_abandoned(tx_id, status).await;
 
         self.db
             .set_transaction_as_unmined(tx_id)
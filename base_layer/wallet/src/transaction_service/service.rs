@@ -90,13 +90,14 @@ use crate::{
     storage::database::{WalletBackend, WalletDatabase},
     transaction_service::{
         config::TransactionServiceConfig,
-        error::{TransactionServiceError, TransactionServiceProtocolError},
+        error::{TransactionServiceError, TransactionServiceProtocolError, TransactionStorageError},
         handle::{
             FeePerGramStatsResponse,
             TransactionEvent,
             TransactionEventSender,
             TransactionServiceRequest,
             TransactionServiceResponse,
+            UtxoImport,
         },
         protocols::{
             transaction_broadcast_protocol::TransactionBroadcastProtocol,
@@ -720,6 +721,11 @@ where
             TransactionServiceRequest::GetCompletedTransaction(tx_id) => Ok(
                 TransactionServiceResponse::CompletedTransaction(Box::new(self.db.get_completed_transaction(tx_id)?)),
             ),
+            TransactionServiceRequest::GetTransactionSummaries { filter, after, limit } => {
+                Ok(TransactionServiceResponse::TransactionSummaries(
+                    self.db.fetch_transaction_summaries(&filter, after, limit)?,
+                ))
+            },
             TransactionServiceRequest::GetAnyTransaction(tx_id) => Ok(TransactionServiceResponse::AnyTransaction(
                 Box::new(self.db.get_any_transaction(tx_id)?),
             )),
@@ -746,6 +752,10 @@ where
                 )
                 .await
                 .map(TransactionServiceResponse::UtxoImported),
+            TransactionServiceRequest::ImportUtxosWithStatus(imports) => self
+                .add_utxo_import_transactions_with_status(imports, transaction_validation_join_handles)
+                .await
+                .map(TransactionServiceResponse::UtxosImported),
             TransactionServiceRequest::SubmitTransactionToSelf(tx_id, tx, fee, amount, message) => self
                 .submit_transaction_to_self(transaction_broadcast_join_handles, tx_id, tx, fee, amount, message)
                 .map(|_| TransactionServiceResponse::TransactionSubmitted),
@@ -2502,19 +2512,62 @@ where
             JoinHandle<Result<OperationId, TransactionServiceProtocolError<OperationId>>>,
         >,
     ) -> Result<TxId, TransactionServiceError> {
-        let tx_id = if let Some(id) = tx_id { id } else { TxId::new_random() };
-        self.db.add_utxo_import_transaction_with_status(
-            tx_id,
-            value,
+        let tx_id = self.add_utxo_import_transaction_record(UtxoImport {
+            amount: value,
             source_address,
-            self.resources.wallet_identity.address.clone(),
             message,
             maturity,
-            import_status.clone(),
+            import_status,
+            tx_id,
             current_height,
             mined_timestamp,
+        })?;
+        // Because we added new transactions, let try to trigger a validation for them
+        self.start_transaction_validation_protocol(transaction_validation_join_handles)
+            .await?;
+        Ok(tx_id)
+    }
+
+    /// Add a completed transaction for each of the imported UTXOs and trigger a single validation for all of them.
+    /// Outputs that were already imported are skipped and returned as `None`.
+    pub async fn add_utxo_import_transactions_with_status(
+        &mut self,
+        imports: Vec<UtxoImport>,
+        transaction_validation_join_handles: &mut FuturesUnordered<
+            JoinHandle<Result<OperationId, TransactionServiceProtocolError<OperationId>>>,
+        >,
+    ) -> Result<Vec<Option<TxId>>, TransactionServiceError> {
+        let mut tx_ids = Vec::with_capacity(imports.len());
+        for import in imports {
+            match self.add_utxo_import_transaction_record(import) {
+                Ok(tx_id) => tx_ids.push(Some(tx_id)),
+                Err(TransactionServiceError::TransactionStorageError(TransactionStorageError::DuplicateOutput)) => {
+                    tx_ids.push(None)
+                },
+                Err(e) => return Err(e),
+            }
+        }
+        if tx_ids.iter().any(Option::is_some) {
+            self.start_transaction_validation_protocol(transaction_validation_join_handles)
+                .await?;
+        }
+        Ok(tx_ids)
+    }
+
+    fn add_utxo_import_transaction_record(&mut self, import: UtxoImport) -> Result<TxId, TransactionServiceError> {
+        let tx_id = import.tx_id.unwrap_or_else(TxId::new_random);
+        self.db.add_utxo_import_transaction_with_status(
+            tx_id,
+            import.amount,
+            import.source_address,
+            self.resources.wallet_identity.address.clone(),
+            import.message,
+            import.maturity,
+            import.import_status.clone(),
+            import.current_height,
+            import.mined_timestamp,
         )?;
-        let transaction_event = match import_status {
+        let transaction_event = match import.import_status {
             ImportStatus::Imported => TransactionEvent::TransactionImported(tx_id),
             ImportStatus::FauxUnconfirmed => TransactionEvent::FauxTransactionUnconfirmed {
                 tx_id,
@@ -2533,9 +2586,6 @@ where
             );
             e
         });
-        // Because we added new transactions, let try to trigger a validation for them
-        self.start_transaction_validation_protocol(transaction_validation_join_handles)
-            .await?;
         Ok(tx_id)
     }
 
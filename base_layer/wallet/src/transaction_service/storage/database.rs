@@ -44,10 +44,13 @@ use crate::transaction_service::{
             CompletedTransaction,
             InboundTransaction,
             OutboundTransaction,
+            TransactionSummaryFilter,
+            TransactionSummaryPosition,
+            TransactionValidationUpdate,
             TxCancellationReason,
             WalletTransaction,
         },
-        sqlite_db::{InboundTransactionSenderInfo, UnconfirmedTransactionInfo},
+        sqlite_db::{InboundTransactionSenderInfo, TransactionSummary, UnconfirmedTransactionInfo},
     },
 };
 
@@ -142,6 +145,12 @@ pub trait TransactionBackend: Send + Sync + Clone {
     ) -> Result<(), TransactionStorageError>;
     /// Clears the mined block and height of a transaction
     fn set_transaction_as_unmined(&self, tx_id: TxId) -> Result<(), TransactionStorageError>;
+    /// Applies the updates found by one round of transaction validation. The updates share group commits instead of
+    /// each waiting for its own, and an update fails on its own if its transaction is not found.
+    fn apply_validation_updates(
+        &self,
+        updates: Vec<TransactionValidationUpdate>,
+    ) -> Result<(), TransactionStorageError>;
     /// Reset optional 'mined height' and 'mined in block' fields to nothing
     fn mark_all_transactions_as_unvalidated(&self) -> Result<(), TransactionStorageError>;
     /// Light weight method to retrieve pertinent transaction sender info for all pending inbound transactions
@@ -155,6 +164,14 @@ pub trait TransactionBackend: Send + Sync + Clone {
         height: u64,
     ) -> Result<Vec<CompletedTransaction>, TransactionStorageError>;
     fn abandon_coinbase_transaction(&self, tx_id: TxId) -> Result<(), TransactionStorageError>;
+    /// Light weight method to page through the transactions of the filter's source, newest first. At most `limit`
+    /// transactions following the `after` position are returned.
+    fn fetch_transaction_summaries(
+        &self,
+        filter: &TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+    ) -> Result<Vec<TransactionSummary>, TransactionStorageError>;
 }
 
 #[derive(Clone, PartialEq)]
@@ -707,6 +724,16 @@ where T: TransactionBackend + 'static
         self.db.set_transaction_as_unmined(tx_id)
     }
 
+    pub fn apply_validation_updates(
+        &self,
+        updates: Vec<TransactionValidationUpdate>,
+    ) -> Result<(), TransactionStorageError> {
+        if updates.is_empty() {
+            return Ok(());
+        }
+        self.db.apply_validation_updates(updates)
+    }
+
     pub fn mark_all_transactions_as_unvalidated(&self) -> Result<(), TransactionStorageError> {
         self.db.mark_all_transactions_as_unvalidated()
     }
@@ -745,6 +772,15 @@ where T: TransactionBackend + 'static
     pub fn abandon_coinbase_transaction(&self, tx_id: TxId) -> Result<(), TransactionStorageError> {
         self.db.abandon_coinbase_transaction(tx_id)
     }
+
+    pub fn fetch_transaction_summaries(
+        &self,
+        filter: &TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+    ) -> Result<Vec<TransactionSummary>, TransactionStorageError> {
+        self.db.fetch_transaction_summaries(filter, after, limit)
+    }
 }
 
 impl Display for DbKey {
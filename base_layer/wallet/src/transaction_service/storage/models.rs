@@ -311,6 +311,67 @@ impl From<InboundTransaction> for CompletedTransaction {
     }
 }
 
+/// The transactions a summary page is read from
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub enum TransactionSummarySource {
+    #[default]
+    Completed,
+    PendingInbound,
+    PendingOutbound,
+}
+
+/// Selection criteria used when paging through transactions without loading their full bodies
+#[derive(Debug, Clone, Default, PartialEq)]
+pub struct TransactionSummaryFilter {
+    pub source: TransactionSummarySource,
+    /// Only return transactions with one of these statuses, an empty list matches any status
+    pub statuses: Vec<TransactionStatus>,
+    /// Only return transactions in this direction, `None` matches any direction
+    pub direction: Option<TransactionDirection>,
+    /// Only return transactions mined at or above this height
+    pub min_mined_height: Option<u64>,
+    /// Only return transactions mined at or below this height
+    pub max_mined_height: Option<u64>,
+    /// Return cancelled instead of non-cancelled transactions
+    pub cancelled: bool,
+}
+
+impl TransactionSummaryFilter {
+    /// Pending transactions have the `Pending` status, no direction other than their own and are never mined, so a
+    /// filter on any of these can rule out a whole pending source without querying it.
+    pub fn can_match_pending(&self, direction: TransactionDirection) -> bool {
+        (self.statuses.is_empty() || self.statuses.contains(&TransactionStatus::Pending)) &&
+            self.direction.as_ref().map_or(true, |d| *d == direction) &&
+            self.min_mined_height.is_none() &&
+            self.max_mined_height.is_none()
+    }
+}
+
+/// The position of a summary page cursor. Pages are ordered newest first by timestamp, with the TxId breaking ties,
+/// and the next page starts after the last position returned.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct TransactionSummaryPosition {
+    pub timestamp: NaiveDateTime,
+    pub tx_id: TxId,
+}
+
+/// A change to the chain state of a completed transaction found while validating it against a base node
+#[derive(Debug, Clone, PartialEq)]
+pub enum TransactionValidationUpdate {
+    Mined {
+        tx_id: TxId,
+        mined_height: u64,
+        mined_in_block: BlockHash,
+        mined_timestamp: u64,
+        num_confirmations: u64,
+        is_confirmed: bool,
+        is_faux: bool,
+    },
+    Unmined {
+        tx_id: TxId,
+    },
+}
+
 #[derive(Debug)]
 #[allow(clippy::large_enum_variant)]
 pub enum WalletTransaction {
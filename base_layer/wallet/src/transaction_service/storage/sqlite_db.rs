@@ -23,7 +23,6 @@
 use std::{
     collections::HashMap,
     convert::{TryFrom, TryInto},
-    str::from_utf8,
     sync::{Arc, RwLock},
 };
 
@@ -31,6 +30,7 @@ use chacha20poly1305::XChaCha20Poly1305;
 use chrono::{NaiveDateTime, Utc};
 use diesel::{prelude::*, result::Error as DieselError, SqliteConnection};
 use log::*;
+use rayon::prelude::*;
 use tari_common_types::{
     tari_address::TariAddress,
     transaction::{
@@ -43,18 +43,14 @@ use tari_common_types::{
     types::{BlockHash, PrivateKey, PublicKey, Signature},
 };
 use tari_core::transactions::tari_amount::MicroTari;
-use tari_utilities::{
-    hex::{from_hex, Hex},
-    ByteArray,
-    Hidden,
-};
+use tari_utilities::{hex::Hex, ByteArray, Hidden};
 use thiserror::Error;
 use tokio::time::Instant;
 use zeroize::Zeroize;
 
 use crate::{
     schema::{completed_transactions, inbound_transactions, outbound_transactions},
-    storage::sqlite_utilities::wallet_db_connection::WalletDbConnection,
+    storage::sqlite_utilities::{wallet_db_connection::WalletDbConnection, write_batcher::PendingWrite},
     transaction_service::{
         error::{TransactionKeyError, TransactionStorageError},
         storage::{
@@ -63,6 +59,10 @@ use crate::{
                 CompletedTransaction,
                 InboundTransaction,
                 OutboundTransaction,
+                TransactionSummaryFilter,
+                TransactionSummaryPosition,
+                TransactionSummarySource,
+                TransactionValidationUpdate,
                 TxCancellationReason,
                 WalletTransaction,
             },
@@ -70,7 +70,7 @@ use crate::{
     },
     util::{
         diesel_ext::ExpectedRowsExtension,
-        encryption::{decrypt_bytes_integral_nonce, encrypt_bytes_integral_nonce, Encryptable},
+        encryption::{decrypt_all, decrypt_hex_integral_nonce, encrypt_bytes_integral_nonce, Encryptable},
     },
 };
 
@@ -221,6 +221,76 @@ impl TransactionServiceSqliteDatabase {
         Ok(())
     }
 
+    fn decrypt_all_if_necessary<T: Encryptable<XChaCha20Poly1305> + Send>(
+        &self,
+        items: &mut [T],
+    ) -> Result<(), TransactionStorageError> {
+        let cipher = acquire_read_lock!(self.cipher);
+        decrypt_all(&cipher, items).map_err(|_| TransactionStorageError::AeadError("Decryption Error".to_string()))?;
+
+        Ok(())
+    }
+
+    /// Decrypts and deserializes a result set of completed transactions in parallel
+    fn decrypt_completed_transactions(
+        &self,
+        mut rows: Vec<CompletedTransactionSql>,
+    ) -> Result<Vec<CompletedTransaction>, TransactionStorageError> {
+        self.decrypt_all_if_necessary(&mut rows)?;
+        rows.into_par_iter()
+            .map(|c| CompletedTransaction::try_from(c).map_err(TransactionStorageError::from))
+            .collect()
+    }
+
+    fn apply_validation_update(
+        update: &TransactionValidationUpdate,
+        conn: &SqliteConnection,
+    ) -> Result<(), TransactionStorageError> {
+        let (tx_id, result) = match *update {
+            TransactionValidationUpdate::Mined {
+                tx_id,
+                mined_height,
+                mined_in_block,
+                mined_timestamp,
+                num_confirmations,
+                is_confirmed,
+                is_faux,
+            } => {
+                let status = if is_confirmed {
+                    if is_faux {
+                        TransactionStatus::FauxConfirmed
+                    } else {
+                        TransactionStatus::MinedConfirmed
+                    }
+                } else if is_faux {
+                    TransactionStatus::FauxUnconfirmed
+                } else {
+                    TransactionStatus::MinedUnconfirmed
+                };
+                let result = CompletedTransactionSql::update_mined_height(
+                    tx_id,
+                    num_confirmations,
+                    status,
+                    mined_height,
+                    mined_in_block,
+                    mined_timestamp,
+                    conn,
+                );
+                (tx_id, result)
+            },
+            TransactionValidationUpdate::Unmined { tx_id } => {
+                (tx_id, CompletedTransactionSql::set_as_unmined(tx_id, conn))
+            },
+        };
+        match result {
+            Ok(_) => Ok(()),
+            Err(TransactionStorageError::DieselError(DieselError::NotFound)) => Err(
+                TransactionStorageError::ValueNotFound(DbKey::CompletedTransaction(tx_id)),
+            ),
+            Err(e) => Err(e),
+        }
+    }
+
     fn encrypt_if_necessary<T: Encryptable<XChaCha20Poly1305>>(
         &self,
         o: &mut T,
@@ -308,55 +378,61 @@ impl TransactionBackend for TransactionServiceSqliteDatabase {
                 None
             },
             DbKey::PendingOutboundTransactions => {
-                let mut result = HashMap::new();
-                for o in &mut OutboundTransactionSql::index_by_cancelled(&conn, false)? {
-                    self.decrypt_if_necessary(o)?;
-                    result.insert((o.tx_id as u64).into(), OutboundTransaction::try_from((*o).clone())?);
+                let mut rows = OutboundTransactionSql::index_by_cancelled(&conn, false)?;
+                self.decrypt_all_if_necessary(&mut rows)?;
+                let mut result = HashMap::with_capacity(rows.len());
+                for o in rows {
+                    result.insert((o.tx_id as u64).into(), OutboundTransaction::try_from(o)?);
                 }
 
                 Some(DbValue::PendingOutboundTransactions(result))
             },
             DbKey::PendingInboundTransactions => {
-                let mut result = HashMap::new();
-                for i in &mut InboundTransactionSql::index_by_cancelled(&conn, false)? {
-                    self.decrypt_if_necessary(i)?;
-                    result.insert((i.tx_id as u64).into(), InboundTransaction::try_from((*i).clone())?);
+                let mut rows = InboundTransactionSql::index_by_cancelled(&conn, false)?;
+                self.decrypt_all_if_necessary(&mut rows)?;
+                let mut result = HashMap::with_capacity(rows.len());
+                for i in rows {
+                    result.insert((i.tx_id as u64).into(), InboundTransaction::try_from(i)?);
                 }
 
                 Some(DbValue::PendingInboundTransactions(result))
             },
             DbKey::CompletedTransactions => {
-                let mut result = HashMap::new();
-                for c in &mut CompletedTransactionSql::index_by_cancelled(&conn, false)? {
-                    self.decrypt_if_necessary(c)?;
-                    result.insert((c.tx_id as u64).into(), CompletedTransaction::try_from((*c).clone())?);
+                let mut rows = CompletedTransactionSql::index_by_cancelled(&conn, false)?;
+                self.decrypt_all_if_necessary(&mut rows)?;
+                let mut result = HashMap::with_capacity(rows.len());
+                for c in rows {
+                    result.insert((c.tx_id as u64).into(), CompletedTransaction::try_from(c)?);
                 }
 
                 Some(DbValue::CompletedTransactions(result))
             },
             DbKey::CancelledPendingOutboundTransactions => {
-                let mut result = HashMap::new();
-                for o in &mut OutboundTransactionSql::index_by_cancelled(&conn, true)? {
-                    self.decrypt_if_necessary(o)?;
-                    result.insert((o.tx_id as u64).into(), OutboundTransaction::try_from((*o).clone())?);
+                let mut rows = OutboundTransactionSql::index_by_cancelled(&conn, true)?;
+                self.decrypt_all_if_necessary(&mut rows)?;
+                let mut result = HashMap::with_capacity(rows.len());
+                for o in rows {
+                    result.insert((o.tx_id as u64).into(), OutboundTransaction::try_from(o)?);
                 }
 
                 Some(DbValue::PendingOutboundTransactions(result))
             },
             DbKey::CancelledPendingInboundTransactions => {
-                let mut result = HashMap::new();
-                for i in &mut InboundTransactionSql::index_by_cancelled(&conn, true)? {
-                    self.decrypt_if_necessary(i)?;
-                    result.insert((i.tx_id as u64).into(), InboundTransaction::try_from((*i).clone())?);
+                let mut rows = InboundTransactionSql::index_by_cancelled(&conn, true)?;
+                self.decrypt_all_if_necessary(&mut rows)?;
+                let mut result = HashMap::with_capacity(rows.len());
+                for i in rows {
+                    result.insert((i.tx_id as u64).into(), InboundTransaction::try_from(i)?);
                 }
 
                 Some(DbValue::PendingInboundTransactions(result))
             },
             DbKey::CancelledCompletedTransactions => {
-                let mut result = HashMap::new();
-                for c in &mut CompletedTransactionSql::index_by_cancelled(&conn, true)? {
-                    self.decrypt_if_necessary(c)?;
-                    result.insert((c.tx_id as u64).into(), CompletedTransaction::try_from((*c).clone())?);
+                let mut rows = CompletedTransactionSql::index_by_cancelled(&conn, true)?;
+                self.decrypt_all_if_necessary(&mut rows)?;
+                let mut result = HashMap::with_capacity(rows.len());
+                for c in rows {
+                    result.insert((c.tx_id as u64).into(), CompletedTransaction::try_from(c)?);
                 }
 
                 Some(DbValue::CompletedTransactions(result))
@@ -881,36 +957,16 @@ impl TransactionBackend for TransactionServiceSqliteDatabase {
         let start = Instant::now();
         let conn = self.database_connection.get_pooled_connection()?;
         let acquire_lock = start.elapsed();
-        let status = if is_confirmed {
-            if is_faux {
-                TransactionStatus::FauxConfirmed
-            } else {
-                TransactionStatus::MinedConfirmed
-            }
-        } else if is_faux {
-            TransactionStatus::FauxUnconfirmed
-        } else {
-            TransactionStatus::MinedUnconfirmed
-        };
-
-        match CompletedTransactionSql::update_mined_height(
+        let update = TransactionValidationUpdate::Mined {
             tx_id,
-            num_confirmations,
-            status,
             mined_height,
             mined_in_block,
             mined_timestamp,
-            &conn,
-        ) {
-            Ok(_) => {},
-            Err(TransactionStorageError::DieselError(DieselError::NotFound)) => {
-                return Err(TransactionStorageError::ValueNotFound(DbKey::CompletedTransaction(
-                    tx_id,
-                )));
-            },
-            Err(e) => return Err(e),
-        }
-
+            num_confirmations,
+            is_confirmed,
+            is_faux,
+        };
+        Self::apply_validation_update(&update, &conn)?;
         if start.elapsed().as_millis() > 0 {
             trace!(
                 target: LOG_TARGET,
@@ -1047,15 +1103,7 @@ impl TransactionBackend for TransactionServiceSqliteDatabase {
         let start = Instant::now();
         let conn = self.database_connection.get_pooled_connection()?;
         let acquire_lock = start.elapsed();
-        match CompletedTransactionSql::set_as_unmined(tx_id, &conn) {
-            Ok(_) => {},
-            Err(TransactionStorageError::DieselError(DieselError::NotFound)) => {
-                return Err(TransactionStorageError::ValueNotFound(DbKey::CompletedTransaction(
-                    tx_id,
-                )));
-            },
-            Err(e) => return Err(e),
-        }
+        Self::apply_validation_update(&TransactionValidationUpdate::Unmined { tx_id }, &conn)?;
         if start.elapsed().as_millis() > 0 {
             trace!(
                 target: LOG_TARGET,
@@ -1068,6 +1116,33 @@ impl TransactionBackend for TransactionServiceSqliteDatabase {
         Ok(())
     }
 
+    fn apply_validation_updates(
+        &self,
+        updates: Vec<TransactionValidationUpdate>,
+    ) -> Result<(), TransactionStorageError> {
+        let start = Instant::now();
+        let num_updates = updates.len();
+        // Queue the whole round before waiting so that it is committed in as few transactions as possible
+        let pending = updates
+            .into_iter()
+            .map(|update| {
+                self.database_connection
+                    .submit_batched_write(move |conn| Self::apply_validation_update(&update, conn))
+            })
+            .collect::<Vec<_>>();
+        let results = pending.into_iter().map(PendingWrite::wait).collect::<Vec<_>>();
+        if start.elapsed().as_millis() > 0 {
+            trace!(
+                target: LOG_TARGET,
+                "sqlite profile - apply_validation_updates: {} batched writes {} ms",
+                num_updates,
+                start.elapsed().as_millis()
+            );
+        }
+
+        results.into_iter().collect()
+    }
+
     fn get_pending_inbound_transaction_sender_info(
         &self,
     ) -> Result<Vec<InboundTransactionSenderInfo>, TransactionStorageError> {
@@ -1097,28 +1172,15 @@ impl TransactionBackend for TransactionServiceSqliteDatabase {
 
     fn fetch_imported_transactions(&self) -> Result<Vec<CompletedTransaction>, TransactionStorageError> {
         let conn = self.database_connection.get_pooled_connection()?;
-        CompletedTransactionSql::index_by_status_and_cancelled(TransactionStatus::Imported, false, &conn)?
-            .into_iter()
-            .map(|mut ct: CompletedTransactionSql| {
-                if let Err(e) = self.decrypt_if_necessary(&mut ct) {
-                    return Err(e);
-                }
-                CompletedTransaction::try_from(ct).map_err(TransactionStorageError::from)
-            })
-            .collect::<Result<Vec<CompletedTransaction>, TransactionStorageError>>()
+        let rows = CompletedTransactionSql::index_by_status_and_cancelled(TransactionStatus::Imported, false, &conn)?;
+        self.decrypt_completed_transactions(rows)
     }
 
     fn fetch_unconfirmed_faux_transactions(&self) -> Result<Vec<CompletedTransaction>, TransactionStorageError> {
         let conn = self.database_connection.get_pooled_connection()?;
-        CompletedTransactionSql::index_by_status_and_cancelled(TransactionStatus::FauxUnconfirmed, false, &conn)?
-            .into_iter()
-            .map(|mut ct: CompletedTransactionSql| {
-                if let Err(e) = self.decrypt_if_necessary(&mut ct) {
-                    return Err(e);
-                }
-                CompletedTransaction::try_from(ct).map_err(TransactionStorageError::from)
-            })
-            .collect::<Result<Vec<CompletedTransaction>, TransactionStorageError>>()
+        let rows =
+            CompletedTransactionSql::index_by_status_and_cancelled(TransactionStatus::FauxUnconfirmed, false, &conn)?;
+        self.decrypt_completed_transactions(rows)
     }
 
     fn fetch_confirmed_faux_transactions_from_height(
@@ -1126,20 +1188,13 @@ impl TransactionBackend for TransactionServiceSqliteDatabase {
         height: u64,
     ) -> Result<Vec<CompletedTransaction>, TransactionStorageError> {
         let conn = self.database_connection.get_pooled_connection()?;
-        CompletedTransactionSql::index_by_status_and_cancelled_from_block_height(
+        let rows = CompletedTransactionSql::index_by_status_and_cancelled_from_block_height(
             TransactionStatus::FauxConfirmed,
             false,
             height as i64,
             &conn,
-        )?
-        .into_iter()
-        .map(|mut ct: CompletedTransactionSql| {
-            if let Err(e) = self.decrypt_if_necessary(&mut ct) {
-                return Err(e);
-            }
-            CompletedTransaction::try_from(ct).map_err(TransactionStorageError::from)
-        })
-        .collect::<Result<Vec<CompletedTransaction>, TransactionStorageError>>()
+        )?;
+        self.decrypt_completed_transactions(rows)
     }
 
     fn abandon_coinbase_transaction(&self, tx_id: TxId) -> Result<(), TransactionStorageError> {
@@ -1156,6 +1211,31 @@ impl TransactionBackend for TransactionServiceSqliteDatabase {
 
         Ok(())
     }
+
+    fn fetch_transaction_summaries(
+        &self,
+        filter: &TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+    ) -> Result<Vec<TransactionSummary>, TransactionStorageError> {
+        let start = Instant::now();
+        let conn = self.database_connection.get_pooled_connection()?;
+        let acquire_lock = start.elapsed();
+        let result = TransactionSummarySql::fetch_page(filter, after, limit, &conn)?
+            .into_iter()
+            .map(|c| TransactionSummary::try_from(c).map_err(TransactionStorageError::from))
+            .collect::<Result<Vec<_>, _>>()?;
+        if start.elapsed().as_millis() > 0 {
+            trace!(
+                target: LOG_TARGET,
+                "sqlite profile - fetch_transaction_summaries: lock {} + db_op {} = {} ms",
+                acquire_lock.as_millis(),
+                (start.elapsed() - acquire_lock).as_millis(),
+                start.elapsed().as_millis()
+            );
+        }
+        Ok(result)
+    }
 }
 
 #[derive(Debug, PartialEq)]
@@ -1399,18 +1479,15 @@ impl Encryptable<XChaCha20Poly1305> for InboundTransactionSql {
     }
 
     fn decrypt(&mut self, cipher: &XChaCha20Poly1305) -> Result<(), String> {
-        let mut decrypted_protocol = decrypt_bytes_integral_nonce(
-            cipher,
-            self.domain("receiver_protocol"),
-            &from_hex(self.receiver_protocol.as_str()).map_err(|e| e.to_string())?,
-        )?;
-
-        self.receiver_protocol = from_utf8(decrypted_protocol.as_slice())
-            .map_err(|e| e.to_string())?
-            .to_string();
-
-        // zeroize the decrypted protocol data buffer
-        decrypted_protocol.zeroize();
+        let decrypted_protocol =
+            decrypt_hex_integral_nonce(cipher, &self.domain("receiver_protocol"), &self.receiver_protocol)?;
+
+        // The decrypted buffer is moved into the string, so there is no copy of the protocol data left to zeroize
+        self.receiver_protocol = String::from_utf8(decrypted_protocol).map_err(|e| {
+            let error = e.utf8_error().to_string();
+            e.into_bytes().zeroize();
+            error
+        })?;
 
         Ok(())
     }
@@ -1656,18 +1733,15 @@ impl Encryptable<XChaCha20Poly1305> for OutboundTransactionSql {
     }
 
     fn decrypt(&mut self, cipher: &XChaCha20Poly1305) -> Result<(), String> {
-        let mut decrypted_protocol = decrypt_bytes_integral_nonce(
-            cipher,
-            self.domain("sender_protocol"),
-            &from_hex(self.sender_protocol.as_str()).map_err(|e| e.to_string())?,
-        )?;
-
-        self.sender_protocol = from_utf8(decrypted_protocol.as_slice())
-            .map_err(|e| e.to_string())?
-            .to_string();
-
-        // zeroize the decrypted protocol data buffer
-        decrypted_protocol.zeroize();
+        let decrypted_protocol =
+            decrypt_hex_integral_nonce(cipher, &self.domain("sender_protocol"), &self.sender_protocol)?;
+
+        // The decrypted buffer is moved into the string, so there is no copy of the protocol data left to zeroize
+        self.sender_protocol = String::from_utf8(decrypted_protocol).map_err(|e| {
+            let error = e.utf8_error().to_string();
+            e.into_bytes().zeroize();
+            error
+        })?;
 
         Ok(())
     }
@@ -2067,18 +2141,15 @@ impl Encryptable<XChaCha20Poly1305> for CompletedTransactionSql {
     }
 
     fn decrypt(&mut self, cipher: &XChaCha20Poly1305) -> Result<(), String> {
-        let mut decrypted_protocol = decrypt_bytes_integral_nonce(
-            cipher,
-            self.domain("transaction_protocol"),
-            &from_hex(self.transaction_protocol.as_str()).map_err(|e| e.to_string())?,
-        )?;
-
-        self.transaction_protocol = from_utf8(decrypted_protocol.as_slice())
-            .map_err(|e| e.to_string())?
-            .to_string();
-
-        // zeroize the decrypted protocol data buffer
-        decrypted_protocol.zeroize();
+        let decrypted_protocol =
+            decrypt_hex_integral_nonce(cipher, &self.domain("transaction_protocol"), &self.transaction_protocol)?;
+
+        // The decrypted buffer is moved into the string, so there is no copy of the protocol data left to zeroize
+        self.transaction_protocol = String::from_utf8(decrypted_protocol).map_err(|e| {
+            let error = e.utf8_error().to_string();
+            e.into_bytes().zeroize();
+            error
+        })?;
 
         Ok(())
     }
@@ -2263,13 +2334,287 @@ impl UnconfirmedTransactionInfoSql {
     }
 }
 
+/// A light weight view of a transaction that can be loaded without decrypting and deserializing the transaction body
+#[derive(Debug, Clone, PartialEq)]
+pub struct TransactionSummary {
+    pub tx_id: TxId,
+    pub source_address: TariAddress,
+    pub destination_address: TariAddress,
+    pub amount: MicroTari,
+    pub fee: MicroTari,
+    pub status: TransactionStatus,
+    pub direction: TransactionDirection,
+    pub timestamp: NaiveDateTime,
+    pub cancelled: Option<TxCancellationReason>,
+    pub confirmations: Option<u64>,
+    pub mined_height: Option<u64>,
+    pub mined_timestamp: Option<NaiveDateTime>,
+}
+
+impl TryFrom<TransactionSummarySql> for TransactionSummary {
+    type Error = CompletedTransactionConversionError;
+
+    fn try_from(c: TransactionSummarySql) -> Result<Self, Self::Error> {
+        Ok(Self {
+            tx_id: (c.tx_id as u64).into(),
+            source_address: TariAddress::from_bytes(&c.source_address).map_err(TransactionKeyError::Source)?,
+            destination_address: TariAddress::from_bytes(&c.destination_address)
+                .map_err(TransactionKeyError::Destination)?,
+            amount: MicroTari::from(c.amount as u64),
+            fee: MicroTari::from(c.fee as u64),
+            status: TransactionStatus::try_from(c.status)?,
+            direction: TransactionDirection::try_from(c.direction.unwrap_or(2i32))?,
+            timestamp: c.timestamp,
+            cancelled: c
+                .cancelled
+                .map(|v| TxCancellationReason::try_from(v as u32).unwrap_or(TxCancellationReason::Unknown)),
+            confirmations: c.confirmations.map(|ic| ic as u64),
+            mined_height: c.mined_height.map(|ic| ic as u64),
+            mined_timestamp: c.mined_timestamp,
+        })
+    }
+}
+
+#[derive(Clone, Queryable)]
+pub struct TransactionSummarySql {
+    pub tx_id: i64,
+    pub source_address: Vec<u8>,
+    pub destination_address: Vec<u8>,
+    pub amount: i64,
+    pub fee: i64,
+    pub status: i32,
+    pub direction: Option<i32>,
+    pub timestamp: NaiveDateTime,
+    pub cancelled: Option<i32>,
+    pub confirmations: Option<i64>,
+    pub mined_height: Option<i64>,
+    pub mined_timestamp: Option<NaiveDateTime>,
+}
+
+impl TransactionSummarySql {
+    /// Returns at most `limit` transactions of the filter's source that match the filter, newest first and starting
+    /// after the provided position. None of the selected columns are encrypted so the rows do not need to be
+    /// decrypted.
+    pub fn fetch_page(
+        filter: &TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+        conn: &SqliteConnection,
+    ) -> Result<Vec<TransactionSummarySql>, TransactionStorageError> {
+        match filter.source {
+            TransactionSummarySource::Completed => Self::fetch_completed_page(filter, after, limit, conn),
+            TransactionSummarySource::PendingInbound => Self::fetch_pending_inbound_page(filter, after, limit, conn),
+            TransactionSummarySource::PendingOutbound => Self::fetch_pending_outbound_page(filter, after, limit, conn),
+        }
+    }
+
+    fn fetch_completed_page(
+        filter: &TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+        conn: &SqliteConnection,
+    ) -> Result<Vec<TransactionSummarySql>, TransactionStorageError> {
+        let mut query = completed_transactions::table
+            .select((
+                completed_transactions::tx_id,
+                completed_transactions::source_address,
+                completed_transactions::destination_address,
+                completed_transactions::amount,
+                completed_transactions::fee,
+                completed_transactions::status,
+                completed_transactions::direction,
+                completed_transactions::timestamp,
+                completed_transactions::cancelled,
+                completed_transactions::confirmations,
+                completed_transactions::mined_height,
+                completed_transactions::mined_timestamp,
+            ))
+            .into_boxed();
+
+        query = if filter.cancelled {
+            query.filter(completed_transactions::cancelled.is_not_null())
+        } else {
+            query.filter(completed_transactions::cancelled.is_null())
+        };
+        if !filter.statuses.is_empty() {
+            let statuses = filter.statuses.iter().map(|s| s.clone() as i32).collect::<Vec<_>>();
+            query = query.filter(completed_transactions::status.eq_any(statuses));
+        }
+        if let Some(direction) = &filter.direction {
+            query = query.filter(completed_transactions::direction.eq(direction.clone() as i32));
+        }
+        if let Some(height) = filter.min_mined_height {
+            query = query.filter(completed_transactions::mined_height.ge(height as i64));
+        }
+        if let Some(height) = filter.max_mined_height {
+            query = query.filter(completed_transactions::mined_height.le(height as i64));
+        }
+        if let Some(position) = after {
+            query = query.filter(
+                completed_transactions::timestamp
+                    .lt(position.timestamp)
+                    .or(completed_transactions::timestamp
+                        .eq(position.timestamp)
+                        .and(completed_transactions::tx_id.lt(position.tx_id.as_u64() as i64))),
+            );
+        }
+
+        Ok(query
+            .order_by((
+                completed_transactions::timestamp.desc(),
+                completed_transactions::tx_id.desc(),
+            ))
+            .limit(limit as i64)
+            .load::<TransactionSummarySql>(conn)?)
+    }
+
+    fn fetch_pending_inbound_page(
+        filter: &TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+        conn: &SqliteConnection,
+    ) -> Result<Vec<TransactionSummarySql>, TransactionStorageError> {
+        if !filter.can_match_pending(TransactionDirection::Inbound) {
+            return Ok(Vec::new());
+        }
+        let mut query = inbound_transactions::table
+            .select((
+                inbound_transactions::tx_id,
+                inbound_transactions::source_address,
+                inbound_transactions::amount,
+                inbound_transactions::timestamp,
+                inbound_transactions::cancelled,
+            ))
+            .filter(inbound_transactions::cancelled.eq(i32::from(filter.cancelled)))
+            .into_boxed();
+        if let Some(position) = after {
+            query = query.filter(
+                inbound_transactions::timestamp
+                    .lt(position.timestamp)
+                    .or(inbound_transactions::timestamp
+                        .eq(position.timestamp)
+                        .and(inbound_transactions::tx_id.lt(position.tx_id.as_u64() as i64))),
+            );
+        }
+
+        let rows = query
+            .order_by((
+                inbound_transactions::timestamp.desc(),
+                inbound_transactions::tx_id.desc(),
+            ))
+            .limit(limit as i64)
+            .load::<(i64, Vec<u8>, i64, NaiveDateTime, i32)>(conn)?;
+        let destination_address = TariAddress::default().to_bytes().to_vec();
+        Ok(rows
+            .into_iter()
+            .map(|(tx_id, source_address, amount, timestamp, cancelled)| {
+                Self::pending(
+                    tx_id,
+                    source_address,
+                    destination_address.clone(),
+                    amount,
+                    0,
+                    TransactionDirection::Inbound,
+                    timestamp,
+                    cancelled,
+                )
+            })
+            .collect())
+    }
+
+    fn fetch_pending_outbound_page(
+        filter: &TransactionSummaryFilter,
+        after: Option<TransactionSummaryPosition>,
+        limit: usize,
+        conn: &SqliteConnection,
+    ) -> Result<Vec<TransactionSummarySql>, TransactionStorageError> {
+        if !filter.can_match_pending(TransactionDirection::Outbound) {
+            return Ok(Vec::new());
+        }
+        let mut query = outbound_transactions::table
+            .select((
+                outbound_transactions::tx_id,
+                outbound_transactions::destination_address,
+                outbound_transactions::amount,
+                outbound_transactions::fee,
+                outbound_transactions::timestamp,
+                outbound_transactions::cancelled,
+            ))
+            .filter(outbound_transactions::cancelled.eq(i32::from(filter.cancelled)))
+            .into_boxed();
+        if let Some(position) = after {
+            query = query.filter(
+                outbound_transactions::timestamp
+                    .lt(position.timestamp)
+                    .or(outbound_transactions::timestamp
+                        .eq(position.timestamp)
+                        .and(outbound_transactions::tx_id.lt(position.tx_id.as_u64() as i64))),
+            );
+        }
+
+        let rows = query
+            .order_by((
+                outbound_transactions::timestamp.desc(),
+                outbound_transactions::tx_id.desc(),
+            ))
+            .limit(limit as i64)
+            .load::<(i64, Vec<u8>, i64, i64, NaiveDateTime, i32)>(conn)?;
+        let source_address = TariAddress::default().to_bytes().to_vec();
+        Ok(rows
+            .into_iter()
+            .map(|(tx_id, destination_address, amount, fee, timestamp, cancelled)| {
+                Self::pending(
+                    tx_id,
+                    source_address.clone(),
+                    destination_address,
+                    amount,
+                    fee,
+                    TransactionDirection::Outbound,
+                    timestamp,
+                    cancelled,
+                )
+            })
+            .collect())
+    }
+
+    /// Builds the summary row of a pending transaction. Like the conversion of pending transactions into completed
+    /// ones, the address of the local side is left at its default and a cancelled transaction was cancelled by the
+    /// user.
+    #[allow(clippy::too_many_arguments)]
+    fn pending(
+        tx_id: i64,
+        source_address: Vec<u8>,
+        destination_address: Vec<u8>,
+        amount: i64,
+        fee: i64,
+        direction: TransactionDirection,
+        timestamp: NaiveDateTime,
+        cancelled: i32,
+    ) -> Self {
+        Self {
+            tx_id,
+            source_address,
+            destination_address,
+            amount,
+            fee,
+            status: TransactionStatus::Pending as i32,
+            direction: Some(direction as i32),
+            timestamp,
+            cancelled: (cancelled != 0).then(|| TxCancellationReason::UserCancelled as i32),
+            confirmations: None,
+            mined_height: None,
+            mined_timestamp: None,
+        }
+    }
+}
+
 #[cfg(test)]
 mod test {
     use std::{convert::TryFrom, mem::size_of, time::Duration};
 
     use chacha20poly1305::{Key, KeyInit, XChaCha20Poly1305};
     use chrono::Utc;
-    use diesel::{Connection, SqliteConnection};
+    use diesel::{prelude::*, Connection, SqliteConnection};
     use rand::{rngs::OsRng, RngCore};
     use tari_common::configuration::Network;
     use tari_common_sqlite::sqlite_connection_pool::SqliteConnectionPool;
@@ -2296,11 +2641,20 @@ mod test {
     use tempfile::tempdir;
 
     use crate::{
+        schema::{inbound_transactions, outbound_transactions},
         storage::sqlite_utilities::wallet_db_connection::WalletDbConnection,
         test_utils::create_consensus_constants,
         transaction_service::storage::{
             database::{DbKey, TransactionBackend},
-            models::{CompletedTransaction, InboundTransaction, OutboundTransaction, TxCancellationReason},
+            models::{
+                CompletedTransaction,
+                InboundTransaction,
+                OutboundTransaction,
+                TransactionSummaryFilter,
+                TransactionSummaryPosition,
+                TransactionSummarySource,
+                TxCancellationReason,
+            },
             sqlite_db::{
                 CompletedTransactionSql,
                 InboundTransactionSenderInfo,
@@ -2997,7 +3351,7 @@ mod test {
             completed_tx_sql.commit(&conn).unwrap();
         }
 
-        let connection = WalletDbConnection::new(pool, None);
+        let connection = WalletDbConnection::new(pool, None).unwrap();
 
         let db2 = TransactionServiceSqliteDatabase::new(connection.clone(), cipher);
 
@@ -3145,7 +3499,7 @@ mod test {
             }
         }
 
-        let connection = WalletDbConnection::new(pool, None);
+        let connection = WalletDbConnection::new(pool, None).unwrap();
         let db1 = TransactionServiceSqliteDatabase::new(connection, cipher);
 
         let txn_list = db1.get_transactions_to_be_broadcast().unwrap();
@@ -3160,4 +3514,198 @@ mod test {
         assert_eq!(info_list.len(), 941);
         assert_eq!(info_list, info_list_reference);
     }
+
+    #[test]
+    fn test_fetch_transaction_summaries() {
+        let db_name = format!("{}.sqlite3", string(8).as_str());
+        let temp_dir = tempdir().unwrap();
+        let db_folder = temp_dir.path().to_str().unwrap().to_string();
+        let db_path = format!("{}{}", db_folder, db_name);
+
+        embed_migrations!("./migrations");
+        let mut pool = SqliteConnectionPool::new(db_path.clone(), 2, true, true, Duration::from_secs(60));
+        pool.create_pool()
+            .unwrap_or_else(|_| panic!("Error connecting to {}", db_path));
+        let conn = pool
+            .get_pooled_connection()
+            .unwrap_or_else(|_| panic!("Error connecting to {}", db_path));
+
+        embedded_migrations::run_with_output(&conn, &mut std::io::stdout()).expect("Migration failed");
+
+        let mut key = [0u8; size_of::<Key>()];
+        OsRng.fill_bytes(&mut key);
+        let key_ga = Key::from_slice(&key);
+        let cipher = XChaCha20Poly1305::new(key_ga);
+
+        // Three transactions share each timestamp so that the TxId has to break ties
+        let base_timestamp = Utc::now().naive_utc();
+        let timestamp_of = |i: u64| base_timestamp + chrono::Duration::seconds((i / 3) as i64);
+        for i in 0..100u64 {
+            let completed_tx = CompletedTransaction {
+                tx_id: TxId::from(i),
+                source_address: TariAddress::new(
+                    PublicKey::from_secret_key(&PrivateKey::random(&mut OsRng)),
+                    Network::LocalNet,
+                ),
+                destination_address: TariAddress::new(
+                    PublicKey::from_secret_key(&PrivateKey::random(&mut OsRng)),
+                    Network::LocalNet,
+                ),
+                amount: MicroTari::from(i),
+                fee: MicroTari::from(1),
+                transaction: Transaction::new(
+                    vec![],
+                    vec![],
+                    vec![],
+                    PrivateKey::random(&mut OsRng),
+                    PrivateKey::random(&mut OsRng),
+                ),
+                status: if i % 2 == 0 {
+                    TransactionStatus::MinedConfirmed
+                } else {
+                    TransactionStatus::Broadcast
+                },
+                message: "Yo!".to_string(),
+                timestamp: timestamp_of(i),
+                cancelled: if i % 10 == 9 {
+                    Some(TxCancellationReason::UserCancelled)
+                } else {
+                    None
+                },
+                direction: if i % 4 < 2 {
+                    TransactionDirection::Inbound
+                } else {
+                    TransactionDirection::Outbound
+                },
+                coinbase_block_height: None,
+                send_count: 0,
+                last_send_timestamp: None,
+                transaction_signature: Signature::default(),
+                confirmations: None,
+                mined_height: if i % 2 == 0 { Some(i) } else { None },
+                mined_in_block: None,
+                mined_timestamp: None,
+            };
+            let mut completed_tx_sql = CompletedTransactionSql::try_from(completed_tx).unwrap();
+            completed_tx_sql.encrypt(&cipher).unwrap();
+            completed_tx_sql.commit(&conn).unwrap();
+        }
+        for i in 100..110u64 {
+            diesel::insert_into(inbound_transactions::table)
+                .values((
+                    inbound_transactions::tx_id.eq(i as i64),
+                    inbound_transactions::source_address.eq(TariAddress::default().to_bytes().to_vec()),
+                    inbound_transactions::amount.eq(i as i64),
+                    inbound_transactions::receiver_protocol.eq(""),
+                    inbound_transactions::message.eq(""),
+                    inbound_transactions::timestamp.eq(timestamp_of(i)),
+                    inbound_transactions::cancelled.eq(i32::from(i % 5 == 4)),
+                    inbound_transactions::direct_send_success.eq(0),
+                    inbound_transactions::send_count.eq(0),
+                ))
+                .execute(&conn)
+                .unwrap();
+            diesel::insert_into(outbound_transactions::table)
+                .values((
+                    outbound_transactions::tx_id.eq(i as i64 + 100),
+                    outbound_transactions::destination_address.eq(TariAddress::default().to_bytes().to_vec()),
+                    outbound_transactions::amount.eq(i as i64),
+                    outbound_transactions::fee.eq(1i64),
+                    outbound_transactions::sender_protocol.eq(""),
+                    outbound_transactions::message.eq(""),
+                    outbound_transactions::timestamp.eq(timestamp_of(i)),
+                    outbound_transactions::cancelled.eq(0),
+                    outbound_transactions::direct_send_success.eq(0),
+                    outbound_transactions::send_count.eq(0),
+                ))
+                .execute(&conn)
+                .unwrap();
+        }
+
+        let connection = WalletDbConnection::new(pool, None).unwrap();
+        let db = TransactionServiceSqliteDatabase::new(connection, cipher);
+
+        let mut after = None;
+        let mut summaries = vec![];
+        loop {
+            let page = db
+                .fetch_transaction_summaries(&TransactionSummaryFilter::default(), after, 7)
+                .unwrap();
+            if page.is_empty() {
+                break;
+            }
+            assert!(page.len() <= 7);
+            after = page.last().map(|s| TransactionSummaryPosition {
+                timestamp: s.timestamp,
+                tx_id: s.tx_id,
+            });
+            summaries.extend(page);
+        }
+        // Newest first, with the TxId descending within a timestamp
+        let expected = (0..100u64).rev().filter(|i| i % 10 != 9).collect::<Vec<_>>();
+        assert_eq!(summaries.iter().map(|s| s.tx_id.as_u64()).collect::<Vec<_>>(), expected);
+
+        let filter = TransactionSummaryFilter {
+            source: TransactionSummarySource::Completed,
+            statuses: vec![TransactionStatus::MinedConfirmed],
+            direction: Some(TransactionDirection::Outbound),
+            min_mined_height: Some(10),
+            max_mined_height: Some(50),
+            cancelled: false,
+        };
+        let summaries = db.fetch_transaction_summaries(&filter, None, 100).unwrap();
+        assert_eq!(summaries.iter().map(|s| s.tx_id.as_u64()).collect::<Vec<_>>(), vec![
+            50, 46, 42, 38, 34, 30, 26, 22, 18, 14, 10
+        ]);
+
+        let filter = TransactionSummaryFilter {
+            cancelled: true,
+            ..Default::default()
+        };
+        let summaries = db.fetch_transaction_summaries(&filter, None, 100).unwrap();
+        assert_eq!(summaries.len(), 10);
+        assert!(summaries
+            .iter()
+            .all(|s| s.cancelled == Some(TxCancellationReason::UserCancelled)));
+
+        let filter = TransactionSummaryFilter {
+            source: TransactionSummarySource::PendingInbound,
+            ..Default::default()
+        };
+        let first_page = db.fetch_transaction_summaries(&filter, None, 3).unwrap();
+        let last = first_page.last().unwrap();
+        let position = TransactionSummaryPosition {
+            timestamp: last.timestamp,
+            tx_id: last.tx_id,
+        };
+        let second_page = db.fetch_transaction_summaries(&filter, Some(position), 100).unwrap();
+        assert_eq!(
+            first_page
+                .iter()
+                .chain(second_page.iter())
+                .map(|s| s.tx_id.as_u64())
+                .collect::<Vec<_>>(),
+            vec![108, 107, 106, 105, 103, 102, 101, 100]
+        );
+        assert!(first_page.iter().all(|s| s.status == TransactionStatus::Pending &&
+            s.direction == TransactionDirection::Inbound &&
+            s.cancelled.is_none()));
+
+        let filter = TransactionSummaryFilter {
+            source: TransactionSummarySource::PendingOutbound,
+            direction: Some(TransactionDirection::Outbound),
+            ..Default::default()
+        };
+        let summaries = db.fetch_transaction_summaries(&filter, None, 100).unwrap();
+        assert_eq!(summaries.len(), 10);
+        assert!(summaries.iter().all(|s| s.fee == MicroTari::from(1)));
+
+        // Pending transactions are never mined
+        let filter = TransactionSummaryFilter {
+            source: TransactionSummarySource::PendingOutbound,
+            min_mined_height: Some(1),
+            ..Default::default()
+        };
+        assert!(db.fetch_transaction_summaries(&filter, None, 100).unwrap().is_empty());
+    }
 }
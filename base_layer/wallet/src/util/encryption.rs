@@ -23,13 +23,14 @@
 use std::mem::size_of;
 
 use chacha20poly1305::{
-    aead::{Aead, Payload},
+    aead::{Aead, AeadInPlace, Payload},
     Tag,
     XChaCha20Poly1305,
     XNonce,
 };
 use rand::{rngs::OsRng, RngCore};
-use tari_utilities::{ByteArray, Hidden};
+use rayon::prelude::*;
+use tari_utilities::{hex::from_hex, ByteArray, Hidden};
 
 pub trait Encryptable<C> {
     const KEY_MANAGER: &'static [u8] = b"KEY_MANAGER";
@@ -75,6 +76,50 @@ pub fn decrypt_bytes_integral_nonce(
     Ok(plaintext)
 }
 
+// Decrypt data in place (with domain binding and authentication) using XChaCha20-Poly1305. The buffer holding the
+// nonce, ciphertext and tag is reused for the plaintext, and is left unchanged if authentication fails.
+pub fn decrypt_bytes_integral_nonce_in_place(
+    cipher: &XChaCha20Poly1305,
+    domain: &[u8],
+    data: &mut Vec<u8>,
+) -> Result<(), String> {
+    // We need at least a nonce and tag, or there's no point in attempting decryption
+    if data.len() < size_of::<XNonce>() + size_of::<Tag>() {
+        return Err("Ciphertext is too short".to_string());
+    }
+
+    let tag_start = data.len() - size_of::<Tag>();
+    let (nonce, rest) = data.split_at_mut(size_of::<XNonce>());
+    let (ciphertext, tag) = rest.split_at_mut(tag_start - size_of::<XNonce>());
+    cipher
+        .decrypt_in_place_detached(XNonce::from_slice(nonce), domain, ciphertext, Tag::from_slice(tag))
+        .map_err(|e| format!("Decryption failed: {}", e))?;
+
+    // Drop the tag and shift the plaintext over the nonce
+    data.truncate(tag_start);
+    data.drain(..size_of::<XNonce>());
+
+    Ok(())
+}
+
+// Decrypt hex encoded data (with domain binding and authentication) using XChaCha20-Poly1305, reusing the decoded
+// buffer for the plaintext
+pub fn decrypt_hex_integral_nonce(
+    cipher: &XChaCha20Poly1305,
+    domain: &[u8],
+    ciphertext_hex: &str,
+) -> Result<Vec<u8>, String> {
+    let mut data = from_hex(ciphertext_hex).map_err(|e| e.to_string())?;
+    decrypt_bytes_integral_nonce_in_place(cipher, domain, &mut data)?;
+    Ok(data)
+}
+
+/// Decrypts a whole result set, spreading the rows over the available cores
+pub fn decrypt_all<T>(cipher: &XChaCha20Poly1305, items: &mut [T]) -> Result<(), String>
+where T: Encryptable<XChaCha20Poly1305> + Send {
+    items.par_iter_mut().try_for_each(|item| item.decrypt(cipher))
+}
+
 // Encrypt data (with domain binding and authentication) using XChaCha20-Poly1305
 pub fn encrypt_bytes_integral_nonce(
     cipher: &XChaCha20Poly1305,
@@ -112,7 +157,11 @@ mod test {
     use rand::{rngs::OsRng, RngCore};
     use tari_utilities::{ByteArray, Hidden};
 
-    use crate::util::encryption::{decrypt_bytes_integral_nonce, encrypt_bytes_integral_nonce};
+    use crate::util::encryption::{
+        decrypt_bytes_integral_nonce,
+        decrypt_bytes_integral_nonce_in_place,
+        encrypt_bytes_integral_nonce,
+    };
 
     #[test]
     fn test_encrypt_decrypt() {
@@ -183,4 +232,25 @@ mod test {
         )
         .is_err());
     }
+
+    #[test]
+    fn test_decrypt_in_place() {
+        let plaintext = b"The quick brown fox was annoying".to_vec();
+        let mut key = [0u8; size_of::<Key>()];
+        OsRng.fill_bytes(&mut key);
+        let cipher = XChaCha20Poly1305::new(Key::from_slice(&key));
+        let ciphertext =
+            encrypt_bytes_integral_nonce(&cipher, b"correct_domain".to_vec(), Hidden::hide(plaintext.clone())).unwrap();
+
+        // A failed authentication leaves the buffer untouched
+        let mut data = ciphertext.clone();
+        assert!(decrypt_bytes_integral_nonce_in_place(&cipher, b"wrong_domain", &mut data).is_err());
+        assert_eq!(data, ciphertext);
+
+        decrypt_bytes_integral_nonce_in_place(&cipher, b"correct_domain", &mut data).unwrap();
+        assert_eq!(data, plaintext);
+
+        let mut data = ciphertext[0..(size_of::<XNonce>() + size_of::<Tag>() - 1)].to_vec();
+        assert!(decrypt_bytes_integral_nonce_in_place(&cipher, b"correct_domain", &mut data).is_err());
+    }
 }
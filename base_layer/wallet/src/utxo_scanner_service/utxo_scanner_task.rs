@@ -35,7 +35,7 @@ use tari_common_types::{
 };
 use tari_comms::{
     peer_manager::NodeId,
-    protocol::rpc::RpcClientLease,
+    protocol::rpc::{ClientStreaming, RpcClientLease},
     traits::OrOptional,
     types::CommsPublicKey,
     PeerConnection,
@@ -43,7 +43,7 @@ use tari_comms::{
 use tari_core::{
     base_node::rpc::BaseNodeWalletRpcClient,
     blocks::BlockHeader,
-    proto::base_node::SyncUtxosByBlockRequest,
+    proto::base_node::{SyncUtxosByBlockRequest, SyncUtxosByBlockResponse},
     transactions::{
         tari_amount::MicroTari,
         transaction_components::{TransactionOutput, UnblindedOutput},
@@ -52,13 +52,13 @@ use tari_core::{
 use tari_key_manager::get_birthday_from_unix_epoch_in_seconds;
 use tari_shutdown::ShutdownSignal;
 use tari_utilities::hex::Hex;
-use tokio::sync::broadcast;
+use tokio::sync::{broadcast, mpsc};
 
 use crate::{
     connectivity_service::WalletConnectivityInterface,
-    error::WalletError,
+    output_manager_service::handle::OutputManagerHandle,
     storage::database::WalletBackend,
-    transaction_service::error::{TransactionServiceError, TransactionStorageError},
+    transaction_service::handle::UtxoImport,
     utxo_scanner_service::{
         error::UtxoScannerError,
         handle::UtxoScannerEvent,
@@ -69,6 +69,8 @@ use crate::{
 };
 
 pub const LOG_TARGET: &str = "wallet::utxo_scanning";
+/// The number of blocks that can be buffered between each of the scanning pipeline stages
+const SCAN_PIPELINE_DEPTH: usize = 10;
 
 pub struct UtxoScannerTask<TBackend, TWalletConnectivity> {
     pub(crate) resources: UtxoScannerResources<TBackend, TWalletConnectivity>,
@@ -428,6 +430,10 @@ where
         }
     }
 
+    /// Scans the blocks from `start_header_hash` to `end_header_hash` with three concurrent stages joined by bounded
+    /// channels: the blocks are streamed from the base node, scanned for outputs belonging to this wallet and then the
+    /// found outputs are imported. A block is only recorded as scanned once its outputs have been imported, so an
+    /// interrupted scan resumes from the last imported block.
     async fn scan_utxos(
         &mut self,
         client: &mut BaseNodeWalletRpcClient,
@@ -435,111 +441,195 @@ where
         end_header_hash: HashOutput,
         tip_height: u64,
     ) -> Result<(u64, u64, MicroTari), UtxoScannerError> {
-        // Setting how often the progress event and log should occur during scanning. Defined in blocks
-        const PROGRESS_REPORT_INTERVAL: u64 = 100;
-
-        let mut num_recovered = 0u64;
-        let mut total_amount = MicroTari::from(0);
-        let mut total_scanned = 0;
-
         let request = SyncUtxosByBlockRequest {
             start_header_hash: start_header_hash.to_vec(),
             end_header_hash: end_header_hash.to_vec(),
         };
 
         let start = Instant::now();
-        let mut utxo_stream = client.sync_utxos_by_block(request).await?;
+        let utxo_stream = client.sync_utxos_by_block(request).await?;
         trace!(
             target: LOG_TARGET,
             "bulletproof rewind profile - UTXO stream request time {} ms",
             start.elapsed().as_millis(),
         );
 
-        let mut utxo_next_await_profiling = Vec::new();
-        let mut scan_for_outputs_profiling = Vec::new();
+        let (fetched_tx, fetched_rx) = mpsc::channel(SCAN_PIPELINE_DEPTH);
+        let (scanned_tx, scanned_rx) = mpsc::channel(SCAN_PIPELINE_DEPTH);
+        let fetch = Self::fetch_blocks(utxo_stream, fetched_tx, self.shutdown_signal.clone());
+        let scan = Self::scan_blocks(
+            self.resources.output_manager_service.clone(),
+            self.resources.recovery_message.clone(),
+            self.resources.one_sided_payment_message.clone(),
+            fetched_rx,
+            scanned_tx,
+        );
+        let import = self.import_blocks(scanned_rx, tip_height);
+        let (total_scanned, _, (num_recovered, total_amount)) = futures::try_join!(fetch, scan, import)?;
+
+        Ok((num_recovered, total_scanned, total_amount))
+    }
+
+    /// First pipeline stage: reads the blocks from the base node stream ahead of the scan
+    async fn fetch_blocks(
+        mut utxo_stream: ClientStreaming<SyncUtxosByBlockResponse>,
+        fetched_tx: mpsc::Sender<FetchedBlock>,
+        shutdown_signal: ShutdownSignal,
+    ) -> Result<u64, UtxoScannerError> {
+        let mut total_scanned = 0u64;
+        let mut utxo_next_await_profiling = Duration::ZERO;
         while let Some(response) = {
             let start = Instant::now();
             let utxo_stream_next = utxo_stream.next().await;
-            utxo_next_await_profiling.push(start.elapsed());
+            utxo_next_await_profiling += start.elapsed();
             utxo_stream_next
         } {
-            if self.shutdown_signal.is_triggered() {
+            if shutdown_signal.is_triggered() {
                 // if running is set to false, we know its been canceled upstream so lets exit the loop
-                return Ok((num_recovered, total_scanned as u64, total_amount));
+                break;
             }
 
             let response = response.map_err(|e| UtxoScannerError::RpcStatus(e.to_string()))?;
-            let current_height = response.height;
-            let current_header_hash = response.header_hash;
-            let mined_timestamp =
-                NaiveDateTime::from_timestamp_opt(response.mined_timestamp as i64, 0).unwrap_or(NaiveDateTime::MIN);
             let outputs = response
                 .outputs
                 .into_iter()
                 .map(|utxo| TransactionOutput::try_from(utxo).map_err(UtxoScannerError::ConversionError))
                 .collect::<Result<Vec<_>, _>>()?;
-
-            total_scanned += outputs.len();
-
-            let start = Instant::now();
-            let found_outputs = self.scan_for_outputs(outputs).await?;
-            scan_for_outputs_profiling.push(start.elapsed());
-
-            let (count, amount) = self
-                .import_utxos_to_transaction_service(found_outputs, current_height, mined_timestamp)
-                .await?;
-            let block_hash = current_header_hash.try_into()?;
-            self.resources.db.save_scanned_block(ScannedBlock {
-                header_hash: block_hash,
-                height: current_height,
-                num_outputs: Some(count),
-                amount: Some(amount),
-                timestamp: Utc::now().naive_utc(),
-            })?;
-
-            self.resources
-                .db
-                .clear_scanned_blocks_before_height(current_height.saturating_sub(SCANNED_BLOCK_CACHE_SIZE), true)?;
-
-            if current_height % PROGRESS_REPORT_INTERVAL == 0 {
-                debug!(
-                    target: LOG_TARGET,
-                    "Scanned up to block {} with a current tip_height of {}", current_height, tip_height
-                );
-                self.publish_event(UtxoScannerEvent::Progress {
-                    current_height,
-                    tip_height,
-                });
+            total_scanned += outputs.len() as u64;
+
+            let block = FetchedBlock {
+                height: response.height,
+                header_hash: response.header_hash,
+                mined_timestamp: NaiveDateTime::from_timestamp_opt(response.mined_timestamp as i64, 0)
+                    .unwrap_or(NaiveDateTime::MIN),
+                outputs,
+            };
+            // The later stages stop receiving when they are done early, e.g. on shutdown
+            if fetched_tx.send(block).await.is_err() {
+                break;
             }
-
-            num_recovered = num_recovered.saturating_add(count);
-            total_amount += amount;
         }
         trace!(
             target: LOG_TARGET,
             "bulletproof rewind profile - streamed {} outputs in {} ms",
             total_scanned,
-            utxo_next_await_profiling.iter().fold(0, |acc, &x| acc + x.as_millis()),
+            utxo_next_await_profiling.as_millis(),
         );
+
+        Ok(total_scanned)
+    }
+
+    /// Second pipeline stage: rewinds the outputs and matches one-sided payments for each fetched block
+    async fn scan_blocks(
+        mut output_manager_service: OutputManagerHandle,
+        recovery_message: String,
+        one_sided_payment_message: String,
+        mut fetched_rx: mpsc::Receiver<FetchedBlock>,
+        scanned_tx: mpsc::Sender<ScannedBlockOutputs>,
+    ) -> Result<(), UtxoScannerError> {
+        let mut total_outputs = 0usize;
+        let mut scan_for_outputs_profiling = Duration::ZERO;
+        while let Some(block) = fetched_rx.recv().await {
+            total_outputs += block.outputs.len();
+            let start = Instant::now();
+            let found_outputs = Self::scan_for_outputs(
+                &mut output_manager_service,
+                &recovery_message,
+                &one_sided_payment_message,
+                block.outputs,
+            )
+            .await?;
+            scan_for_outputs_profiling += start.elapsed();
+
+            let scanned = ScannedBlockOutputs {
+                height: block.height,
+                header_hash: block.header_hash,
+                mined_timestamp: block.mined_timestamp,
+                found_outputs,
+            };
+            if scanned_tx.send(scanned).await.is_err() {
+                break;
+            }
+        }
         trace!(
             target: LOG_TARGET,
             "bulletproof rewind profile - scanned {} outputs in {} ms",
-            total_scanned,
-            scan_for_outputs_profiling.iter().fold(0, |acc, &x| acc + x.as_millis()),
+            total_outputs,
+            scan_for_outputs_profiling.as_millis(),
         );
 
-        Ok((num_recovered, total_scanned as u64, total_amount))
+        Ok(())
     }
 
-    async fn scan_for_outputs(
+    /// Last pipeline stage: imports the found outputs of all the blocks that are ready in a single batch and then
+    /// records the blocks as scanned
+    async fn import_blocks(
         &mut self,
+        mut scanned_rx: mpsc::Receiver<ScannedBlockOutputs>,
+        tip_height: u64,
+    ) -> Result<(u64, MicroTari), UtxoScannerError> {
+        // Setting how often the progress event and log should occur during scanning. Defined in blocks
+        const PROGRESS_REPORT_INTERVAL: u64 = 100;
+
+        let mut num_recovered = 0u64;
+        let mut total_amount = MicroTari::from(0);
+
+        while let Some(block) = scanned_rx.recv().await {
+            if self.shutdown_signal.is_triggered() {
+                break;
+            }
+            let mut blocks = vec![block];
+            while blocks.len() < SCAN_PIPELINE_DEPTH {
+                match scanned_rx.try_recv() {
+                    Ok(block) => blocks.push(block),
+                    Err(_) => break,
+                }
+            }
+
+            let imported = self.import_utxos_to_transaction_service(&blocks).await?;
+            for (block, (count, amount)) in blocks.into_iter().zip(imported) {
+                let current_height = block.height;
+                self.resources.db.save_scanned_block(ScannedBlock {
+                    header_hash: block.header_hash.try_into()?,
+                    height: current_height,
+                    num_outputs: Some(count),
+                    amount: Some(amount),
+                    timestamp: Utc::now().naive_utc(),
+                })?;
+
+                self.resources.db.clear_scanned_blocks_before_height(
+                    current_height.saturating_sub(SCANNED_BLOCK_CACHE_SIZE),
+                    true,
+                )?;
+
+                if current_height % PROGRESS_REPORT_INTERVAL == 0 {
+                    debug!(
+                        target: LOG_TARGET,
+                        "Scanned up to block {} with a current tip_height of {}", current_height, tip_height
+                    );
+                    self.publish_event(UtxoScannerEvent::Progress {
+                        current_height,
+                        tip_height,
+                    });
+                }
+
+                num_recovered = num_recovered.saturating_add(count);
+                total_amount += amount;
+            }
+        }
+
+        Ok((num_recovered, total_amount))
+    }
+
+    async fn scan_for_outputs(
+        output_manager_service: &mut OutputManagerHandle,
+        recovery_message: &str,
+        one_sided_payment_message: &str,
         outputs: Vec<TransactionOutput>,
     ) -> Result<Vec<(UnblindedOutput, String, ImportStatus, TxId)>, UtxoScannerError> {
         let mut found_outputs: Vec<(UnblindedOutput, String, ImportStatus, TxId)> = Vec::new();
         found_outputs.append(
-            &mut self
-                .resources
-                .output_manager_service
+            &mut output_manager_service
                 .scan_for_recoverable_outputs(outputs.clone())
                 .await?
                 .into_iter()
@@ -549,22 +639,20 @@ where
                     } else {
                         ImportStatus::Imported
                     };
-                    (ro.output, self.resources.recovery_message.clone(), status, ro.tx_id)
+                    (ro.output, recovery_message.to_string(), status, ro.tx_id)
                 })
                 .collect(),
         );
 
         found_outputs.append(
-            &mut self
-                .resources
-                .output_manager_service
-                .scan_outputs_for_one_sided_payments(outputs.clone())
+            &mut output_manager_service
+                .scan_outputs_for_one_sided_payments(outputs)
                 .await?
                 .into_iter()
                 .map(|ro| {
                     (
                         ro.output,
-                        self.resources.one_sided_payment_message.clone(),
+                        one_sided_payment_message.to_string(),
                         ImportStatus::FauxUnconfirmed,
                         ro.tx_id,
                     )
@@ -574,53 +662,77 @@ where
         Ok(found_outputs)
     }
 
+    /// Imports the found outputs of the given blocks with a single request to the transaction service and returns the
+    /// number and value of the outputs imported for each block
     async fn import_utxos_to_transaction_service(
         &mut self,
-        utxos: Vec<(UnblindedOutput, String, ImportStatus, TxId)>,
-        current_height: u64,
-        mined_timestamp: NaiveDateTime,
-    ) -> Result<(u64, MicroTari), UtxoScannerError> {
-        let mut num_recovered = 0u64;
-        let mut total_amount = MicroTari::from(0);
-        for (uo, message, import_status, tx_id) in utxos {
-            let source_address = if uo.features.is_coinbase() {
-                // its a coinbase, so we know we mined it and it comes from us.
-                self.resources.wallet_identity.address.clone()
-            } else {
-                // Because we do not know the source public key we are making it the default key of zeroes to make it
-                // clear this value is a placeholder.
-                TariAddress::default()
-            };
-            match self
-                .import_unblinded_utxo_to_transaction_service(
-                    uo.clone(),
+        blocks: &[ScannedBlockOutputs],
+    ) -> Result<Vec<(u64, MicroTari)>, UtxoScannerError> {
+        let mut imports = Vec::new();
+        for block in blocks {
+            for (uo, message, import_status, tx_id) in &block.found_outputs {
+                let source_address = if uo.features.is_coinbase() {
+                    // its a coinbase, so we know we mined it and it comes from us.
+                    self.resources.wallet_identity.address.clone()
+                } else {
+                    // Because we do not know the source public key we are making it the default key of zeroes to make
+                    // it clear this value is a placeholder.
+                    TariAddress::default()
+                };
+                imports.push(UtxoImport {
+                    amount: uo.value,
                     source_address,
-                    message,
-                    import_status,
-                    tx_id,
-                    current_height,
-                    mined_timestamp,
-                )
-                .await
-            {
-                Ok(_) => {
-                    num_recovered = num_recovered.saturating_add(1);
-                    total_amount += uo.value;
-                },
-                Err(WalletError::TransactionServiceError(TransactionServiceError::TransactionStorageError(
-                    TransactionStorageError::DuplicateOutput,
-                ))) => {
+                    message: message.clone(),
+                    maturity: Some(uo.features.maturity),
+                    import_status: import_status.clone(),
+                    tx_id: Some(*tx_id),
+                    current_height: Some(block.height),
+                    mined_timestamp: Some(block.mined_timestamp),
+                });
+            }
+        }
+        if imports.is_empty() {
+            return Ok(vec![(0, MicroTari::from(0)); blocks.len()]);
+        }
+
+        let mut imported = self
+            .resources
+            .transaction_service
+            .import_utxos_with_status(imports)
+            .await
+            .map_err(|e| UtxoScannerError::UtxoImportError(e.to_string()))?
+            .into_iter();
+
+        let mut results = Vec::with_capacity(blocks.len());
+        for block in blocks {
+            let mut num_recovered = 0u64;
+            let mut total_amount = MicroTari::from(0);
+            for (uo, _, import_status, tx_id) in &block.found_outputs {
+                if imported.next().flatten().is_none() {
                     info!(
                         target: LOG_TARGET,
                         "Recoverer attempted to add a duplicate output to the database for faux transaction ({}); \
                          ignoring it as this is not a real error",
                         tx_id
                     );
-                },
-                Err(e) => return Err(UtxoScannerError::UtxoImportError(e.to_string())),
+                    continue;
+                }
+                let commitment = uo
+                    .as_transaction_input(&self.resources.factories.commitment)
+                    .and_then(|input| input.commitment().cloned())
+                    .map_err(|e| UtxoScannerError::UtxoImportError(e.to_string()))?;
+                info!(
+                    target: LOG_TARGET,
+                    "UTXO (Commitment: {}) imported into wallet as 'ImportStatus::{}'",
+                    commitment.to_hex(),
+                    import_status
+                );
+                num_recovered = num_recovered.saturating_add(1);
+                total_amount += uo.value;
             }
+            results.push((num_recovered, total_amount));
         }
-        Ok((num_recovered, total_amount))
+        Ok(results)
     }
 
     fn set_recovery_mode(&self) -> Result<(), UtxoScannerError> {
@@ -647,47 +759,6 @@ where
         let _size = self.event_sender.send(event);
     }
 
-    /// A faux incoming transaction will be created to provide a record of the event of importing a scanned UTXO. The
-    /// TxId of the generated transaction is returned.
-    pub async fn import_unblinded_utxo_to_transaction_service(
-        &mut self,
-        unblinded_output: UnblindedOutput,
-        source_address: TariAddress,
-        message: String,
-        import_status: ImportStatus,
-        tx_id: TxId,
-        current_height: u64,
-        mined_timestamp: NaiveDateTime,
-    ) -> Result<TxId, WalletError> {
-        let tx_id = self
-            .resources
-            .transaction_service
-            .import_utxo_with_status(
-                unblinded_output.value,
-                source_address,
-                message,
-                Some(unblinded_output.features.maturity),
-                import_status.clone(),
-                Some(tx_id),
-                Some(current_height),
-                Some(mined_timestamp),
-            )
-            .await?;
-
-        info!(
-            target: LOG_TARGET,
-            "UTXO (Commitment: {}) imported into wallet as 'ImportStatus::{}'",
-            unblinded_output
-                .as_transaction_input(&self.resources.factories.commitment)?
-                .commitment()
-                .map_err(WalletError::TransactionError)?
-                .to_hex(),
-            import_status
-        );
-
-        Ok(tx_id)
-    }
-
     fn get_next_peer(&mut self) -> Option<NodeId> {
         let peer = self.peer_seeds.get(self.peer_index).map(NodeId::from_public_key);
         self.peer_index += 1;
@@ -729,6 +800,22 @@ where
     }
 }
 
+/// A block streamed from the base node that still has to be scanned
+struct FetchedBlock {
+    height: u64,
+    header_hash: Vec<u8>,
+    mined_timestamp: NaiveDateTime,
+    outputs: Vec<TransactionOutput>,
+}
+
+/// A scanned block with the outputs that belong to this wallet, waiting to be imported
+struct ScannedBlockOutputs {
+    height: u64,
+    header_hash: Vec<u8>,
+    mined_timestamp: NaiveDateTime,
+    found_outputs: Vec<(UnblindedOutput, String, ImportStatus, TxId)>,
+}
+
 struct HeightHash {
     height: u64,
     header_hash: HashOutput,
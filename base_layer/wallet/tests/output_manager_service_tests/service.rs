@@ -38,7 +38,7 @@ use tari_core::{
     blocks::BlockHeader,
     borsh::SerializedSize,
     covenants::Covenant,
-    proto::base_node::{QueryDeletedResponse, UtxoQueryResponse, UtxoQueryResponses},
+    proto::base_node::{ChainMetadata, QueryDeletedResponse, TipInfoResponse, UtxoQueryResponse, UtxoQueryResponses},
     transactions::{
         fee::Fee,
         tari_amount::{uT, MicroTari},
@@ -2101,6 +2101,136 @@ async fn test_txo_revalidation() {
     assert_eq!(unspent_txos.len(), 0);
 }
 
+async fn wait_for_txo_validation(event_stream: &mut broadcast::Receiver<Arc<OutputManagerEvent>>, validation_id: u64) {
+    let delay = sleep(Duration::from_secs(30));
+    tokio::pin!(delay);
+    loop {
+        tokio::select! {
+            event = event_stream.recv() => {
+                if let OutputManagerEvent::TxoValidationSuccess(id) = &*event.unwrap() {
+                    if *id == validation_id {
+                        return;
+                    }
+                }
+            },
+            () = &mut delay => {
+                panic!("Validation protocol should complete");
+            },
+        }
+    }
+}
+
+#[tokio::test]
+async fn test_txo_validation_from_last_validated_tip() {
+    let factories = CryptoFactories::default();
+
+    let mut key = [0u8; size_of::<Key>()];
+    OsRng.fill_bytes(&mut key);
+    let key_ga = Key::from_slice(&key);
+    let cipher = XChaCha20Poly1305::new(key_ga);
+
+    let (connection, _tempdir) = get_temp_sqlite_database_connection();
+    let backend = OutputManagerSqliteDatabase::new(connection.clone(), cipher.clone());
+    let ks_backend = KeyManagerSqliteDatabase::new(connection, cipher).unwrap();
+
+    let mut oms = setup_output_manager_service(backend, ks_backend, true).await;
+
+    let mut connection = oms
+        .mock_rpc_service
+        .create_connection(oms.node_id.to_peer(), "t/bnwallet/1".into())
+        .await;
+    oms.wallet_connectivity_mock
+        .set_base_node_wallet_rpc_client(connect_rpc_client(&mut connection).await);
+
+    let output = create_unblinded_output(
+        script!(Nop),
+        OutputFeatures::default(),
+        &TestParamsHelpers::new(),
+        MicroTari::from(1_000_000),
+    );
+    let tx_output = output.as_transaction_output(&factories).unwrap();
+    oms.output_manager_handle
+        .add_output_with_tx_id(TxId::from(1u64), output, None)
+        .await
+        .unwrap();
+
+    let mut block1_header = BlockHeader::new(1);
+    block1_header.height = 1;
+    let mut block4_header = BlockHeader::new(1);
+    block4_header.height = 4;
+    let mut block5_header = BlockHeader::new(1);
+    block5_header.height = 5;
+
+    let mut block_headers = HashMap::new();
+    block_headers.insert(1, block1_header.clone());
+    block_headers.insert(4, block4_header.clone());
+    oms.base_node_wallet_rpc_mock_state.set_blocks(block_headers.clone());
+
+    let rpc_state = oms.base_node_wallet_rpc_mock_state.clone();
+    let set_tip = |header: &BlockHeader| {
+        rpc_state.set_tip_info_response(TipInfoResponse {
+            metadata: Some(ChainMetadata {
+                height_of_longest_chain: Some(header.height),
+                best_block: Some(header.hash().to_vec()),
+                accumulated_difficulty: Vec::new(),
+                pruned_height: 0,
+                timestamp: Some(0),
+            }),
+            is_synced: true,
+        });
+    };
+    set_tip(&block4_header);
+
+    oms.base_node_wallet_rpc_mock_state
+        .set_utxo_query_response(UtxoQueryResponses {
+            best_block: block4_header.hash().to_vec(),
+            height_of_longest_chain: 4,
+            responses: vec![UtxoQueryResponse {
+                output: Some(tx_output.clone().try_into().unwrap()),
+                mmr_position: 1,
+                mined_height: 1,
+                mined_in_block: block1_header.hash().to_vec(),
+                output_hash: tx_output.hash().to_vec(),
+                mined_timestamp: 0,
+            }],
+        });
+    oms.base_node_wallet_rpc_mock_state
+        .set_query_deleted_response(QueryDeletedResponse {
+            best_block: block4_header.hash().to_vec(),
+            height_of_longest_chain: 4,
+            deleted_positions: vec![],
+            not_deleted_positions: vec![1],
+            heights_deleted_at: vec![],
+            blocks_deleted_in: vec![],
+        });
+
+    // The first validation checks everything
+    let mut event_stream = oms.output_manager_handle.get_event_stream();
+    let validation_id = oms.output_manager_handle.validate_txos().await.unwrap();
+    wait_for_txo_validation(&mut event_stream, validation_id).await;
+    assert_eq!(oms.base_node_wallet_rpc_mock_state.take_utxo_query_calls().len(), 1);
+    assert_eq!(oms.base_node_wallet_rpc_mock_state.take_query_deleted_calls().len(), 1);
+    assert_eq!(oms.output_manager_handle.get_unspent_outputs().await.unwrap().len(), 1);
+
+    // Nothing can have changed while the tip has not moved
+    let validation_id = oms.output_manager_handle.validate_txos().await.unwrap();
+    wait_for_txo_validation(&mut event_stream, validation_id).await;
+    assert!(oms.base_node_wallet_rpc_mock_state.take_utxo_query_calls().is_empty());
+    assert!(oms
+        .base_node_wallet_rpc_mock_state
+        .take_query_deleted_calls()
+        .is_empty());
+
+    // A new block can spend the output
+    block_headers.insert(5, block5_header.clone());
+    oms.base_node_wallet_rpc_mock_state.set_blocks(block_headers);
+    set_tip(&block5_header);
+    let validation_id = oms.output_manager_handle.validate_txos().await.unwrap();
+    wait_for_txo_validation(&mut event_stream, validation_id).await;
+    assert!(oms.base_node_wallet_rpc_mock_state.take_utxo_query_calls().is_empty());
+    assert_eq!(oms.base_node_wallet_rpc_mock_state.take_query_deleted_calls().len(), 1);
+}
+
 #[tokio::test]
 async fn test_get_status_by_tx_id() {
     let factories = CryptoFactories::default();
@@ -31,7 +31,7 @@ use tari_wallet::output_manager_service::{
     service::Balance,
     storage::{
         database::{OutputManagerBackend, OutputManagerDatabase},
-        models::DbUnblindedOutput,
+        models::{DbUnblindedOutput, OutputValidationUpdate},
         sqlite_db::OutputManagerSqliteDatabase,
         OutputSource,
     },
@@ -472,3 +472,68 @@ pub async fn test_mark_as_unmined() {
     assert!(o.mined_height.is_none());
     assert!(o.mined_in_block.is_none());
 }
+
+#[tokio::test]
+pub async fn test_apply_validation_updates() {
+    let factories = CryptoFactories::default();
+    let (connection, _tempdir) = get_temp_sqlite_database_connection();
+
+    let mut key = [0u8; size_of::<Key>()];
+    OsRng.fill_bytes(&mut key);
+    let key_ga = Key::from_slice(&key);
+    let cipher = XChaCha20Poly1305::new(key_ga);
+
+    let backend = OutputManagerSqliteDatabase::new(connection, cipher);
+    let db = OutputManagerDatabase::new(backend);
+
+    let mut outputs = Vec::new();
+    for _ in 0..3 {
+        let (_ti, uo) = make_input(&mut OsRng, MicroTari::from(1000), &factories.commitment).await;
+        let uo = DbUnblindedOutput::from_unblinded_output(uo, &factories, None, OutputSource::Unknown).unwrap();
+        db.add_unspent_output(uo.clone()).unwrap();
+        outputs.push(uo);
+    }
+
+    // Updates of one round are applied in order, including several for the same output
+    db.apply_validation_updates(vec![
+        OutputValidationUpdate::Mined {
+            hash: outputs[0].hash,
+            mined_height: 1,
+            mined_in_block: FixedHash::zero(),
+            mmr_position: 1,
+            confirmed: true,
+            mined_timestamp: 0,
+        },
+        OutputValidationUpdate::Mined {
+            hash: outputs[1].hash,
+            mined_height: 2,
+            mined_in_block: FixedHash::zero(),
+            mmr_position: 2,
+            confirmed: true,
+            mined_timestamp: 0,
+        },
+        OutputValidationUpdate::Spent {
+            hash: outputs[1].hash,
+            deleted_height: 3,
+            deleted_in_block: FixedHash::zero(),
+            confirmed: true,
+        },
+        OutputValidationUpdate::UnminedAndInvalid { hash: outputs[2].hash },
+    ])
+    .unwrap();
+    let mined = db.fetch_mined_unspent_outputs().unwrap();
+    assert_eq!(mined.len(), 1);
+    assert_eq!(mined[0].hash, outputs[0].hash);
+    assert_eq!(db.get_last_spent_output().unwrap().unwrap().hash, outputs[1].hash);
+    assert_eq!(db.get_invalid_outputs().unwrap().pop().unwrap().hash, outputs[2].hash);
+
+    // An update for an unknown output fails on its own without undoing the rest of the round
+    let result = db.apply_validation_updates(vec![
+        OutputValidationUpdate::Unspent { hash: outputs[1].hash },
+        OutputValidationUpdate::Unspent {
+            hash: FixedHash::zero(),
+        },
+    ]);
+    assert!(result.is_err());
+    assert!(db.get_last_spent_output().unwrap().is_none());
+}
@@ -110,6 +110,16 @@ impl TransactionServiceMock {
                         e
                     });
             },
+            TransactionServiceRequest::ImportUtxosWithStatus(imports) => {
+                let _result = reply_tx
+                    .send(Ok(TransactionServiceResponse::UtxosImported(
+                        imports.iter().map(|_| Some(TxId::from(42u64))).collect(),
+                    )))
+                    .map_err(|e| {
+                        warn!(target: LOG_TARGET, "Failed to send reply");
+                        e
+                    });
+            },
             _ => panic!("Transaction Service Mock does not support this call"),
         }
     }
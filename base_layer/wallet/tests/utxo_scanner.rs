@@ -448,19 +448,14 @@ async fn test_utxo_scanner_recovery_with_restart() {
     let requests = test_interface.transaction_service_mock_state.drain_requests();
     assert!(!requests.is_empty());
     for req in requests {
-        if let TransactionServiceRequest::ImportUtxoWithStatus {
-            amount: _,
-            source_address,
-            message,
-            maturity: _,
-            import_status: _,
-            tx_id: _,
-            current_height: _,
-            mined_timestamp: _,
-        } = req
-        {
-            assert_eq!(message, "Output found on blockchain during Wallet Recovery".to_string());
-            assert_eq!(source_address, TariAddress::default());
+        if let TransactionServiceRequest::ImportUtxosWithStatus(imports) = req {
+            for import in imports {
+                assert_eq!(
+                    import.message,
+                    "Output found on blockchain during Wallet Recovery".to_string()
+                );
+                assert_eq!(import.source_address, TariAddress::default());
+            }
         }
     }
 
@@ -515,18 +510,10 @@ async fn test_utxo_scanner_recovery_with_restart() {
     let requests = test_interface2.transaction_service_mock_state.drain_requests();
     assert!(!requests.is_empty());
     for req in requests {
-        if let TransactionServiceRequest::ImportUtxoWithStatus {
-            amount: _,
-            source_address: _,
-            message,
-            maturity: _,
-            import_status: _,
-            tx_id: _,
-            current_height: _,
-            mined_timestamp: _,
-        } = req
-        {
-            assert_eq!(message, "recovery".to_string());
+        if let TransactionServiceRequest::ImportUtxosWithStatus(imports) = req {
+            for import in imports {
+                assert_eq!(import.message, "recovery".to_string());
+            }
         }
     }
 }
@@ -890,18 +877,10 @@ async fn test_utxo_scanner_one_sided_payments() {
     let requests = test_interface.transaction_service_mock_state.drain_requests();
     assert!(!requests.is_empty());
     for req in requests {
-        if let TransactionServiceRequest::ImportUtxoWithStatus {
-            amount: _,
-            source_address: _,
-            message,
-            maturity: _,
-            import_status: _,
-            tx_id: _,
-            current_height: _,
-            mined_timestamp: _,
-        } = req
-        {
-            assert_eq!(message, "one-sided non-default".to_string());
+        if let TransactionServiceRequest::ImportUtxosWithStatus(imports) = req {
+            for import in imports {
+                assert_eq!(import.message, "one-sided non-default".to_string());
+            }
         }
     }
 
@@ -978,19 +957,11 @@ async fn test_utxo_scanner_one_sided_payments() {
     assert!(!requests.is_empty());
 
     for req in requests {
-        if let TransactionServiceRequest::ImportUtxoWithStatus {
-            amount: _,
-            source_address: _,
-            message,
-            maturity: _,
-            import_status: _,
-            tx_id: _,
-            current_height: h,
-            mined_timestamp: _,
-        } = req
-        {
-            println!("{:?}", h);
-            assert_eq!(message, "new one-sided message".to_string());
+        if let TransactionServiceRequest::ImportUtxosWithStatus(imports) = req {
+            for import in imports {
+                println!("{:?}", import.current_height);
+                assert_eq!(import.message, "new one-sided message".to_string());
+            }
         }
     }
 }
@@ -35,7 +35,7 @@
 //! request_key is used to identify which request this callback references and a result of true means it was successful
 //! and false that the process timed out and new one will be started
 
-use std::{ops::Deref, sync::Arc};
+use std::{ops::Deref, sync::Arc, time::Duration};
 
 use log::*;
 use tari_common_types::{tari_address::TariAddress, transaction::TxId};
@@ -56,7 +56,13 @@ use tari_wallet::{
         },
     },
 };
-use tokio::sync::{broadcast, watch};
+use tokio::{
+    sync::{broadcast, watch},
+    time,
+    time::MissedTickBehavior,
+};
+
+use crate::event_batch::{EventBatchConfig, PendingEvents, TariTransactionEventKind, TariValidationEventKind};
 
 const LOG_TARGET: &str = "wallet::transaction_service::callback_handler";
 
@@ -89,6 +95,9 @@ where TBackend: TransactionBackend + 'static
     balance_cache: Balance,
     connectivity_status_watch: watch::Receiver<OnlineStatus>,
     contacts_liveness_events: broadcast::Receiver<Arc<ContactsLivenessEvent>>,
+    event_batching_watch: watch::Receiver<Option<EventBatchConfig>>,
+    event_batch_config: Option<EventBatchConfig>,
+    pending_events: PendingEvents,
 }
 
 impl<TBackend> CallbackHandler<TBackend>
@@ -105,6 +114,7 @@ where TBackend: TransactionBackend + 'static
         comms_address: TariAddress,
         connectivity_status_watch: watch::Receiver<OnlineStatus>,
         contacts_liveness_events: broadcast::Receiver<Arc<ContactsLivenessEvent>>,
+        event_batching_watch: watch::Receiver<Option<EventBatchConfig>>,
         callback_received_transaction: unsafe extern "C" fn(*mut InboundTransaction),
         callback_received_transaction_reply: unsafe extern "C" fn(*mut CompletedTransaction),
         callback_received_finalized_transaction: unsafe extern "C" fn(*mut CompletedTransaction),
@@ -214,6 +224,9 @@ where TBackend: TransactionBackend + 'static
             balance_cache: Balance::zero(),
             connectivity_status_watch,
             contacts_liveness_events,
+            event_batching_watch,
+            event_batch_config: None,
+            pending_events: PendingEvents::new(),
         }
     }
 
@@ -226,6 +239,13 @@ where TBackend: TransactionBackend + 'static
 
         info!(target: LOG_TARGET, "Transaction Service Callback Handler starting");
 
+        let mut flush_interval = time::interval(Duration::from_secs(1));
+        self.event_batch_config = *self.event_batching_watch.borrow();
+        if let Some(config) = self.event_batch_config {
+            flush_interval = time::interval(config.flush_interval);
+        }
+        flush_interval.set_missed_tick_behavior(MissedTickBehavior::Delay);
+
         loop {
             tokio::select! {
                 result = self.transaction_service_event_stream.recv() => {
@@ -353,15 +373,70 @@ where TBackend: TransactionBackend + 'static
                         Err(broadcast::error::RecvError::Closed) => {}
                     }
                 }
+                Ok(_) = self.event_batching_watch.changed() => {
+                    let config = *self.event_batching_watch.borrow();
+                    // Deliver what was collected under the previous configuration before switching
+                    self.flush_events().await;
+                    self.event_batch_config = config;
+                    if let Some(config) = config {
+                        debug!(target: LOG_TARGET, "Event batching enabled with a flush interval of {:.2?}", config.flush_interval);
+                        flush_interval = time::interval(config.flush_interval);
+                        flush_interval.set_missed_tick_behavior(MissedTickBehavior::Delay);
+                    } else {
+                        debug!(target: LOG_TARGET, "Event batching disabled");
+                    }
+                },
+                _ = flush_interval.tick(), if self.event_batch_config.is_some() => {
+                    self.flush_events().await;
+                },
                  _ = shutdown_signal.wait() => {
                     info!(target: LOG_TARGET, "Transaction Callback Handler shutting down because the shutdown signal was received");
+                    // Deliver the events collected since the last flush
+                    self.flush_events().await;
                     break;
                 },
             }
         }
     }
 
+    /// Queues a transaction event for the next batch if event batching is enabled, returning false otherwise
+    fn queue_transaction_event(&mut self, tx_id: TxId, kind: TariTransactionEventKind, value: u64) -> bool {
+        if self.event_batch_config.is_none() {
+            return false;
+        }
+        self.pending_events.push_transaction_event(tx_id, kind, value);
+        true
+    }
+
+    /// Delivers the events collected since the last flush as a single batch
+    async fn flush_events(&mut self) {
+        let config = match self.event_batch_config {
+            Some(config) => config,
+            None => return,
+        };
+        let mut balance = None;
+        if self.pending_events.take_balance_dirty() {
+            match self.output_manager_service.get_balance().await {
+                Ok(b) if b != self.balance_cache => {
+                    self.balance_cache = b.clone();
+                    balance = Some(b);
+                },
+                Ok(_) => {},
+                Err(e) => error!(target: LOG_TARGET, "Could not obtain balance ({:?})", e),
+            }
+        }
+        if let Some(batch) = self.pending_events.take_batch(balance) {
+            debug!(target: LOG_TARGET, "Calling Event Batch callback function");
+            unsafe {
+                (config.callback)(batch);
+            }
+        }
+    }
+
     fn receive_transaction_event(&mut self, tx_id: TxId) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::Received, 0) {
+            return;
+        }
         match self.db.get_pending_inbound_transaction(tx_id) {
             Ok(tx) => {
                 debug!(
@@ -381,6 +456,9 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn receive_transaction_reply_event(&mut self, tx_id: TxId) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::ReplyReceived, 0) {
+            return;
+        }
         match self.db.get_completed_transaction(tx_id) {
             Ok(tx) => {
                 debug!(
@@ -397,6 +475,9 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn receive_finalized_transaction_event(&mut self, tx_id: TxId) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::FinalizedReceived, 0) {
+            return;
+        }
         match self.db.get_completed_transaction(tx_id) {
             Ok(tx) => {
                 debug!(
@@ -413,6 +494,10 @@ where TBackend: TransactionBackend + 'static
     }
 
     async fn trigger_balance_refresh(&mut self) {
+        if self.event_batch_config.is_some() {
+            self.pending_events.mark_balance_dirty();
+            return;
+        }
         match self.output_manager_service.get_balance().await {
             Ok(balance) => {
                 if balance != self.balance_cache {
@@ -462,6 +547,9 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn receive_transaction_cancellation(&mut self, tx_id: TxId, reason: u64) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::Cancelled, reason) {
+            return;
+        }
         let mut transaction = None;
         if let Ok(tx) = self.db.get_cancelled_completed_transaction(tx_id) {
             transaction = Some(tx);
@@ -495,6 +583,9 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn receive_transaction_broadcast_event(&mut self, tx_id: TxId) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::Broadcast, 0) {
+            return;
+        }
         match self.db.get_completed_transaction(tx_id) {
             Ok(tx) => {
                 debug!(
@@ -511,6 +602,9 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn receive_transaction_mined_event(&mut self, tx_id: TxId) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::Mined, 0) {
+            return;
+        }
         match self.db.get_completed_transaction(tx_id) {
             Ok(tx) => {
                 debug!(
@@ -527,6 +621,9 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn receive_transaction_mined_unconfirmed_event(&mut self, tx_id: TxId, confirmations: u64) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::MinedUnconfirmed, confirmations) {
+            return;
+        }
         match self.db.get_completed_transaction(tx_id) {
             Ok(tx) => {
                 debug!(
@@ -543,6 +640,9 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn receive_faux_transaction_confirmed_event(&mut self, tx_id: TxId) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::FauxConfirmed, 0) {
+            return;
+        }
         match self.db.get_completed_transaction(tx_id) {
             Ok(tx) => {
                 debug!(
@@ -559,6 +659,9 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn receive_faux_transaction_unconfirmed_event(&mut self, tx_id: TxId, confirmations: u64) {
+        if self.queue_transaction_event(tx_id, TariTransactionEventKind::FauxUnconfirmed, confirmations) {
+            return;
+        }
         match self.db.get_completed_transaction(tx_id) {
             Ok(tx) => {
                 debug!(
@@ -575,6 +678,11 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn transaction_validation_complete_event(&mut self, request_key: u64, success: u64) {
+        if self.event_batch_config.is_some() {
+            self.pending_events
+                .push_validation_event(TariValidationEventKind::Transaction, request_key, success);
+            return;
+        }
         debug!(
             target: LOG_TARGET,
             "Calling Transaction Validation Complete callback function for Request Key: {}", request_key,
@@ -585,6 +693,11 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn output_validation_complete_event(&mut self, request_key: u64, success: u64) {
+        if self.event_batch_config.is_some() {
+            self.pending_events
+                .push_validation_event(TariValidationEventKind::Txo, request_key, success);
+            return;
+        }
         debug!(
             target: LOG_TARGET,
             "Calling Output Validation Complete callback function for Request Key: {} with success = {:?}",
@@ -598,6 +711,10 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn saf_messages_received_event(&mut self) {
+        if self.event_batch_config.is_some() {
+            self.pending_events.set_saf_messages_received();
+            return;
+        }
         debug!(target: LOG_TARGET, "Calling SAF Messages Received callback function");
         unsafe {
             (self.callback_saf_messages_received)();
@@ -605,6 +722,10 @@ where TBackend: TransactionBackend + 'static
     }
 
     fn connectivity_status_changed(&mut self, status: OnlineStatus) {
+        if self.event_batch_config.is_some() {
+            self.pending_events.set_connectivity_status(status as u64);
+            return;
+        }
         debug!(
             target: LOG_TARGET,
             "Calling Connectivity Status changed callback function"
@@ -56,7 +56,11 @@ mod test {
         time::Instant,
     };
 
-    use crate::{callback_handler::CallbackHandler, output_manager_service_mock::MockOutputManagerService};
+    use crate::{
+        callback_handler::CallbackHandler,
+        event_batch::{EventBatchConfig, TariEventBatch, TariTransactionEvent, TariTransactionEventKind},
+        output_manager_service_mock::MockOutputManagerService,
+    };
 
     #[derive(Debug)]
     #[allow(clippy::struct_excessive_bools)]
@@ -433,6 +437,7 @@ mod test {
         assert_eq!(balance, runtime.block_on(oms_handle.get_balance()).unwrap());
 
         let (connectivity_tx, connectivity_rx) = watch::channel(OnlineStatus::Offline);
+        let (_event_batching_tx, event_batching_rx) = watch::channel(None);
         let (contacts_liveness_events_sender, _) = broadcast::channel(250);
         let contacts_liveness_events = contacts_liveness_events_sender.subscribe();
         let comms_address = TariAddress::new(
@@ -450,6 +455,7 @@ mod test {
             comms_address,
             connectivity_rx,
             contacts_liveness_events,
+            event_batching_rx,
             received_tx_callback,
             received_tx_reply_callback,
             received_tx_finalized_callback,
@@ -796,4 +802,234 @@ mod test {
 
         drop(lock);
     }
+
+    /// A batch as seen by the event batch callback
+    #[derive(Debug)]
+    struct BatchRecord {
+        transaction_events: Vec<TariTransactionEvent>,
+        balance: Option<Balance>,
+        saf_messages_received: bool,
+    }
+
+    #[derive(Debug, Default)]
+    struct BatchCallbackState {
+        batches: Vec<BatchRecord>,
+        individual_callbacks: u32,
+    }
+
+    lazy_static! {
+        static ref BATCH_CALLBACK_STATE: Mutex<BatchCallbackState> = Mutex::new(BatchCallbackState::default());
+    }
+
+    unsafe extern "C" fn event_batch_callback(batch: *mut TariEventBatch) {
+        let record = {
+            let batch = &*batch;
+            BatchRecord {
+                transaction_events: std::slice::from_raw_parts(batch.transaction_events, batch.transaction_events_len)
+                    .to_vec(),
+                balance: batch.balance.as_ref().cloned(),
+                saf_messages_received: batch.saf_messages_received,
+            }
+        };
+        BATCH_CALLBACK_STATE.lock().unwrap().batches.push(record);
+        TariEventBatch::destroy(batch);
+    }
+
+    fn individual_callback_called() {
+        BATCH_CALLBACK_STATE.lock().unwrap().individual_callbacks += 1;
+    }
+
+    unsafe extern "C" fn unbatched_inbound_tx_callback(tx: *mut InboundTransaction) {
+        individual_callback_called();
+        drop(Box::from_raw(tx));
+    }
+
+    unsafe extern "C" fn unbatched_completed_tx_callback(tx: *mut CompletedTransaction) {
+        individual_callback_called();
+        drop(Box::from_raw(tx));
+    }
+
+    unsafe extern "C" fn unbatched_completed_tx_value_callback(tx: *mut CompletedTransaction, _value: u64) {
+        individual_callback_called();
+        drop(Box::from_raw(tx));
+    }
+
+    unsafe extern "C" fn unbatched_send_result_callback(_tx_id: u64, status: *mut TransactionSendStatus) {
+        individual_callback_called();
+        drop(Box::from_raw(status));
+    }
+
+    unsafe extern "C" fn unbatched_contacts_liveness_callback(data: *mut ContactsLivenessData) {
+        individual_callback_called();
+        drop(Box::from_raw(data));
+    }
+
+    unsafe extern "C" fn unbatched_balance_callback(balance: *mut Balance) {
+        individual_callback_called();
+        drop(Box::from_raw(balance));
+    }
+
+    unsafe extern "C" fn unbatched_result_callback(_request_key: u64, _result: u64) {
+        individual_callback_called();
+    }
+
+    unsafe extern "C" fn unbatched_saf_callback() {
+        individual_callback_called();
+    }
+
+    unsafe extern "C" fn unbatched_connectivity_callback(_status: u64) {
+        individual_callback_called();
+    }
+
+    #[test]
+    #[allow(clippy::too_many_lines)]
+    fn test_callback_handler_event_batching() {
+        let runtime = Runtime::new().unwrap();
+
+        let (connection, _tempdir) = make_wallet_database_connection(None);
+        let mut key = [0u8; size_of::<Key>()];
+        OsRng.fill_bytes(&mut key);
+        let cipher = XChaCha20Poly1305::new(Key::from_slice(&key));
+        let db = TransactionDatabase::new(TransactionServiceSqliteDatabase::new(connection, cipher));
+
+        let (transaction_event_sender, transaction_event_receiver) = broadcast::channel(20);
+        let (oms_event_sender, oms_event_receiver) = broadcast::channel(20);
+        let (dht_event_sender, dht_event_receiver) = broadcast::channel(20);
+        let (oms_request_sender, oms_request_receiver) = reply_channel::unbounded();
+        let oms_handle = OutputManagerHandle::new(oms_request_sender, oms_event_sender);
+
+        let mut shutdown = Shutdown::new();
+        let mut mock_output_manager_service = MockOutputManagerService::new(oms_request_receiver, shutdown.to_signal());
+        let balance = Balance {
+            available_balance: MicroTari::from(1000),
+            time_locked_balance: None,
+            pending_incoming_balance: MicroTari::from(200),
+            pending_outgoing_balance: MicroTari::from(0),
+        };
+        let mut mock_output_manager_service_state = mock_output_manager_service.get_response_state();
+        mock_output_manager_service_state.set_balance(balance.clone());
+        runtime.spawn(mock_output_manager_service.run());
+
+        let (_connectivity_tx, connectivity_rx) = watch::channel(OnlineStatus::Offline);
+        let (event_batching_tx, event_batching_rx) = watch::channel(Some(EventBatchConfig {
+            callback: event_batch_callback,
+            flush_interval: Duration::from_secs(1),
+        }));
+        let (contacts_liveness_events_sender, _) = broadcast::channel(250);
+        let comms_address = TariAddress::new(
+            PublicKey::from_secret_key(&PrivateKey::random(&mut OsRng)),
+            Network::LocalNet,
+        );
+
+        let callback_handler = CallbackHandler::new(
+            db,
+            transaction_event_receiver,
+            oms_event_receiver,
+            oms_handle,
+            dht_event_receiver,
+            shutdown.to_signal(),
+            comms_address,
+            connectivity_rx,
+            contacts_liveness_events_sender.subscribe(),
+            event_batching_rx,
+            unbatched_inbound_tx_callback,
+            unbatched_completed_tx_callback,
+            unbatched_completed_tx_callback,
+            unbatched_completed_tx_callback,
+            unbatched_completed_tx_callback,
+            unbatched_completed_tx_value_callback,
+            unbatched_completed_tx_callback,
+            unbatched_completed_tx_value_callback,
+            unbatched_send_result_callback,
+            unbatched_completed_tx_value_callback,
+            unbatched_result_callback,
+            unbatched_contacts_liveness_callback,
+            unbatched_balance_callback,
+            unbatched_result_callback,
+            unbatched_saf_callback,
+            unbatched_connectivity_callback,
+        );
+        runtime.spawn(callback_handler.start());
+        // Let the handler take the immediate first tick of its flush interval
+        thread::sleep(Duration::from_millis(200));
+
+        // Events of the same transaction within one interval are coalesced into its latest event
+        for event in [
+            TransactionEvent::ReceivedTransaction(1u64.into()),
+            TransactionEvent::TransactionBroadcast(1u64.into()),
+            TransactionEvent::TransactionMined {
+                tx_id: 1u64.into(),
+                is_valid: true,
+            },
+            TransactionEvent::ReceivedTransaction(2u64.into()),
+        ] {
+            transaction_event_sender.send(Arc::new(event)).unwrap();
+        }
+        dht_event_sender
+            .send(Arc::new(DhtEvent::StoreAndForwardMessagesReceived))
+            .unwrap();
+        thread::sleep(Duration::from_millis(2500));
+        {
+            let lock = BATCH_CALLBACK_STATE.lock().unwrap();
+            // The interval after the events had nothing to report, so it delivered no batch
+            assert_eq!(lock.batches.len(), 1);
+            let batch = &lock.batches[0];
+            assert_eq!(batch.transaction_events, vec![
+                TariTransactionEvent {
+                    tx_id: 1,
+                    kind: TariTransactionEventKind::Mined,
+                    value: 0,
+                },
+                TariTransactionEvent {
+                    tx_id: 2,
+                    kind: TariTransactionEventKind::Received,
+                    value: 0,
+                },
+            ]);
+            assert_eq!(batch.balance, Some(balance.clone()));
+            assert!(batch.saf_messages_received);
+        }
+
+        // The balance did not change, so the next batch does not report it
+        transaction_event_sender
+            .send(Arc::new(TransactionEvent::TransactionBroadcast(3u64.into())))
+            .unwrap();
+        thread::sleep(Duration::from_millis(1500));
+        {
+            let lock = BATCH_CALLBACK_STATE.lock().unwrap();
+            assert_eq!(lock.batches.len(), 2);
+            assert_eq!(lock.batches[1].transaction_events, vec![TariTransactionEvent {
+                tx_id: 3,
+                kind: TariTransactionEventKind::Broadcast,
+                value: 0,
+            }]);
+            assert_eq!(lock.batches[1].balance, None);
+            assert!(!lock.batches[1].saf_messages_received);
+        }
+
+        // With a flush interval that does not elapse during the test, pending events are delivered on shutdown
+        event_batching_tx
+            .send(Some(EventBatchConfig {
+                callback: event_batch_callback,
+                flush_interval: Duration::from_secs(3600),
+            }))
+            .unwrap();
+        thread::sleep(Duration::from_millis(200));
+        transaction_event_sender
+            .send(Arc::new(TransactionEvent::ReceivedTransaction(4u64.into())))
+            .unwrap();
+        thread::sleep(Duration::from_millis(200));
+        assert_eq!(BATCH_CALLBACK_STATE.lock().unwrap().batches.len(), 2);
+        shutdown.trigger();
+        thread::sleep(Duration::from_millis(500));
+
+        let lock = BATCH_CALLBACK_STATE.lock().unwrap();
+        assert_eq!(lock.batches.len(), 3);
+        assert_eq!(lock.batches[2].transaction_events, vec![TariTransactionEvent {
+            tx_id: 4,
+            kind: TariTransactionEventKind::Received,
+            value: 0,
+        }]);
+        assert_eq!(lock.individual_callbacks, 0);
+    }
 }
@@ -0,0 +1,236 @@
+// Copyright 2022. The Tari Project
+// SPDX-License-Identifier: BSD-3-Clause
+
+//! Completion queue backing the `_async` FFI entry points.
+//!
+//! An `_async` call allocates a request id, spawns the service round trip onto the wallet runtime and returns the id
+//! to the caller straight away. When the task finishes its `Completion` is either handed to the registered
+//! completion callback or, when no callback is registered, queued until the client collects it with
+//! `wallet_poll_completions`.
+
+use std::{
+    collections::VecDeque,
+    mem::ManuallyDrop,
+    ptr,
+    sync::{
+        atomic::{AtomicU64, Ordering},
+        Mutex,
+    },
+};
+
+use libc::{c_int, c_void};
+use log::*;
+use tari_wallet::output_manager_service::{service::Balance, storage::models::DbUnblindedOutput};
+
+use crate::TariVector;
+
+const LOG_TARGET: &str = "wallet_ffi::completions";
+
+pub type CompletionCallback = unsafe extern "C" fn(TariCompletion);
+
+/// Identifies which `_async` call a completion belongs to
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(C)]
+pub enum TariCompletionKind {
+    GetBalance = 0,
+    SendTransaction = 1,
+    CoinJoin = 2,
+    GetUtxos = 3,
+}
+
+/// The outcome of an `_async` call as seen by the client.
+///
+/// `error_code` is 0 on success. `value` carries the scalar result (the `TxId` for sends and coin joins) and `result`
+/// carries a heap allocated result (a `TariBalance` for `GetBalance` and a `TariVector` of `TariUtxo` for `GetUtxos`)
+/// which becomes owned by the client and must be freed with its matching destroy function.
+#[derive(Debug)]
+#[repr(C)]
+pub struct TariCompletion {
+    pub request_id: u64,
+    pub kind: TariCompletionKind,
+    pub error_code: c_int,
+    pub value: u64,
+    pub result: *mut c_void,
+}
+
+#[derive(Debug)]
+#[repr(C)]
+pub struct TariCompletions {
+    pub len: usize,
+    pub cap: usize,
+    pub ptr: *mut TariCompletion,
+}
+
+impl From<Vec<TariCompletion>> for TariCompletions {
+    fn from(v: Vec<TariCompletion>) -> Self {
+        let mut v = ManuallyDrop::new(v);
+
+        Self {
+            len: v.len(),
+            cap: v.capacity(),
+            ptr: v.as_mut_ptr(),
+        }
+    }
+}
+
+/// The heap allocated result of a completion, if any
+#[derive(Debug)]
+pub enum CompletionResult {
+    None,
+    Balance(Box<Balance>),
+    Utxos(Vec<DbUnblindedOutput>),
+}
+
+/// Internal, thread safe form of a completion. Results are only turned into raw pointers once they are delivered.
+#[derive(Debug)]
+pub struct Completion {
+    pub request_id: u64,
+    pub kind: TariCompletionKind,
+    pub error_code: c_int,
+    pub value: u64,
+    pub result: CompletionResult,
+}
+
+impl Completion {
+    pub fn success(request_id: u64, kind: TariCompletionKind, value: u64) -> Self {
+        Self {
+            request_id,
+            kind,
+            error_code: 0,
+            value,
+            result: CompletionResult::None,
+        }
+    }
+
+    pub fn balance(request_id: u64, balance: Balance) -> Self {
+        Self {
+            request_id,
+            kind: TariCompletionKind::GetBalance,
+            error_code: 0,
+            value: 0,
+            result: CompletionResult::Balance(Box::new(balance)),
+        }
+    }
+
+    pub fn utxos(request_id: u64, utxos: Vec<DbUnblindedOutput>) -> Self {
+        Self {
+            request_id,
+            kind: TariCompletionKind::GetUtxos,
+            error_code: 0,
+            value: 0,
+            result: CompletionResult::Utxos(utxos),
+        }
+    }
+
+    pub fn failure(request_id: u64, kind: TariCompletionKind, error_code: c_int) -> Self {
+        Self {
+            request_id,
+            kind,
+            error_code,
+            value: 0,
+            result: CompletionResult::None,
+        }
+    }
+}
+
+impl From<Completion> for TariCompletion {
+    fn from(c: Completion) -> Self {
+        Self {
+            request_id: c.request_id,
+            kind: c.kind,
+            error_code: c.error_code,
+            value: c.value,
+            result: match c.result {
+                CompletionResult::None => ptr::null_mut(),
+                CompletionResult::Balance(balance) => Box::into_raw(balance) as *mut c_void,
+                CompletionResult::Utxos(utxos) => Box::into_raw(Box::new(TariVector::from(utxos))) as *mut c_void,
+            },
+        }
+    }
+}
+
+pub struct CompletionQueue {
+    next_request_id: AtomicU64,
+    pending: Mutex<VecDeque<Completion>>,
+    callback: Mutex<Option<CompletionCallback>>,
+}
+
+impl CompletionQueue {
+    pub fn new() -> Self {
+        Self {
+            // 0 is reserved to signal that a request could not be submitted
+            next_request_id: AtomicU64::new(1),
+            pending: Mutex::new(VecDeque::new()),
+            callback: Mutex::new(None),
+        }
+    }
+
+    pub fn next_request_id(&self) -> u64 {
+        self.next_request_id.fetch_add(1, Ordering::Relaxed)
+    }
+
+    pub fn set_callback(&self, callback: Option<CompletionCallback>) {
+        *self.callback.lock().unwrap_or_else(|e| e.into_inner()) = callback;
+    }
+
+    /// Delivers a completion to the registered callback, or queues it for `drain` if there is none.
+    pub fn complete(&self, completion: Completion) {
+        let callback = *self.callback.lock().unwrap_or_else(|e| e.into_inner());
+        match callback {
+            Some(callback) => {
+                debug!(
+                    target: LOG_TARGET,
+                    "Calling completion callback for request {}", completion.request_id
+                );
+                unsafe {
+                    (callback)(completion.into());
+                }
+            },
+            None => self
+                .pending
+                .lock()
+                .unwrap_or_else(|e| e.into_inner())
+                .push_back(completion),
+        }
+    }
+
+    /// Removes up to `max` queued completions in the order they finished
+    pub fn drain(&self, max: usize) -> Vec<Completion> {
+        let mut pending = self.pending.lock().unwrap_or_else(|e| e.into_inner());
+        let n = max.min(pending.len());
+        pending.drain(..n).collect()
+    }
+}
+
+impl Default for CompletionQueue {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use super::*;
+
+    #[test]
+    fn it_queues_completions_in_order_without_a_callback() {
+        let queue = CompletionQueue::new();
+        let a = queue.next_request_id();
+        let b = queue.next_request_id();
+        assert_eq!(a, 1);
+        assert_eq!(b, 2);
+
+        queue.complete(Completion::success(b, TariCompletionKind::SendTransaction, 42));
+        queue.complete(Completion::failure(a, TariCompletionKind::CoinJoin, 101));
+
+        let drained = queue.drain(1);
+        assert_eq!(drained.len(), 1);
+        assert_eq!(drained[0].request_id, b);
+        assert_eq!(drained[0].value, 42);
+        let drained = queue.drain(10);
+        assert_eq!(drained.len(), 1);
+        assert_eq!(drained[0].request_id, a);
+        assert_eq!(drained[0].error_code, 101);
+        assert!(queue.drain(10).is_empty());
+    }
+}
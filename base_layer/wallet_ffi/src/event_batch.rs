@@ -0,0 +1,245 @@
+// Copyright 2022. The Tari Project
+// SPDX-License-Identifier: BSD-3-Clause
+
+//! Opt-in batching of the wallet callbacks.
+//!
+//! When a client enables event batching with `wallet_set_event_batching` the callback handler stops calling the
+//! individual transaction, balance, validation, connectivity and SAF callbacks. The events are instead collected in
+//! `PendingEvents` and delivered as a single `TariEventBatch` once per flush interval:
+//! - Only the latest event per transaction is kept, identified by its `TxId`, and no transaction is loaded from the
+//!   database. Clients fetch the transactions they are interested in with the existing getters.
+//! - The balance is fetched once per flush and only reported when it changed.
+//! - The latest connectivity status wins.
+//! - Validation completions are reported in the order they happened.
+//!
+//! Transaction send results and contacts liveness updates are still delivered through their own callbacks.
+
+use std::{collections::HashMap, mem::ManuallyDrop, ptr, time::Duration};
+
+use tari_common_types::transaction::TxId;
+use tari_wallet::output_manager_service::service::Balance;
+
+pub type EventBatchCallback = unsafe extern "C" fn(*mut TariEventBatch);
+
+#[derive(Clone, Copy, Debug)]
+pub struct EventBatchConfig {
+    pub callback: EventBatchCallback,
+    pub flush_interval: Duration,
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(C)]
+pub enum TariTransactionEventKind {
+    Received = 0,
+    ReplyReceived = 1,
+    FinalizedReceived = 2,
+    Broadcast = 3,
+    Mined = 4,
+    MinedUnconfirmed = 5,
+    FauxConfirmed = 6,
+    FauxUnconfirmed = 7,
+    Cancelled = 8,
+}
+
+/// The latest event for a transaction. `value` holds the number of confirmations for the unconfirmed kinds and the
+/// cancellation reason for `Cancelled`.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(C)]
+pub struct TariTransactionEvent {
+    pub tx_id: u64,
+    pub kind: TariTransactionEventKind,
+    pub value: u64,
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(C)]
+pub enum TariValidationEventKind {
+    Txo = 0,
+    Transaction = 1,
+}
+
+/// A validation completion, with the same `result` values as the matching individual callback
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(C)]
+pub struct TariValidationEvent {
+    pub kind: TariValidationEventKind,
+    pub request_key: u64,
+    pub result: u64,
+}
+
+/// The coalesced events of one flush interval. `balance` is null when the balance did not change and
+/// `connectivity_status` is -1 when the connectivity status did not change.
+#[derive(Debug)]
+#[repr(C)]
+pub struct TariEventBatch {
+    pub balance: *mut Balance,
+    pub transaction_events_len: usize,
+    pub transaction_events: *mut TariTransactionEvent,
+    pub validation_events_len: usize,
+    pub validation_events: *mut TariValidationEvent,
+    pub connectivity_status: i32,
+    pub saf_messages_received: bool,
+}
+
+impl TariEventBatch {
+    /// Frees the batch and everything it points to
+    ///
+    /// # Safety
+    /// `batch` must have been produced by `PendingEvents::take_batch` and not been destroyed before
+    pub unsafe fn destroy(batch: *mut TariEventBatch) {
+        let batch = Box::from_raw(batch);
+        if !batch.balance.is_null() {
+            drop(Box::from_raw(batch.balance));
+        }
+        // The arrays are boxed slices, so their capacity equals their length
+        drop(Vec::from_raw_parts(
+            batch.transaction_events,
+            batch.transaction_events_len,
+            batch.transaction_events_len,
+        ));
+        drop(Vec::from_raw_parts(
+            batch.validation_events,
+            batch.validation_events_len,
+            batch.validation_events_len,
+        ));
+    }
+}
+
+#[derive(Debug, Default)]
+pub struct PendingEvents {
+    transaction_events: Vec<TariTransactionEvent>,
+    transaction_index: HashMap<TxId, usize>,
+    validation_events: Vec<TariValidationEvent>,
+    connectivity_status: Option<u64>,
+    saf_messages_received: bool,
+    balance_dirty: bool,
+}
+
+impl PendingEvents {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Records the latest event for a transaction, replacing any earlier event for the same transaction
+    pub fn push_transaction_event(&mut self, tx_id: TxId, kind: TariTransactionEventKind, value: u64) {
+        let event = TariTransactionEvent {
+            tx_id: tx_id.as_u64(),
+            kind,
+            value,
+        };
+        match self.transaction_index.get(&tx_id) {
+            Some(i) => self.transaction_events[*i] = event,
+            None => {
+                self.transaction_index.insert(tx_id, self.transaction_events.len());
+                self.transaction_events.push(event);
+            },
+        }
+    }
+
+    pub fn push_validation_event(&mut self, kind: TariValidationEventKind, request_key: u64, result: u64) {
+        self.validation_events.push(TariValidationEvent {
+            kind,
+            request_key,
+            result,
+        });
+    }
+
+    pub fn set_connectivity_status(&mut self, status: u64) {
+        self.connectivity_status = Some(status);
+    }
+
+    pub fn set_saf_messages_received(&mut self) {
+        self.saf_messages_received = true;
+    }
+
+    pub fn mark_balance_dirty(&mut self) {
+        self.balance_dirty = true;
+    }
+
+    /// Returns true, and clears the flag, if a balance refresh was requested since the last call
+    pub fn take_balance_dirty(&mut self) -> bool {
+        std::mem::take(&mut self.balance_dirty)
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.transaction_events.is_empty() &&
+            self.validation_events.is_empty() &&
+            self.connectivity_status.is_none() &&
+            !self.saf_messages_received
+    }
+
+    /// Drains the pending events into a heap allocated batch, or returns None if there is nothing to report
+    pub fn take_batch(&mut self, balance: Option<Balance>) -> Option<*mut TariEventBatch> {
+        if self.is_empty() && balance.is_none() {
+            return None;
+        }
+        self.transaction_index.clear();
+        let mut transaction_events = ManuallyDrop::new(std::mem::take(&mut self.transaction_events).into_boxed_slice());
+        let mut validation_events = ManuallyDrop::new(std::mem::take(&mut self.validation_events).into_boxed_slice());
+
+        let batch = TariEventBatch {
+            balance: balance.map(|b| Box::into_raw(Box::new(b))).unwrap_or(ptr::null_mut()),
+            transaction_events_len: transaction_events.len(),
+            transaction_events: transaction_events.as_mut_ptr(),
+            validation_events_len: validation_events.len(),
+            validation_events: validation_events.as_mut_ptr(),
+            connectivity_status: self.connectivity_status.take().map(|s| s as i32).unwrap_or(-1),
+            saf_messages_received: std::mem::take(&mut self.saf_messages_received),
+        };
+        Some(Box::into_raw(Box::new(batch)))
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use std::slice;
+
+    use tari_core::transactions::tari_amount::MicroTari;
+
+    use super::*;
+
+    #[test]
+    fn it_coalesces_events() {
+        let mut pending = PendingEvents::new();
+        assert!(pending.take_batch(None).is_none());
+
+        pending.push_transaction_event(1u64.into(), TariTransactionEventKind::Broadcast, 0);
+        pending.push_transaction_event(2u64.into(), TariTransactionEventKind::Received, 0);
+        pending.push_transaction_event(1u64.into(), TariTransactionEventKind::MinedUnconfirmed, 1);
+        pending.push_transaction_event(1u64.into(), TariTransactionEventKind::MinedUnconfirmed, 2);
+        pending.push_validation_event(TariValidationEventKind::Txo, 7, 0);
+        pending.push_validation_event(TariValidationEventKind::Transaction, 8, 0);
+        pending.set_connectivity_status(1);
+        pending.set_connectivity_status(2);
+        pending.mark_balance_dirty();
+        assert!(pending.take_balance_dirty());
+        assert!(!pending.take_balance_dirty());
+
+        let mut balance = Balance::zero();
+        balance.available_balance = MicroTari::from(100);
+        let batch = pending.take_batch(Some(balance.clone())).unwrap();
+        unsafe {
+            assert_eq!(*(*batch).balance, balance);
+            let tx_events = slice::from_raw_parts((*batch).transaction_events, (*batch).transaction_events_len);
+            assert_eq!(tx_events, &[
+                TariTransactionEvent {
+                    tx_id: 1,
+                    kind: TariTransactionEventKind::MinedUnconfirmed,
+                    value: 2,
+                },
+                TariTransactionEvent {
+                    tx_id: 2,
+                    kind: TariTransactionEventKind::Received,
+                    value: 0,
+                },
+            ]);
+            assert_eq!((*batch).validation_events_len, 2);
+            assert_eq!((*batch).connectivity_status, 2);
+            assert!(!(*batch).saf_messages_received);
+            TariEventBatch::destroy(batch);
+        }
+
+        assert!(pending.is_empty());
+        assert!(pending.take_batch(None).is_none());
+    }
+}
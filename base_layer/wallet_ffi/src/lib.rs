@@ -151,7 +151,15 @@ use tari_wallet::{
         error::TransactionServiceError,
         storage::{
             database::TransactionDatabase,
-            models::{CompletedTransaction, InboundTransaction, OutboundTransaction},
+            models::{
+                CompletedTransaction,
+                InboundTransaction,
+                OutboundTransaction,
+                TransactionSummaryFilter,
+                TransactionSummaryPosition,
+                TransactionSummarySource,
+            },
+            sqlite_db::TransactionSummary,
         },
     },
     utxo_scanner_service::{service::UtxoScannerService, RECOVERY_KEY},
@@ -160,21 +168,32 @@ use tari_wallet::{
     WalletConfig,
     WalletSqlite,
 };
-use tokio::runtime::Runtime;
+use tokio::{runtime::Runtime, sync::watch};
 use zeroize::Zeroize;
 
 use crate::{
     callback_handler::CallbackHandler,
+    completions::{
+        Completion,
+        CompletionCallback,
+        CompletionQueue,
+        TariCompletion,
+        TariCompletionKind,
+        TariCompletions,
+    },
     enums::SeedWordPushResult,
     error::{InterfaceError, TransactionError},
+    event_batch::{EventBatchCallback, EventBatchConfig, TariEventBatch},
     tasks::recovery_event_monitoring,
 };
 
 mod callback_handler;
 #[cfg(test)]
 mod callback_handler_tests;
+mod completions;
 mod enums;
 mod error;
+mod event_batch;
 #[cfg(test)]
 mod output_manager_service_mock;
 mod tasks;
@@ -237,6 +256,8 @@ pub struct TariWallet {
     wallet: WalletSqlite,
     runtime: Runtime,
     shutdown: Shutdown,
+    completions: Arc<CompletionQueue>,
+    event_batching: watch::Sender<Option<EventBatchConfig>>,
 }
 
 #[derive(Debug)]
@@ -317,6 +338,86 @@ impl From<DbUnblindedOutput> for TariUtxo {
     }
 }
 
+/// The value written to the status column of `TariUtxoColumns` for an output that has been deleted from the wallet
+pub const TARI_UTXO_STATUS_DELETED: u8 = 255;
+
+/// Caller provided column buffers filled by `wallet_export_utxo_columns`. Each non-null column must have room for
+/// `capacity` entries; `commitments` holds 32 raw bytes per output. Null columns are skipped.
+#[derive(Debug)]
+#[repr(C)]
+pub struct TariUtxoColumns {
+    pub capacity: usize,
+    pub len: usize,
+    pub revision: u64,
+    pub commitments: *mut u8,
+    pub values: *mut u64,
+    pub mined_heights: *mut u64,
+    pub mined_timestamps: *mut u64,
+    pub statuses: *mut u8,
+}
+
+/// A fixed layout summary of a transaction, returned in batches by `wallet_transactions_cursor_next_batch`
+#[derive(Debug, Clone)]
+#[repr(C)]
+pub struct TariTransactionRecord {
+    pub tx_id: u64,
+    pub amount: u64,
+    pub fee: u64,
+    pub timestamp: u64,
+    pub mined_height: u64,
+    pub mined_timestamp: u64,
+    pub confirmations: u64,
+    pub status: i32,
+    pub direction: i32,
+    pub cancellation_reason: i32,
+    pub source_address: [u8; 33],
+    pub destination_address: [u8; 33],
+}
+
+impl From<TransactionSummary> for TariTransactionRecord {
+    fn from(x: TransactionSummary) -> Self {
+        Self {
+            tx_id: x.tx_id.as_u64(),
+            amount: x.amount.as_u64(),
+            fee: x.fee.as_u64(),
+            timestamp: x.timestamp.timestamp() as u64,
+            mined_height: x.mined_height.unwrap_or(0),
+            mined_timestamp: x.mined_timestamp.map(|ts| ts.timestamp() as u64).unwrap_or_default(),
+            confirmations: x.confirmations.unwrap_or(0),
+            status: x.status as i32,
+            direction: x.direction as i32,
+            cancellation_reason: x.cancelled.map(|reason| reason as i32).unwrap_or(-1),
+            source_address: x.source_address.to_bytes(),
+            destination_address: x.destination_address.to_bytes(),
+        }
+    }
+}
+
+#[derive(Debug)]
+#[repr(C)]
+pub struct TariTransactionRecords {
+    pub len: usize,
+    pub cap: usize,
+    pub ptr: *mut TariTransactionRecord,
+}
+
+impl From<Vec<TariTransactionRecord>> for TariTransactionRecords {
+    fn from(v: Vec<TariTransactionRecord>) -> Self {
+        let mut v = ManuallyDrop::new(v);
+
+        Self {
+            len: v.len(),
+            cap: v.capacity(),
+            ptr: v.as_mut_ptr(),
+        }
+    }
+}
+
+pub struct TariTransactionsCursor {
+    filter: TransactionSummaryFilter,
+    position: Option<TransactionSummaryPosition>,
+}
+
 /// -------------------------------- Vector ------------------------------------------------ ///
 
 #[derive(Debug, Clone)]
@@ -3001,6 +3102,198 @@ pub unsafe extern "C" fn completed_transactions_destroy(transactions: *mut TariC
 
 /// -------------------------------------------------------------------------------------------- ///
 
+/// ----------------------------------- TransactionsCursor ------------------------------------- ///
+
+/// Opens a cursor that pages through the transactions of a TariWallet, newest first, in batches of fixed layout
+/// records without loading the transaction bodies
+///
+/// ## Arguments
+/// `wallet` - The TariWallet pointer
+/// `source` - The transactions to page through: 0 for completed, 1 for pending inbound and 2 for pending outbound
+/// transactions. Pending transactions have the `Pending` status and are never mined
+/// `status_mask` - Bitmask of the transaction statuses to include, bit `n` selects the status with value `n` as listed
+/// for `completed_transaction_get_status`. A mask of 0 includes all statuses
+/// `direction` - The direction to include: -1 for any, 0 for inbound, 1 for outbound
+/// `min_mined_height` - Only include transactions mined at or above this height, 0 for no lower bound
+/// `max_mined_height` - Only include transactions mined at or below this height, 0 for no upper bound
+/// `cancelled` - Include only cancelled transactions if true, otherwise only non-cancelled transactions
+/// `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+/// as an out parameter.
+///
+/// ## Returns
+/// `*mut TariTransactionsCursor` - Returns the cursor, note that it returns ptr::null_mut() if wallet is null or an
+/// argument is invalid
+///
+/// # Safety
+/// The ```wallet_transactions_cursor_close``` method must be called when finished with a TariTransactionsCursor to
+/// prevent a memory leak
+#[no_mangle]
+pub unsafe extern "C" fn wallet_transactions_cursor_open(
+    wallet: *mut TariWallet,
+    source: c_int,
+    status_mask: c_uint,
+    direction: c_int,
+    min_mined_height: c_ulonglong,
+    max_mined_height: c_ulonglong,
+    cancelled: bool,
+    error_out: *mut c_int,
+) -> *mut TariTransactionsCursor {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return ptr::null_mut();
+    }
+
+    let source = match source {
+        0 => TransactionSummarySource::Completed,
+        1 => TransactionSummarySource::PendingInbound,
+        2 => TransactionSummarySource::PendingOutbound,
+        _ => {
+            error = LibWalletError::from(InterfaceError::InvalidArgument("source".to_string())).code;
+            ptr::swap(error_out, &mut error as *mut c_int);
+            return ptr::null_mut();
+        },
+    };
+
+    let statuses = match (0..c_uint::BITS as i32)
+        .filter(|bit| status_mask & (1 << *bit) != 0)
+        .map(TransactionStatus::try_from)
+        .collect::<Result<Vec<_>, _>>()
+    {
+        Ok(statuses) => statuses,
+        Err(e) => {
+            error = LibWalletError::from(InterfaceError::InvalidArgument(format!("status_mask: {}", e))).code;
+            ptr::swap(error_out, &mut error as *mut c_int);
+            return ptr::null_mut();
+        },
+    };
+
+    let direction = match direction {
+        -1 => None,
+        0 => Some(TransactionDirection::Inbound),
+        1 => Some(TransactionDirection::Outbound),
+        _ => {
+            error = LibWalletError::from(InterfaceError::InvalidArgument("direction".to_string())).code;
+            ptr::swap(error_out, &mut error as *mut c_int);
+            return ptr::null_mut();
+        },
+    };
+
+    Box::into_raw(Box::new(TariTransactionsCursor {
+        filter: TransactionSummaryFilter {
+            source,
+            statuses,
+            direction,
+            min_mined_height: Some(min_mined_height).filter(|h| *h > 0),
+            max_mined_height: Some(max_mined_height).filter(|h| *h > 0),
+            cancelled,
+        },
+        position: None,
+    }))
+}
+
+/// Fetches the next batch of records from a TariTransactionsCursor, advancing the cursor
+///
+/// ## Arguments
+/// `wallet` - The TariWallet pointer
+/// `cursor` - The TariTransactionsCursor pointer
+/// `batch_size` - The maximum number of records to return
+/// `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+/// as an out parameter.
+///
+/// ## Returns
+/// `*mut TariTransactionRecords` - Returns a struct with an array pointer, length and capacity (needed for proper
+/// destruction after use). An empty batch means the cursor is exhausted. Note that it returns ptr::null_mut() if
+/// wallet or cursor is null or an error is encountered
+///
+/// # Safety
+/// The ```transaction_records_destroy``` method must be called when finished with a TariTransactionRecords to prevent
+/// a memory leak
+#[no_mangle]
+pub unsafe extern "C" fn wallet_transactions_cursor_next_batch(
+    wallet: *mut TariWallet,
+    cursor: *mut TariTransactionsCursor,
+    batch_size: c_uint,
+    error_out: *mut c_int,
+) -> *mut TariTransactionRecords {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return ptr::null_mut();
+    }
+    if cursor.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("cursor".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return ptr::null_mut();
+    }
+
+    let summaries = (*wallet)
+        .runtime
+        .block_on((*wallet).wallet.transaction_service.get_transaction_summaries(
+            (*cursor).filter.clone(),
+            (*cursor).position,
+            batch_size as usize,
+        ));
+    match summaries {
+        Ok(summaries) => {
+            if let Some(last) = summaries.last() {
+                (*cursor).position = Some(TransactionSummaryPosition {
+                    timestamp: last.timestamp,
+                    tx_id: last.tx_id,
+                });
+            }
+            let records = summaries.into_iter().map(TariTransactionRecord::from).collect_vec();
+            Box::into_raw(Box::new(TariTransactionRecords::from(records)))
+        },
+        Err(e) => {
+            error = LibWalletError::from(WalletError::TransactionServiceError(e)).code;
+            ptr::swap(error_out, &mut error as *mut c_int);
+            ptr::null_mut()
+        },
+    }
+}
+
+/// Frees memory for a TariTransactionsCursor
+///
+/// ## Arguments
+/// `cursor` - The pointer to a TariTransactionsCursor
+///
+/// ## Returns
+/// `()` - Does not return a value, equivalent to void in C
+///
+/// # Safety
+/// None
+#[no_mangle]
+pub unsafe extern "C" fn wallet_transactions_cursor_close(cursor: *mut TariTransactionsCursor) {
+    if !cursor.is_null() {
+        Box::from_raw(cursor);
+    }
+}
+
+/// Frees memory for a TariTransactionRecords
+///
+/// ## Arguments
+/// `records` - The pointer to a TariTransactionRecords
+///
+/// ## Returns
+/// `()` - Does not return a value, equivalent to void in C
+///
+/// # Safety
+/// None
+#[no_mangle]
+pub unsafe extern "C" fn transaction_records_destroy(records: *mut TariTransactionRecords) {
+    if !records.is_null() {
+        let x = Box::from_raw(records);
+        drop(Vec::from_raw_parts(x.ptr, x.len, x.cap));
+    }
+}
+
+/// -------------------------------------------------------------------------------------------- ///
+
 /// ----------------------------------- OutboundTransactions ------------------------------------ ///
 
 /// Gets the length of a TariPendingOutboundTransactions
@@ -5064,6 +5357,7 @@ pub unsafe extern "C" fn wallet_create(
             }
             let wallet_address = TariAddress::new(w.comms.node_identity().public_key().clone(), w.network.as_network());
             // Start Callback Handler
+            let (event_batching_tx, event_batching_rx) = watch::channel(None);
             let callback_handler = CallbackHandler::new(
                 TransactionDatabase::new(transaction_backend),
                 w.transaction_service.get_event_stream(),
@@ -5074,6 +5368,7 @@ pub unsafe extern "C" fn wallet_create(
                 wallet_address,
                 w.wallet_connectivity.get_connectivity_status_watch(),
                 w.contacts_service.get_contacts_liveness_event_stream(),
+                event_batching_rx,
                 callback_received_transaction,
                 callback_received_transaction_reply,
                 callback_received_finalized_transaction,
@@ -5105,6 +5400,8 @@ pub unsafe extern "C" fn wallet_create(
                 wallet: w,
                 runtime,
                 shutdown,
+                completions: Arc::new(CompletionQueue::new()),
+                event_batching: event_batching_tx,
             };
 
             Box::into_raw(Box::new(tari_wallet))
@@ -5150,6 +5447,47 @@ pub unsafe extern "C" fn wallet_get_balance(wallet: *mut TariWallet, error_out:
     }
 }
 
+/// Takes ownership of the `u64` states vector passed over FFI and converts it to `OutputStatus`es.
+unsafe fn utxo_states(states: *mut TariVector) -> Vec<OutputStatus> {
+    if states.is_null() {
+        vec![]
+    } else {
+        Vec::from_raw_parts((*states).ptr as *mut u64, (*states).len, (*states).cap)
+            .into_iter()
+            .map(|x| OutputStatus::try_from(x as i32).unwrap())
+            .collect_vec()
+    }
+}
+
+/// Builds the output query shared by `wallet_get_utxos` and `wallet_get_utxos_async`.
+fn utxos_query(
+    page: usize,
+    page_size: usize,
+    sorting: TariUtxoSort,
+    status: Vec<OutputStatus>,
+    dust_threshold: u64,
+) -> OutputBackendQuery {
+    let page = i64::from_usize(page).unwrap_or(i64::MAX);
+    let page_size = i64::from_usize(page_size).unwrap_or(i64::MAX);
+    let dust_threshold = i64::from_u64(dust_threshold).unwrap_or(0);
+
+    use SortDirection::{Asc, Desc};
+    OutputBackendQuery {
+        tip_height: i64::MAX,
+        status,
+        commitments: vec![],
+        pagination: Some((page, page_size)),
+        value_min: Some((dust_threshold, false)),
+        value_max: None,
+        sorting: vec![match sorting {
+            TariUtxoSort::MinedHeightAsc => ("mined_height", Asc),
+            TariUtxoSort::MinedHeightDesc => ("mined_height", Desc),
+            TariUtxoSort::ValueAsc => ("value", Asc),
+            TariUtxoSort::ValueDesc => ("value", Desc),
+        }],
+    }
+}
+
 /// This function returns a list of unspent UTXO values and commitments.
 ///
 /// ## Arguments
@@ -5189,36 +5527,7 @@ pub unsafe extern "C" fn wallet_get_utxos(
         return ptr::null_mut();
     }
 
-    let page = i64::from_usize(page).unwrap_or(i64::MAX);
-    let page_size = i64::from_usize(page_size).unwrap_or(i64::MAX);
-    let dust_threshold = i64::from_u64(dust_threshold).unwrap_or(0);
-
-    let status = {
-        if states.is_null() {
-            vec![]
-        } else {
-            Vec::from_raw_parts((*states).ptr as *mut u64, (*states).len, (*states).cap)
-                .into_iter()
-                .map(|x| OutputStatus::try_from(x as i32).unwrap())
-                .collect_vec()
-        }
-    };
-
-    use SortDirection::{Asc, Desc};
-    let q = OutputBackendQuery {
-        tip_height: i64::MAX,
-        status,
-        commitments: vec![],
-        pagination: Some((page, page_size)),
-        value_min: Some((dust_threshold, false)),
-        value_max: None,
-        sorting: vec![match sorting {
-            TariUtxoSort::MinedHeightAsc => ("mined_height", Asc),
-            TariUtxoSort::MinedHeightDesc => ("mined_height", Desc),
-            TariUtxoSort::ValueAsc => ("value", Asc),
-            TariUtxoSort::ValueDesc => ("value", Desc),
-        }],
-    };
+    let q = utxos_query(page, page_size, sorting, utxo_states(states), dust_threshold);
 
     match (*wallet).wallet.output_db.fetch_outputs_by(q) {
         Ok(outputs) => {
@@ -5310,60 +5619,204 @@ pub unsafe extern "C" fn wallet_get_all_utxos(wallet: *mut TariWallet, error_ptr
     }
 }
 
-/// This function will tell the wallet to do a coin split.
+/// This function exports the outputs that changed after `since_revision` into the caller provided columns, ordered by
+/// revision. Only the unencrypted output columns are read, so nothing is decrypted or hex encoded.
 ///
 /// ## Arguments
-/// * `wallet` - The TariWallet pointer
-/// * `commitments` - A `TariVector` of "strings", tagged as `TariTypeTag::String`, containing commitment's hex values
-///   (see `Commitment::to_hex()`)
-/// * `number_of_splits` - The number of times to split the amount
-/// * `fee_per_gram` - The transaction fee
+/// * `wallet` - The TariWallet pointer,
+/// * `since_revision` - Only outputs whose revision is greater than this are exported, 0 exports every output,
+/// * `columns` - The TariUtxoColumns to fill. On return `len` holds the number of outputs written and `revision` the
+/// highest revision written, or `since_revision` if nothing changed,
 /// * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
 /// Functions as an out parameter.
 ///
 /// ## Returns
-/// `c_ulonglong` - Returns the transaction id.
+/// `bool` - Returns true if more changed outputs are available than fit in `capacity`; call again with the returned
+/// `revision` to continue.
+///
+/// ## States
+/// The status column uses the same values as `wallet_get_all_utxos`. Outputs that are deleted from the wallet are
+/// reported with their last commitment, value and mined columns and a status of `TARI_UTXO_STATUS_DELETED`.
+///
+/// ## Retention
+/// Deleted outputs are kept until a revision at or after their deletion is passed to
+/// `wallet_acknowledge_utxo_revision`. An export from a `since_revision` below an acknowledged revision may therefore
+/// miss deletions; a client that has lost its state should export from 0 and replace its output set.
 ///
 /// # Safety
-/// `TariVector` must be freed after use with `destroy_tari_vector()`
+/// Every non-null column pointer must be valid for `capacity` entries
 #[no_mangle]
-pub unsafe extern "C" fn wallet_coin_split(
+pub unsafe extern "C" fn wallet_export_utxo_columns(
     wallet: *mut TariWallet,
-    commitments: *mut TariVector,
-    number_of_splits: usize,
-    fee_per_gram: u64,
-    error_ptr: *mut i32,
-) -> u64 {
+    since_revision: u64,
+    columns: *mut TariUtxoColumns,
+    error_out: *mut c_int,
+) -> bool {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
     if wallet.is_null() {
-        error!(target: LOG_TARGET, "wallet pointer is null");
-        ptr::replace(
-            error_ptr,
-            LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code as c_int,
-        );
-        return 0;
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return false;
+    }
+    if columns.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("columns".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return false;
     }
 
-    let commitments = match commitments.as_ref() {
-        None => {
-            error!(target: LOG_TARGET, "failed to obtain commitments as reference");
-            ptr::replace(
-                error_ptr,
-                LibWalletError::from(InterfaceError::NullError("commitments vector".to_string())).code as c_int,
-            );
-            return 0;
-        },
-        Some(cs) => match cs.to_commitment_vec() {
-            Ok(cs) => cs,
-            Err(e) => {
-                error!(target: LOG_TARGET, "failed to convert from tari vector: {:?}", e);
-                ptr::replace(error_ptr, LibWalletError::from(e).code as c_int);
-                return 0;
-            },
+    let columns = &mut *columns;
+    columns.len = 0;
+    columns.revision = since_revision;
+    // Fetch one extra summary to find out if there are more to come
+    let summaries = match (*wallet)
+        .wallet
+        .output_db
+        .fetch_output_summaries_changed_since(since_revision, columns.capacity.saturating_add(1))
+    {
+        Ok(summaries) => summaries,
+        Err(e) => {
+            error!(target: LOG_TARGET, "failed to obtain output summaries: {:#?}", e);
+            error = LibWalletError::from(WalletError::OutputManagerError(
+                OutputManagerError::OutputManagerStorageError(e),
+            ))
+            .code;
+            ptr::swap(error_out, &mut error as *mut c_int);
+            return false;
         },
     };
 
-    match (*wallet).runtime.block_on((*wallet).wallet.coin_split_even(
-        commitments,
+    let has_more = summaries.len() > columns.capacity;
+    for (i, summary) in summaries.iter().take(columns.capacity).enumerate() {
+        if !columns.commitments.is_null() {
+            let dest = slice::from_raw_parts_mut(columns.commitments.add(i * 32), 32);
+            match summary.commitment.as_deref() {
+                Some(c) if c.len() == 32 => dest.copy_from_slice(c),
+                _ => dest.fill(0),
+            }
+        }
+        if !columns.values.is_null() {
+            *columns.values.add(i) = summary.value.as_u64();
+        }
+        if !columns.mined_heights.is_null() {
+            *columns.mined_heights.add(i) = summary.mined_height.unwrap_or(0);
+        }
+        if !columns.mined_timestamps.is_null() {
+            *columns.mined_timestamps.add(i) = summary
+                .mined_timestamp
+                .map(|ts| ts.timestamp_millis() as u64)
+                .unwrap_or_default();
+        }
+        if !columns.statuses.is_null() {
+            *columns.statuses.add(i) = if summary.deleted {
+                TARI_UTXO_STATUS_DELETED
+            } else {
+                summary.status as u8
+            };
+        }
+        columns.len = i + 1;
+        columns.revision = summary.revision;
+    }
+
+    has_more
+}
+
+/// This function acknowledges that the client has stored every output change up to and including `revision`, so the
+/// wallet can discard the deleted outputs it keeps for `wallet_export_utxo_columns` at or below that revision.
+///
+/// ## Arguments
+/// * `wallet` - The TariWallet pointer,
+/// * `revision` - The highest revision the client has stored, as returned in `TariUtxoColumns.revision`,
+/// * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
+/// Functions as an out parameter.
+///
+/// ## Returns
+/// `c_ulonglong` - Returns the number of deleted outputs discarded
+///
+/// # Safety
+/// None
+#[no_mangle]
+pub unsafe extern "C" fn wallet_acknowledge_utxo_revision(
+    wallet: *mut TariWallet,
+    revision: c_ulonglong,
+    error_out: *mut c_int,
+) -> c_ulonglong {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return 0;
+    }
+
+    match (*wallet).wallet.output_db.prune_deleted_output_summaries(revision) {
+        Ok(pruned) => pruned as c_ulonglong,
+        Err(e) => {
+            error!(target: LOG_TARGET, "failed to prune deleted output summaries: {:#?}", e);
+            error = LibWalletError::from(WalletError::OutputManagerError(
+                OutputManagerError::OutputManagerStorageError(e),
+            ))
+            .code;
+            ptr::swap(error_out, &mut error as *mut c_int);
+            0
+        },
+    }
+}
+
+/// This function will tell the wallet to do a coin split.
+///
+/// ## Arguments
+/// * `wallet` - The TariWallet pointer
+/// * `commitments` - A `TariVector` of "strings", tagged as `TariTypeTag::String`, containing commitment's hex values
+///   (see `Commitment::to_hex()`)
+/// * `number_of_splits` - The number of times to split the amount
+/// * `fee_per_gram` - The transaction fee
+/// * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
+/// Functions as an out parameter.
+///
+/// ## Returns
+/// `c_ulonglong` - Returns the transaction id.
+///
+/// # Safety
+/// `TariVector` must be freed after use with `destroy_tari_vector()`
+#[no_mangle]
+pub unsafe extern "C" fn wallet_coin_split(
+    wallet: *mut TariWallet,
+    commitments: *mut TariVector,
+    number_of_splits: usize,
+    fee_per_gram: u64,
+    error_ptr: *mut i32,
+) -> u64 {
+    if wallet.is_null() {
+        error!(target: LOG_TARGET, "wallet pointer is null");
+        ptr::replace(
+            error_ptr,
+            LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code as c_int,
+        );
+        return 0;
+    }
+
+    let commitments = match commitments.as_ref() {
+        None => {
+            error!(target: LOG_TARGET, "failed to obtain commitments as reference");
+            ptr::replace(
+                error_ptr,
+                LibWalletError::from(InterfaceError::NullError("commitments vector".to_string())).code as c_int,
+            );
+            return 0;
+        },
+        Some(cs) => match cs.to_commitment_vec() {
+            Ok(cs) => cs,
+            Err(e) => {
+                error!(target: LOG_TARGET, "failed to convert from tari vector: {:?}", e);
+                ptr::replace(error_ptr, LibWalletError::from(e).code as c_int);
+                return 0;
+            },
+        },
+    };
+
+    match (*wallet).runtime.block_on((*wallet).wallet.coin_split_even(
+        commitments,
         number_of_splits,
         MicroTari(fee_per_gram),
         String::new(),
@@ -8080,109 +8533,582 @@ pub unsafe extern "C" fn fee_per_gram_stat_destroy(fee_per_gram_stat: *mut TariF
 }
 
 /// ------------------------------------------------------------------------------------------ ///
-#[cfg(test)]
-mod test {
-    use std::{
-        ffi::CString,
-        path::Path,
-        str::{from_utf8, FromStr},
-        sync::Mutex,
-    };
-
-    use borsh::BorshSerialize;
-    use libc::{c_char, c_uchar, c_uint};
-    use tari_common_types::{emoji, transaction::TransactionStatus, types::PrivateKey};
-    use tari_core::{
-        covenant,
-        transactions::test_helpers::{create_test_input, create_unblinded_output, TestParams},
-    };
-    use tari_crypto::ristretto::pedersen::extended_commitment_factory::ExtendedPedersenCommitmentFactory;
-    use tari_key_manager::{mnemonic::MnemonicLanguage, mnemonic_wordlists};
-    use tari_script::script;
-    use tari_test_utils::random;
-    use tari_wallet::{
-        storage::sqlite_utilities::run_migration_and_create_sqlite_connection,
-        transaction_service::handle::TransactionSendStatus,
-    };
-    use tempfile::tempdir;
 
-    use crate::*;
+/// ------------------------------------- Async Requests ------------------------------------- ///
 
-    fn type_of<T>(_: T) -> String {
-        std::any::type_name::<T>().to_string()
+/// Registers the callback through which the results of `_async` calls are delivered. When no callback is registered
+/// (the default) results are queued until collected with `wallet_poll_completions`.
+///
+/// ## Arguments
+/// `wallet` - The TariWallet pointer
+/// `callback` - The callback function pointer, or null to fall back to polling. The `TariCompletion` is passed by value
+/// and any `result` pointer it carries becomes owned by the client.
+/// `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+/// as an out parameter.
+///
+/// ## Returns
+/// `()` - Does not return a value, equivalent to void in C
+///
+/// # Safety
+/// The callback is invoked from a wallet runtime thread, not from the thread that made the `_async` call
+#[no_mangle]
+pub unsafe extern "C" fn wallet_set_completion_callback(
+    wallet: *mut TariWallet,
+    callback: Option<CompletionCallback>,
+    error_out: *mut c_int,
+) {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return;
     }
 
-    #[allow(dead_code)]
-    #[derive(Debug)]
-    #[allow(clippy::struct_excessive_bools)]
-    struct CallbackState {
-        pub received_tx_callback_called: bool,
-        pub received_tx_reply_callback_called: bool,
-        pub received_finalized_tx_callback_called: bool,
-        pub broadcast_tx_callback_called: bool,
-        pub mined_tx_callback_called: bool,
-        pub mined_tx_unconfirmed_callback_called: bool,
-        pub scanned_tx_callback_called: bool,
-        pub scanned_tx_unconfirmed_callback_called: bool,
-        pub transaction_send_result_callback: bool,
-        pub tx_cancellation_callback_called: bool,
-        pub callback_txo_validation_complete: bool,
-        pub callback_contacts_liveness_data_updated: bool,
-        pub callback_balance_updated: bool,
-        pub callback_transaction_validation_complete: bool,
-    }
+    (*wallet).completions.set_callback(callback);
+}
 
-    impl CallbackState {
-        fn new() -> Self {
-            Self {
-                received_tx_callback_called: false,
-                received_tx_reply_callback_called: false,
-                received_finalized_tx_callback_called: false,
-                broadcast_tx_callback_called: false,
-                mined_tx_callback_called: false,
-                mined_tx_unconfirmed_callback_called: false,
-                scanned_tx_callback_called: false,
-                scanned_tx_unconfirmed_callback_called: false,
-                transaction_send_result_callback: false,
-                tx_cancellation_callback_called: false,
-                callback_txo_validation_complete: false,
-                callback_contacts_liveness_data_updated: false,
-                callback_balance_updated: false,
-                callback_transaction_validation_complete: false,
-            }
-        }
+/// Collects the results of finished `_async` calls that were not delivered to a completion callback
+///
+/// ## Arguments
+/// `wallet` - The TariWallet pointer
+/// `max` - The maximum number of completions to return
+/// `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+/// as an out parameter.
+///
+/// ## Returns
+/// `*mut TariCompletions` - Returns a struct with an array pointer, length and capacity (needed for proper destruction
+/// after use), in the order the requests finished. Note that it returns ptr::null_mut() if wallet is null.
+///
+/// # Safety
+/// The ```completions_destroy``` method must be called when finished with a TariCompletions to prevent a memory leak.
+/// It does not free the `result` pointers, which must be destroyed individually (e.g. with ```balance_destroy```)
+#[no_mangle]
+pub unsafe extern "C" fn wallet_poll_completions(
+    wallet: *mut TariWallet,
+    max: c_uint,
+    error_out: *mut c_int,
+) -> *mut TariCompletions {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return ptr::null_mut();
     }
 
-    lazy_static! {
-        static ref CALLBACK_STATE_FFI: Mutex<CallbackState> = Mutex::new(CallbackState::new());
-    }
+    let completions = (*wallet)
+        .completions
+        .drain(max as usize)
+        .into_iter()
+        .map(TariCompletion::from)
+        .collect_vec();
+    Box::into_raw(Box::new(TariCompletions::from(completions)))
+}
 
-    unsafe extern "C" fn received_tx_callback(tx: *mut TariPendingInboundTransaction) {
-        assert!(!tx.is_null());
-        assert_eq!(
-            type_of((*tx).clone()),
-            std::any::type_name::<TariPendingInboundTransaction>()
-        );
-        let mut lock = CALLBACK_STATE_FFI.lock().unwrap();
-        lock.received_tx_callback_called = true;
-        drop(lock);
-        pending_inbound_transaction_destroy(tx);
+/// Frees memory for a TariCompletions
+///
+/// ## Arguments
+/// `completions` - The pointer to a TariCompletions
+///
+/// ## Returns
+/// `()` - Does not return a value, equivalent to void in C
+///
+/// # Safety
+/// None
+#[no_mangle]
+pub unsafe extern "C" fn completions_destroy(completions: *mut TariCompletions) {
+    if !completions.is_null() {
+        let completions = Box::from_raw(completions);
+        Vec::from_raw_parts(completions.ptr, completions.len, completions.cap);
     }
+}
 
-    unsafe extern "C" fn received_tx_reply_callback(tx: *mut TariCompletedTransaction) {
-        assert!(!tx.is_null());
-        assert_eq!(
-            type_of((*tx).clone()),
-            std::any::type_name::<TariCompletedTransaction>()
-        );
-        assert_eq!((*tx).status, TransactionStatus::Completed);
-        let mut lock = CALLBACK_STATE_FFI.lock().unwrap();
-        lock.received_tx_reply_callback_called = true;
-        drop(lock);
-        completed_transaction_destroy(tx);
+/// Retrieves the balance from a wallet without blocking the calling thread
+///
+/// ## Arguments
+/// `wallet` - The TariWallet pointer.
+/// `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+/// as an out parameter.
+///
+/// ## Returns
+/// `unsigned long long` - Returns the request id, or 0 if the request could not be submitted. The completion carries
+/// a `TariBalance` pointer in `result`.
+///
+/// # Safety
+/// The ```balance_destroy``` method must be called when finished with the completion's TariBalance to prevent a memory
+/// leak
+#[no_mangle]
+pub unsafe extern "C" fn wallet_get_balance_async(wallet: *mut TariWallet, error_out: *mut c_int) -> c_ulonglong {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return 0;
     }
 
-    unsafe extern "C" fn received_tx_finalized_callback(tx: *mut TariCompletedTransaction) {
+    let completions = (*wallet).completions.clone();
+    let request_id = completions.next_request_id();
+    let mut output_manager_service = (*wallet).wallet.output_manager_service.clone();
+    (*wallet).runtime.spawn(async move {
+        let completion = match output_manager_service.get_balance().await {
+            Ok(balance) => Completion::balance(request_id, balance),
+            Err(_) => Completion::failure(
+                request_id,
+                TariCompletionKind::GetBalance,
+                LibWalletError::from(InterfaceError::BalanceError).code,
+            ),
+        };
+        completions.complete(completion);
+    });
+
+    request_id
+}
+
+/// Sends a TariPendingOutboundTransaction without blocking the calling thread
+///
+/// ## Arguments
+/// `wallet` - The TariWallet pointer
+/// `destination` - The TariWalletAddress pointer of the peer
+/// `amount` - The amount
+/// `commitments` - A `TariVector` of "strings", tagged as `TariTypeTag::String`, containing commitment's hex values
+///   (see `Commitment::to_hex()`)
+/// `fee_per_gram` - The transaction fee
+/// `message` - The pointer to a char array, may be null
+/// `one_sided` - Whether to send a one-sided transaction to the destination's stealth address
+/// `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+/// as an out parameter.
+///
+/// ## Returns
+/// `unsigned long long` - Returns the request id, or 0 if the request could not be submitted. The completion carries
+/// the TxId of the sent transaction in `value`.
+///
+/// # Safety
+/// None
+#[no_mangle]
+pub unsafe extern "C" fn wallet_send_transaction_async(
+    wallet: *mut TariWallet,
+    destination: *mut TariWalletAddress,
+    amount: c_ulonglong,
+    commitments: *mut TariVector,
+    fee_per_gram: c_ulonglong,
+    message: *const c_char,
+    one_sided: bool,
+    error_out: *mut c_int,
+) -> c_ulonglong {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return 0;
+    }
+
+    if destination.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("dest_public_key".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return 0;
+    }
+
+    let selection_criteria = match commitments.as_ref() {
+        None => UtxoSelectionCriteria::default(),
+        Some(cs) => match cs.to_commitment_vec() {
+            Ok(cs) => UtxoSelectionCriteria::specific(cs),
+            Err(e) => {
+                error!(target: LOG_TARGET, "failed to convert from tari vector: {:?}", e);
+                ptr::replace(error_out, LibWalletError::from(e).code as c_int);
+                return 0;
+            },
+        },
+    };
+
+    let message_string = if message.is_null() {
+        String::new()
+    } else {
+        match CStr::from_ptr(message).to_str() {
+            Ok(v) => v.to_owned(),
+            _ => {
+                error = LibWalletError::from(InterfaceError::PointerError("message".to_string())).code;
+                ptr::swap(error_out, &mut error as *mut c_int);
+                return 0;
+            },
+        }
+    };
+
+    let completions = (*wallet).completions.clone();
+    let request_id = completions.next_request_id();
+    let mut transaction_service = (*wallet).wallet.transaction_service.clone();
+    let destination = (*destination).clone();
+    (*wallet).runtime.spawn(async move {
+        let result = if one_sided {
+            transaction_service
+                .send_one_sided_to_stealth_address_transaction(
+                    destination,
+                    MicroTari::from(amount),
+                    selection_criteria,
+                    OutputFeatures::default(),
+                    MicroTari::from(fee_per_gram),
+                    message_string,
+                )
+                .await
+        } else {
+            transaction_service
+                .send_transaction(
+                    destination,
+                    MicroTari::from(amount),
+                    selection_criteria,
+                    OutputFeatures::default(),
+                    MicroTari::from(fee_per_gram),
+                    message_string,
+                )
+                .await
+        };
+        let completion = match result {
+            Ok(tx_id) => Completion::success(request_id, TariCompletionKind::SendTransaction, tx_id.as_u64()),
+            Err(e) => Completion::failure(
+                request_id,
+                TariCompletionKind::SendTransaction,
+                LibWalletError::from(WalletError::TransactionServiceError(e)).code,
+            ),
+        };
+        completions.complete(completion);
+    });
+
+    request_id
+}
+
+/// Performs a coin join without blocking the calling thread
+///
+/// ## Arguments
+/// * `wallet` - The TariWallet pointer
+/// * `commitments` - A `TariVector` of "strings", tagged as `TariTypeTag::String`, containing commitment's hex values
+///   (see `Commitment::to_hex()`)
+/// * `fee_per_gram` - The transaction fee
+/// * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
+/// Functions as an out parameter.
+///
+/// ## Returns
+/// `unsigned long long` - Returns the request id, or 0 if the request could not be submitted. The completion carries
+/// the TxId of the coin join transaction in `value`.
+///
+/// # Safety
+/// `TariVector` must be freed after use with `destroy_tari_vector()`
+#[no_mangle]
+pub unsafe extern "C" fn wallet_coin_join_async(
+    wallet: *mut TariWallet,
+    commitments: *mut TariVector,
+    fee_per_gram: u64,
+    error_out: *mut c_int,
+) -> c_ulonglong {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return 0;
+    }
+
+    let commitments = match commitments.as_ref() {
+        None => {
+            error = LibWalletError::from(InterfaceError::NullError("commitments vector".to_string())).code;
+            ptr::swap(error_out, &mut error as *mut c_int);
+            return 0;
+        },
+        Some(cs) => match cs.to_commitment_vec() {
+            Ok(cs) => cs,
+            Err(e) => {
+                error!(target: LOG_TARGET, "failed to convert from tari vector: {:?}", e);
+                ptr::replace(error_out, LibWalletError::from(e).code as c_int);
+                return 0;
+            },
+        },
+    };
+
+    let completions = (*wallet).completions.clone();
+    let request_id = completions.next_request_id();
+    let mut output_manager_service = (*wallet).wallet.output_manager_service.clone();
+    let mut transaction_service = (*wallet).wallet.transaction_service.clone();
+    (*wallet).runtime.spawn(async move {
+        let result = match output_manager_service
+            .create_coin_join(commitments, MicroTari::from(fee_per_gram))
+            .await
+        {
+            Ok((tx_id, tx, output_value)) => transaction_service
+                .submit_transaction(tx_id, tx, output_value, String::new())
+                .await
+                .map(|_| tx_id)
+                .map_err(WalletError::TransactionServiceError),
+            Err(e) => Err(WalletError::OutputManagerError(e)),
+        };
+        let completion = match result {
+            Ok(tx_id) => Completion::success(request_id, TariCompletionKind::CoinJoin, tx_id.as_u64()),
+            Err(e) => {
+                error!(target: LOG_TARGET, "failed to join outputs: {:#?}", e);
+                Completion::failure(request_id, TariCompletionKind::CoinJoin, LibWalletError::from(e).code)
+            },
+        };
+        completions.complete(completion);
+    });
+
+    request_id
+}
+
+/// Lists unspent UTXOs without blocking the calling thread, see `wallet_get_utxos`
+///
+/// ## Arguments
+/// * `wallet` - The TariWallet pointer,
+/// * `page` - Page offset,
+/// * `page_size` - A number of items per page,
+/// * `sorting` - An enum representing desired sorting,
+/// * `states` - A `TariVector` of `u64` output states to include, or null for all states. Ownership is taken.
+/// * `dust_threshold` - A value filtering threshold. Outputs whose values are <= `dust_threshold` are not listed in the
+/// result.
+/// * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
+/// Functions as an out parameter.
+///
+/// ## Returns
+/// `unsigned long long` - Returns the request id, or 0 if the request could not be submitted. The completion carries
+/// a `TariVector` of `TariUtxo` in `result`.
+///
+/// # Safety
+/// `destroy_tari_vector()` must be called on the completion's `TariVector` after use.
+#[no_mangle]
+pub unsafe extern "C" fn wallet_get_utxos_async(
+    wallet: *mut TariWallet,
+    page: usize,
+    page_size: usize,
+    sorting: TariUtxoSort,
+    states: *mut TariVector,
+    dust_threshold: u64,
+    error_out: *mut c_int,
+) -> c_ulonglong {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return 0;
+    }
+
+    let q = utxos_query(page, page_size, sorting, utxo_states(states), dust_threshold);
+
+    let completions = (*wallet).completions.clone();
+    let request_id = completions.next_request_id();
+    let output_db = (*wallet).wallet.output_db.clone();
+    (*wallet).runtime.spawn_blocking(move || {
+        let completion = match output_db.fetch_outputs_by(q) {
+            Ok(outputs) => Completion::utxos(request_id, outputs),
+            Err(e) => {
+                error!(target: LOG_TARGET, "failed to obtain outputs: {:#?}", e);
+                Completion::failure(
+                    request_id,
+                    TariCompletionKind::GetUtxos,
+                    LibWalletError::from(WalletError::OutputManagerError(
+                        OutputManagerError::OutputManagerStorageError(e),
+                    ))
+                    .code,
+                )
+            },
+        };
+        completions.complete(completion);
+    });
+
+    request_id
+}
+
+/// ------------------------------------------------------------------------------------------ ///
+
+/// ------------------------------------- Event Batching ------------------------------------- ///
+
+/// Enables or disables batched delivery of wallet events. While enabled the transaction, balance, validation,
+/// connectivity and SAF callbacks registered in `wallet_create` are no longer called. Their events are coalesced and
+/// delivered through `callback_events` at most once per flush interval: only the latest event per transaction is kept,
+/// the balance is only reported when it changed and the latest connectivity status wins. Transaction send results
+/// and contacts liveness updates keep using their own callbacks.
+///
+/// ## Arguments
+/// `wallet` - The TariWallet pointer
+/// `callback_events` - The callback function pointer receiving a `TariEventBatch`, or null to disable batching and
+/// return to the individual callbacks. Events collected before the change are flushed first.
+/// `flush_interval_ms` - The interval in milliseconds at which collected events are delivered, must be greater than 0
+/// when `callback_events` is not null
+/// `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+/// as an out parameter.
+///
+/// ## Returns
+/// `()` - Does not return a value, equivalent to void in C
+///
+/// # Safety
+/// The ```event_batch_destroy``` method must be called when finished with a TariEventBatch to prevent a memory leak
+#[no_mangle]
+pub unsafe extern "C" fn wallet_set_event_batching(
+    wallet: *mut TariWallet,
+    callback_events: Option<EventBatchCallback>,
+    flush_interval_ms: c_ulonglong,
+    error_out: *mut c_int,
+) {
+    let mut error = 0;
+    ptr::swap(error_out, &mut error as *mut c_int);
+    if wallet.is_null() {
+        error = LibWalletError::from(InterfaceError::NullError("wallet".to_string())).code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+        return;
+    }
+
+    let config = match callback_events {
+        Some(callback) => {
+            if flush_interval_ms == 0 {
+                error = LibWalletError::from(InterfaceError::InvalidArgument(
+                    "flush_interval_ms must be greater than 0".to_string(),
+                ))
+                .code;
+                ptr::swap(error_out, &mut error as *mut c_int);
+                return;
+            }
+            Some(EventBatchConfig {
+                callback,
+                flush_interval: Duration::from_millis(flush_interval_ms),
+            })
+        },
+        None => None,
+    };
+
+    if (*wallet).event_batching.send(config).is_err() {
+        error = LibWalletError::from(InterfaceError::TokioError(
+            "The callback handler is no longer running".to_string(),
+        ))
+        .code;
+        ptr::swap(error_out, &mut error as *mut c_int);
+    }
+}
+
+/// Frees memory for a TariEventBatch, including the balance and event arrays it points to
+///
+/// ## Arguments
+/// `batch` - The pointer to a TariEventBatch
+///
+/// ## Returns
+/// `()` - Does not return a value, equivalent to void in C
+///
+/// # Safety
+/// None
+#[no_mangle]
+pub unsafe extern "C" fn event_batch_destroy(batch: *mut TariEventBatch) {
+    if !batch.is_null() {
+        TariEventBatch::destroy(batch);
+    }
+}
+
+/// ------------------------------------------------------------------------------------------ ///
+#[cfg(test)]
+mod test {
+    use std::{
+        ffi::CString,
+        path::Path,
+        str::{from_utf8, FromStr},
+        sync::Mutex,
+        thread,
+    };
+
+    use borsh::BorshSerialize;
+    use libc::{c_char, c_uchar, c_uint};
+    use tari_common_types::{
+        emoji,
+        transaction::{ImportStatus, TransactionStatus},
+        types::PrivateKey,
+    };
+    use tari_core::{
+        covenant,
+        transactions::test_helpers::{create_test_input, create_unblinded_output, TestParams},
+    };
+    use tari_crypto::ristretto::pedersen::extended_commitment_factory::ExtendedPedersenCommitmentFactory;
+    use tari_key_manager::{mnemonic::MnemonicLanguage, mnemonic_wordlists};
+    use tari_script::script;
+    use tari_test_utils::random;
+    use tari_wallet::{
+        storage::sqlite_utilities::run_migration_and_create_sqlite_connection,
+        transaction_service::handle::TransactionSendStatus,
+    };
+    use tempfile::tempdir;
+
+    use crate::*;
+
+    fn type_of<T>(_: T) -> String {
+        std::any::type_name::<T>().to_string()
+    }
+
+    #[allow(dead_code)]
+    #[derive(Debug)]
+    #[allow(clippy::struct_excessive_bools)]
+    struct CallbackState {
+        pub received_tx_callback_called: bool,
+        pub received_tx_reply_callback_called: bool,
+        pub received_finalized_tx_callback_called: bool,
+        pub broadcast_tx_callback_called: bool,
+        pub mined_tx_callback_called: bool,
+        pub mined_tx_unconfirmed_callback_called: bool,
+        pub scanned_tx_callback_called: bool,
+        pub scanned_tx_unconfirmed_callback_called: bool,
+        pub transaction_send_result_callback: bool,
+        pub tx_cancellation_callback_called: bool,
+        pub callback_txo_validation_complete: bool,
+        pub callback_contacts_liveness_data_updated: bool,
+        pub callback_balance_updated: bool,
+        pub callback_transaction_validation_complete: bool,
+    }
+
+    impl CallbackState {
+        fn new() -> Self {
+            Self {
+                received_tx_callback_called: false,
+                received_tx_reply_callback_called: false,
+                received_finalized_tx_callback_called: false,
+                broadcast_tx_callback_called: false,
+                mined_tx_callback_called: false,
+                mined_tx_unconfirmed_callback_called: false,
+                scanned_tx_callback_called: false,
+                scanned_tx_unconfirmed_callback_called: false,
+                transaction_send_result_callback: false,
+                tx_cancellation_callback_called: false,
+                callback_txo_validation_complete: false,
+                callback_contacts_liveness_data_updated: false,
+                callback_balance_updated: false,
+                callback_transaction_validation_complete: false,
+            }
+        }
+    }
+
+    lazy_static! {
+        static ref CALLBACK_STATE_FFI: Mutex<CallbackState> = Mutex::new(CallbackState::new());
+    }
+
+    unsafe extern "C" fn received_tx_callback(tx: *mut TariPendingInboundTransaction) {
+        assert!(!tx.is_null());
+        assert_eq!(
+            type_of((*tx).clone()),
+            std::any::type_name::<TariPendingInboundTransaction>()
+        );
+        let mut lock = CALLBACK_STATE_FFI.lock().unwrap();
+        lock.received_tx_callback_called = true;
+        drop(lock);
+        pending_inbound_transaction_destroy(tx);
+    }
+
+    unsafe extern "C" fn received_tx_reply_callback(tx: *mut TariCompletedTransaction) {
+        assert!(!tx.is_null());
+        assert_eq!(
+            type_of((*tx).clone()),
+            std::any::type_name::<TariCompletedTransaction>()
+        );
+        assert_eq!((*tx).status, TransactionStatus::Completed);
+        let mut lock = CALLBACK_STATE_FFI.lock().unwrap();
+        lock.received_tx_reply_callback_called = true;
+        drop(lock);
+        completed_transaction_destroy(tx);
+    }
+
+    unsafe extern "C" fn received_tx_finalized_callback(tx: *mut TariCompletedTransaction) {
         assert!(!tx.is_null());
         assert_eq!(
             type_of((*tx).clone()),
@@ -8583,319 +9509,694 @@ mod test {
             assert_eq!((*address), (*address_emoji));
             private_key_destroy(private_key);
             public_key_destroy(public_key);
-            tari_address_destroy(address_emoji);
-            tari_address_destroy(address);
+            tari_address_destroy(address_emoji);
+            tari_address_destroy(address);
+            byte_vector_destroy(public_bytes);
+            byte_vector_destroy(private_bytes);
+            byte_vector_destroy(address_bytes);
+        }
+    }
+
+    #[test]
+    fn test_covenant_create_empty() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+
+            let covenant_bytes = Box::into_raw(Box::new(ByteVector(vec![0u8])));
+            let covenant = covenant_create_from_bytes(covenant_bytes, error_ptr);
+
+            assert_eq!(error, 0);
+            let empty_covenant = covenant!();
+            assert_eq!(*covenant, empty_covenant);
+
+            covenant_destroy(covenant);
+            byte_vector_destroy(covenant_bytes);
+        }
+    }
+
+    #[test]
+    fn test_covenant_create_filled() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+
+            let expected_covenant = covenant!(identity());
+            let covenant_bytes = Box::into_raw(Box::new(ByteVector(expected_covenant.try_to_vec().unwrap())));
+            let covenant = covenant_create_from_bytes(covenant_bytes, error_ptr);
+
+            assert_eq!(error, 0);
+            assert_eq!(*covenant, expected_covenant);
+
+            covenant_destroy(covenant);
+            byte_vector_destroy(covenant_bytes);
+        }
+    }
+
+    #[test]
+    fn test_encrypted_value_empty() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+
+            let encrypted_value_bytes = Box::into_raw(Box::new(ByteVector(Vec::new())));
+            let encrypted_value_1 = encrypted_value_create_from_bytes(encrypted_value_bytes, error_ptr);
+
+            assert_ne!(error, 0);
+
+            encrypted_value_destroy(encrypted_value_1);
+            byte_vector_destroy(encrypted_value_bytes);
+        }
+    }
+
+    #[test]
+    fn test_encrypted_value_filled() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+
+            let commitment = Commitment::from_public_key(&PublicKey::from_secret_key(&PrivateKey::random(&mut OsRng)));
+            let encryption_key = PrivateKey::random(&mut OsRng);
+            let amount = MicroTari::from(123456);
+            let encrypted_value = TariEncryptedValue::encrypt_value(&encryption_key, &commitment, amount).unwrap();
+            let encrypted_value_bytes = encrypted_value.as_bytes();
+
+            let encrypted_value_1 = Box::into_raw(Box::new(encrypted_value.clone()));
+            let encrypted_value_1_as_bytes = encrypted_value_as_bytes(encrypted_value_1, error_ptr);
+            assert_eq!(error, 0);
+
+            let encrypted_value_2 = encrypted_value_create_from_bytes(encrypted_value_1_as_bytes, error_ptr);
+            assert_eq!(error, 0);
+            assert_eq!(*encrypted_value_1, *encrypted_value_2);
+
+            assert_eq!((*encrypted_value_1_as_bytes).0, encrypted_value_bytes.to_vec());
+
+            encrypted_value_destroy(encrypted_value_2);
+            encrypted_value_destroy(encrypted_value_1);
+            byte_vector_destroy(encrypted_value_1_as_bytes);
+        }
+    }
+
+    #[test]
+    fn test_output_features_create_empty() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+
+            let version: c_uchar = 0;
+            let output_type: c_ushort = 0;
+            let maturity: c_ulonglong = 20;
+            let metadata = Box::into_raw(Box::new(ByteVector(Vec::new())));
+
+            let output_features =
+                output_features_create_from_bytes(version, output_type, maturity, metadata, error_ptr);
+            assert_eq!(error, 0);
+            assert_eq!((*output_features).version, OutputFeaturesVersion::V0);
+            assert_eq!(
+                (*output_features).output_type,
+                OutputType::from_byte(output_type as u8).unwrap()
+            );
+            assert_eq!((*output_features).maturity, maturity);
+            assert!((*output_features).coinbase_extra.is_empty());
+
+            output_features_destroy(output_features);
+            byte_vector_destroy(metadata);
+        }
+    }
+
+    #[test]
+    fn test_output_features_create_filled() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+
+            let version: c_uchar = OutputFeaturesVersion::V1.as_u8();
+            let output_type = OutputType::Coinbase.as_byte();
+            let maturity: c_ulonglong = 20;
+
+            let expected_metadata = vec![1; 1024];
+            let metadata = Box::into_raw(Box::new(ByteVector(expected_metadata.clone())));
+
+            let output_features =
+                output_features_create_from_bytes(version, c_ushort::from(output_type), maturity, metadata, error_ptr);
+            assert_eq!(error, 0);
+            assert_eq!((*output_features).version, OutputFeaturesVersion::V1);
+            assert_eq!(
+                (*output_features).output_type,
+                OutputType::from_byte(output_type as u8).unwrap()
+            );
+            assert_eq!((*output_features).maturity, maturity);
+            assert_eq!((*output_features).coinbase_extra, expected_metadata);
+
+            output_features_destroy(output_features);
+            byte_vector_destroy(metadata);
+        }
+    }
+
+    #[test]
+    fn test_keys_dont_panic() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+            let private_key = private_key_create(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("bytes_ptr".to_string())).code
+            );
+            let public_key = public_key_from_private_key(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("secret_key_ptr".to_string())).code
+            );
+            let private_bytes = private_key_get_bytes(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("pk_ptr".to_string())).code
+            );
+            let public_bytes = public_key_get_bytes(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("pk_ptr".to_string())).code
+            );
+            let private_key_length = byte_vector_get_length(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("vec_ptr".to_string())).code
+            );
+            let public_key_length = byte_vector_get_length(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("vec_ptr".to_string())).code
+            );
+            assert_eq!(private_key_length, 0);
+            assert_eq!(public_key_length, 0);
+            private_key_destroy(private_key);
+            public_key_destroy(public_key);
             byte_vector_destroy(public_bytes);
             byte_vector_destroy(private_bytes);
-            byte_vector_destroy(address_bytes);
         }
     }
 
     #[test]
-    fn test_covenant_create_empty() {
+    fn test_contact() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
-
-            let covenant_bytes = Box::into_raw(Box::new(ByteVector(vec![0u8])));
-            let covenant = covenant_create_from_bytes(covenant_bytes, error_ptr);
-
-            assert_eq!(error, 0);
-            let empty_covenant = covenant!();
-            assert_eq!(*covenant, empty_covenant);
-
-            covenant_destroy(covenant);
-            byte_vector_destroy(covenant_bytes);
+            let test_contact_private_key = private_key_generate();
+            let test_address = tari_address_from_private_key(test_contact_private_key, 0x10, error_ptr);
+            let test_str = "Test Contact";
+            let test_contact_str = CString::new(test_str).unwrap();
+            let test_contact_alias: *const c_char = CString::into_raw(test_contact_str) as *const c_char;
+            let test_contact = contact_create(test_contact_alias, test_address, error_ptr);
+            let alias = contact_get_alias(test_contact, error_ptr);
+            let alias_string = CString::from_raw(alias).to_str().unwrap().to_owned();
+            assert_eq!(alias_string, test_str);
+            let contact_address = contact_get_tari_address(test_contact, error_ptr);
+            let contact_key_bytes = tari_address_get_bytes(contact_address, error_ptr);
+            let contact_bytes_len = byte_vector_get_length(contact_key_bytes, error_ptr);
+            assert_eq!(contact_bytes_len, 33);
+            contact_destroy(test_contact);
+            tari_address_destroy(test_address);
+            private_key_destroy(test_contact_private_key);
+            string_destroy(test_contact_alias as *mut c_char);
+            byte_vector_destroy(contact_key_bytes);
         }
     }
 
     #[test]
-    fn test_covenant_create_filled() {
+    fn test_contact_dont_panic() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
-
-            let expected_covenant = covenant!(identity());
-            let covenant_bytes = Box::into_raw(Box::new(ByteVector(expected_covenant.try_to_vec().unwrap())));
-            let covenant = covenant_create_from_bytes(covenant_bytes, error_ptr);
-
-            assert_eq!(error, 0);
-            assert_eq!(*covenant, expected_covenant);
-
-            covenant_destroy(covenant);
-            byte_vector_destroy(covenant_bytes);
+            let test_contact_private_key = private_key_generate();
+            let test_contact_address = tari_address_from_private_key(test_contact_private_key, 0x00, error_ptr);
+            let test_str = "Test Contact";
+            let test_contact_str = CString::new(test_str).unwrap();
+            let test_contact_alias: *const c_char = CString::into_raw(test_contact_str) as *const c_char;
+            let mut _test_contact = contact_create(ptr::null_mut(), test_contact_address, error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("alias_ptr".to_string())).code
+            );
+            _test_contact = contact_create(test_contact_alias, ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("public_key_ptr".to_string())).code
+            );
+            let _alias = contact_get_alias(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("contact_ptr".to_string())).code
+            );
+            let _contact_address = contact_get_tari_address(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("contact_ptr".to_string())).code
+            );
+            let contact_key_bytes = public_key_get_bytes(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("contact_ptr".to_string())).code
+            );
+            let contact_bytes_len = byte_vector_get_length(ptr::null_mut(), error_ptr);
+            assert_eq!(
+                error,
+                LibWalletError::from(InterfaceError::NullError("contact_ptr".to_string())).code
+            );
+            assert_eq!(contact_bytes_len, 0);
+            contact_destroy(_test_contact);
+            tari_address_destroy(test_contact_address);
+            private_key_destroy(test_contact_private_key);
+            string_destroy(test_contact_alias as *mut c_char);
+            byte_vector_destroy(contact_key_bytes);
         }
     }
 
     #[test]
-    fn test_encrypted_value_empty() {
+    #[allow(clippy::too_many_lines)]
+    fn test_master_private_key_persistence() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
+            let mut recovery_in_progress = true;
+            let recovery_in_progress_ptr = &mut recovery_in_progress as *mut bool;
 
-            let encrypted_value_bytes = Box::into_raw(Box::new(ByteVector(Vec::new())));
-            let encrypted_value_1 = encrypted_value_create_from_bytes(encrypted_value_bytes, error_ptr);
+            let secret_key_alice = private_key_generate();
+            let public_key_alice = public_key_from_private_key(secret_key_alice, error_ptr);
+            let db_name = random::string(8);
+            let db_name_alice = CString::new(db_name.as_str()).unwrap();
+            let db_name_alice_str: *const c_char = CString::into_raw(db_name_alice) as *const c_char;
+            let alice_temp_dir = tempdir().unwrap();
+            let db_path_alice = CString::new(alice_temp_dir.path().to_str().unwrap()).unwrap();
+            let db_path_alice_str: *const c_char = CString::into_raw(db_path_alice) as *const c_char;
+            let transport_config_alice = transport_memory_create();
+            let address_alice = transport_memory_get_address(transport_config_alice, error_ptr);
+            let address_alice_str = CStr::from_ptr(address_alice).to_str().unwrap().to_owned();
+            let address_alice_str: *const c_char = CString::new(address_alice_str).unwrap().into_raw() as *const c_char;
 
-            assert_ne!(error, 0);
+            let sql_database_path = Path::new(alice_temp_dir.path().to_str().unwrap())
+                .join(db_name)
+                .with_extension("sqlite3");
 
-            encrypted_value_destroy(encrypted_value_1);
-            byte_vector_destroy(encrypted_value_bytes);
-        }
-    }
+            let alice_network = CString::new(NETWORK_STRING).unwrap();
+            let alice_network_str: *const c_char = CString::into_raw(alice_network) as *const c_char;
 
-    #[test]
-    fn test_encrypted_value_filled() {
-        unsafe {
-            let mut error = 0;
-            let error_ptr = &mut error as *mut c_int;
+            let alice_config = comms_config_create(
+                address_alice_str,
+                transport_config_alice,
+                db_name_alice_str,
+                db_path_alice_str,
+                20,
+                10800,
+                error_ptr,
+            );
 
-            let commitment = Commitment::from_public_key(&PublicKey::from_secret_key(&PrivateKey::random(&mut OsRng)));
-            let encryption_key = PrivateKey::random(&mut OsRng);
-            let amount = MicroTari::from(123456);
-            let encrypted_value = TariEncryptedValue::encrypt_value(&encryption_key, &commitment, amount).unwrap();
-            let encrypted_value_bytes = encrypted_value.as_bytes();
+            let passphrase: *const c_char =
+                CString::into_raw(CString::new("Hello from Alasca").unwrap()) as *const c_char;
 
-            let encrypted_value_1 = Box::into_raw(Box::new(encrypted_value.clone()));
-            let encrypted_value_1_as_bytes = encrypted_value_as_bytes(encrypted_value_1, error_ptr);
-            assert_eq!(error, 0);
+            let alice_wallet = wallet_create(
+                alice_config,
+                ptr::null(),
+                0,
+                0,
+                passphrase,
+                ptr::null(),
+                alice_network_str,
+                received_tx_callback,
+                received_tx_reply_callback,
+                received_tx_finalized_callback,
+                broadcast_callback,
+                mined_callback,
+                mined_unconfirmed_callback,
+                scanned_callback,
+                scanned_unconfirmed_callback,
+                transaction_send_result_callback,
+                tx_cancellation_callback,
+                txo_validation_complete_callback,
+                contacts_liveness_data_updated_callback,
+                balance_updated_callback,
+                transaction_validation_complete_callback,
+                saf_messages_received_callback,
+                connectivity_status_callback,
+                recovery_in_progress_ptr,
+                error_ptr,
+            );
+            assert!(!(*recovery_in_progress_ptr), "no recovery in progress");
+            assert_eq!(*error_ptr, 0, "No error expected");
+            wallet_destroy(alice_wallet);
 
-            let encrypted_value_2 = encrypted_value_create_from_bytes(encrypted_value_1_as_bytes, error_ptr);
+            let connection =
+                run_migration_and_create_sqlite_connection(&sql_database_path, 16).expect("Could not open Sqlite db");
+            let wallet_backend = WalletDatabase::new(
+                WalletSqliteDatabase::new(connection, "Hello from Alasca".to_string().into()).unwrap(),
+            );
+
+            let stored_seed1 = wallet_backend.get_master_seed().unwrap().unwrap();
+
+            drop(wallet_backend);
+
+            // Check that the same key is returned when the wallet is started a second time
+            let alice_wallet2 = wallet_create(
+                alice_config,
+                ptr::null(),
+                0,
+                0,
+                passphrase,
+                ptr::null(),
+                alice_network_str,
+                received_tx_callback,
+                received_tx_reply_callback,
+                received_tx_finalized_callback,
+                broadcast_callback,
+                mined_callback,
+                mined_unconfirmed_callback,
+                scanned_callback,
+                scanned_unconfirmed_callback,
+                transaction_send_result_callback,
+                tx_cancellation_callback,
+                txo_validation_complete_callback,
+                contacts_liveness_data_updated_callback,
+                balance_updated_callback,
+                transaction_validation_complete_callback,
+                saf_messages_received_callback,
+                connectivity_status_callback,
+                recovery_in_progress_ptr,
+                error_ptr,
+            );
             assert_eq!(error, 0);
-            assert_eq!(*encrypted_value_1, *encrypted_value_2);
+            assert!(!(*recovery_in_progress_ptr), "no recovery in progress");
 
-            assert_eq!((*encrypted_value_1_as_bytes).0, encrypted_value_bytes.to_vec());
+            assert_eq!(*error_ptr, 0, "No error expected");
+            wallet_destroy(alice_wallet2);
 
-            encrypted_value_destroy(encrypted_value_2);
-            encrypted_value_destroy(encrypted_value_1);
-            byte_vector_destroy(encrypted_value_1_as_bytes);
+            let connection =
+                run_migration_and_create_sqlite_connection(&sql_database_path, 16).expect("Could not open Sqlite db");
+
+            let passphrase = SafePassword::from("Hello from Alasca");
+            let wallet_backend = WalletDatabase::new(WalletSqliteDatabase::new(connection, passphrase).unwrap());
+
+            let stored_seed2 = wallet_backend.get_master_seed().unwrap().unwrap();
+
+            assert_eq!(stored_seed1, stored_seed2);
+
+            drop(wallet_backend);
+
+            // Test the file path based version
+            let backup_path_alice =
+                CString::new(alice_temp_dir.path().join("backup.sqlite3").to_str().unwrap()).unwrap();
+            let backup_path_alice_str: *const c_char = CString::into_raw(backup_path_alice) as *const c_char;
+            let original_path_cstring = CString::new(sql_database_path.to_str().unwrap()).unwrap();
+            let original_path_str: *const c_char = CString::into_raw(original_path_cstring) as *const c_char;
+
+            let sql_database_path = alice_temp_dir.path().join("backup").with_extension("sqlite3");
+            let connection =
+                run_migration_and_create_sqlite_connection(&sql_database_path, 16).expect("Could not open Sqlite db");
+            let wallet_backend =
+                WalletDatabase::new(WalletSqliteDatabase::new(connection, "holiday".to_string().into()).unwrap());
+
+            let stored_seed = wallet_backend.get_master_seed().unwrap();
+
+            assert!(stored_seed.is_none(), "key should be cleared");
+            drop(wallet_backend);
+
+            string_destroy(alice_network_str as *mut c_char);
+            string_destroy(db_name_alice_str as *mut c_char);
+            string_destroy(db_path_alice_str as *mut c_char);
+            string_destroy(address_alice_str as *mut c_char);
+            string_destroy(backup_path_alice_str as *mut c_char);
+            string_destroy(original_path_str as *mut c_char);
+            private_key_destroy(secret_key_alice);
+            public_key_destroy(public_key_alice);
+            transport_config_destroy(transport_config_alice);
+            comms_config_destroy(alice_config);
         }
     }
 
     #[test]
-    fn test_output_features_create_empty() {
+    #[allow(clippy::too_many_lines)]
+    fn test_wallet_client_key_value_store() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
+            let mut recovery_in_progress = true;
+            let recovery_in_progress_ptr = &mut recovery_in_progress as *mut bool;
 
-            let version: c_uchar = 0;
-            let output_type: c_ushort = 0;
-            let maturity: c_ulonglong = 20;
-            let metadata = Box::into_raw(Box::new(ByteVector(Vec::new())));
+            let secret_key_alice = private_key_generate();
+            let db_name_alice = CString::new(random::string(8).as_str()).unwrap();
+            let db_name_alice_str: *const c_char = CString::into_raw(db_name_alice) as *const c_char;
+            let alice_temp_dir = tempdir().unwrap();
+            let db_path_alice = CString::new(alice_temp_dir.path().to_str().unwrap()).unwrap();
+            let db_path_alice_str: *const c_char = CString::into_raw(db_path_alice) as *const c_char;
+            let transport_config_alice = transport_memory_create();
+            let address_alice = transport_memory_get_address(transport_config_alice, error_ptr);
+            let address_alice_str = CStr::from_ptr(address_alice).to_str().unwrap().to_owned();
+            let address_alice_str: *const c_char = CString::new(address_alice_str).unwrap().into_raw() as *const c_char;
+            let network = CString::new(NETWORK_STRING).unwrap();
+            let network_str: *const c_char = CString::into_raw(network) as *const c_char;
 
-            let output_features =
-                output_features_create_from_bytes(version, output_type, maturity, metadata, error_ptr);
-            assert_eq!(error, 0);
-            assert_eq!((*output_features).version, OutputFeaturesVersion::V0);
-            assert_eq!(
-                (*output_features).output_type,
-                OutputType::from_byte(output_type as u8).unwrap()
+            let alice_config = comms_config_create(
+                address_alice_str,
+                transport_config_alice,
+                db_name_alice_str,
+                db_path_alice_str,
+                20,
+                10800,
+                error_ptr,
             );
-            assert_eq!((*output_features).maturity, maturity);
-            assert!((*output_features).coinbase_extra.is_empty());
 
-            output_features_destroy(output_features);
-            byte_vector_destroy(metadata);
-        }
-    }
+            let passphrase: *const c_char =
+                CString::into_raw(CString::new("dolphis dancing in the coastal waters").unwrap()) as *const c_char;
 
-    #[test]
-    fn test_output_features_create_filled() {
-        unsafe {
-            let mut error = 0;
-            let error_ptr = &mut error as *mut c_int;
+            let alice_wallet = wallet_create(
+                alice_config,
+                ptr::null(),
+                0,
+                0,
+                passphrase,
+                ptr::null(),
+                network_str,
+                received_tx_callback,
+                received_tx_reply_callback,
+                received_tx_finalized_callback,
+                broadcast_callback,
+                mined_callback,
+                mined_unconfirmed_callback,
+                scanned_callback,
+                scanned_unconfirmed_callback,
+                transaction_send_result_callback,
+                tx_cancellation_callback,
+                txo_validation_complete_callback,
+                contacts_liveness_data_updated_callback,
+                balance_updated_callback,
+                transaction_validation_complete_callback,
+                saf_messages_received_callback,
+                connectivity_status_callback,
+                recovery_in_progress_ptr,
+                error_ptr,
+            );
+            assert_eq!(error, 0);
 
-            let version: c_uchar = OutputFeaturesVersion::V1.as_u8();
-            let output_type = OutputType::Coinbase.as_byte();
-            let maturity: c_ulonglong = 20;
+            let client_key_values = vec![
+                ("key1".to_string(), "value1".to_string()),
+                ("key2".to_string(), "value2".to_string()),
+                ("key3".to_string(), "value3".to_string()),
+            ];
 
-            let expected_metadata = vec![1; 1024];
-            let metadata = Box::into_raw(Box::new(ByteVector(expected_metadata.clone())));
+            for kv in &client_key_values {
+                let k = CString::new(kv.0.as_str()).unwrap();
+                let k_str: *const c_char = CString::into_raw(k) as *const c_char;
+                let v = CString::new(kv.1.as_str()).unwrap();
+                let v_str: *const c_char = CString::into_raw(v.clone()) as *const c_char;
+                assert!(wallet_set_key_value(alice_wallet, k_str, v_str, error_ptr));
+                string_destroy(k_str as *mut c_char);
+                string_destroy(v_str as *mut c_char);
+            }
+
+            let passphrase =
+                "A pretty long passphrase that should test the hashing to a 32-bit key quite well".to_string();
+            let passphrase_str = CString::new(passphrase).unwrap();
+            let passphrase_const_str: *const c_char = CString::into_raw(passphrase_str) as *const c_char;
 
-            let output_features =
-                output_features_create_from_bytes(version, c_ushort::from(output_type), maturity, metadata, error_ptr);
             assert_eq!(error, 0);
-            assert_eq!((*output_features).version, OutputFeaturesVersion::V1);
-            assert_eq!(
-                (*output_features).output_type,
-                OutputType::from_byte(output_type as u8).unwrap()
-            );
-            assert_eq!((*output_features).maturity, maturity);
-            assert_eq!((*output_features).coinbase_extra, expected_metadata);
 
-            output_features_destroy(output_features);
-            byte_vector_destroy(metadata);
-        }
-    }
+            for kv in &client_key_values {
+                let k = CString::new(kv.0.as_str()).unwrap();
+                let k_str: *const c_char = CString::into_raw(k) as *const c_char;
 
-    #[test]
-    fn test_keys_dont_panic() {
-        unsafe {
-            let mut error = 0;
-            let error_ptr = &mut error as *mut c_int;
-            let private_key = private_key_create(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("bytes_ptr".to_string())).code
-            );
-            let public_key = public_key_from_private_key(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("secret_key_ptr".to_string())).code
-            );
-            let private_bytes = private_key_get_bytes(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("pk_ptr".to_string())).code
-            );
-            let public_bytes = public_key_get_bytes(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("pk_ptr".to_string())).code
-            );
-            let private_key_length = byte_vector_get_length(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("vec_ptr".to_string())).code
-            );
-            let public_key_length = byte_vector_get_length(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("vec_ptr".to_string())).code
-            );
-            assert_eq!(private_key_length, 0);
-            assert_eq!(public_key_length, 0);
-            private_key_destroy(private_key);
-            public_key_destroy(public_key);
-            byte_vector_destroy(public_bytes);
-            byte_vector_destroy(private_bytes);
-        }
-    }
+                let found_value = wallet_get_value(alice_wallet, k_str, error_ptr);
+                let found_string = CString::from_raw(found_value).to_str().unwrap().to_owned();
+                assert_eq!(found_string, kv.1.clone());
+                string_destroy(k_str as *mut c_char);
+            }
+            let wrong_key = CString::new("Wrong").unwrap();
+            let wrong_key_str: *const c_char = CString::into_raw(wrong_key) as *const c_char;
+            assert!(!wallet_clear_value(alice_wallet, wrong_key_str, error_ptr));
+            string_destroy(wrong_key_str as *mut c_char);
 
-    #[test]
-    fn test_contact() {
-        unsafe {
-            let mut error = 0;
-            let error_ptr = &mut error as *mut c_int;
-            let test_contact_private_key = private_key_generate();
-            let test_address = tari_address_from_private_key(test_contact_private_key, 0x10, error_ptr);
-            let test_str = "Test Contact";
-            let test_contact_str = CString::new(test_str).unwrap();
-            let test_contact_alias: *const c_char = CString::into_raw(test_contact_str) as *const c_char;
-            let test_contact = contact_create(test_contact_alias, test_address, error_ptr);
-            let alias = contact_get_alias(test_contact, error_ptr);
-            let alias_string = CString::from_raw(alias).to_str().unwrap().to_owned();
-            assert_eq!(alias_string, test_str);
-            let contact_address = contact_get_tari_address(test_contact, error_ptr);
-            let contact_key_bytes = tari_address_get_bytes(contact_address, error_ptr);
-            let contact_bytes_len = byte_vector_get_length(contact_key_bytes, error_ptr);
-            assert_eq!(contact_bytes_len, 33);
-            contact_destroy(test_contact);
-            tari_address_destroy(test_address);
-            private_key_destroy(test_contact_private_key);
-            string_destroy(test_contact_alias as *mut c_char);
-            byte_vector_destroy(contact_key_bytes);
-        }
-    }
+            let k = CString::new(client_key_values[0].0.as_str()).unwrap();
+            let k_str: *const c_char = CString::into_raw(k) as *const c_char;
+            assert!(wallet_clear_value(alice_wallet, k_str, error_ptr));
 
-    #[test]
-    fn test_contact_dont_panic() {
-        unsafe {
-            let mut error = 0;
-            let error_ptr = &mut error as *mut c_int;
-            let test_contact_private_key = private_key_generate();
-            let test_contact_address = tari_address_from_private_key(test_contact_private_key, 0x00, error_ptr);
-            let test_str = "Test Contact";
-            let test_contact_str = CString::new(test_str).unwrap();
-            let test_contact_alias: *const c_char = CString::into_raw(test_contact_str) as *const c_char;
-            let mut _test_contact = contact_create(ptr::null_mut(), test_contact_address, error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("alias_ptr".to_string())).code
-            );
-            _test_contact = contact_create(test_contact_alias, ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("public_key_ptr".to_string())).code
-            );
-            let _alias = contact_get_alias(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("contact_ptr".to_string())).code
-            );
-            let _contact_address = contact_get_tari_address(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("contact_ptr".to_string())).code
-            );
-            let contact_key_bytes = public_key_get_bytes(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("contact_ptr".to_string())).code
-            );
-            let contact_bytes_len = byte_vector_get_length(ptr::null_mut(), error_ptr);
-            assert_eq!(
-                error,
-                LibWalletError::from(InterfaceError::NullError("contact_ptr".to_string())).code
-            );
-            assert_eq!(contact_bytes_len, 0);
-            contact_destroy(_test_contact);
-            tari_address_destroy(test_contact_address);
-            private_key_destroy(test_contact_private_key);
-            string_destroy(test_contact_alias as *mut c_char);
-            byte_vector_destroy(contact_key_bytes);
+            let found_value = wallet_get_value(alice_wallet, k_str, error_ptr);
+            assert_eq!(found_value, ptr::null_mut());
+            assert_eq!(*error_ptr, 424i32);
+
+            string_destroy(network_str as *mut c_char);
+            string_destroy(k_str as *mut c_char);
+            string_destroy(db_name_alice_str as *mut c_char);
+            string_destroy(db_path_alice_str as *mut c_char);
+            string_destroy(address_alice_str as *mut c_char);
+            string_destroy(passphrase_const_str as *mut c_char);
+            private_key_destroy(secret_key_alice);
+            transport_config_destroy(transport_config_alice);
+
+            comms_config_destroy(alice_config);
+            wallet_destroy(alice_wallet);
+        }
+    }
+
+    #[test]
+    pub fn test_mnemonic_word_lists() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+
+            for language in MnemonicLanguage::iterator() {
+                let language_str: *const c_char =
+                    CString::into_raw(CString::new(language.to_string()).unwrap()) as *const c_char;
+                let mnemonic_wordlist_ffi = seed_words_get_mnemonic_word_list_for_language(language_str, error_ptr);
+                assert_eq!(error, 0);
+                let mnemonic_wordlist = match *(language) {
+                    TariMnemonicLanguage::ChineseSimplified => mnemonic_wordlists::MNEMONIC_CHINESE_SIMPLIFIED_WORDS,
+                    TariMnemonicLanguage::English => mnemonic_wordlists::MNEMONIC_ENGLISH_WORDS,
+                    TariMnemonicLanguage::French => mnemonic_wordlists::MNEMONIC_FRENCH_WORDS,
+                    TariMnemonicLanguage::Italian => mnemonic_wordlists::MNEMONIC_ITALIAN_WORDS,
+                    TariMnemonicLanguage::Japanese => mnemonic_wordlists::MNEMONIC_JAPANESE_WORDS,
+                    TariMnemonicLanguage::Korean => mnemonic_wordlists::MNEMONIC_KOREAN_WORDS,
+                    TariMnemonicLanguage::Spanish => mnemonic_wordlists::MNEMONIC_SPANISH_WORDS,
+                };
+                // Compare from Rust's perspective
+                assert_eq!(
+                    (*mnemonic_wordlist_ffi).0,
+                    SeedWords::new(
+                        mnemonic_wordlist
+                            .to_vec()
+                            .iter()
+                            .map(|s| Hidden::hide(s.to_string()))
+                            .collect::<Vec<Hidden<String>>>()
+                    )
+                );
+                // Compare from C's perspective
+                let count = seed_words_get_length(mnemonic_wordlist_ffi, error_ptr);
+                assert_eq!(error, 0);
+                for i in 0..count {
+                    // Compare each word in the list
+                    let mnemonic_word_ffi = CString::from_raw(seed_words_get_at(mnemonic_wordlist_ffi, i, error_ptr));
+                    assert_eq!(error, 0);
+                    assert_eq!(
+                        mnemonic_word_ffi.to_str().unwrap().to_string(),
+                        mnemonic_wordlist[i as usize].to_string()
+                    );
+                }
+                // Try to wrongfully add a new seed word onto the mnemonic wordlist seed words object
+                let w = CString::new(mnemonic_wordlist[188]).unwrap();
+                let w_str: *const c_char = CString::into_raw(w) as *const c_char;
+                seed_words_push_word(mnemonic_wordlist_ffi, w_str, error_ptr);
+                assert_eq!(
+                    seed_words_push_word(mnemonic_wordlist_ffi, w_str, error_ptr),
+                    SeedWordPushResult::InvalidObject as u8
+                );
+                assert_ne!(error, 0);
+                // Clear memory
+                seed_words_destroy(mnemonic_wordlist_ffi);
+            }
         }
     }
 
     #[test]
     #[allow(clippy::too_many_lines)]
-    fn test_master_private_key_persistence() {
+    pub fn test_seed_words() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
             let mut recovery_in_progress = true;
             let recovery_in_progress_ptr = &mut recovery_in_progress as *mut bool;
 
-            let secret_key_alice = private_key_generate();
-            let public_key_alice = public_key_from_private_key(secret_key_alice, error_ptr);
-            let db_name = random::string(8);
-            let db_name_alice = CString::new(db_name.as_str()).unwrap();
-            let db_name_alice_str: *const c_char = CString::into_raw(db_name_alice) as *const c_char;
-            let alice_temp_dir = tempdir().unwrap();
-            let db_path_alice = CString::new(alice_temp_dir.path().to_str().unwrap()).unwrap();
-            let db_path_alice_str: *const c_char = CString::into_raw(db_path_alice) as *const c_char;
-            let transport_config_alice = transport_memory_create();
-            let address_alice = transport_memory_get_address(transport_config_alice, error_ptr);
-            let address_alice_str = CStr::from_ptr(address_alice).to_str().unwrap().to_owned();
-            let address_alice_str: *const c_char = CString::new(address_alice_str).unwrap().into_raw() as *const c_char;
+            // To create a new seed word sequence, uncomment below
+            // let seed = CipherSeed::new();
+            // use tari_key_manager::mnemonic::{Mnemonic, MnemonicLanguage};
+            // let mnemonic_seq = seed
+            //     .to_mnemonic(MnemonicLanguage::English, None)
+            //     .expect("Couldn't convert CipherSeed to Mnemonic");
+            // println!("{:?}", mnemonic_seq);
 
-            let sql_database_path = Path::new(alice_temp_dir.path().to_str().unwrap())
-                .join(db_name)
-                .with_extension("sqlite3");
+            let mnemonic = vec![
+                "scan", "couch", "work", "water", "find", "electric", "weasel", "code", "column", "sick", "secret",
+                "birth", "word", "infant", "fatigue", "upper", "vacuum", "senior", "build", "post", "lend", "electric",
+                "pact", "retire",
+            ];
 
-            let alice_network = CString::new(NETWORK_STRING).unwrap();
-            let alice_network_str: *const c_char = CString::into_raw(alice_network) as *const c_char;
+            let seed_words = seed_words_create();
 
-            let alice_config = comms_config_create(
-                address_alice_str,
-                transport_config_alice,
-                db_name_alice_str,
-                db_path_alice_str,
+            let w = CString::new("hodl").unwrap();
+            let w_str: *const c_char = CString::into_raw(w) as *const c_char;
+
+            assert_eq!(
+                seed_words_push_word(seed_words, w_str, error_ptr),
+                SeedWordPushResult::InvalidSeedWord as u8
+            );
+
+            for (count, w) in mnemonic.iter().enumerate() {
+                let w = CString::new(*w).unwrap();
+                let w_str: *const c_char = CString::into_raw(w) as *const c_char;
+
+                if count + 1 < 24 {
+                    assert_eq!(
+                        seed_words_push_word(seed_words, w_str, error_ptr),
+                        SeedWordPushResult::SuccessfulPush as u8
+                    );
+                } else {
+                    assert_eq!(
+                        seed_words_push_word(seed_words, w_str, error_ptr),
+                        SeedWordPushResult::SeedPhraseComplete as u8
+                    );
+                }
+            }
+
+            // create a new wallet
+            let db_name = CString::new(random::string(8).as_str()).unwrap();
+            let db_name_str: *const c_char = CString::into_raw(db_name) as *const c_char;
+            let temp_dir = tempdir().unwrap();
+            let db_path = CString::new(temp_dir.path().to_str().unwrap()).unwrap();
+            let db_path_str: *const c_char = CString::into_raw(db_path) as *const c_char;
+            let transport_type = transport_memory_create();
+            let address = transport_memory_get_address(transport_type, error_ptr);
+            let address_str = CStr::from_ptr(address).to_str().unwrap().to_owned();
+            let address_str = CString::new(address_str).unwrap().into_raw() as *const c_char;
+            let network = CString::new(NETWORK_STRING).unwrap();
+            let network_str: *const c_char = CString::into_raw(network) as *const c_char;
+
+            let config = comms_config_create(
+                address_str,
+                transport_type,
+                db_name_str,
+                db_path_str,
                 20,
                 10800,
                 error_ptr,
             );
 
             let passphrase: *const c_char =
-                CString::into_raw(CString::new("Hello from Alasca").unwrap()) as *const c_char;
+                CString::into_raw(CString::new("a cat outside in Istanbul").unwrap()) as *const c_char;
 
-            let alice_wallet = wallet_create(
-                alice_config,
+            let wallet = wallet_create(
+                config,
                 ptr::null(),
                 0,
                 0,
                 passphrase,
                 ptr::null(),
-                alice_network_str,
+                network_str,
                 received_tx_callback,
                 received_tx_reply_callback,
                 received_tx_finalized_callback,
@@ -8915,100 +10216,83 @@ mod test {
                 recovery_in_progress_ptr,
                 error_ptr,
             );
-            assert!(!(*recovery_in_progress_ptr), "no recovery in progress");
-            assert_eq!(*error_ptr, 0, "No error expected");
-            wallet_destroy(alice_wallet);
 
-            let connection =
-                run_migration_and_create_sqlite_connection(&sql_database_path, 16).expect("Could not open Sqlite db");
-            let wallet_backend = WalletDatabase::new(
-                WalletSqliteDatabase::new(connection, "Hello from Alasca".to_string().into()).unwrap(),
-            );
+            assert_eq!(error, 0);
+            let seed_words = wallet_get_seed_words(wallet, error_ptr);
+            assert_eq!(error, 0);
+            let public_address = wallet_get_tari_address(wallet, error_ptr);
+            assert_eq!(error, 0);
 
-            let stored_seed1 = wallet_backend.get_master_seed().unwrap().unwrap();
+            // use seed words to create recovery wallet
+            let db_name = CString::new(random::string(8).as_str()).unwrap();
+            let db_name_str: *const c_char = CString::into_raw(db_name) as *const c_char;
+            let temp_dir = tempdir().unwrap();
+            let db_path = CString::new(temp_dir.path().to_str().unwrap()).unwrap();
+            let db_path_str: *const c_char = CString::into_raw(db_path) as *const c_char;
+            let transport_type = transport_memory_create();
+            let address = transport_memory_get_address(transport_type, error_ptr);
+            let address_str = CStr::from_ptr(address).to_str().unwrap().to_owned();
+            let address_str = CString::new(address_str).unwrap().into_raw() as *const c_char;
 
-            drop(wallet_backend);
+            let config = comms_config_create(
+                address_str,
+                transport_type,
+                db_name_str,
+                db_path_str,
+                20,
+                10800,
+                error_ptr,
+            );
 
-            // Check that the same key is returned when the wallet is started a second time
-            let alice_wallet2 = wallet_create(
-                alice_config,
-                ptr::null(),
+            let passphrase: *const c_char =
+                CString::into_raw(CString::new("a wave in teahupoo").unwrap()) as *const c_char;
+
+            let log_path: *const c_char =
+                CString::into_raw(CString::new(temp_dir.path().join("asdf").to_str().unwrap()).unwrap())
+                    as *const c_char;
+            let recovered_wallet = wallet_create(
+                config,
+                log_path,
                 0,
                 0,
                 passphrase,
-                ptr::null(),
-                alice_network_str,
+                seed_words,
+                network_str,
                 received_tx_callback,
                 received_tx_reply_callback,
                 received_tx_finalized_callback,
                 broadcast_callback,
                 mined_callback,
                 mined_unconfirmed_callback,
-                scanned_callback,
-                scanned_unconfirmed_callback,
-                transaction_send_result_callback,
-                tx_cancellation_callback,
-                txo_validation_complete_callback,
-                contacts_liveness_data_updated_callback,
-                balance_updated_callback,
-                transaction_validation_complete_callback,
-                saf_messages_received_callback,
-                connectivity_status_callback,
-                recovery_in_progress_ptr,
-                error_ptr,
-            );
-            assert_eq!(error, 0);
-            assert!(!(*recovery_in_progress_ptr), "no recovery in progress");
-
-            assert_eq!(*error_ptr, 0, "No error expected");
-            wallet_destroy(alice_wallet2);
-
-            let connection =
-                run_migration_and_create_sqlite_connection(&sql_database_path, 16).expect("Could not open Sqlite db");
-
-            let passphrase = SafePassword::from("Hello from Alasca");
-            let wallet_backend = WalletDatabase::new(WalletSqliteDatabase::new(connection, passphrase).unwrap());
-
-            let stored_seed2 = wallet_backend.get_master_seed().unwrap().unwrap();
-
-            assert_eq!(stored_seed1, stored_seed2);
-
-            drop(wallet_backend);
-
-            // Test the file path based version
-            let backup_path_alice =
-                CString::new(alice_temp_dir.path().join("backup.sqlite3").to_str().unwrap()).unwrap();
-            let backup_path_alice_str: *const c_char = CString::into_raw(backup_path_alice) as *const c_char;
-            let original_path_cstring = CString::new(sql_database_path.to_str().unwrap()).unwrap();
-            let original_path_str: *const c_char = CString::into_raw(original_path_cstring) as *const c_char;
-
-            let sql_database_path = alice_temp_dir.path().join("backup").with_extension("sqlite3");
-            let connection =
-                run_migration_and_create_sqlite_connection(&sql_database_path, 16).expect("Could not open Sqlite db");
-            let wallet_backend =
-                WalletDatabase::new(WalletSqliteDatabase::new(connection, "holiday".to_string().into()).unwrap());
-
-            let stored_seed = wallet_backend.get_master_seed().unwrap();
+                scanned_callback,
+                scanned_unconfirmed_callback,
+                transaction_send_result_callback,
+                tx_cancellation_callback,
+                txo_validation_complete_callback,
+                contacts_liveness_data_updated_callback,
+                balance_updated_callback,
+                transaction_validation_complete_callback,
+                saf_messages_received_callback,
+                connectivity_status_callback,
+                recovery_in_progress_ptr,
+                error_ptr,
+            );
+            assert_eq!(error, 0);
 
-            assert!(stored_seed.is_none(), "key should be cleared");
-            drop(wallet_backend);
+            let recovered_seed_words = wallet_get_seed_words(recovered_wallet, error_ptr);
+            assert_eq!(error, 0);
+            let recovered_address = wallet_get_tari_address(recovered_wallet, error_ptr);
+            assert_eq!(error, 0);
 
-            string_destroy(alice_network_str as *mut c_char);
-            string_destroy(db_name_alice_str as *mut c_char);
-            string_destroy(db_path_alice_str as *mut c_char);
-            string_destroy(address_alice_str as *mut c_char);
-            string_destroy(backup_path_alice_str as *mut c_char);
-            string_destroy(original_path_str as *mut c_char);
-            private_key_destroy(secret_key_alice);
-            public_key_destroy(public_key_alice);
-            transport_config_destroy(transport_config_alice);
-            comms_config_destroy(alice_config);
+            assert_eq!(*seed_words, *recovered_seed_words);
+            assert_eq!(*public_address, *recovered_address);
+            // TODO: Clean up memory leaks please
         }
     }
 
     #[test]
     #[allow(clippy::too_many_lines)]
-    fn test_wallet_client_key_value_store() {
+    fn test_wallet_get_utxos() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
@@ -9039,7 +10323,7 @@ mod test {
             );
 
             let passphrase: *const c_char =
-                CString::into_raw(CString::new("dolphis dancing in the coastal waters").unwrap()) as *const c_char;
+                CString::into_raw(CString::new("Satoshi Nakamoto").unwrap()) as *const c_char;
 
             let alice_wallet = wallet_create(
                 alice_config,
@@ -9068,203 +10352,126 @@ mod test {
                 recovery_in_progress_ptr,
                 error_ptr,
             );
-            assert_eq!(error, 0);
-
-            let client_key_values = vec![
-                ("key1".to_string(), "value1".to_string()),
-                ("key2".to_string(), "value2".to_string()),
-                ("key3".to_string(), "value3".to_string()),
-            ];
-
-            for kv in &client_key_values {
-                let k = CString::new(kv.0.as_str()).unwrap();
-                let k_str: *const c_char = CString::into_raw(k) as *const c_char;
-                let v = CString::new(kv.1.as_str()).unwrap();
-                let v_str: *const c_char = CString::into_raw(v.clone()) as *const c_char;
-                assert!(wallet_set_key_value(alice_wallet, k_str, v_str, error_ptr));
-                string_destroy(k_str as *mut c_char);
-                string_destroy(v_str as *mut c_char);
-            }
-
-            let passphrase =
-                "A pretty long passphrase that should test the hashing to a 32-bit key quite well".to_string();
-            let passphrase_str = CString::new(passphrase).unwrap();
-            let passphrase_const_str: *const c_char = CString::into_raw(passphrase_str) as *const c_char;
 
             assert_eq!(error, 0);
+            (0..10).for_each(|i| {
+                let (_, uout) = create_test_input((1000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default());
+                (*alice_wallet)
+                    .runtime
+                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(uout, None))
+                    .unwrap();
+            });
 
-            for kv in &client_key_values {
-                let k = CString::new(kv.0.as_str()).unwrap();
-                let k_str: *const c_char = CString::into_raw(k) as *const c_char;
-
-                let found_value = wallet_get_value(alice_wallet, k_str, error_ptr);
-                let found_string = CString::from_raw(found_value).to_str().unwrap().to_owned();
-                assert_eq!(found_string, kv.1.clone());
-                string_destroy(k_str as *mut c_char);
-            }
-            let wrong_key = CString::new("Wrong").unwrap();
-            let wrong_key_str: *const c_char = CString::into_raw(wrong_key) as *const c_char;
-            assert!(!wallet_clear_value(alice_wallet, wrong_key_str, error_ptr));
-            string_destroy(wrong_key_str as *mut c_char);
+            // ascending order
+            let outputs = wallet_get_utxos(
+                alice_wallet,
+                0,
+                20,
+                TariUtxoSort::ValueAsc,
+                ptr::null_mut(),
+                3000,
+                error_ptr,
+            );
+            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            assert_eq!(error, 0);
+            assert_eq!((*outputs).len, 6);
+            assert_eq!(utxos.len(), 6);
+            assert!(
+                utxos
+                    .iter()
+                    .skip(1)
+                    .fold((true, utxos[0].value), |acc, x| { (acc.0 && x.value > acc.1, x.value) })
+                    .0
+            );
+            destroy_tari_vector(outputs);
 
-            let k = CString::new(client_key_values[0].0.as_str()).unwrap();
-            let k_str: *const c_char = CString::into_raw(k) as *const c_char;
-            assert!(wallet_clear_value(alice_wallet, k_str, error_ptr));
+            // descending order
+            let outputs = wallet_get_utxos(
+                alice_wallet,
+                0,
+                20,
+                TariUtxoSort::ValueDesc,
+                ptr::null_mut(),
+                3000,
+                error_ptr,
+            );
+            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            assert_eq!(error, 0);
+            assert_eq!((*outputs).len, 6);
+            assert_eq!(utxos.len(), 6);
+            assert!(
+                utxos
+                    .iter()
+                    .skip(1)
+                    .fold((true, utxos[0].value), |acc, x| (acc.0 && x.value < acc.1, x.value))
+                    .0
+            );
+            destroy_tari_vector(outputs);
 
-            let found_value = wallet_get_value(alice_wallet, k_str, error_ptr);
-            assert_eq!(found_value, ptr::null_mut());
-            assert_eq!(*error_ptr, 424i32);
+            // result must be empty due to high dust threshold
+            let outputs = wallet_get_utxos(
+                alice_wallet,
+                0,
+                20,
+                TariUtxoSort::ValueAsc,
+                ptr::null_mut(),
+                15000,
+                error_ptr,
+            );
+            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            assert_eq!(error, 0);
+            assert_eq!((*outputs).len, 0);
+            assert_eq!(utxos.len(), 0);
+            destroy_tari_vector(outputs);
 
             string_destroy(network_str as *mut c_char);
-            string_destroy(k_str as *mut c_char);
             string_destroy(db_name_alice_str as *mut c_char);
             string_destroy(db_path_alice_str as *mut c_char);
             string_destroy(address_alice_str as *mut c_char);
-            string_destroy(passphrase_const_str as *mut c_char);
             private_key_destroy(secret_key_alice);
             transport_config_destroy(transport_config_alice);
-
             comms_config_destroy(alice_config);
             wallet_destroy(alice_wallet);
         }
-    }
-
-    #[test]
-    pub fn test_mnemonic_word_lists() {
-        unsafe {
-            let mut error = 0;
-            let error_ptr = &mut error as *mut c_int;
-
-            for language in MnemonicLanguage::iterator() {
-                let language_str: *const c_char =
-                    CString::into_raw(CString::new(language.to_string()).unwrap()) as *const c_char;
-                let mnemonic_wordlist_ffi = seed_words_get_mnemonic_word_list_for_language(language_str, error_ptr);
-                assert_eq!(error, 0);
-                let mnemonic_wordlist = match *(language) {
-                    TariMnemonicLanguage::ChineseSimplified => mnemonic_wordlists::MNEMONIC_CHINESE_SIMPLIFIED_WORDS,
-                    TariMnemonicLanguage::English => mnemonic_wordlists::MNEMONIC_ENGLISH_WORDS,
-                    TariMnemonicLanguage::French => mnemonic_wordlists::MNEMONIC_FRENCH_WORDS,
-                    TariMnemonicLanguage::Italian => mnemonic_wordlists::MNEMONIC_ITALIAN_WORDS,
-                    TariMnemonicLanguage::Japanese => mnemonic_wordlists::MNEMONIC_JAPANESE_WORDS,
-                    TariMnemonicLanguage::Korean => mnemonic_wordlists::MNEMONIC_KOREAN_WORDS,
-                    TariMnemonicLanguage::Spanish => mnemonic_wordlists::MNEMONIC_SPANISH_WORDS,
-                };
-                // Compare from Rust's perspective
-                assert_eq!(
-                    (*mnemonic_wordlist_ffi).0,
-                    SeedWords::new(
-                        mnemonic_wordlist
-                            .to_vec()
-                            .iter()
-                            .map(|s| Hidden::hide(s.to_string()))
-                            .collect::<Vec<Hidden<String>>>()
-                    )
-                );
-                // Compare from C's perspective
-                let count = seed_words_get_length(mnemonic_wordlist_ffi, error_ptr);
-                assert_eq!(error, 0);
-                for i in 0..count {
-                    // Compare each word in the list
-                    let mnemonic_word_ffi = CString::from_raw(seed_words_get_at(mnemonic_wordlist_ffi, i, error_ptr));
-                    assert_eq!(error, 0);
-                    assert_eq!(
-                        mnemonic_word_ffi.to_str().unwrap().to_string(),
-                        mnemonic_wordlist[i as usize].to_string()
-                    );
-                }
-                // Try to wrongfully add a new seed word onto the mnemonic wordlist seed words object
-                let w = CString::new(mnemonic_wordlist[188]).unwrap();
-                let w_str: *const c_char = CString::into_raw(w) as *const c_char;
-                seed_words_push_word(mnemonic_wordlist_ffi, w_str, error_ptr);
-                assert_eq!(
-                    seed_words_push_word(mnemonic_wordlist_ffi, w_str, error_ptr),
-                    SeedWordPushResult::InvalidObject as u8
-                );
-                assert_ne!(error, 0);
-                // Clear memory
-                seed_words_destroy(mnemonic_wordlist_ffi);
-            }
-        }
-    }
-
-    #[test]
-    #[allow(clippy::too_many_lines)]
-    pub fn test_seed_words() {
-        unsafe {
-            let mut error = 0;
-            let error_ptr = &mut error as *mut c_int;
-            let mut recovery_in_progress = true;
-            let recovery_in_progress_ptr = &mut recovery_in_progress as *mut bool;
-
-            // To create a new seed word sequence, uncomment below
-            // let seed = CipherSeed::new();
-            // use tari_key_manager::mnemonic::{Mnemonic, MnemonicLanguage};
-            // let mnemonic_seq = seed
-            //     .to_mnemonic(MnemonicLanguage::English, None)
-            //     .expect("Couldn't convert CipherSeed to Mnemonic");
-            // println!("{:?}", mnemonic_seq);
-
-            let mnemonic = vec![
-                "scan", "couch", "work", "water", "find", "electric", "weasel", "code", "column", "sick", "secret",
-                "birth", "word", "infant", "fatigue", "upper", "vacuum", "senior", "build", "post", "lend", "electric",
-                "pact", "retire",
-            ];
-
-            let seed_words = seed_words_create();
-
-            let w = CString::new("hodl").unwrap();
-            let w_str: *const c_char = CString::into_raw(w) as *const c_char;
-
-            assert_eq!(
-                seed_words_push_word(seed_words, w_str, error_ptr),
-                SeedWordPushResult::InvalidSeedWord as u8
-            );
-
-            for (count, w) in mnemonic.iter().enumerate() {
-                let w = CString::new(*w).unwrap();
-                let w_str: *const c_char = CString::into_raw(w) as *const c_char;
-
-                if count + 1 < 24 {
-                    assert_eq!(
-                        seed_words_push_word(seed_words, w_str, error_ptr),
-                        SeedWordPushResult::SuccessfulPush as u8
-                    );
-                } else {
-                    assert_eq!(
-                        seed_words_push_word(seed_words, w_str, error_ptr),
-                        SeedWordPushResult::SeedPhraseComplete as u8
-                    );
-                }
-            }
+    }
 
-            // create a new wallet
-            let db_name = CString::new(random::string(8).as_str()).unwrap();
-            let db_name_str: *const c_char = CString::into_raw(db_name) as *const c_char;
-            let temp_dir = tempdir().unwrap();
-            let db_path = CString::new(temp_dir.path().to_str().unwrap()).unwrap();
-            let db_path_str: *const c_char = CString::into_raw(db_path) as *const c_char;
-            let transport_type = transport_memory_create();
-            let address = transport_memory_get_address(transport_type, error_ptr);
-            let address_str = CStr::from_ptr(address).to_str().unwrap().to_owned();
-            let address_str = CString::new(address_str).unwrap().into_raw() as *const c_char;
+    #[test]
+    #[allow(clippy::too_many_lines)]
+    fn test_wallet_get_all_utxos() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+            let mut recovery_in_progress = true;
+            let recovery_in_progress_ptr = &mut recovery_in_progress as *mut bool;
+
+            let secret_key_alice = private_key_generate();
+            let db_name_alice = CString::new(random::string(8).as_str()).unwrap();
+            let db_name_alice_str: *const c_char = CString::into_raw(db_name_alice) as *const c_char;
+            let alice_temp_dir = tempdir().unwrap();
+            let db_path_alice = CString::new(alice_temp_dir.path().to_str().unwrap()).unwrap();
+            let db_path_alice_str: *const c_char = CString::into_raw(db_path_alice) as *const c_char;
+            let transport_config_alice = transport_memory_create();
+            let address_alice = transport_memory_get_address(transport_config_alice, error_ptr);
+            let address_alice_str = CStr::from_ptr(address_alice).to_str().unwrap().to_owned();
+            let address_alice_str: *const c_char = CString::new(address_alice_str).unwrap().into_raw() as *const c_char;
             let network = CString::new(NETWORK_STRING).unwrap();
             let network_str: *const c_char = CString::into_raw(network) as *const c_char;
 
-            let config = comms_config_create(
-                address_str,
-                transport_type,
-                db_name_str,
-                db_path_str,
+            let alice_config = comms_config_create(
+                address_alice_str,
+                transport_config_alice,
+                db_name_alice_str,
+                db_path_alice_str,
                 20,
                 10800,
                 error_ptr,
             );
 
             let passphrase: *const c_char =
-                CString::into_raw(CString::new("a cat outside in Istanbul").unwrap()) as *const c_char;
+                CString::into_raw(CString::new("J-bay open corona").unwrap()) as *const c_char;
 
-            let wallet = wallet_create(
-                config,
+            let alice_wallet = wallet_create(
+                alice_config,
                 ptr::null(),
                 0,
                 0,
@@ -9290,83 +10497,59 @@ mod test {
                 recovery_in_progress_ptr,
                 error_ptr,
             );
-
-            assert_eq!(error, 0);
-            let seed_words = wallet_get_seed_words(wallet, error_ptr);
-            assert_eq!(error, 0);
-            let public_address = wallet_get_tari_address(wallet, error_ptr);
             assert_eq!(error, 0);
 
-            // use seed words to create recovery wallet
-            let db_name = CString::new(random::string(8).as_str()).unwrap();
-            let db_name_str: *const c_char = CString::into_raw(db_name) as *const c_char;
-            let temp_dir = tempdir().unwrap();
-            let db_path = CString::new(temp_dir.path().to_str().unwrap()).unwrap();
-            let db_path_str: *const c_char = CString::into_raw(db_path) as *const c_char;
-            let transport_type = transport_memory_create();
-            let address = transport_memory_get_address(transport_type, error_ptr);
-            let address_str = CStr::from_ptr(address).to_str().unwrap().to_owned();
-            let address_str = CString::new(address_str).unwrap().into_raw() as *const c_char;
-
-            let config = comms_config_create(
-                address_str,
-                transport_type,
-                db_name_str,
-                db_path_str,
-                20,
-                10800,
-                error_ptr,
-            );
-
-            let passphrase: *const c_char =
-                CString::into_raw(CString::new("a wave in teahupoo").unwrap()) as *const c_char;
+            (0..10).for_each(|i| {
+                let (_, uout) = create_test_input((1000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default());
+                (*alice_wallet)
+                    .runtime
+                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(uout, None))
+                    .unwrap();
+            });
 
-            let log_path: *const c_char =
-                CString::into_raw(CString::new(temp_dir.path().join("asdf").to_str().unwrap()).unwrap())
-                    as *const c_char;
-            let recovered_wallet = wallet_create(
-                config,
-                log_path,
+            let outputs = wallet_get_utxos(
+                alice_wallet,
                 0,
+                100,
+                TariUtxoSort::ValueAsc,
+                ptr::null_mut(),
                 0,
-                passphrase,
-                seed_words,
-                network_str,
-                received_tx_callback,
-                received_tx_reply_callback,
-                received_tx_finalized_callback,
-                broadcast_callback,
-                mined_callback,
-                mined_unconfirmed_callback,
-                scanned_callback,
-                scanned_unconfirmed_callback,
-                transaction_send_result_callback,
-                tx_cancellation_callback,
-                txo_validation_complete_callback,
-                contacts_liveness_data_updated_callback,
-                balance_updated_callback,
-                transaction_validation_complete_callback,
-                saf_messages_received_callback,
-                connectivity_status_callback,
-                recovery_in_progress_ptr,
                 error_ptr,
             );
+            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
             assert_eq!(error, 0);
 
-            let recovered_seed_words = wallet_get_seed_words(recovered_wallet, error_ptr);
+            let payload = utxos[0..3]
+                .iter()
+                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
+                .collect::<Vec<String>>();
+
+            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
+            let result = wallet_coin_join(alice_wallet, commitments, 5, error_ptr);
             assert_eq!(error, 0);
-            let recovered_address = wallet_get_tari_address(recovered_wallet, error_ptr);
+            assert!(result > 0);
+
+            let outputs = wallet_get_all_utxos(alice_wallet, error_ptr);
+            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
             assert_eq!(error, 0);
+            assert_eq!((*outputs).len, 11);
+            assert_eq!(utxos.len(), 11);
+            destroy_tari_vector(outputs);
 
-            assert_eq!(*seed_words, *recovered_seed_words);
-            assert_eq!(*public_address, *recovered_address);
-            // TODO: Clean up memory leaks please
+            string_destroy(network_str as *mut c_char);
+            string_destroy(db_name_alice_str as *mut c_char);
+            string_destroy(db_path_alice_str as *mut c_char);
+            string_destroy(address_alice_str as *mut c_char);
+            private_key_destroy(secret_key_alice);
+            transport_config_destroy(transport_config_alice);
+            comms_config_destroy(alice_config);
+            wallet_destroy(alice_wallet);
         }
     }
 
     #[test]
-    #[allow(clippy::too_many_lines)]
-    fn test_wallet_get_utxos() {
+    #[allow(clippy::too_many_lines, clippy::needless_collect)]
+    fn test_wallet_coin_join() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
@@ -9397,7 +10580,7 @@ mod test {
             );
 
             let passphrase: *const c_char =
-                CString::into_raw(CString::new("Satoshi Nakamoto").unwrap()) as *const c_char;
+                CString::into_raw(CString::new("The master and margarita").unwrap()) as *const c_char;
 
             let alice_wallet = wallet_create(
                 alice_config,
@@ -9428,75 +10611,125 @@ mod test {
             );
 
             assert_eq!(error, 0);
-            (0..10).for_each(|i| {
-                let (_, uout) = create_test_input((1000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default());
+            (1..=5).for_each(|i| {
                 (*alice_wallet)
                     .runtime
-                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(uout, None))
+                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(
+                        create_test_input((15000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default()).1,
+                        None,
+                    ))
                     .unwrap();
             });
 
-            // ascending order
+            // ----------------------------------------------------------------------------
+            // preview
+
             let outputs = wallet_get_utxos(
                 alice_wallet,
                 0,
-                20,
+                100,
                 TariUtxoSort::ValueAsc,
                 ptr::null_mut(),
-                3000,
+                0,
                 error_ptr,
             );
             let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
             assert_eq!(error, 0);
-            assert_eq!((*outputs).len, 6);
-            assert_eq!(utxos.len(), 6);
-            assert!(
-                utxos
-                    .iter()
-                    .skip(1)
-                    .fold((true, utxos[0].value), |acc, x| { (acc.0 && x.value > acc.1, x.value) })
-                    .0
-            );
-            destroy_tari_vector(outputs);
 
-            // descending order
+            let pre_join_total_amount = utxos[0..3].iter().fold(0u64, |acc, x| acc + x.value);
+
+            let payload = utxos[0..3]
+                .iter()
+                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
+                .collect::<Vec<String>>();
+
+            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
+            let preview = wallet_preview_coin_join(alice_wallet, commitments, 5, error_ptr);
+            assert_eq!(error, 0);
+
+            // ----------------------------------------------------------------------------
+            // join
+
             let outputs = wallet_get_utxos(
                 alice_wallet,
                 0,
-                20,
-                TariUtxoSort::ValueDesc,
+                100,
+                TariUtxoSort::ValueAsc,
                 ptr::null_mut(),
-                3000,
+                0,
                 error_ptr,
             );
             let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
             assert_eq!(error, 0);
-            assert_eq!((*outputs).len, 6);
-            assert_eq!(utxos.len(), 6);
-            assert!(
-                utxos
-                    .iter()
-                    .skip(1)
-                    .fold((true, utxos[0].value), |acc, x| (acc.0 && x.value < acc.1, x.value))
-                    .0
+
+            let payload = utxos[0..3]
+                .iter()
+                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
+                .collect::<Vec<String>>();
+
+            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
+            let result = wallet_coin_join(alice_wallet, commitments, 5, error_ptr);
+            assert_eq!(error, 0);
+            assert!(result > 0);
+
+            let unspent_outputs = (*alice_wallet)
+                .wallet
+                .output_db
+                .fetch_outputs_by(OutputBackendQuery {
+                    status: vec![OutputStatus::Unspent],
+                    ..Default::default()
+                })
+                .unwrap()
+                .into_iter()
+                .map(|x| x.unblinded_output.value)
+                .collect::<Vec<MicroTari>>();
+
+            let new_pending_outputs = (*alice_wallet)
+                .wallet
+                .output_db
+                .fetch_outputs_by(OutputBackendQuery {
+                    status: vec![OutputStatus::EncumberedToBeReceived],
+                    ..Default::default()
+                })
+                .unwrap()
+                .into_iter()
+                .map(|x| x.unblinded_output.value)
+                .collect::<Vec<MicroTari>>();
+
+            let post_join_total_amount = new_pending_outputs.iter().fold(0u64, |acc, x| acc + x.as_u64());
+            let expected_output_values: Vec<u64> = Vec::from_raw_parts(
+                (*(*preview).expected_outputs).ptr as *mut u64,
+                (*(*preview).expected_outputs).len,
+                (*(*preview).expected_outputs).cap,
             );
-            destroy_tari_vector(outputs);
 
-            // result must be empty due to high dust threshold
             let outputs = wallet_get_utxos(
                 alice_wallet,
                 0,
                 20,
                 TariUtxoSort::ValueAsc,
-                ptr::null_mut(),
-                15000,
+                Box::into_raw(Box::new(TariVector::from(vec![OutputStatus::Unspent]))),
+                0,
                 error_ptr,
             );
             let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
             assert_eq!(error, 0);
-            assert_eq!((*outputs).len, 0);
-            assert_eq!(utxos.len(), 0);
+            assert_eq!(utxos.len(), 2);
+            assert_eq!(unspent_outputs.len(), 2);
+
+            // lengths
+            assert_eq!(new_pending_outputs.len(), 1);
+            assert_eq!(new_pending_outputs.len(), expected_output_values.len());
+
+            // comparing result with expected
+            assert_eq!(new_pending_outputs[0].as_u64(), expected_output_values[0]);
+
+            // checking fee
+            assert_eq!(pre_join_total_amount - post_join_total_amount, (*preview).fee);
+
             destroy_tari_vector(outputs);
+            destroy_tari_vector(commitments);
+            destroy_tari_coin_preview(preview);
 
             string_destroy(network_str as *mut c_char);
             string_destroy(db_name_alice_str as *mut c_char);
@@ -9510,8 +10743,8 @@ mod test {
     }
 
     #[test]
-    #[allow(clippy::too_many_lines)]
-    fn test_wallet_get_all_utxos() {
+    #[allow(clippy::too_many_lines, clippy::needless_collect)]
+    fn test_wallet_coin_split() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
@@ -9541,8 +10774,7 @@ mod test {
                 error_ptr,
             );
 
-            let passphrase: *const c_char =
-                CString::into_raw(CString::new("J-bay open corona").unwrap()) as *const c_char;
+            let passphrase: *const c_char = CString::into_raw(CString::new("niao").unwrap()) as *const c_char;
 
             let alice_wallet = wallet_create(
                 alice_config,
@@ -9572,15 +10804,47 @@ mod test {
                 error_ptr,
             );
             assert_eq!(error, 0);
-
-            (0..10).for_each(|i| {
-                let (_, uout) = create_test_input((1000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default());
+            (1..=5).for_each(|i| {
                 (*alice_wallet)
                     .runtime
-                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(uout, None))
+                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(
+                        create_test_input((15000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default()).1,
+                        None,
+                    ))
                     .unwrap();
             });
 
+            // ----------------------------------------------------------------------------
+            // preview
+
+            let outputs = wallet_get_utxos(
+                alice_wallet,
+                0,
+                100,
+                TariUtxoSort::ValueAsc,
+                ptr::null_mut(),
+                0,
+                error_ptr,
+            );
+            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            assert_eq!(error, 0);
+
+            let pre_split_total_amount = utxos[0..3].iter().fold(0u64, |acc, x| acc + x.value);
+
+            let payload = utxos[0..3]
+                .iter()
+                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
+                .collect::<Vec<String>>();
+
+            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
+
+            let preview = wallet_preview_coin_split(alice_wallet, commitments, 3, 5, error_ptr);
+            assert_eq!(error, 0);
+            destroy_tari_vector(commitments);
+
+            // ----------------------------------------------------------------------------
+            // split
+
             let outputs = wallet_get_utxos(
                 alice_wallet,
                 0,
@@ -9590,74 +10854,277 @@ mod test {
                 0,
                 error_ptr,
             );
-            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
-            assert_eq!(error, 0);
+            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            assert_eq!(error, 0);
+
+            let payload = utxos[0..3]
+                .iter()
+                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
+                .collect::<Vec<String>>();
+
+            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
+
+            let result = wallet_coin_split(alice_wallet, commitments, 3, 5, error_ptr);
+            assert_eq!(error, 0);
+            assert!(result > 0);
+
+            let unspent_outputs = (*alice_wallet)
+                .wallet
+                .output_db
+                .fetch_outputs_by(OutputBackendQuery {
+                    status: vec![OutputStatus::Unspent],
+                    ..Default::default()
+                })
+                .unwrap()
+                .into_iter()
+                .map(|x| x.unblinded_output.value)
+                .collect::<Vec<_>>();
+
+            let new_pending_outputs = (*alice_wallet)
+                .wallet
+                .output_db
+                .fetch_outputs_by(OutputBackendQuery {
+                    status: vec![OutputStatus::EncumberedToBeReceived],
+                    ..Default::default()
+                })
+                .unwrap()
+                .into_iter()
+                .map(|x| x.unblinded_output.value)
+                .collect::<Vec<_>>();
+
+            let post_split_total_amount = new_pending_outputs.iter().fold(0u64, |acc, x| acc + x.as_u64());
+            let expected_output_values: Vec<u64> = Vec::from_raw_parts(
+                (*(*preview).expected_outputs).ptr as *mut u64,
+                (*(*preview).expected_outputs).len,
+                (*(*preview).expected_outputs).cap,
+            );
+
+            let outputs = wallet_get_utxos(
+                alice_wallet,
+                0,
+                20,
+                TariUtxoSort::ValueAsc,
+                Box::into_raw(Box::new(TariVector::from(vec![OutputStatus::Unspent]))),
+                0,
+                error_ptr,
+            );
+            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            assert_eq!(error, 0);
+            assert_eq!(utxos.len(), 2);
+            assert_eq!(unspent_outputs.len(), 2);
+
+            // lengths
+            assert_eq!(new_pending_outputs.len(), 3);
+            assert_eq!(new_pending_outputs.len(), expected_output_values.len());
+
+            // comparing resulting output values relative to itself
+            assert_eq!(new_pending_outputs[0], new_pending_outputs[1]);
+            assert_eq!(new_pending_outputs[2], new_pending_outputs[1] + MicroTari(1));
+
+            // comparing resulting output values to the expected
+            assert_eq!(new_pending_outputs[0].as_u64(), expected_output_values[0]);
+            assert_eq!(new_pending_outputs[1].as_u64(), expected_output_values[1]);
+            assert_eq!(new_pending_outputs[2].as_u64(), expected_output_values[2]);
+
+            // checking fee
+            assert_eq!(pre_split_total_amount - post_split_total_amount, (*preview).fee);
+
+            destroy_tari_vector(outputs);
+            destroy_tari_vector(commitments);
+            destroy_tari_coin_preview(preview);
+
+            string_destroy(network_str as *mut c_char);
+            string_destroy(db_name_alice_str as *mut c_char);
+            string_destroy(db_path_alice_str as *mut c_char);
+            string_destroy(address_alice_str as *mut c_char);
+            private_key_destroy(secret_key_alice);
+            transport_config_destroy(transport_config_alice);
+            comms_config_destroy(alice_config);
+            wallet_destroy(alice_wallet);
+        }
+    }
+
+    #[test]
+    fn test_tari_vector() {
+        let mut error = 0;
+
+        unsafe {
+            let tv = create_tari_vector(TariTypeTag::Text);
+            assert_eq!((*tv).tag, TariTypeTag::Text);
+            assert_eq!((*tv).len, 0);
+            assert_eq!((*tv).cap, 2);
+
+            tari_vector_push_string(
+                tv,
+                CString::new("test string 1").unwrap().into_raw() as *const c_char,
+                &mut error as *mut c_int,
+            );
+            assert_eq!(error, 0);
+            assert_eq!((*tv).tag, TariTypeTag::Text);
+            assert_eq!((*tv).len, 1);
+            assert_eq!((*tv).cap, 1);
+
+            tari_vector_push_string(
+                tv,
+                CString::new("test string 2").unwrap().into_raw() as *const c_char,
+                &mut error as *mut c_int,
+            );
+            assert_eq!(error, 0);
+            assert_eq!((*tv).tag, TariTypeTag::Text);
+            assert_eq!((*tv).len, 2);
+            assert_eq!((*tv).cap, 2);
+
+            tari_vector_push_string(
+                tv,
+                CString::new("test string 3").unwrap().into_raw() as *const c_char,
+                &mut error as *mut c_int,
+            );
+            assert_eq!(error, 0);
+            assert_eq!((*tv).tag, TariTypeTag::Text);
+            assert_eq!((*tv).len, 3);
+            assert_eq!((*tv).cap, 3);
+
+            destroy_tari_vector(tv);
+        }
+    }
+
+    #[test]
+    fn test_com_pub_sig_create() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+
+            let (a_value, ephemeral_pubkey) = PublicKey::random_keypair(&mut OsRng);
+            let (x_value, ephemeral_com) = PublicKey::random_keypair(&mut OsRng);
+            let (y_value, _) = PublicKey::random_keypair(&mut OsRng);
+            let ephemeral_com = Commitment::from_public_key(&ephemeral_com);
+
+            let a_bytes = Box::into_raw(Box::new(ByteVector(a_value.to_vec())));
+            let x_bytes = Box::into_raw(Box::new(ByteVector(x_value.to_vec())));
+            let y_bytes = Box::into_raw(Box::new(ByteVector(y_value.to_vec())));
+            let ephemeral_pubkey_bytes = Box::into_raw(Box::new(ByteVector(ephemeral_pubkey.to_vec())));
+            let ephemeral_com_bytes = Box::into_raw(Box::new(ByteVector(ephemeral_com.to_vec())));
+
+            let sig = commitment_and_public_signature_create_from_bytes(
+                ephemeral_com_bytes,
+                ephemeral_pubkey_bytes,
+                a_bytes,
+                x_bytes,
+                y_bytes,
+                error_ptr,
+            );
+
+            assert_eq!(error, 0);
+            assert_eq!(*(*sig).ephemeral_commitment(), ephemeral_com);
+            assert_eq!(*(*sig).ephemeral_pubkey(), ephemeral_pubkey);
+            assert_eq!(*(*sig).u_a(), a_value);
+            assert_eq!(*(*sig).u_x(), x_value);
+            assert_eq!(*(*sig).u_y(), y_value);
+
+            commitment_and_public_signature_destroy(sig);
+            byte_vector_destroy(ephemeral_com_bytes);
+            byte_vector_destroy(ephemeral_pubkey_bytes);
+            byte_vector_destroy(a_bytes);
+            byte_vector_destroy(x_bytes);
+            byte_vector_destroy(y_bytes);
+        }
+    }
+
+    #[test]
+    pub fn test_create_external_utxo() {
+        unsafe {
+            let mut error = 0;
+            let error_ptr = &mut error as *mut c_int;
+            // Test the consistent features case
+            let utxo_1 = create_unblinded_output(
+                script!(Nop),
+                OutputFeatures::default(),
+                &TestParams::new(),
+                MicroTari(1234u64),
+            );
+            let amount = utxo_1.value.as_u64();
+            let spending_key_ptr = Box::into_raw(Box::new(utxo_1.spending_key.clone()));
+            let features_ptr = Box::into_raw(Box::new(utxo_1.features.clone()));
+            let metadata_signature_ptr = Box::into_raw(Box::new(utxo_1.metadata_signature.clone()));
+            let sender_offset_public_key_ptr = Box::into_raw(Box::new(utxo_1.sender_offset_public_key.clone()));
+            let script_private_key_ptr = Box::into_raw(Box::new(utxo_1.script_private_key.clone()));
+            let covenant_ptr = Box::into_raw(Box::new(utxo_1.covenant.clone()));
+            let encrypted_value_ptr = Box::into_raw(Box::new(utxo_1.encrypted_value.clone()));
+            let minimum_value_promise = utxo_1.minimum_value_promise.as_u64();
+            let script_ptr = CString::into_raw(CString::new(script!(Nop).to_hex()).unwrap()) as *const c_char;
+            let input_data_ptr = CString::into_raw(CString::new(utxo_1.input_data.to_hex()).unwrap()) as *const c_char;
+
+            let tari_utxo = create_tari_unblinded_output(
+                amount,
+                spending_key_ptr,
+                features_ptr,
+                script_ptr,
+                input_data_ptr,
+                metadata_signature_ptr,
+                sender_offset_public_key_ptr,
+                script_private_key_ptr,
+                covenant_ptr,
+                encrypted_value_ptr,
+                minimum_value_promise,
+                0,
+                error_ptr,
+            );
 
-            let payload = utxos[0..3]
-                .iter()
-                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
-                .collect::<Vec<String>>();
-
-            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
-            let result = wallet_coin_join(alice_wallet, commitments, 5, error_ptr);
-            assert_eq!(error, 0);
-            assert!(result > 0);
-
-            let outputs = wallet_get_all_utxos(alice_wallet, error_ptr);
-            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
             assert_eq!(error, 0);
-            assert_eq!((*outputs).len, 11);
-            assert_eq!(utxos.len(), 11);
-            destroy_tari_vector(outputs);
+            assert_eq!(*tari_utxo, utxo_1);
+            tari_unblinded_output_destroy(tari_utxo);
 
-            string_destroy(network_str as *mut c_char);
-            string_destroy(db_name_alice_str as *mut c_char);
-            string_destroy(db_path_alice_str as *mut c_char);
-            string_destroy(address_alice_str as *mut c_char);
-            private_key_destroy(secret_key_alice);
-            transport_config_destroy(transport_config_alice);
-            comms_config_destroy(alice_config);
-            wallet_destroy(alice_wallet);
+            // Cleanup
+            string_destroy(script_ptr as *mut c_char);
+            string_destroy(input_data_ptr as *mut c_char);
+            let _covenant = Box::from_raw(covenant_ptr);
+            let _script_private_key = Box::from_raw(script_private_key_ptr);
+            let _sender_offset_public_key = Box::from_raw(sender_offset_public_key_ptr);
+            let _metadata_signature = Box::from_raw(metadata_signature_ptr);
+            let _features = Box::from_raw(features_ptr);
+            let _spending_key = Box::from_raw(spending_key_ptr);
         }
     }
 
+    fn get_next_memory_address() -> Multiaddr {
+        let port = MemoryTransport::acquire_next_memsocket_port();
+        format!("/memory/{}", port).parse().unwrap()
+    }
+
     #[test]
-    #[allow(clippy::too_many_lines, clippy::needless_collect)]
-    fn test_wallet_coin_join() {
+    #[allow(clippy::too_many_lines)]
+    pub fn test_import_external_utxo() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
             let mut recovery_in_progress = true;
             let recovery_in_progress_ptr = &mut recovery_in_progress as *mut bool;
 
-            let secret_key_alice = private_key_generate();
-            let db_name_alice = CString::new(random::string(8).as_str()).unwrap();
-            let db_name_alice_str: *const c_char = CString::into_raw(db_name_alice) as *const c_char;
-            let alice_temp_dir = tempdir().unwrap();
-            let db_path_alice = CString::new(alice_temp_dir.path().to_str().unwrap()).unwrap();
-            let db_path_alice_str: *const c_char = CString::into_raw(db_path_alice) as *const c_char;
-            let transport_config_alice = transport_memory_create();
-            let address_alice = transport_memory_get_address(transport_config_alice, error_ptr);
-            let address_alice_str = CStr::from_ptr(address_alice).to_str().unwrap().to_owned();
-            let address_alice_str: *const c_char = CString::new(address_alice_str).unwrap().into_raw() as *const c_char;
+            // create a new wallet
+            let db_name = CString::new(random::string(8).as_str()).unwrap();
+            let db_name_str: *const c_char = CString::into_raw(db_name) as *const c_char;
+            let temp_dir = tempdir().unwrap();
+            let db_path = CString::new(temp_dir.path().to_str().unwrap()).unwrap();
+            let db_path_str: *const c_char = CString::into_raw(db_path) as *const c_char;
+            let transport_type = transport_memory_create();
+            let address = transport_memory_get_address(transport_type, error_ptr);
+            let address_str = CStr::from_ptr(address).to_str().unwrap().to_owned();
+            let address_str = CString::new(address_str).unwrap().into_raw() as *const c_char;
             let network = CString::new(NETWORK_STRING).unwrap();
             let network_str: *const c_char = CString::into_raw(network) as *const c_char;
 
-            let alice_config = comms_config_create(
-                address_alice_str,
-                transport_config_alice,
-                db_name_alice_str,
-                db_path_alice_str,
+            let config = comms_config_create(
+                address_str,
+                transport_type,
+                db_name_str,
+                db_path_str,
                 20,
                 10800,
                 error_ptr,
             );
-
-            let passphrase: *const c_char =
-                CString::into_raw(CString::new("The master and margarita").unwrap()) as *const c_char;
-
-            let alice_wallet = wallet_create(
-                alice_config,
+            let passphrase: *const c_char = CString::into_raw(CString::new("niao").unwrap()) as *const c_char;
+            let wallet_ptr = wallet_create(
+                config,
                 ptr::null(),
                 0,
                 0,
@@ -9683,142 +11150,101 @@ mod test {
                 recovery_in_progress_ptr,
                 error_ptr,
             );
-
             assert_eq!(error, 0);
-            (1..=5).for_each(|i| {
-                (*alice_wallet)
-                    .runtime
-                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(
-                        create_test_input((15000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default()).1,
-                        None,
-                    ))
-                    .unwrap();
-            });
-
-            // ----------------------------------------------------------------------------
-            // preview
-
-            let outputs = wallet_get_utxos(
-                alice_wallet,
-                0,
-                100,
-                TariUtxoSort::ValueAsc,
-                ptr::null_mut(),
-                0,
+            let node_identity =
+                NodeIdentity::random(&mut OsRng, get_next_memory_address(), PeerFeatures::COMMUNICATION_NODE);
+            let base_node_peer_public_key_ptr = Box::into_raw(Box::new(node_identity.public_key().clone()));
+            let base_node_peer_address_ptr =
+                CString::into_raw(CString::new(node_identity.public_address().to_string()).unwrap()) as *const c_char;
+            wallet_add_base_node_peer(
+                wallet_ptr,
+                base_node_peer_public_key_ptr,
+                base_node_peer_address_ptr,
                 error_ptr,
             );
-            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
-            assert_eq!(error, 0);
-
-            let pre_join_total_amount = utxos[0..3].iter().fold(0u64, |acc, x| acc + x.value);
-
-            let payload = utxos[0..3]
-                .iter()
-                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
-                .collect::<Vec<String>>();
-
-            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
-            let preview = wallet_preview_coin_join(alice_wallet, commitments, 5, error_ptr);
-            assert_eq!(error, 0);
 
-            // ----------------------------------------------------------------------------
-            // join
+            // Test the consistent features case
+            let utxo_1 = create_unblinded_output(
+                script!(Nop),
+                OutputFeatures::default(),
+                &TestParams::new(),
+                MicroTari(1234u64),
+            );
+            let amount = utxo_1.value.as_u64();
+            let spending_key_ptr = Box::into_raw(Box::new(utxo_1.spending_key.clone()));
+            let features_ptr = Box::into_raw(Box::new(utxo_1.features.clone()));
+            let source_address_ptr = Box::into_raw(Box::new(TariWalletAddress::default()));
+            let metadata_signature_ptr = Box::into_raw(Box::new(utxo_1.metadata_signature.clone()));
+            let sender_offset_public_key_ptr = Box::into_raw(Box::new(utxo_1.sender_offset_public_key.clone()));
+            let script_private_key_ptr = Box::into_raw(Box::new(utxo_1.script_private_key.clone()));
+            let covenant_ptr = Box::into_raw(Box::new(utxo_1.covenant.clone()));
+            let encrypted_value_ptr = Box::into_raw(Box::new(utxo_1.encrypted_value.clone()));
+            let minimum_value_promise = utxo_1.minimum_value_promise.as_u64();
+            let message_ptr = CString::into_raw(CString::new("For my friend").unwrap()) as *const c_char;
+            let script_ptr = CString::into_raw(CString::new(script!(Nop).to_hex()).unwrap()) as *const c_char;
+            let input_data_ptr = CString::into_raw(CString::new(utxo_1.input_data.to_hex()).unwrap()) as *const c_char;
 
-            let outputs = wallet_get_utxos(
-                alice_wallet,
-                0,
-                100,
-                TariUtxoSort::ValueAsc,
-                ptr::null_mut(),
+            let tari_utxo = create_tari_unblinded_output(
+                amount,
+                spending_key_ptr,
+                features_ptr,
+                script_ptr,
+                input_data_ptr,
+                metadata_signature_ptr,
+                sender_offset_public_key_ptr,
+                script_private_key_ptr,
+                covenant_ptr,
+                encrypted_value_ptr,
+                minimum_value_promise,
                 0,
                 error_ptr,
             );
-            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
-            assert_eq!(error, 0);
-
-            let payload = utxos[0..3]
-                .iter()
-                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
-                .collect::<Vec<String>>();
-
-            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
-            let result = wallet_coin_join(alice_wallet, commitments, 5, error_ptr);
-            assert_eq!(error, 0);
-            assert!(result > 0);
-
-            let unspent_outputs = (*alice_wallet)
-                .wallet
-                .output_db
-                .fetch_outputs_by(OutputBackendQuery {
-                    status: vec![OutputStatus::Unspent],
-                    ..Default::default()
-                })
-                .unwrap()
-                .into_iter()
-                .map(|x| x.unblinded_output.value)
-                .collect::<Vec<MicroTari>>();
-
-            let new_pending_outputs = (*alice_wallet)
-                .wallet
-                .output_db
-                .fetch_outputs_by(OutputBackendQuery {
-                    status: vec![OutputStatus::EncumberedToBeReceived],
-                    ..Default::default()
-                })
-                .unwrap()
-                .into_iter()
-                .map(|x| x.unblinded_output.value)
-                .collect::<Vec<MicroTari>>();
-
-            let post_join_total_amount = new_pending_outputs.iter().fold(0u64, |acc, x| acc + x.as_u64());
-            let expected_output_values: Vec<u64> = Vec::from_raw_parts(
-                (*(*preview).expected_outputs).ptr as *mut u64,
-                (*(*preview).expected_outputs).len,
-                (*(*preview).expected_outputs).cap,
-            );
-
-            let outputs = wallet_get_utxos(
-                alice_wallet,
-                0,
-                20,
-                TariUtxoSort::ValueAsc,
-                Box::into_raw(Box::new(TariVector::from(vec![OutputStatus::Unspent]))),
-                0,
+            let tx_id = wallet_import_external_utxo_as_non_rewindable(
+                wallet_ptr,
+                tari_utxo,
+                source_address_ptr,
+                message_ptr,
                 error_ptr,
             );
-            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
-            assert_eq!(error, 0);
-            assert_eq!(utxos.len(), 2);
-            assert_eq!(unspent_outputs.len(), 2);
 
-            // lengths
-            assert_eq!(new_pending_outputs.len(), 1);
-            assert_eq!(new_pending_outputs.len(), expected_output_values.len());
+            assert_eq!(error, 0);
+            assert!(tx_id > 0);
 
-            // comparing result with expected
-            assert_eq!(new_pending_outputs[0].as_u64(), expected_output_values[0]);
+            let outputs = wallet_get_unspent_outputs(wallet_ptr, error_ptr);
+            assert_eq!((*outputs).0.len(), 0);
+            assert_eq!(unblinded_outputs_get_length(outputs, error_ptr), 0);
 
-            // checking fee
-            assert_eq!(pre_join_total_amount - post_join_total_amount, (*preview).fee);
+            // Cleanup
+            tari_unblinded_output_destroy(tari_utxo);
+            unblinded_outputs_destroy(outputs);
+            string_destroy(message_ptr as *mut c_char);
+            string_destroy(script_ptr as *mut c_char);
+            string_destroy(input_data_ptr as *mut c_char);
+            let _covenant = Box::from_raw(covenant_ptr);
+            let _script_private_key = Box::from_raw(script_private_key_ptr);
+            let _sender_offset_public_key = Box::from_raw(sender_offset_public_key_ptr);
+            let _metadata_signature = Box::from_raw(metadata_signature_ptr);
+            let _features = Box::from_raw(features_ptr);
+            let _source_address = Box::from_raw(source_address_ptr);
+            let _spending_key = Box::from_raw(spending_key_ptr);
 
-            destroy_tari_vector(outputs);
-            destroy_tari_vector(commitments);
-            destroy_tari_coin_preview(preview);
+            let _base_node_peer_public_key = Box::from_raw(base_node_peer_public_key_ptr);
+            string_destroy(base_node_peer_address_ptr as *mut c_char);
 
             string_destroy(network_str as *mut c_char);
-            string_destroy(db_name_alice_str as *mut c_char);
-            string_destroy(db_path_alice_str as *mut c_char);
-            string_destroy(address_alice_str as *mut c_char);
-            private_key_destroy(secret_key_alice);
-            transport_config_destroy(transport_config_alice);
-            comms_config_destroy(alice_config);
-            wallet_destroy(alice_wallet);
+            string_destroy(db_name_str as *mut c_char);
+            string_destroy(db_path_str as *mut c_char);
+            string_destroy(address_str as *mut c_char);
+            transport_config_destroy(transport_type);
+
+            comms_config_destroy(config);
+            wallet_destroy(wallet_ptr);
         }
     }
 
     #[test]
-    #[allow(clippy::too_many_lines, clippy::needless_collect)]
-    fn test_wallet_coin_split() {
+    #[allow(clippy::too_many_lines)]
+    fn test_wallet_transactions_cursor() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
@@ -9848,7 +11274,8 @@ mod test {
                 error_ptr,
             );
 
-            let passphrase: *const c_char = CString::into_raw(CString::new("niao").unwrap()) as *const c_char;
+            let passphrase: *const c_char =
+                CString::into_raw(CString::new("Satoshi Nakamoto").unwrap()) as *const c_char;
 
             let alice_wallet = wallet_create(
                 alice_config,
@@ -9878,134 +11305,81 @@ mod test {
                 error_ptr,
             );
             assert_eq!(error, 0);
-            (1..=5).for_each(|i| {
+
+            let source_address = TariAddress::new(
+                PublicKey::from_secret_key(&PrivateKey::random(&mut OsRng)),
+                Network::LocalNet,
+            );
+            (0..5).for_each(|i| {
                 (*alice_wallet)
                     .runtime
-                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(
-                        create_test_input((15000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default()).1,
+                    .block_on((*alice_wallet).wallet.transaction_service.import_utxo_with_status(
+                        MicroTari::from(1000 * (i + 1)),
+                        source_address.clone(),
+                        "imported".to_string(),
+                        None,
+                        ImportStatus::Imported,
+                        None,
+                        None,
                         None,
                     ))
                     .unwrap();
             });
 
-            // ----------------------------------------------------------------------------
-            // preview
-
-            let outputs = wallet_get_utxos(
-                alice_wallet,
-                0,
-                100,
-                TariUtxoSort::ValueAsc,
-                ptr::null_mut(),
-                0,
-                error_ptr,
-            );
-            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            // page through all transactions in batches of two
+            let cursor = wallet_transactions_cursor_open(alice_wallet, 0, 0, -1, 0, 0, false, error_ptr);
             assert_eq!(error, 0);
-
-            let pre_split_total_amount = utxos[0..3].iter().fold(0u64, |acc, x| acc + x.value);
-
-            let payload = utxos[0..3]
-                .iter()
-                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
-                .collect::<Vec<String>>();
-
-            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
-
-            let preview = wallet_preview_coin_split(alice_wallet, commitments, 3, 5, error_ptr);
+            let mut tx_ids = Vec::new();
+            let mut timestamps = Vec::new();
+            for expected_len in [2, 2, 1, 0] {
+                let records = wallet_transactions_cursor_next_batch(alice_wallet, cursor, 2, error_ptr);
+                assert_eq!(error, 0);
+                assert_eq!((*records).len, expected_len);
+                let batch: &[TariTransactionRecord] = slice::from_raw_parts((*records).ptr, (*records).len);
+                for record in batch {
+                    assert_eq!(record.status, TransactionStatus::Imported as i32);
+                    assert_eq!(record.direction, TransactionDirection::Inbound as i32);
+                    assert_eq!(record.cancellation_reason, -1);
+                    assert_eq!(record.source_address, source_address.to_bytes());
+                    tx_ids.push(record.tx_id);
+                    timestamps.push(record.timestamp);
+                }
+                transaction_records_destroy(records);
+            }
+            assert_eq!(tx_ids.iter().unique().count(), 5);
+            // newest first
+            assert!(timestamps.windows(2).all(|w| w[0] >= w[1]));
+            wallet_transactions_cursor_close(cursor);
+
+            // filtered on status and direction
+            let status_mask = 1 << (TransactionStatus::Imported as u32);
+            let cursor = wallet_transactions_cursor_open(alice_wallet, 0, status_mask, 1, 0, 0, false, error_ptr);
             assert_eq!(error, 0);
-            destroy_tari_vector(commitments);
-
-            // ----------------------------------------------------------------------------
-            // split
-
-            let outputs = wallet_get_utxos(
-                alice_wallet,
-                0,
-                100,
-                TariUtxoSort::ValueAsc,
-                ptr::null_mut(),
-                0,
-                error_ptr,
-            );
-            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            let records = wallet_transactions_cursor_next_batch(alice_wallet, cursor, 10, error_ptr);
             assert_eq!(error, 0);
+            assert_eq!((*records).len, 0);
+            transaction_records_destroy(records);
+            wallet_transactions_cursor_close(cursor);
 
-            let payload = utxos[0..3]
-                .iter()
-                .map(|x| CStr::from_ptr(x.commitment).to_str().unwrap().to_owned())
-                .collect::<Vec<String>>();
-
-            let commitments = Box::into_raw(Box::new(TariVector::from(payload))) as *mut TariVector;
-
-            let result = wallet_coin_split(alice_wallet, commitments, 3, 5, error_ptr);
+            // the imported transactions are not pending
+            let cursor = wallet_transactions_cursor_open(alice_wallet, 1, 0, -1, 0, 0, false, error_ptr);
             assert_eq!(error, 0);
-            assert!(result > 0);
-
-            let unspent_outputs = (*alice_wallet)
-                .wallet
-                .output_db
-                .fetch_outputs_by(OutputBackendQuery {
-                    status: vec![OutputStatus::Unspent],
-                    ..Default::default()
-                })
-                .unwrap()
-                .into_iter()
-                .map(|x| x.unblinded_output.value)
-                .collect::<Vec<_>>();
-
-            let new_pending_outputs = (*alice_wallet)
-                .wallet
-                .output_db
-                .fetch_outputs_by(OutputBackendQuery {
-                    status: vec![OutputStatus::EncumberedToBeReceived],
-                    ..Default::default()
-                })
-                .unwrap()
-                .into_iter()
-                .map(|x| x.unblinded_output.value)
-                .collect::<Vec<_>>();
-
-            let post_split_total_amount = new_pending_outputs.iter().fold(0u64, |acc, x| acc + x.as_u64());
-            let expected_output_values: Vec<u64> = Vec::from_raw_parts(
-                (*(*preview).expected_outputs).ptr as *mut u64,
-                (*(*preview).expected_outputs).len,
-                (*(*preview).expected_outputs).cap,
-            );
-
-            let outputs = wallet_get_utxos(
-                alice_wallet,
-                0,
-                20,
-                TariUtxoSort::ValueAsc,
-                Box::into_raw(Box::new(TariVector::from(vec![OutputStatus::Unspent]))),
-                0,
-                error_ptr,
-            );
-            let utxos: &[TariUtxo] = slice::from_raw_parts_mut((*outputs).ptr as *mut TariUtxo, (*outputs).len);
+            let records = wallet_transactions_cursor_next_batch(alice_wallet, cursor, 10, error_ptr);
             assert_eq!(error, 0);
-            assert_eq!(utxos.len(), 2);
-            assert_eq!(unspent_outputs.len(), 2);
-
-            // lengths
-            assert_eq!(new_pending_outputs.len(), 3);
-            assert_eq!(new_pending_outputs.len(), expected_output_values.len());
-
-            // comparing resulting output values relative to itself
-            assert_eq!(new_pending_outputs[0], new_pending_outputs[1]);
-            assert_eq!(new_pending_outputs[2], new_pending_outputs[1] + MicroTari(1));
-
-            // comparing resulting output values to the expected
-            assert_eq!(new_pending_outputs[0].as_u64(), expected_output_values[0]);
-            assert_eq!(new_pending_outputs[1].as_u64(), expected_output_values[1]);
-            assert_eq!(new_pending_outputs[2].as_u64(), expected_output_values[2]);
-
-            // checking fee
-            assert_eq!(pre_split_total_amount - post_split_total_amount, (*preview).fee);
+            assert_eq!((*records).len, 0);
+            transaction_records_destroy(records);
+            wallet_transactions_cursor_close(cursor);
 
-            destroy_tari_vector(outputs);
-            destroy_tari_vector(commitments);
-            destroy_tari_coin_preview(preview);
+            // invalid arguments
+            let cursor = wallet_transactions_cursor_open(alice_wallet, 3, 0, -1, 0, 0, false, error_ptr);
+            assert!(cursor.is_null());
+            assert_ne!(error, 0);
+            let cursor = wallet_transactions_cursor_open(alice_wallet, 0, 0, 5, 0, 0, false, error_ptr);
+            assert!(cursor.is_null());
+            assert_ne!(error, 0);
+            let cursor = wallet_transactions_cursor_open(alice_wallet, 0, 1 << 31, -1, 0, 0, false, error_ptr);
+            assert!(cursor.is_null());
+            assert_ne!(error, 0);
 
             string_destroy(network_str as *mut c_char);
             string_destroy(db_name_alice_str as *mut c_char);
@@ -10019,186 +11393,203 @@ mod test {
     }
 
     #[test]
-    fn test_tari_vector() {
-        let mut error = 0;
-
-        unsafe {
-            let tv = create_tari_vector(TariTypeTag::Text);
-            assert_eq!((*tv).tag, TariTypeTag::Text);
-            assert_eq!((*tv).len, 0);
-            assert_eq!((*tv).cap, 2);
-
-            tari_vector_push_string(
-                tv,
-                CString::new("test string 1").unwrap().into_raw() as *const c_char,
-                &mut error as *mut c_int,
-            );
-            assert_eq!(error, 0);
-            assert_eq!((*tv).tag, TariTypeTag::Text);
-            assert_eq!((*tv).len, 1);
-            assert_eq!((*tv).cap, 1);
-
-            tari_vector_push_string(
-                tv,
-                CString::new("test string 2").unwrap().into_raw() as *const c_char,
-                &mut error as *mut c_int,
-            );
-            assert_eq!(error, 0);
-            assert_eq!((*tv).tag, TariTypeTag::Text);
-            assert_eq!((*tv).len, 2);
-            assert_eq!((*tv).cap, 2);
-
-            tari_vector_push_string(
-                tv,
-                CString::new("test string 3").unwrap().into_raw() as *const c_char,
-                &mut error as *mut c_int,
-            );
-            assert_eq!(error, 0);
-            assert_eq!((*tv).tag, TariTypeTag::Text);
-            assert_eq!((*tv).len, 3);
-            assert_eq!((*tv).cap, 3);
-
-            destroy_tari_vector(tv);
-        }
-    }
-
-    #[test]
-    fn test_com_pub_sig_create() {
+    fn test_wallet_export_utxo_columns() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
+            let mut recovery_in_progress = true;
+            let recovery_in_progress_ptr = &mut recovery_in_progress as *mut bool;
 
-            let (a_value, ephemeral_pubkey) = PublicKey::random_keypair(&mut OsRng);
-            let (x_value, ephemeral_com) = PublicKey::random_keypair(&mut OsRng);
-            let (y_value, _) = PublicKey::random_keypair(&mut OsRng);
-            let ephemeral_com = Commitment::from_public_key(&ephemeral_com);
+            let secret_key_alice = private_key_generate();
+            let db_name_alice = CString::new(random::string(8).as_str()).unwrap();
+            let db_name_alice_str: *const c_char = CString::into_raw(db_name_alice) as *const c_char;
+            let alice_temp_dir = tempdir().unwrap();
+            let db_path_alice = CString::new(alice_temp_dir.path().to_str().unwrap()).unwrap();
+            let db_path_alice_str: *const c_char = CString::into_raw(db_path_alice) as *const c_char;
+            let transport_config_alice = transport_memory_create();
+            let address_alice = transport_memory_get_address(transport_config_alice, error_ptr);
+            let address_alice_str = CStr::from_ptr(address_alice).to_str().unwrap().to_owned();
+            let address_alice_str: *const c_char = CString::new(address_alice_str).unwrap().into_raw() as *const c_char;
+            let network = CString::new(NETWORK_STRING).unwrap();
+            let network_str: *const c_char = CString::into_raw(network) as *const c_char;
 
-            let a_bytes = Box::into_raw(Box::new(ByteVector(a_value.to_vec())));
-            let x_bytes = Box::into_raw(Box::new(ByteVector(x_value.to_vec())));
-            let y_bytes = Box::into_raw(Box::new(ByteVector(y_value.to_vec())));
-            let ephemeral_pubkey_bytes = Box::into_raw(Box::new(ByteVector(ephemeral_pubkey.to_vec())));
-            let ephemeral_com_bytes = Box::into_raw(Box::new(ByteVector(ephemeral_com.to_vec())));
+            let alice_config = comms_config_create(
+                address_alice_str,
+                transport_config_alice,
+                db_name_alice_str,
+                db_path_alice_str,
+                20,
+                10800,
+                error_ptr,
+            );
 
-            let sig = commitment_and_public_signature_create_from_bytes(
-                ephemeral_com_bytes,
-                ephemeral_pubkey_bytes,
-                a_bytes,
-                x_bytes,
-                y_bytes,
+            let passphrase: *const c_char =
+                CString::into_raw(CString::new("Satoshi Nakamoto").unwrap()) as *const c_char;
+
+            let alice_wallet = wallet_create(
+                alice_config,
+                ptr::null(),
+                0,
+                0,
+                passphrase,
+                ptr::null(),
+                network_str,
+                received_tx_callback,
+                received_tx_reply_callback,
+                received_tx_finalized_callback,
+                broadcast_callback,
+                mined_callback,
+                mined_unconfirmed_callback,
+                scanned_callback,
+                scanned_unconfirmed_callback,
+                transaction_send_result_callback,
+                tx_cancellation_callback,
+                txo_validation_complete_callback,
+                contacts_liveness_data_updated_callback,
+                balance_updated_callback,
+                transaction_validation_complete_callback,
+                saf_messages_received_callback,
+                connectivity_status_callback,
+                recovery_in_progress_ptr,
                 error_ptr,
             );
-
             assert_eq!(error, 0);
-            assert_eq!(*(*sig).ephemeral_commitment(), ephemeral_com);
-            assert_eq!(*(*sig).ephemeral_pubkey(), ephemeral_pubkey);
-            assert_eq!(*(*sig).u_a(), a_value);
-            assert_eq!(*(*sig).u_x(), x_value);
-            assert_eq!(*(*sig).u_y(), y_value);
+            (1..=5).for_each(|i| {
+                let (_, uout) = create_test_input((1000 * i).into(), 0, &ExtendedPedersenCommitmentFactory::default());
+                (*alice_wallet)
+                    .runtime
+                    .block_on((*alice_wallet).wallet.output_manager_service.add_output(uout, None))
+                    .unwrap();
+            });
 
-            commitment_and_public_signature_destroy(sig);
-            byte_vector_destroy(ephemeral_com_bytes);
-            byte_vector_destroy(ephemeral_pubkey_bytes);
-            byte_vector_destroy(a_bytes);
-            byte_vector_destroy(x_bytes);
-            byte_vector_destroy(y_bytes);
-        }
-    }
+            let mut commitments = vec![0u8; 3 * 32];
+            let mut values = vec![0u64; 3];
+            let mut statuses = vec![0u8; 3];
+            let mut columns = TariUtxoColumns {
+                capacity: 3,
+                len: 0,
+                revision: 0,
+                commitments: commitments.as_mut_ptr(),
+                values: values.as_mut_ptr(),
+                mined_heights: ptr::null_mut(),
+                mined_timestamps: ptr::null_mut(),
+                statuses: statuses.as_mut_ptr(),
+            };
 
-    #[test]
-    pub fn test_create_external_utxo() {
-        unsafe {
-            let mut error = 0;
-            let error_ptr = &mut error as *mut c_int;
-            // Test the consistent features case
-            let utxo_1 = create_unblinded_output(
-                script!(Nop),
-                OutputFeatures::default(),
-                &TestParams::new(),
-                MicroTari(1234u64),
-            );
-            let amount = utxo_1.value.as_u64();
-            let spending_key_ptr = Box::into_raw(Box::new(utxo_1.spending_key.clone()));
-            let features_ptr = Box::into_raw(Box::new(utxo_1.features.clone()));
-            let metadata_signature_ptr = Box::into_raw(Box::new(utxo_1.metadata_signature.clone()));
-            let sender_offset_public_key_ptr = Box::into_raw(Box::new(utxo_1.sender_offset_public_key.clone()));
-            let script_private_key_ptr = Box::into_raw(Box::new(utxo_1.script_private_key.clone()));
-            let covenant_ptr = Box::into_raw(Box::new(utxo_1.covenant.clone()));
-            let encrypted_value_ptr = Box::into_raw(Box::new(utxo_1.encrypted_value.clone()));
-            let minimum_value_promise = utxo_1.minimum_value_promise.as_u64();
-            let script_ptr = CString::into_raw(CString::new(script!(Nop).to_hex()).unwrap()) as *const c_char;
-            let input_data_ptr = CString::into_raw(CString::new(utxo_1.input_data.to_hex()).unwrap()) as *const c_char;
+            // the first export fills the buffers and reports that there is more
+            assert!(wallet_export_utxo_columns(alice_wallet, 0, &mut columns, error_ptr));
+            assert_eq!(error, 0);
+            assert_eq!(columns.len, 3);
+            assert_eq!(values, vec![1000, 2000, 3000]);
+            assert!(statuses.iter().all(|s| *s == OutputStatus::Unspent as u8));
+            assert!(commitments.chunks(32).all(|c| c.iter().any(|b| *b != 0)));
+
+            // continuing from the returned revision exports the rest
+            let revision = columns.revision;
+            let has_more = wallet_export_utxo_columns(alice_wallet, revision, &mut columns, error_ptr);
+            assert!(!has_more);
+            assert_eq!(error, 0);
+            assert_eq!(columns.len, 2);
+            assert_eq!(&values[..2], &[4000, 5000]);
 
-            let tari_utxo = create_tari_unblinded_output(
-                amount,
-                spending_key_ptr,
-                features_ptr,
-                script_ptr,
-                input_data_ptr,
-                metadata_signature_ptr,
-                sender_offset_public_key_ptr,
-                script_private_key_ptr,
-                covenant_ptr,
-                encrypted_value_ptr,
-                minimum_value_promise,
-                0,
-                error_ptr,
-            );
+            // nothing changed since the last revision
+            let revision = columns.revision;
+            let has_more = wallet_export_utxo_columns(alice_wallet, revision, &mut columns, error_ptr);
+            assert!(!has_more);
+            assert_eq!(error, 0);
+            assert_eq!(columns.len, 0);
+            assert_eq!(columns.revision, revision);
 
+            // deleting the newest output reports it once as deleted, under a revision that is never reused
+            let deleted_commitment = commitments[32..64].to_vec();
+            (*alice_wallet)
+                .wallet
+                .output_db
+                .remove_output_by_commitment(Commitment::from_bytes(&deleted_commitment).unwrap())
+                .unwrap();
+            let has_more = wallet_export_utxo_columns(alice_wallet, revision, &mut columns, error_ptr);
+            assert!(!has_more);
             assert_eq!(error, 0);
-            assert_eq!(*tari_utxo, utxo_1);
-            tari_unblinded_output_destroy(tari_utxo);
+            assert_eq!(columns.len, 1);
+            assert!(columns.revision > revision);
+            assert_eq!(statuses[0], TARI_UTXO_STATUS_DELETED);
+            assert_eq!(values[0], 5000);
+            assert_eq!(&commitments[..32], deleted_commitment.as_slice());
+
+            // acknowledging the deletion discards it, so a full export only reports the remaining outputs
+            assert_eq!(wallet_acknowledge_utxo_revision(alice_wallet, revision, error_ptr), 0);
+            assert_eq!(error, 0);
+            let pruned = wallet_acknowledge_utxo_revision(alice_wallet, columns.revision, error_ptr);
+            assert_eq!(pruned, 1);
+            assert_eq!(error, 0);
+            let mut values = vec![0u64; 5];
+            let mut columns = TariUtxoColumns {
+                capacity: 5,
+                len: 0,
+                revision: 0,
+                commitments: ptr::null_mut(),
+                values: values.as_mut_ptr(),
+                mined_heights: ptr::null_mut(),
+                mined_timestamps: ptr::null_mut(),
+                statuses: ptr::null_mut(),
+            };
+            assert!(!wallet_export_utxo_columns(alice_wallet, 0, &mut columns, error_ptr));
+            assert_eq!(error, 0);
+            assert_eq!(columns.len, 4);
+            assert_eq!(&values[..4], &[1000, 2000, 3000, 4000]);
 
-            // Cleanup
-            string_destroy(script_ptr as *mut c_char);
-            string_destroy(input_data_ptr as *mut c_char);
-            let _covenant = Box::from_raw(covenant_ptr);
-            let _script_private_key = Box::from_raw(script_private_key_ptr);
-            let _sender_offset_public_key = Box::from_raw(sender_offset_public_key_ptr);
-            let _metadata_signature = Box::from_raw(metadata_signature_ptr);
-            let _features = Box::from_raw(features_ptr);
-            let _spending_key = Box::from_raw(spending_key_ptr);
-        }
-    }
+            wallet_acknowledge_utxo_revision(ptr::null_mut(), 0, error_ptr);
+            assert_ne!(error, 0);
+            assert!(!wallet_export_utxo_columns(alice_wallet, 0, ptr::null_mut(), error_ptr));
+            assert_ne!(error, 0);
 
-    fn get_next_memory_address() -> Multiaddr {
-        let port = MemoryTransport::acquire_next_memsocket_port();
-        format!("/memory/{}", port).parse().unwrap()
+            string_destroy(network_str as *mut c_char);
+            string_destroy(db_name_alice_str as *mut c_char);
+            string_destroy(db_path_alice_str as *mut c_char);
+            string_destroy(address_alice_str as *mut c_char);
+            private_key_destroy(secret_key_alice);
+            transport_config_destroy(transport_config_alice);
+            comms_config_destroy(alice_config);
+            wallet_destroy(alice_wallet);
+        }
     }
 
     #[test]
-    #[allow(clippy::too_many_lines)]
-    pub fn test_import_external_utxo() {
+    fn test_wallet_async_requests() {
         unsafe {
             let mut error = 0;
             let error_ptr = &mut error as *mut c_int;
             let mut recovery_in_progress = true;
             let recovery_in_progress_ptr = &mut recovery_in_progress as *mut bool;
 
-            // create a new wallet
-            let db_name = CString::new(random::string(8).as_str()).unwrap();
-            let db_name_str: *const c_char = CString::into_raw(db_name) as *const c_char;
-            let temp_dir = tempdir().unwrap();
-            let db_path = CString::new(temp_dir.path().to_str().unwrap()).unwrap();
-            let db_path_str: *const c_char = CString::into_raw(db_path) as *const c_char;
-            let transport_type = transport_memory_create();
-            let address = transport_memory_get_address(transport_type, error_ptr);
-            let address_str = CStr::from_ptr(address).to_str().unwrap().to_owned();
-            let address_str = CString::new(address_str).unwrap().into_raw() as *const c_char;
+            let secret_key_alice = private_key_generate();
+            let db_name_alice = CString::new(random::string(8).as_str()).unwrap();
+            let db_name_alice_str: *const c_char = CString::into_raw(db_name_alice) as *const c_char;
+            let alice_temp_dir = tempdir().unwrap();
+            let db_path_alice = CString::new(alice_temp_dir.path().to_str().unwrap()).unwrap();
+            let db_path_alice_str: *const c_char = CString::into_raw(db_path_alice) as *const c_char;
+            let transport_config_alice = transport_memory_create();
+            let address_alice = transport_memory_get_address(transport_config_alice, error_ptr);
+            let address_alice_str = CStr::from_ptr(address_alice).to_str().unwrap().to_owned();
+            let address_alice_str: *const c_char = CString::new(address_alice_str).unwrap().into_raw() as *const c_char;
             let network = CString::new(NETWORK_STRING).unwrap();
             let network_str: *const c_char = CString::into_raw(network) as *const c_char;
 
-            let config = comms_config_create(
-                address_str,
-                transport_type,
-                db_name_str,
-                db_path_str,
+            let alice_config = comms_config_create(
+                address_alice_str,
+                transport_config_alice,
+                db_name_alice_str,
+                db_path_alice_str,
                 20,
                 10800,
                 error_ptr,
             );
-            let passphrase: *const c_char = CString::into_raw(CString::new("niao").unwrap()) as *const c_char;
-            let wallet_ptr = wallet_create(
-                config,
+
+            let passphrase: *const c_char =
+                CString::into_raw(CString::new("Satoshi Nakamoto").unwrap()) as *const c_char;
+
+            let alice_wallet = wallet_create(
+                alice_config,
                 ptr::null(),
                 0,
                 0,
@@ -10225,94 +11616,86 @@ mod test {
                 error_ptr,
             );
             assert_eq!(error, 0);
-            let node_identity =
-                NodeIdentity::random(&mut OsRng, get_next_memory_address(), PeerFeatures::COMMUNICATION_NODE);
-            let base_node_peer_public_key_ptr = Box::into_raw(Box::new(node_identity.public_key().clone()));
-            let base_node_peer_address_ptr =
-                CString::into_raw(CString::new(node_identity.public_address().to_string()).unwrap()) as *const c_char;
-            wallet_add_base_node_peer(
-                wallet_ptr,
-                base_node_peer_public_key_ptr,
-                base_node_peer_address_ptr,
-                error_ptr,
-            );
 
-            // Test the consistent features case
-            let utxo_1 = create_unblinded_output(
-                script!(Nop),
-                OutputFeatures::default(),
-                &TestParams::new(),
-                MicroTari(1234u64),
-            );
-            let amount = utxo_1.value.as_u64();
-            let spending_key_ptr = Box::into_raw(Box::new(utxo_1.spending_key.clone()));
-            let features_ptr = Box::into_raw(Box::new(utxo_1.features.clone()));
-            let source_address_ptr = Box::into_raw(Box::new(TariWalletAddress::default()));
-            let metadata_signature_ptr = Box::into_raw(Box::new(utxo_1.metadata_signature.clone()));
-            let sender_offset_public_key_ptr = Box::into_raw(Box::new(utxo_1.sender_offset_public_key.clone()));
-            let script_private_key_ptr = Box::into_raw(Box::new(utxo_1.script_private_key.clone()));
-            let covenant_ptr = Box::into_raw(Box::new(utxo_1.covenant.clone()));
-            let encrypted_value_ptr = Box::into_raw(Box::new(utxo_1.encrypted_value.clone()));
-            let minimum_value_promise = utxo_1.minimum_value_promise.as_u64();
-            let message_ptr = CString::into_raw(CString::new("For my friend").unwrap()) as *const c_char;
-            let script_ptr = CString::into_raw(CString::new(script!(Nop).to_hex()).unwrap()) as *const c_char;
-            let input_data_ptr = CString::into_raw(CString::new(utxo_1.input_data.to_hex()).unwrap()) as *const c_char;
+            // without a callback the completion is queued until polled
+            let request_id = wallet_get_balance_async(alice_wallet, error_ptr);
+            assert_eq!(error, 0);
+            assert_ne!(request_id, 0);
+            let mut completion = None;
+            for _ in 0..100 {
+                let completions = wallet_poll_completions(alice_wallet, 10, error_ptr);
+                assert_eq!(error, 0);
+                let batch: &[TariCompletion] = slice::from_raw_parts((*completions).ptr, (*completions).len);
+                if let Some(c) = batch.first() {
+                    completion = Some((c.request_id, c.kind, c.error_code, c.result));
+                }
+                completions_destroy(completions);
+                if completion.is_some() {
+                    break;
+                }
+                thread::sleep(Duration::from_millis(100));
+            }
+            let (id, kind, error_code, result) = completion.expect("balance request did not complete");
+            assert_eq!(id, request_id);
+            assert_eq!(kind, TariCompletionKind::GetBalance);
+            assert_eq!(error_code, 0);
+            assert!(!result.is_null());
+            assert_eq!((*(result as *mut TariBalance)).available_balance, MicroTari::from(0));
+            balance_destroy(result as *mut TariBalance);
+
+            // request ids are never reused and argument errors are reported synchronously
+            let coin_join_id = wallet_coin_join_async(alice_wallet, ptr::null_mut(), 5, error_ptr);
+            assert_eq!(coin_join_id, 0);
+            assert_ne!(error, 0);
+            let next_id = wallet_get_balance_async(alice_wallet, error_ptr);
+            assert_eq!(error, 0);
+            assert!(next_id > request_id);
 
-            let tari_utxo = create_tari_unblinded_output(
-                amount,
-                spending_key_ptr,
-                features_ptr,
-                script_ptr,
-                input_data_ptr,
-                metadata_signature_ptr,
-                sender_offset_public_key_ptr,
-                script_private_key_ptr,
-                covenant_ptr,
-                encrypted_value_ptr,
-                minimum_value_promise,
+            // utxo listings complete with a vector that the client owns
+            let utxos_id = wallet_get_utxos_async(
+                alice_wallet,
+                0,
+                20,
+                TariUtxoSort::ValueAsc,
+                ptr::null_mut(),
                 0,
                 error_ptr,
             );
-            let tx_id = wallet_import_external_utxo_as_non_rewindable(
-                wallet_ptr,
-                tari_utxo,
-                source_address_ptr,
-                message_ptr,
-                error_ptr,
-            );
-
             assert_eq!(error, 0);
-            assert!(tx_id > 0);
-
-            let outputs = wallet_get_unspent_outputs(wallet_ptr, error_ptr);
-            assert_eq!((*outputs).0.len(), 0);
-            assert_eq!(unblinded_outputs_get_length(outputs, error_ptr), 0);
-
-            // Cleanup
-            tari_unblinded_output_destroy(tari_utxo);
-            unblinded_outputs_destroy(outputs);
-            string_destroy(message_ptr as *mut c_char);
-            string_destroy(script_ptr as *mut c_char);
-            string_destroy(input_data_ptr as *mut c_char);
-            let _covenant = Box::from_raw(covenant_ptr);
-            let _script_private_key = Box::from_raw(script_private_key_ptr);
-            let _sender_offset_public_key = Box::from_raw(sender_offset_public_key_ptr);
-            let _metadata_signature = Box::from_raw(metadata_signature_ptr);
-            let _features = Box::from_raw(features_ptr);
-            let _source_address = Box::from_raw(source_address_ptr);
-            let _spending_key = Box::from_raw(spending_key_ptr);
-
-            let _base_node_peer_public_key = Box::from_raw(base_node_peer_public_key_ptr);
-            string_destroy(base_node_peer_address_ptr as *mut c_char);
+            assert!(utxos_id > next_id);
+            let mut completion = None;
+            for _ in 0..100 {
+                let completions = wallet_poll_completions(alice_wallet, 10, error_ptr);
+                assert_eq!(error, 0);
+                let batch: &[TariCompletion] = slice::from_raw_parts((*completions).ptr, (*completions).len);
+                for c in batch {
+                    if c.request_id == utxos_id {
+                        completion = Some((c.kind, c.error_code, c.result));
+                    } else if c.kind == TariCompletionKind::GetBalance && !c.result.is_null() {
+                        balance_destroy(c.result as *mut TariBalance);
+                    }
+                }
+                completions_destroy(completions);
+                if completion.is_some() {
+                    break;
+                }
+                thread::sleep(Duration::from_millis(100));
+            }
+            let (kind, error_code, result) = completion.expect("utxo request did not complete");
+            assert_eq!(kind, TariCompletionKind::GetUtxos);
+            assert_eq!(error_code, 0);
+            assert!(!result.is_null());
+            assert_eq!((*(result as *mut TariVector)).len, 0);
+            destroy_tari_vector(result as *mut TariVector);
 
             string_destroy(network_str as *mut c_char);
-            string_destroy(db_name_str as *mut c_char);
-            string_destroy(db_path_str as *mut c_char);
-            string_destroy(address_str as *mut c_char);
-            transport_config_destroy(transport_type);
-
-            comms_config_destroy(config);
-            wallet_destroy(wallet_ptr);
+            string_destroy(db_name_alice_str as *mut c_char);
+            string_destroy(db_path_alice_str as *mut c_char);
+            string_destroy(address_alice_str as *mut c_char);
+            private_key_destroy(secret_key_alice);
+            transport_config_destroy(transport_config_alice);
+            comms_config_destroy(alice_config);
+            wallet_destroy(alice_wallet);
         }
     }
 }
@@ -13,6 +13,33 @@
  */
 #define OutputFields_NUM_FIELDS 10
 
+/**
+ * The value written to the status column of `TariUtxoColumns` for an output that has been deleted from the wallet
+ */
+#define TARI_UTXO_STATUS_DELETED 255
+
+/**
+ * Identifies which `_async` call a completion belongs to
+ */
+enum TariCompletionKind {
+  GetBalance = 0,
+  SendTransaction = 1,
+  CoinJoin = 2,
+  GetUtxos = 3,
+};
+
+enum TariTransactionEventKind {
+  Received = 0,
+  ReplyReceived = 1,
+  FinalizedReceived = 2,
+  Broadcast = 3,
+  Mined = 4,
+  MinedUnconfirmed = 5,
+  FauxConfirmed = 6,
+  FauxUnconfirmed = 7,
+  Cancelled = 8,
+};
+
 enum TariTypeTag {
   Text = 0,
   Utxo = 1,
@@ -28,6 +55,11 @@ enum TariUtxoSort {
   MinedHeightDesc = 3,
 };
 
+enum TariValidationEventKind {
+  Txo = 0,
+  Transaction = 1,
+};
+
 /**
  * This struct holds the detailed balance of the Output Manager Service.
  */
@@ -167,6 +199,8 @@ struct TariPublicKeys;
 
 struct TariSeedWords;
 
+struct TariTransactionsCursor;
+
 struct TariUnblindedOutputs;
 
 struct TariWallet;
@@ -324,6 +358,88 @@ typedef struct FeePerGramStatsResponse TariFeePerGramStats;
 
 typedef struct FeePerGramStat TariFeePerGramStat;
 
+/**
+ * A fixed layout summary of a transaction, returned in batches by `wallet_transactions_cursor_next_batch`
+ */
+struct TariTransactionRecord {
+  uint64_t tx_id;
+  uint64_t amount;
+  uint64_t fee;
+  uint64_t timestamp;
+  uint64_t mined_height;
+  uint64_t mined_timestamp;
+  uint64_t confirmations;
+  int32_t status;
+  int32_t direction;
+  int32_t cancellation_reason;
+  uint8_t source_address[33];
+  uint8_t destination_address[33];
+};
+
+struct TariTransactionRecords {
+  uintptr_t len;
+  uintptr_t cap;
+  struct TariTransactionRecord *ptr;
+};
+
+/**
+ * The outcome of an `_async` call as seen by the client.
+ *
+ * `error_code` is 0 on success. `value` carries the scalar result (the `TxId` for sends and coin joins) and `result`
+ * carries a heap allocated result (a `TariBalance` for `GetBalance` and a `TariVector` of `TariUtxo` for `GetUtxos`)
+ * which becomes owned by the client and must be freed with its matching destroy function.
+ */
+struct TariCompletion {
+  uint64_t request_id;
+  enum TariCompletionKind kind;
+  int error_code;
+  uint64_t value;
+  void *result;
+};
+
+typedef void (*CompletionCallback)(struct TariCompletion);
+
+struct TariCompletions {
+  uintptr_t len;
+  uintptr_t cap;
+  struct TariCompletion *ptr;
+};
+
+/**
+ * The latest event for a transaction. `value` holds the number of confirmations for the unconfirmed kinds and the
+ * cancellation reason for `Cancelled`.
+ */
+struct TariTransactionEvent {
+  uint64_t tx_id;
+  enum TariTransactionEventKind kind;
+  uint64_t value;
+};
+
+/**
+ * A validation completion, with the same `result` values as the matching individual callback
+ */
+struct TariValidationEvent {
+  enum TariValidationEventKind kind;
+  uint64_t request_key;
+  uint64_t result;
+};
+
+/**
+ * The coalesced events of one flush interval. `balance` is null when the balance did not change and
+ * `connectivity_status` is -1 when the connectivity status did not change.
+ */
+struct TariEventBatch {
+  struct Balance *balance;
+  uintptr_t transaction_events_len;
+  struct TariTransactionEvent *transaction_events;
+  uintptr_t validation_events_len;
+  struct TariValidationEvent *validation_events;
+  int32_t connectivity_status;
+  bool saf_messages_received;
+};
+
+typedef void (*EventBatchCallback)(struct TariEventBatch*);
+
 struct TariUtxo {
   const char *commitment;
   uint64_t value;
@@ -332,6 +448,21 @@ struct TariUtxo {
   uint8_t status;
 };
 
+/**
+ * Caller provided column buffers filled by `wallet_export_utxo_columns`. Each non-null column must have room for
+ * `capacity` entries; `commitments` holds 32 raw bytes per output. Null columns are skipped.
+ */
+struct TariUtxoColumns {
+  uintptr_t capacity;
+  uintptr_t len;
+  uint64_t revision;
+  uint8_t *commitments;
+  uint64_t *values;
+  uint64_t *mined_heights;
+  uint64_t *mined_timestamps;
+  uint8_t *statuses;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif // __cplusplus
@@ -1594,6 +1725,94 @@ TariCompletedTransaction *completed_transactions_get_at(struct TariCompletedTran
  */
 void completed_transactions_destroy(struct TariCompletedTransactions *transactions);
 
+/**
+ * -------------------------------------------------------------------------------------------- ///
+ * ----------------------------------- TransactionsCursor ------------------------------------- ///
+ * Opens a cursor that pages through the transactions of a TariWallet, newest first, in batches of fixed layout
+ * records without loading the transaction bodies
+ *
+ * ## Arguments
+ * `wallet` - The TariWallet pointer
+ * `source` - The transactions to page through: 0 for completed, 1 for pending inbound and 2 for pending outbound
+ * transactions. Pending transactions have the `Pending` status and are never mined
+ * `status_mask` - Bitmask of the transaction statuses to include, bit `n` selects the status with value `n` as listed
+ * for `completed_transaction_get_status`. A mask of 0 includes all statuses
+ * `direction` - The direction to include: -1 for any, 0 for inbound, 1 for outbound
+ * `min_mined_height` - Only include transactions mined at or above this height, 0 for no lower bound
+ * `max_mined_height` - Only include transactions mined at or below this height, 0 for no upper bound
+ * `cancelled` - Include only cancelled transactions if true, otherwise only non-cancelled transactions
+ * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+ * as an out parameter.
+ *
+ * ## Returns
+ * `*mut TariTransactionsCursor` - Returns the cursor, note that it returns ptr::null_mut() if wallet is null or an
+ * argument is invalid
+ *
+ * # Safety
+ * The ```wallet_transactions_cursor_close``` method must be called when finished with a TariTransactionsCursor to
+ * prevent a memory leak
+ */
+struct TariTransactionsCursor *wallet_transactions_cursor_open(struct TariWallet *wallet,
+                                                               int source,
+                                                               unsigned int status_mask,
+                                                               int direction,
+                                                               unsigned long long min_mined_height,
+                                                               unsigned long long max_mined_height,
+                                                               bool cancelled,
+                                                               int *error_out);
+
+/**
+ * Fetches the next batch of records from a TariTransactionsCursor, advancing the cursor
+ *
+ * ## Arguments
+ * `wallet` - The TariWallet pointer
+ * `cursor` - The TariTransactionsCursor pointer
+ * `batch_size` - The maximum number of records to return
+ * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+ * as an out parameter.
+ *
+ * ## Returns
+ * `*mut TariTransactionRecords` - Returns a struct with an array pointer, length and capacity (needed for proper
+ * destruction after use). An empty batch means the cursor is exhausted. Note that it returns ptr::null_mut() if
+ * wallet or cursor is null or an error is encountered
+ *
+ * # Safety
+ * The ```transaction_records_destroy``` method must be called when finished with a TariTransactionRecords to prevent
+ * a memory leak
+ */
+struct TariTransactionRecords *wallet_transactions_cursor_next_batch(struct TariWallet *wallet,
+                                                                     struct TariTransactionsCursor *cursor,
+                                                                     unsigned int batch_size,
+                                                                     int *error_out);
+
+/**
+ * Frees memory for a TariTransactionsCursor
+ *
+ * ## Arguments
+ * `cursor` - The pointer to a TariTransactionsCursor
+ *
+ * ## Returns
+ * `()` - Does not return a value, equivalent to void in C
+ *
+ * # Safety
+ * None
+ */
+void wallet_transactions_cursor_close(struct TariTransactionsCursor *cursor);
+
+/**
+ * Frees memory for a TariTransactionRecords
+ *
+ * ## Arguments
+ * `records` - The pointer to a TariTransactionRecords
+ *
+ * ## Returns
+ * `()` - Does not return a value, equivalent to void in C
+ *
+ * # Safety
+ * None
+ */
+void transaction_records_destroy(struct TariTransactionRecords *records);
+
 /**
  * -------------------------------------------------------------------------------------------- ///
  * ----------------------------------- OutboundTransactions ------------------------------------ ///
@@ -2637,6 +2856,59 @@ struct TariVector *wallet_get_utxos(struct TariWallet *wallet,
 struct TariVector *wallet_get_all_utxos(struct TariWallet *wallet,
                                         int32_t *error_ptr);
 
+/**
+ * This function exports the outputs that changed after `since_revision` into the caller provided columns, ordered by
+ * revision. Only the unencrypted output columns are read, so nothing is decrypted or hex encoded.
+ *
+ * ## Arguments
+ * * `wallet` - The TariWallet pointer,
+ * * `since_revision` - Only outputs whose revision is greater than this are exported, 0 exports every output,
+ * * `columns` - The TariUtxoColumns to fill. On return `len` holds the number of outputs written and `revision` the
+ * highest revision written, or `since_revision` if nothing changed,
+ * * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
+ * Functions as an out parameter.
+ *
+ * ## Returns
+ * `bool` - Returns true if more changed outputs are available than fit in `capacity`; call again with the returned
+ * `revision` to continue.
+ *
+ * ## States
+ * The status column uses the same values as `wallet_get_all_utxos`. Outputs that are deleted from the wallet are
+ * reported with their last commitment, value and mined columns and a status of `TARI_UTXO_STATUS_DELETED`.
+ *
+ * ## Retention
+ * Deleted outputs are kept until a revision at or after their deletion is passed to
+ * `wallet_acknowledge_utxo_revision`. An export from a `since_revision` below an acknowledged revision may therefore
+ * miss deletions; a client that has lost its state should export from 0 and replace its output set.
+ *
+ * # Safety
+ * Every non-null column pointer must be valid for `capacity` entries
+ */
+bool wallet_export_utxo_columns(struct TariWallet *wallet,
+                                uint64_t since_revision,
+                                struct TariUtxoColumns *columns,
+                                int *error_out);
+
+/**
+ * This function acknowledges that the client has stored every output change up to and including `revision`, so the
+ * wallet can discard the deleted outputs it keeps for `wallet_export_utxo_columns` at or below that revision.
+ *
+ * ## Arguments
+ * * `wallet` - The TariWallet pointer,
+ * * `revision` - The highest revision the client has stored, as returned in `TariUtxoColumns.revision`,
+ * * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
+ * Functions as an out parameter.
+ *
+ * ## Returns
+ * `c_ulonglong` - Returns the number of deleted outputs discarded
+ *
+ * # Safety
+ * None
+ */
+unsigned long long wallet_acknowledge_utxo_revision(struct TariWallet *wallet,
+                                                    unsigned long long revision,
+                                                    int *error_out);
+
 /**
  * This function will tell the wallet to do a coin split.
  *
@@ -3741,6 +4013,209 @@ unsigned long long fee_per_gram_stat_get_max_fee_per_gram(TariFeePerGramStat *fe
  */
 void fee_per_gram_stat_destroy(TariFeePerGramStat *fee_per_gram_stat);
 
+/**
+ * ------------------------------------------------------------------------------------------ ///
+ * ------------------------------------- Async Requests ------------------------------------- ///
+ * Registers the callback through which the results of `_async` calls are delivered. When no callback is registered
+ * (the default) results are queued until collected with `wallet_poll_completions`.
+ *
+ * ## Arguments
+ * `wallet` - The TariWallet pointer
+ * `callback` - The callback function pointer, or null to fall back to polling. The `TariCompletion` is passed by value
+ * and any `result` pointer it carries becomes owned by the client.
+ * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+ * as an out parameter.
+ *
+ * ## Returns
+ * `()` - Does not return a value, equivalent to void in C
+ *
+ * # Safety
+ * The callback is invoked from a wallet runtime thread, not from the thread that made the `_async` call
+ */
+void wallet_set_completion_callback(struct TariWallet *wallet,
+                                    CompletionCallback callback,
+                                    int *error_out);
+
+/**
+ * Collects the results of finished `_async` calls that were not delivered to a completion callback
+ *
+ * ## Arguments
+ * `wallet` - The TariWallet pointer
+ * `max` - The maximum number of completions to return
+ * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+ * as an out parameter.
+ *
+ * ## Returns
+ * `*mut TariCompletions` - Returns a struct with an array pointer, length and capacity (needed for proper destruction
+ * after use), in the order the requests finished. Note that it returns ptr::null_mut() if wallet is null.
+ *
+ * # Safety
+ * The ```completions_destroy``` method must be called when finished with a TariCompletions to prevent a memory leak.
+ * It does not free the `result` pointers, which must be destroyed individually (e.g. with ```balance_destroy```)
+ */
+struct TariCompletions *wallet_poll_completions(struct TariWallet *wallet,
+                                                unsigned int max,
+                                                int *error_out);
+
+/**
+ * Frees memory for a TariCompletions
+ *
+ * ## Arguments
+ * `completions` - The pointer to a TariCompletions
+ *
+ * ## Returns
+ * `()` - Does not return a value, equivalent to void in C
+ *
+ * # Safety
+ * None
+ */
+void completions_destroy(struct TariCompletions *completions);
+
+/**
+ * Retrieves the balance from a wallet without blocking the calling thread
+ *
+ * ## Arguments
+ * `wallet` - The TariWallet pointer.
+ * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+ * as an out parameter.
+ *
+ * ## Returns
+ * `unsigned long long` - Returns the request id, or 0 if the request could not be submitted. The completion carries
+ * a `TariBalance` pointer in `result`.
+ *
+ * # Safety
+ * The ```balance_destroy``` method must be called when finished with the completion's TariBalance to prevent a memory
+ * leak
+ */
+unsigned long long wallet_get_balance_async(struct TariWallet *wallet,
+                                            int *error_out);
+
+/**
+ * Sends a TariPendingOutboundTransaction without blocking the calling thread
+ *
+ * ## Arguments
+ * `wallet` - The TariWallet pointer
+ * `destination` - The TariWalletAddress pointer of the peer
+ * `amount` - The amount
+ * `commitments` - A `TariVector` of "strings", tagged as `TariTypeTag::String`, containing commitment's hex values
+ *   (see `Commitment::to_hex()`)
+ * `fee_per_gram` - The transaction fee
+ * `message` - The pointer to a char array, may be null
+ * `one_sided` - Whether to send a one-sided transaction to the destination's stealth address
+ * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+ * as an out parameter.
+ *
+ * ## Returns
+ * `unsigned long long` - Returns the request id, or 0 if the request could not be submitted. The completion carries
+ * the TxId of the sent transaction in `value`.
+ *
+ * # Safety
+ * None
+ */
+unsigned long long wallet_send_transaction_async(struct TariWallet *wallet,
+                                                 TariWalletAddress *destination,
+                                                 unsigned long long amount,
+                                                 struct TariVector *commitments,
+                                                 unsigned long long fee_per_gram,
+                                                 const char *message,
+                                                 bool one_sided,
+                                                 int *error_out);
+
+/**
+ * Performs a coin join without blocking the calling thread
+ *
+ * ## Arguments
+ * * `wallet` - The TariWallet pointer
+ * * `commitments` - A `TariVector` of "strings", tagged as `TariTypeTag::String`, containing commitment's hex values
+ *   (see `Commitment::to_hex()`)
+ * * `fee_per_gram` - The transaction fee
+ * * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
+ * Functions as an out parameter.
+ *
+ * ## Returns
+ * `unsigned long long` - Returns the request id, or 0 if the request could not be submitted. The completion carries
+ * the TxId of the coin join transaction in `value`.
+ *
+ * # Safety
+ * `TariVector` must be freed after use with `destroy_tari_vector()`
+ */
+unsigned long long wallet_coin_join_async(struct TariWallet *wallet,
+                                          struct TariVector *commitments,
+                                          uint64_t fee_per_gram,
+                                          int *error_out);
+
+/**
+ * Lists unspent UTXOs without blocking the calling thread, see `wallet_get_utxos`
+ *
+ * ## Arguments
+ * * `wallet` - The TariWallet pointer,
+ * * `page` - Page offset,
+ * * `page_size` - A number of items per page,
+ * * `sorting` - An enum representing desired sorting,
+ * * `states` - A `TariVector` of `u64` output states to include, or null for all states. Ownership is taken.
+ * * `dust_threshold` - A value filtering threshold. Outputs whose values are <= `dust_threshold` are not listed in the
+ * result.
+ * * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null.
+ * Functions as an out parameter.
+ *
+ * ## Returns
+ * `unsigned long long` - Returns the request id, or 0 if the request could not be submitted. The completion carries
+ * a `TariVector` of `TariUtxo` in `result`.
+ *
+ * # Safety
+ * `destroy_tari_vector()` must be called on the completion's `TariVector` after use.
+ */
+unsigned long long wallet_get_utxos_async(struct TariWallet *wallet,
+                                          uintptr_t page,
+                                          uintptr_t page_size,
+                                          enum TariUtxoSort sorting,
+                                          struct TariVector *states,
+                                          uint64_t dust_threshold,
+                                          int *error_out);
+
+/**
+ * ------------------------------------------------------------------------------------------ ///
+ * ------------------------------------- Event Batching ------------------------------------- ///
+ * Enables or disables batched delivery of wallet events. While enabled the transaction, balance, validation,
+ * connectivity and SAF callbacks registered in `wallet_create` are no longer called. Their events are coalesced and
+ * delivered through `callback_events` at most once per flush interval: only the latest event per transaction is kept,
+ * the balance is only reported when it changed and the latest connectivity status wins. Transaction send results
+ * and contacts liveness updates keep using their own callbacks.
+ *
+ * ## Arguments
+ * `wallet` - The TariWallet pointer
+ * `callback_events` - The callback function pointer receiving a `TariEventBatch`, or null to disable batching and
+ * return to the individual callbacks. Events collected before the change are flushed first.
+ * `flush_interval_ms` - The interval in milliseconds at which collected events are delivered, must be greater than 0
+ * when `callback_events` is not null
+ * `error_out` - Pointer to an int which will be modified to an error code should one occur, may not be null. Functions
+ * as an out parameter.
+ *
+ * ## Returns
+ * `()` - Does not return a value, equivalent to void in C
+ *
+ * # Safety
+ * The ```event_batch_destroy``` method must be called when finished with a TariEventBatch to prevent a memory leak
+ */
+void wallet_set_event_batching(struct TariWallet *wallet,
+                               EventBatchCallback callback_events,
+                               unsigned long long flush_interval_ms,
+                               int *error_out);
+
+/**
+ * Frees memory for a TariEventBatch, including the balance and event arrays it points to
+ *
+ * ## Arguments
+ * `batch` - The pointer to a TariEventBatch
+ *
+ * ## Returns
+ * `()` - Does not return a value, equivalent to void in C
+ *
+ * # Safety
+ * None
+ */
+void event_batch_destroy(struct TariEventBatch *batch);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif // __cplusplus
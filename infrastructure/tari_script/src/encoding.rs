@@ -0,0 +1,82 @@
+// Copyright 2022. The Tari Project
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+// following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+// disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+// following disclaimer in the documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote
+// products derived from this software without specific prior written permission.
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+use std::{cell::RefCell, io};
+
+use integer_encoding::VarIntWriter;
+
+/// Scratch buffers larger than this are released after use rather than kept around for the lifetime of the thread
+const MAX_RETAINED_CAPACITY: usize = 4096;
+
+thread_local! {
+    static SCRATCH_BUFFER: RefCell<Vec<u8>> = RefCell::new(Vec::new());
+}
+
+/// Writes the bytes produced by `encode`, prefixed with their length as a varint. The length has to be known before
+/// the bytes are written, so they are staged in a buffer that is reused by every call on the same thread. This keeps
+/// hashing scripts and execution stacks free of allocations and hands the bytes to the writer in a single write.
+pub(crate) fn write_length_prefixed<W, F>(writer: &mut W, encode: F) -> io::Result<()>
+where
+    W: io::Write,
+    F: FnOnce(&mut Vec<u8>),
+{
+    SCRATCH_BUFFER.with(|scratch| match scratch.try_borrow_mut() {
+        Ok(mut buf) => {
+            buf.clear();
+            encode(&mut buf);
+            let result = write_buf(writer, &buf);
+            if buf.capacity() > MAX_RETAINED_CAPACITY {
+                *buf = Vec::new();
+            }
+            result
+        },
+        // The buffer is in use further up the stack, which only happens if the writer itself encodes a script
+        Err(_) => {
+            let mut buf = Vec::new();
+            encode(&mut buf);
+            write_buf(writer, &buf)
+        },
+    })
+}
+
+fn write_buf<W: io::Write>(writer: &mut W, buf: &[u8]) -> io::Result<()> {
+    writer.write_varint(buf.len())?;
+    writer.write_all(buf)
+}
+
+#[cfg(test)]
+mod test {
+    use super::*;
+
+    #[test]
+    fn it_writes_the_length_prefix_and_bytes() {
+        let mut out = Vec::new();
+        write_length_prefixed(&mut out, |buf| buf.extend_from_slice(&[1, 2, 3])).unwrap();
+        write_length_prefixed(&mut out, |buf| buf.push(4)).unwrap();
+        assert_eq!(out, vec![3, 1, 2, 3, 1, 4]);
+    }
+
+    #[test]
+    fn it_falls_back_to_a_new_buffer_when_nested() {
+        let mut out = Vec::new();
+        write_length_prefixed(&mut out, |buf| {
+            write_length_prefixed(buf, |inner| inner.push(7)).unwrap();
+        })
+        .unwrap();
+        assert_eq!(out, vec![2, 1, 7]);
+    }
+}
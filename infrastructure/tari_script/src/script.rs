@@ -20,7 +20,7 @@ use std::{cmp::Ordering, collections::HashSet, convert::TryFrom, fmt, io, ops::D
 
 use borsh::{BorshDeserialize, BorshSerialize};
 use digest::Digest;
-use integer_encoding::{VarIntReader, VarIntWriter};
+use integer_encoding::VarIntReader;
 use sha2::Sha256;
 use sha3::Sha3_256;
 use tari_crypto::{
@@ -34,6 +34,7 @@ use tari_utilities::{
 };
 
 use crate::{
+    encoding,
     op_codes::Message,
     slice_to_hash,
     ExecutionStack,
@@ -63,12 +64,11 @@ pub struct TariScript {
 
 impl BorshSerialize for TariScript {
     fn serialize<W: io::Write>(&self, writer: &mut W) -> io::Result<()> {
-        let bytes = self.to_bytes();
-        writer.write_varint(bytes.len())?;
-        for b in &bytes {
-            b.serialize(writer)?;
-        }
-        Ok(())
+        encoding::write_length_prefixed(writer, |buf| {
+            for op in &self.script {
+                op.to_bytes(buf);
+            }
+        })
     }
 }
 
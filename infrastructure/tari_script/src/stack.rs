@@ -18,7 +18,7 @@
 use std::{convert::TryFrom, io};
 
 use borsh::{BorshDeserialize, BorshSerialize};
-use integer_encoding::{VarIntReader, VarIntWriter};
+use integer_encoding::VarIntReader;
 use tari_crypto::ristretto::{pedersen::PedersenCommitment, RistrettoPublicKey, RistrettoSchnorr, RistrettoSecretKey};
 use tari_utilities::{
     hex::{from_hex, to_hex, Hex, HexError},
@@ -26,6 +26,7 @@ use tari_utilities::{
 };
 
 use crate::{
+    encoding,
     error::ScriptError,
     op_codes::{HashValue, ScalarValue},
 };
@@ -186,12 +187,11 @@ pub struct ExecutionStack {
 
 impl BorshSerialize for ExecutionStack {
     fn serialize<W: io::Write>(&self, writer: &mut W) -> io::Result<()> {
-        let bytes = self.to_bytes();
-        writer.write_varint(bytes.len())?;
-        for b in &bytes {
-            b.serialize(writer)?;
-        }
-        Ok(())
+        encoding::write_length_prefixed(writer, |buf| {
+            for item in &self.items {
+                item.to_bytes(buf);
+            }
+        })
     }
 }
 